@@ -3,9 +3,10 @@ option(XO_ENABLE_EXAMPLES "enable building example programs" OFF)
 option(XO_ENABLE_VULKAN "enable vulkan dependency for imgui apps" OFF)
 option(XO_ENABLE_OPENGL "enable opengl dependency for imgui apps" ON)
 option(XO_ENABLE_ASM "generate assembler output (.s files)" OFF)
+set(XO_MIN_LOG_LEVEL "" CACHE STRING "compile out xo::pp::scope logging below this level (never|verbose|chatty|info|..); per-module override: <project>_MIN_LOG_LEVEL")
 
 macro(xo_cxx_config_message)
-    message(STATUS "GUESSED_CMAKE_CMD=cmake -DXO_CMAKE_CONFIG_EXECUTABLE=${XO_CMAKE_CONFIG_EXECUTABLE} -DENABLE_TESTING=${ENABLE_TESTING} -DXO_ENABLE_DOCS=${XO_ENABLE_DOCS} -DXO_ENABLE_ASM=${XO_ENABLE_ASM} -DXO_ENABLE_EXAMPLES=${XO_ENABLE_EXAMPLES} -DXO_ENABLE_VULKAN=${XO_ENABLE_VULKAN} -DXO_ENABLE_OPENGL=${XO_ENABLE_OPENGL} -DCMAKE_CXX_STANDARD=${CMAKE_CXX_STANDARD} -DCMAKE_INSTALL_PREFIX=${CMAKE_INSTALL_PREFIX} -DCMAKE_MODULE_PATH=${CMAKE_MODULE_PATH} -DCMAKE_PREFIX_PATH=${CMAKE_PREFIX_PATH} -DCMAKE_BUILD_TYPE=${CMAKE_BUILD_TYPE} -DCMAKE_INSTALL_DOCDIR=${CMAKE_INSTALL_DOCDIR} -B ${CMAKE_BINARY_DIR}")
+    message(STATUS "GUESSED_CMAKE_CMD=cmake -DXO_CMAKE_CONFIG_EXECUTABLE=${XO_CMAKE_CONFIG_EXECUTABLE} -DENABLE_TESTING=${ENABLE_TESTING} -DXO_ENABLE_DOCS=${XO_ENABLE_DOCS} -DXO_ENABLE_ASM=${XO_ENABLE_ASM} -DXO_MIN_LOG_LEVEL=${XO_MIN_LOG_LEVEL} -DXO_ENABLE_EXAMPLES=${XO_ENABLE_EXAMPLES} -DXO_ENABLE_VULKAN=${XO_ENABLE_VULKAN} -DXO_ENABLE_OPENGL=${XO_ENABLE_OPENGL} -DCMAKE_CXX_STANDARD=${CMAKE_CXX_STANDARD} -DCMAKE_INSTALL_PREFIX=${CMAKE_INSTALL_PREFIX} -DCMAKE_MODULE_PATH=${CMAKE_MODULE_PATH} -DCMAKE_PREFIX_PATH=${CMAKE_PREFIX_PATH} -DCMAKE_BUILD_TYPE=${CMAKE_BUILD_TYPE} -DCMAKE_INSTALL_DOCDIR=${CMAKE_INSTALL_DOCDIR} -B ${CMAKE_BINARY_DIR}")
     message(STATUS "XO_CMAKE_CONFIG_EXECUTABLE=${XO_CMAKE_CONFIG_EXECUTABLE}")
     message(STATUS "CMAKE_INSTALL_PREFIX=${CMAKE_INSTALL_PREFIX}")
 endmacro()
@@ -1200,12 +1201,37 @@ macro(xo_establish_submodule_build)
     endif()
 endmacro()
 
+# ----------------------------------------------------------------
+# build-time minimum log level for xo::pp::scope logging in target
+# (XO_PPSINK_MIN_LOG_LEVEL, see xo-ppsink/scope_macros.hpp).
+# scopes below this level are compiled out.
+#
+# ${PROJECT_NAME}_MIN_LOG_LEVEL (e.g. -Dxo_interpreter2_MIN_LOG_LEVEL=info)
+# overrides XO_MIN_LOG_LEVEL for one module.  Empty => keep everything.
+#
+macro(xo_min_log_level_option target)
+    if(DEFINED ${PROJECT_NAME}_MIN_LOG_LEVEL AND NOT "${${PROJECT_NAME}_MIN_LOG_LEVEL}" STREQUAL "")
+        set(_xo_min_log_level ${${PROJECT_NAME}_MIN_LOG_LEVEL})
+    else()
+        set(_xo_min_log_level ${XO_MIN_LOG_LEVEL})
+    endif()
+
+    if(NOT "${_xo_min_log_level}" STREQUAL "")
+        if(NOT _xo_min_log_level MATCHES "^(never|verbose|chatty|info|warning|error|severe|always|silent)$")
+            message(FATAL_ERROR "xo_min_log_level_option: unknown log level [${_xo_min_log_level}] for ${target}")
+        endif()
+
+        target_compile_definitions(${target} PRIVATE XO_PPSINK_MIN_LOG_LEVEL=${_xo_min_log_level})
+    endif()
+endmacro()
+
 # ----------------------------------------------------------------
 # use this in subdirs that compile c++ code.
 # do not use for header-only subsystems;  see xo_include_headeronly_options2()
 #
 macro(xo_include_options2 target)
     xo_establish_submodule_build()
+    xo_min_log_level_option(${target})
 
     xo_strip_xo_prefix(${target} _nxo_target)
 
@@ -1956,6 +1982,51 @@ macro(xo_pybind11_header_dependency target dep)
     xo_dependency_helper(${target} PUBLIC ${dep})
 endmacro()
 
+# ----------------------------------------------------------------
+# use this for python unit tests (test_*.py in the current source dir)
+# exercising pybind11 library pymodule.
+#
+# remaining arguments: other pybind11 libraries pymodule imports,
+# directly or transitively.  PYTHONPATH is assembled from the directory
+# holding each library,  so tests run against the build tree
+# (submodule build) or wherever find_package() located them,
+# without needing an install first.
+#
+# for example
+#   xo_pybind11_utest(utest.pyprocess xo_pyprocess
+#                     xo_pyreactor xo_pyprintjson xo_pyreflect xo_pywebutil)
+#
+macro(xo_pybind11_utest test_name pymodule)
+    if (ENABLE_TESTING)
+        # same interpreter xo_pybind11_library() built the module for
+        find_package(Python COMPONENTS Interpreter)
+
+        # skip rather than abort,  like xo-cmake/utest: a missing python3
+        # must not break configure for the rest of the build.
+        if (Python_Interpreter_FOUND)
+            set(_xo_pythonpath "")
+            foreach(_xo_pydep ${pymodule} ${ARGN})
+                if (TARGET ${_xo_pydep})
+                    list(APPEND _xo_pythonpath "$<TARGET_FILE_DIR:${_xo_pydep}>")
+                else()
+                    message(WARNING "[${test_name}] no target for python module ${_xo_pydep} (xo_pybind11_utest)")
+                endif()
+            endforeach()
+            string(JOIN ":" _xo_pythonpath ${_xo_pythonpath})
+
+            add_test(
+                NAME ${test_name}
+                COMMAND ${Python_EXECUTABLE} -m unittest discover
+                        -s ${CMAKE_CURRENT_SOURCE_DIR} -p "test_*.py" -v
+            )
+            set_tests_properties(${test_name} PROPERTIES
+                ENVIRONMENT "PYTHONPATH=${_xo_pythonpath}")
+        else()
+            message(WARNING "[${test_name}] python3 not found, skipping python tests (xo_pybind11_utest)")
+        endif()
+    endif()
+endmacro()
+
 # ----------------------------------------------------------------
 # use this to streamline generating .hpp / .cpp scaffolding
 # for faceted object model
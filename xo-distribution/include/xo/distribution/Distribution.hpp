@@ -3,6 +3,11 @@
 #pragma once
 
 #include <xo/refcnt/Refcounted.hpp>
+#include <xo/indentlog2/print/tostr.hpp>
+#include <xo/ppsink/tag.hpp>
+#include <cstddef>
+#include <span>
+#include <stdexcept>
 
 namespace xo {
     namespace distribution {
@@ -13,6 +18,32 @@ namespace xo {
         class Distribution : public ref::Refcount {
         public:
             virtual double cdf(Domain const & x) const = 0;
+
+            /* batch cdf:  out[i] = .cdf(xv[i]) for each i.
+             * Require: out.size() == xv.size()
+             *
+             * Default implementation calls scalar .cdf() for each element;
+             * implementations with closed-form cdf override with a
+             * loop the compiler can vectorize.  Scalar .cdf() remains
+             * the reference implementation.
+             */
+            virtual void cdf(std::span<Domain const> xv, std::span<double> out) const {
+                check_batch_args("Distribution::cdf", xv.size(), out.size());
+
+                for (std::size_t i = 0, n = xv.size(); i < n; ++i)
+                    out[i] = this->cdf(xv[i]);
+            } /*cdf*/
+
+        protected:
+            static void check_batch_args(char const * c_self, std::size_t n_x, std::size_t n_out) {
+                using xo::pp::tostr;
+                using xo::pp::xtag;
+
+                if (n_x != n_out) {
+                    throw std::runtime_error(tostr(c_self, ": expected output span with size matching input",
+                                                   xtag("n_x", n_x), xtag("n_out", n_out)));
+                }
+            } /*check_batch_args*/
         }; /*Distribution*/
     } /*namespace distribution*/
 } /*namespace xo*/
@@ -530,6 +530,9 @@ namespace xo {
 
             // ----- inherited from Distribution<Domain> -----
 
+            /* batch .cdf(xv, out):  default element-wise loop */
+            using Distribution<Domain>::cdf;
+
             /* note: marked const;  actually "logically const" */
             virtual double cdf(Domain const & x) const override {
                 /* .cdf() is slow here,  because partial sums aren't stored
@@ -3,6 +3,7 @@
 #pragma once
 
 #include "xo/distribution/Distribution.hpp"
+#include "xo/distribution/vecmath.hpp"
 #include <cmath>
 #include <limits>
 
@@ -82,6 +83,20 @@ namespace xo {
                 return distribution(x);
             } /*cdf*/
 
+            virtual void cdf(std::span<double const> xv, std::span<double> out) const override {
+                check_batch_args("Exponential::cdf", xv.size(), out.size());
+
+                double const lm = this->lambda_;
+                double const * x = xv.data();
+                double * y = out.data();
+
+                for (std::size_t i = 0, n = xv.size(); i < n; ++i) {
+                    double Fx = 1.0 - vecmath::exp_kernel(-lm * x[i]);
+
+                    y[i] = (x[i] <= 0.0) ? 0.0 : Fx;
+                }
+            } /*cdf*/
+
         private:
             /* intensity parameter.
              * require: lambda > 0
@@ -3,6 +3,7 @@
 #pragma once
 
 #include "Distribution.hpp"
+#include "vecmath.hpp"
 #include <xo/indentlog2/print/tostr.hpp>
 #include <xo/ppsink/scope.hpp>
 #include <xo/ppsink/scope_macros.hpp>
@@ -198,6 +199,60 @@ namespace xo {
                 }
             } /*distr_impl*/
 
+            /* batch version of .distr_impl():  y[i] = distr_impl(x[i]), i in [0, n).
+             *
+             * Evaluates both series P1, P2 for each x (with inline vecmath::exp_kernel()
+             * in place of ::exp(), ::pow()),  then selects,  so the loop is branch-free
+             * and can vectorize (for which flags,  see vecmath.hpp).
+             */
+            static void distr_batch_impl(double const * x, double * y, std::size_t n) {
+                using xo::pp::tostr;
+
+                constexpr char const * c_self = "KolmogorovSmirnov::distr_batch_impl";
+
+                bool negative_flag = false;
+                for (std::size_t i = 0; i < n; ++i)
+                    negative_flag |= (x[i] < 0.0);
+
+                if(negative_flag)
+                    throw std::runtime_error(tostr(c_self, "KS(x) cdf defined for x>=0"));
+
+                double const c_sqrt_2pi = ::sqrt(2.0 * c_pi);
+
+                for (std::size_t i = 0; i < n; ++i) {
+                    double xi = x[i];
+                    double x2 = xi * xi;
+
+                    /* P1(x),  see .distr1_impl() */
+                    double   f = -vecmath::exp_kernel(-2.0 * x2);
+                    double  f2 = f*f;
+                    double  f4 = f2*f2;
+                    double  f8 = f4*f4;
+                    double  f9 = f8*f;
+                    double f16 = f8*f8;
+
+                    double p1 = 1.0 + 2.0*(((f16 + f9) + f4) + f);
+
+                    /* P2(x),  see .distr2_impl();  inf/nan when x=0,  discarded below */
+                    double   u = vecmath::exp_kernel(-c_pi2_8 / x2);
+                    double  u2 = u*u;
+                    double  u4 = u2*u2;
+                    double  u8 = u4*u4;
+                    double u16 = u8*u8;
+                    double u32 = u16*u16;
+
+                    double  u9 = u8*u;
+                    double u25 = u16*u8*u;
+                    double u49 = u32*u16*u;
+
+                    double p2 = (c_sqrt_2pi / xi) * (((u49 + u25) + u9) + u);
+
+                    double Fx = (xi < 1.18) ? p2 : p1;
+
+                    y[i] = (xi == 0.0) ? 0.0 : Fx;
+                }
+            } /*distr_batch_impl*/
+
             /* p-value for significance of a particular value of the KS-statistic
              * obtain this statistic for a sample distribution using
              *   Empirical.ks_stat_1sided(dexp)
@@ -254,6 +309,12 @@ namespace xo {
             virtual double cdf(double const & x) const {
                 return this->distribution(x);
             } /*cdf*/
+
+            virtual void cdf(std::span<double const> xv, std::span<double> out) const override {
+                check_batch_args("KolmogorovSmirnov::cdf", xv.size(), out.size());
+
+                distr_batch_impl(xv.data(), out.data(), xv.size());
+            } /*cdf*/
         }; /*KolmogorovSmirnov*/
     } /*namespace distribution*/
 } /*namespace xo*/
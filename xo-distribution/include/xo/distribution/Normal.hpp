@@ -3,6 +3,7 @@
 #pragma once
 
 #include "Distribution.hpp"
+#include "vecmath.hpp"
 #include <cmath>
 
 namespace xo {
@@ -47,6 +48,16 @@ namespace xo {
             virtual double cdf(double const & x) const override {
                 return cdf_impl(x);
             } /*cdf*/
+
+            virtual void cdf(std::span<double const> xv, std::span<double> out) const override {
+                check_batch_args("Normal::cdf", xv.size(), out.size());
+
+                double const * x = xv.data();
+                double * y = out.data();
+
+                for (std::size_t i = 0, n = xv.size(); i < n; ++i)
+                    y[i] = 0.5 * vecmath::erfc_kernel(-M_SQRT1_2 * x[i]);
+            } /*cdf*/
         }; /*Normal*/
     } /*namespace distribution*/
 } /*namespace xo*/
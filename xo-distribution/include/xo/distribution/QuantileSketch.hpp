@@ -0,0 +1,431 @@
+/* @file QuantileSketch.hpp */
+
+#pragma once
+
+#include "Distribution.hpp"
+#include <xo/indentlog2/print/tostr.hpp>
+#include <xo/ppsink/tag.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace xo {
+    namespace distribution {
+        /* bounded-memory,  mergeable approximation to an empirical distribution
+         * over a given (ordered) Domain.  Alternative to StdEmpirical when the
+         * number of samples (or distinct sample values) is unbounded,
+         * e.g. latency monitoring.
+         *
+         * Implements the KLL sketch (Karnin, Lang & Liberty 2016):
+         * a stack of compactors;  an item at level h stands for 2^h samples.
+         * When the sketch exceeds its capacity,  the lowest full compactor is
+         * sorted and every other item (random parity) promoted to the next level.
+         * Level h holds ~ k.(2/3)^(H-1-h) items,  H = #of levels,
+         * so memory is ~3k items + O(log(n/k)).
+         *
+         * Error bound:
+         *   for any x,  |.cdf(x) - F_n(x)| <= eps  with probability ~99%,
+         *   where F_n is the exact empirical cdf of the n samples seen,  and
+         *     eps = .normalized_rank_error() ~ 2.296 / k^0.9723
+         *   (k=200: eps ~ 1.3%;  k=800: eps ~ 0.35%).
+         *   Constants are the empirical fit published with the Apache DataSketches
+         *   KLL implementation,  which uses the same capacity schedule.
+         *   Bound is additive in rank:  e.g. .quantile(0.999) from a k=200 sketch
+         *   can be any sample with true rank in [0.986, 1.0].
+         *   Merging sketches built with the same k preserves the bound.
+         *   While n < k,  sketch is exact.
+         *
+         * .ks_stat_1sided() and .ks_stat_2sided() are approximate:
+         * reported statistic is within eps (resp. eps1 + eps2) of the exact one.
+         *
+         * Not threadsafe.  For multithreaded collection,  use one sketch per thread
+         * and combine with .merge().
+         *
+         * Require:
+         * - Domain is copyable,  with strict weak order operator<
+         */
+        template<typename Domain>
+        class QuantileSketch : public Distribution<Domain> {
+        public:
+            /* (value, weight) pair,  in sorted view of sketch */
+            using WeightedItem = std::pair<Domain, std::uint64_t>;
+
+            static constexpr std::uint32_t c_default_k = 200;
+            static constexpr std::uint32_t c_min_k = 8;
+
+        public:
+            /* k.     accuracy parameter;  larger k -> more accurate, more memory.
+             * seed.  seed for compaction coin flips;  fixed seed -> reproducible sketch
+             */
+            explicit QuantileSketch(std::uint32_t k = c_default_k,
+                                    std::uint64_t seed = 0x9e3779b97f4a7c15UL)
+                : k_{std::max(k, c_min_k)},
+                  rng_state_{seed ? seed : 1}
+                {
+                    this->grow();
+                }
+
+            static rp<QuantileSketch> make(std::uint32_t k = c_default_k,
+                                           std::uint64_t seed = 0x9e3779b97f4a7c15UL) {
+                return new QuantileSketch(k, seed);
+            }
+
+            /* eps (see class comment) for a sketch with parameter k */
+            static double normalized_rank_error(std::uint32_t k) {
+                return 2.296 / std::pow(static_cast<double>(k), 0.9723);
+            }
+
+            std::uint32_t k() const { return k_; }
+            /* #of samples represented (exact) */
+            std::uint64_t n_sample() const { return n_sample_; }
+            /* #of items retained;  proportional to memory footprint */
+            std::size_t n_retained() const { return size_; }
+            /* #of compactor levels */
+            std::size_t n_level() const { return level_v_.size(); }
+            /* rank error bound for this sketch */
+            double normalized_rank_error() const { return normalized_rank_error(k_); }
+            /* true iff no samples */
+            bool empty() const { return n_sample_ == 0; }
+
+            /* smallest / largest sample seen (exact).  Require: !.empty() */
+            Domain const & min_value() const { return min_; }
+            Domain const & max_value() const { return max_; }
+
+            /* introduce one new sample into this distribution */
+            void include_sample(Domain const & x) {
+                if (this->n_sample_ == 0) {
+                    this->min_ = x;
+                    this->max_ = x;
+                } else {
+                    if (x < this->min_)
+                        this->min_ = x;
+                    if (this->max_ < x)
+                        this->max_ = x;
+                }
+
+                ++(this->n_sample_);
+
+                this->level_v_[0].push_back(x);
+                ++(this->size_);
+                this->sorted_valid_ = false;
+
+                if (this->size_ >= this->max_size_)
+                    this->compress();
+            } /*include_sample*/
+
+            /* fold samples represented by other into this sketch.
+             * other may have different k;  error bound is then governed by
+             * the smaller of the two.
+             */
+            void merge(QuantileSketch const & other) {
+                if (other.n_sample_ == 0)
+                    return;
+
+                if (this->n_sample_ == 0) {
+                    this->min_ = other.min_;
+                    this->max_ = other.max_;
+                } else {
+                    if (other.min_ < this->min_)
+                        this->min_ = other.min_;
+                    if (this->max_ < other.max_)
+                        this->max_ = other.max_;
+                }
+
+                this->n_sample_ += other.n_sample_;
+
+                while (this->level_v_.size() < other.level_v_.size())
+                    this->grow();
+
+                for (std::size_t h = 0; h < other.level_v_.size(); ++h) {
+                    std::vector<Domain> & lvl = this->level_v_[h];
+                    std::vector<Domain> const & src = other.level_v_[h];
+
+                    lvl.insert(lvl.end(), src.begin(), src.end());
+                }
+
+                this->size_ += other.size_;
+                this->sorted_valid_ = false;
+
+                while (this->size_ >= this->max_size_)
+                    this->compress();
+            } /*merge*/
+
+            /* approximate q'th quantile:  sample value x with .cdf(x) ~ q.
+             * Require: !.empty(),  0 <= q <= 1
+             */
+            Domain quantile(double q) const {
+                using xo::pp::tostr;
+                using xo::pp::xtag;
+
+                if (this->n_sample_ == 0) {
+                    throw std::runtime_error(tostr("QuantileSketch::quantile"
+                                                   ": quantile not defined for empty sketch",
+                                                   xtag("q", q)));
+                }
+
+                if (!(q >= 0.0) || !(q <= 1.0)) {
+                    throw std::runtime_error(tostr("QuantileSketch::quantile"
+                                                   ": expected q in [0,1]",
+                                                   xtag("q", q)));
+                }
+
+                if (q == 0.0)
+                    return this->min_;
+                if (q == 1.0)
+                    return this->max_;
+
+                std::vector<WeightedItem> const & v = this->sorted_view();
+
+                /* first item with cumulative weight >= q.n */
+                double target = q * static_cast<double>(this->n_sample_);
+
+                auto ix = std::lower_bound(this->cum_weight_v_.begin(),
+                                           this->cum_weight_v_.end(),
+                                           target,
+                                           [](std::uint64_t w, double t) { return static_cast<double>(w) < t; });
+
+                if (ix == this->cum_weight_v_.end())
+                    return this->max_;
+
+                return v[ix - this->cum_weight_v_.begin()].first;
+            } /*quantile*/
+
+            /* sorted (value, weight) view of sketch contents.
+             * Weights sum to .n_sample().  Cached until next update.
+             */
+            std::vector<WeightedItem> const & sorted_view() const {
+                if (!this->sorted_valid_) {
+                    this->sorted_v_.clear();
+                    this->sorted_v_.reserve(this->size_);
+
+                    for (std::size_t h = 0; h < this->level_v_.size(); ++h) {
+                        std::uint64_t w = (std::uint64_t{1} << h);
+
+                        for (Domain const & x : this->level_v_[h])
+                            this->sorted_v_.push_back(WeightedItem(x, w));
+                    }
+
+                    std::sort(this->sorted_v_.begin(), this->sorted_v_.end(),
+                              [](WeightedItem const & a, WeightedItem const & b) { return a.first < b.first; });
+
+                    this->cum_weight_v_.resize(this->sorted_v_.size());
+
+                    std::uint64_t cum = 0;
+                    for (std::size_t i = 0; i < this->sorted_v_.size(); ++i) {
+                        cum += this->sorted_v_[i].second;
+                        this->cum_weight_v_[i] = cum;
+                    }
+
+                    this->sorted_valid_ = true;
+                }
+
+                return this->sorted_v_;
+            } /*sorted_view*/
+
+            /* approximate kolmogorov-smirnov statistic with a non-sampled distribution.
+             * returns (n, ks) for use with KolmogorovSmirnov
+             * (see StdEmpirical::ks_stat_1sided())
+             */
+            std::pair<double, double> ks_stat_1sided(Distribution<Domain> const & d2) const {
+                std::vector<WeightedItem> const & v = this->sorted_view();
+
+                double nr = 1.0 / static_cast<double>(this->n_sample_);
+                double ks_stat = 0.0;
+
+                /* sketch cdf just below current value */
+                double p1_lo = 0.0;
+
+                for (std::size_t i = 0; i < v.size(); ++i) {
+                    /* skip to last of a run of equal values */
+                    if ((i + 1 < v.size()) && !(v[i].first < v[i+1].first))
+                        continue;
+
+                    Domain const & xi = v[i].first;
+
+                    double p1 = this->cum_weight_v_[i] * nr;
+                    double p2 = d2.cdf(xi);
+
+                    /* sketch cdf jumps at xi:  check both sides */
+                    ks_stat = std::max(ks_stat, std::abs(p1 - p2));
+                    ks_stat = std::max(ks_stat, std::abs(p1_lo - p2));
+
+                    p1_lo = p1;
+                }
+
+                return std::pair<double, double>(this->n_sample_, ks_stat);
+            } /*ks_stat_1sided*/
+
+            /* approximate kolmogorov-smirnov statistic with another sketch;
+             * assess likelihood that both samples come from the same population.
+             * returns (ne, ks),  ne = effective #of points (n1.n2 / (n1 + n2))
+             */
+            std::pair<double, double> ks_stat_2sided(QuantileSketch const & d2) const {
+                std::vector<WeightedItem> const & v1 = this->sorted_view();
+                std::vector<WeightedItem> const & v2 = d2.sorted_view();
+
+                double n1 = this->n_sample_;
+                double n2 = d2.n_sample_;
+
+                double nr1 = 1.0 / n1;
+                double nr2 = 1.0 / n2;
+
+                std::size_t i1 = 0;
+                std::size_t i2 = 0;
+
+                std::uint64_t w1 = 0;
+                std::uint64_t w2 = 0;
+
+                double ks_stat = 0.0;
+
+                /* merge-walk both sorted views;  compare cdfs after
+                 * consuming all items <= smallest remaining value
+                 */
+                while ((i1 < v1.size()) || (i2 < v2.size())) {
+                    Domain const & x
+                        = ((i2 == v2.size())
+                           || ((i1 < v1.size()) && !(v2[i2].first < v1[i1].first)))
+                        ? v1[i1].first
+                        : v2[i2].first;
+
+                    while ((i1 < v1.size()) && !(x < v1[i1].first))
+                        w1 += v1[i1++].second;
+                    while ((i2 < v2.size()) && !(x < v2[i2].first))
+                        w2 += v2[i2++].second;
+
+                    ks_stat = std::max(ks_stat, std::abs(w1 * nr1 - w2 * nr2));
+                }
+
+                double ne = (n1 * n2) / (n1 + n2);
+
+                return std::pair<double, double>(ne, ks_stat);
+            } /*ks_stat_2sided*/
+
+            // ----- inherited from Distribution<Domain> -----
+
+            /* batch .cdf(xv, out):  default element-wise loop */
+            using Distribution<Domain>::cdf;
+
+            /* approximate fraction of samples with value <= x */
+            virtual double cdf(Domain const & x) const override {
+                if (this->n_sample_ == 0)
+                    return 0.0;
+
+                std::vector<WeightedItem> const & v = this->sorted_view();
+
+                /* first item > x */
+                auto ix = std::upper_bound(v.begin(), v.end(), x,
+                                           [](Domain const & x, WeightedItem const & item) { return x < item.first; });
+
+                if (ix == v.begin())
+                    return 0.0;
+
+                return static_cast<double>(this->cum_weight_v_[(ix - v.begin()) - 1]) / this->n_sample_;
+            } /*cdf*/
+
+        private:
+            /* target capacity for level h */
+            std::size_t capacity(std::size_t h) const {
+                std::size_t depth = this->level_v_.size() - h - 1;
+
+                return static_cast<std::size_t>(std::ceil(this->k_ * std::pow(c_shrink, depth))) + 1;
+            } /*capacity*/
+
+            /* add one level on top */
+            void grow() {
+                this->level_v_.emplace_back();
+
+                this->max_size_ = 0;
+                for (std::size_t h = 0; h < this->level_v_.size(); ++h)
+                    this->max_size_ += this->capacity(h);
+            } /*grow*/
+
+            /* compact lowest full level(s) until under capacity */
+            void compress() {
+                for (std::size_t h = 0; h < this->level_v_.size(); ++h) {
+                    if (this->level_v_[h].size() >= this->capacity(h)) {
+                        if (h + 1 >= this->level_v_.size())
+                            this->grow();
+
+                        this->compact_level(h);
+
+                        if (this->size_ < this->max_size_)
+                            break;
+                    }
+                }
+
+                this->sorted_valid_ = false;
+            } /*compress*/
+
+            /* sort level h;  promote every other item to level h+1,
+             * starting from random offset.  Leaves at most one item at level h
+             */
+            void compact_level(std::size_t h) {
+                std::vector<Domain> & src = this->level_v_[h];
+                std::vector<Domain> & dest = this->level_v_[h + 1];
+
+                std::sort(src.begin(), src.end());
+
+                /* with odd size,  keep largest item at level h */
+                std::size_t n_pair = src.size() / 2;
+                std::size_t offset = this->coin_flip();
+
+                for (std::size_t i = 0; i < n_pair; ++i)
+                    dest.push_back(src[2 * i + offset]);
+
+                if (src.size() % 2 == 1) {
+                    src[0] = std::move(src.back());
+                    src.resize(1);
+                } else {
+                    src.clear();
+                }
+
+                this->size_ -= n_pair;
+            } /*compact_level*/
+
+            /* 0 or 1,  with equal probability (xorshift64) */
+            std::size_t coin_flip() {
+                std::uint64_t x = this->rng_state_;
+
+                x ^= x << 13;
+                x ^= x >> 7;
+                x ^= x << 17;
+
+                this->rng_state_ = x;
+
+                return (x >> 63);
+            } /*coin_flip*/
+
+        private:
+            /* ratio between capacities of adjacent levels */
+            static constexpr double c_shrink = 2.0 / 3.0;
+
+            /* accuracy parameter:  capacity of top level */
+            std::uint32_t k_ = c_default_k;
+            /* state for compaction coin flips */
+            std::uint64_t rng_state_ = 1;
+            /* #of samples represented */
+            std::uint64_t n_sample_ = 0;
+            /* smallest,  largest sample seen */
+            Domain min_ = Domain();
+            Domain max_ = Domain();
+            /* .level_v[h]:  items with weight 2^h,  in no particular order */
+            std::vector<std::vector<Domain>> level_v_;
+            /* #of items across all levels */
+            std::size_t size_ = 0;
+            /* compress when .size reaches this:  sum of level capacities */
+            std::size_t max_size_ = 0;
+
+            /* sorted view,  rebuilt lazily after updates */
+            mutable bool sorted_valid_ = false;
+            mutable std::vector<WeightedItem> sorted_v_;
+            /* .cum_weight_v[i]:  sum of .sorted_v[0..i].second */
+            mutable std::vector<std::uint64_t> cum_weight_v_;
+        }; /*QuantileSketch*/
+
+    } /*namespace distribution*/
+} /*namespace xo*/
+
+/* end QuantileSketch.hpp */
@@ -205,6 +205,9 @@ namespace xo {
 
             // ----- inherited from Distribution<Domain> -----
 
+            /* batch .cdf(xv, out):  default element-wise loop */
+            using Distribution<Domain>::cdf;
+
             virtual double cdf(Domain const & x) const override {
                 /* computes #of samples with values <= x */
                 uint32_t nx = this->sample_map_.reduce_lub(x, true /*is_closed*/);
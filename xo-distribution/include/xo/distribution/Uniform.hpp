@@ -48,6 +48,23 @@ namespace xo {
                 return this->distribution(x);
             } /*cdf*/
 
+            virtual void cdf(std::span<double const> xv, std::span<double> out) const override {
+                check_batch_args("Uniform::cdf", xv.size(), out.size());
+
+                double const lo = this->lo_;
+                double const hi = this->hi_;
+                double const w = hi - lo;
+                double const * x = xv.data();
+                double * y = out.data();
+
+                for (std::size_t i = 0, n = xv.size(); i < n; ++i) {
+                    double Fx = (x[i] - lo) / w;
+
+                    Fx = (x[i] <= lo) ? 0.0 : Fx;
+                    y[i] = (x[i] >= hi) ? 1.0 : Fx;
+                }
+            } /*cdf*/
+
         private:
             /* Invariant: .lo < .hi */
             double lo_ = 0.0;
@@ -0,0 +1,184 @@
+/* @file BatchCdf.test.cpp
+ *
+ * batch cdf(span, span) vs. scalar cdf() reference
+ */
+
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
+
+#include "xo/distribution/Normal.hpp"
+#include "xo/distribution/Exponential.hpp"
+#include "xo/distribution/Uniform.hpp"
+#include "xo/distribution/KolmogorovSmirnov.hpp"
+#include "xo/distribution/QuantileSketch.hpp"
+#include "xo/distribution/vecmath.hpp"
+#include <catch2/catch.hpp>
+#include <cmath>
+#include <vector>
+
+namespace xo {
+    using xo::distribution::Distribution;
+    using xo::distribution::Normal;
+    using xo::distribution::Exponential;
+    using xo::distribution::Uniform;
+    using xo::distribution::KolmogorovSmirnov;
+    using xo::distribution::QuantileSketch;
+    namespace vecmath = xo::distribution::vecmath;
+
+    namespace ut {
+        namespace {
+            /* n evenly-spaced points on [lo, hi] */
+            std::vector<double>
+            linspace(double lo, double hi, std::size_t n)
+            {
+                std::vector<double> v(n);
+
+                for (std::size_t i = 0; i < n; ++i)
+                    v[i] = lo + (hi - lo) * i / (n - 1);
+
+                return v;
+            } /*linspace*/
+
+            /* max relative error of d.cdf(xv, ..) vs. scalar d.cdf(x).
+             * Where reference value is below tiny,  require only absolute
+             * agreement within tiny (batch exp() flushes below ~1e-308);
+             * report 1.0 if that fails.
+             */
+            double
+            max_batch_rel_error(Distribution<double> const & d,
+                                std::vector<double> const & xv,
+                                double tiny = 1e-300)
+            {
+                std::vector<double> yv(xv.size());
+
+                d.cdf(xv, yv);
+
+                double err = 0.0;
+
+                for (std::size_t i = 0; i < xv.size(); ++i) {
+                    double y0 = d.cdf(xv[i]);
+
+                    if (std::abs(y0) > tiny) {
+                        err = std::max(err, std::abs(yv[i] / y0 - 1.0));
+                    } else {
+                        err = std::max(err, (std::abs(yv[i] - y0) <= tiny) ? 0.0 : 1.0);
+                    }
+                }
+
+                return err;
+            } /*max_batch_rel_error*/
+        } /*namespace*/
+
+        TEST_CASE("vecmath-exp", "[distribution][vecmath]") {
+            for (double x : linspace(-708.0, 709.0, 100001)) {
+                INFO("x=" << x);
+
+                REQUIRE(vecmath::exp_kernel(x) == Approx(std::exp(x)).epsilon(1e-15));
+            }
+
+            REQUIRE(vecmath::exp_kernel(-800.0) == 0.0);
+            REQUIRE(vecmath::exp_kernel(-INFINITY) == 0.0);
+            REQUIRE(vecmath::exp_kernel(800.0) == INFINITY);
+            REQUIRE(std::isnan(vecmath::exp_kernel(NAN)));
+        } /*TEST_CASE(vecmath-exp)*/
+
+        TEST_CASE("vecmath-erfc", "[distribution][vecmath]") {
+            for (double x : linspace(-6.0, 26.0, 100001)) {
+                INFO("x=" << x);
+
+                REQUIRE(vecmath::erfc_kernel(x) == Approx(std::erfc(x)).epsilon(2e-15));
+            }
+
+            REQUIRE(vecmath::erfc_kernel(0.0) == 1.0);
+            REQUIRE(vecmath::erfc_kernel(INFINITY) == 0.0);
+            REQUIRE(vecmath::erfc_kernel(-INFINITY) == 2.0);
+        } /*TEST_CASE(vecmath-erfc)*/
+
+        TEST_CASE("batch-cdf", "[distribution][batch]") {
+            SECTION("normal") {
+                /* lower tail down to ~1e-300 */
+                REQUIRE(max_batch_rel_error(*(Normal::unit().get()),
+                                            linspace(-37.0, 9.0, 100001)) < 2e-15);
+            }
+
+            SECTION("exponential") {
+                Exponential d(2.5);
+
+                /* 1 - exp(-lm.x) cancels near 0,  same in both paths */
+                REQUIRE(max_batch_rel_error(d, linspace(-1.0, 20.0, 100001), 1e-3) < 1e-14);
+            }
+
+            SECTION("uniform") {
+                Uniform d(-1.5, 3.0);
+
+                REQUIRE(max_batch_rel_error(d, linspace(-5.0, 5.0, 10001)) == 0.0);
+            }
+
+            SECTION("kolmogorov-smirnov") {
+                KolmogorovSmirnov d;
+
+                REQUIRE(max_batch_rel_error(d, linspace(0.0, 5.0, 100001)) < 1e-14);
+
+                /* same domain check as scalar path */
+                std::vector<double> xv = {0.5, -0.1};
+                std::vector<double> yv(2);
+
+                REQUIRE_THROWS_AS(d.cdf(xv, yv), std::runtime_error);
+            }
+
+            SECTION("default") {
+                /* distribution without batch override:  element-wise loop */
+                QuantileSketch<double> d(100);
+
+                for (int i = 0; i < 100; ++i)
+                    d.include_sample(i);
+
+                REQUIRE(max_batch_rel_error(d, linspace(-1.0, 101.0, 1001)) == 0.0);
+            }
+
+            SECTION("size-mismatch") {
+                std::vector<double> xv(10);
+                std::vector<double> yv(9);
+
+                REQUIRE_THROWS_AS(Normal::unit()->cdf(xv, yv), std::runtime_error);
+            }
+        } /*TEST_CASE(batch-cdf)*/
+
+        /* benchmark with:
+         *   $ ./utest.distribution [!benchmark]
+         *
+         * cdf evaluations/sec = 100k / (reported mean time)
+         */
+        TEST_CASE("batch-cdf-benchmark", "[!benchmark]") {
+            std::vector<double> xv = linspace(-4.0, 4.0, 100000);
+            std::vector<double> kv = linspace(0.0, 3.0, 100000);
+            std::vector<double> yv(xv.size());
+
+            auto n01 = Normal::unit();
+            KolmogorovSmirnov ks;
+
+            BENCHMARK("Normal::cdf scalar x100k") {
+                for (std::size_t i = 0; i < xv.size(); ++i)
+                    yv[i] = n01->cdf(xv[i]);
+                return yv[0];
+            };
+
+            BENCHMARK("Normal::cdf batch x100k") {
+                n01->cdf(xv, yv);
+                return yv[0];
+            };
+
+            BENCHMARK("KolmogorovSmirnov::cdf scalar x100k") {
+                for (std::size_t i = 0; i < kv.size(); ++i)
+                    yv[i] = ks.cdf(kv[i]);
+                return yv[0];
+            };
+
+            BENCHMARK("KolmogorovSmirnov::cdf batch x100k") {
+                ks.cdf(kv, yv);
+                return yv[0];
+            };
+        } /*TEST_CASE(batch-cdf-benchmark)*/
+    } /*namespace ut*/
+} /*namespace xo*/
+
+/* end BatchCdf.test.cpp */
@@ -1,5 +1,7 @@
 /* @file Normal.test.cpp */
 
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
+
 #include "xo/distribution/Normal.hpp"
 #include <catch2/catch.hpp>
 
@@ -0,0 +1,261 @@
+/* @file QuantileSketch.test.cpp */
+
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
+
+#include "xo/distribution/QuantileSketch.hpp"
+#include "xo/distribution/Uniform.hpp"
+#include <catch2/catch.hpp>
+#include <algorithm>
+#include <map>
+#include <random>
+#include <vector>
+
+namespace xo {
+    using xo::distribution::QuantileSketch;
+    using xo::distribution::Uniform;
+
+    namespace ut {
+        namespace {
+            /* max |sketch.cdf(x) - exact cdf(x)| over sorted samples v[] */
+            double
+            max_rank_error(QuantileSketch<double> const & sketch,
+                           std::vector<double> const & v)
+            {
+                double n = v.size();
+                double err = 0.0;
+
+                for (std::size_t i = 0; i < v.size(); i += 97) {
+                    /* exact fraction of samples <= v[i] */
+                    auto hi = std::upper_bound(v.begin(), v.end(), v[i]);
+                    double exact = (hi - v.begin()) / n;
+
+                    err = std::max(err, std::abs(sketch.cdf(v[i]) - exact));
+                }
+
+                return err;
+            } /*max_rank_error*/
+
+            /* exact one-sided KS statistic for sorted samples v[] vs. d2 */
+            double
+            exact_ks_1sided(std::vector<double> const & v,
+                            xo::distribution::Distribution<double> const & d2)
+            {
+                double n = v.size();
+                double ks = 0.0;
+
+                for (std::size_t i = 0; i < v.size(); ++i) {
+                    double p2 = d2.cdf(v[i]);
+
+                    ks = std::max(ks, std::abs((i + 1) / n - p2));
+                    ks = std::max(ks, std::abs(i / n - p2));
+                }
+
+                return ks;
+            } /*exact_ks_1sided*/
+        } /*namespace*/
+
+        TEST_CASE("quantile-sketch-exact", "[distribution][sketch]") {
+            /* while n <= k,  sketch retains every sample */
+            QuantileSketch<double> sketch(100);
+
+            REQUIRE(sketch.empty());
+            REQUIRE(sketch.cdf(0.0) == 0.0);
+            REQUIRE_THROWS_AS(sketch.quantile(0.5), std::runtime_error);
+
+            for (int i = 1; i <= 100; ++i)
+                sketch.include_sample(i);
+
+            REQUIRE(sketch.n_sample() == 100);
+            REQUIRE(sketch.n_retained() == 100);
+            REQUIRE(sketch.cdf(0.5) == 0.0);
+            REQUIRE(sketch.cdf(1.0) == 0.01);
+            REQUIRE(sketch.cdf(50.0) == 0.5);
+            REQUIRE(sketch.cdf(100.0) == 1.0);
+            REQUIRE(sketch.quantile(0.0) == 1.0);
+            REQUIRE(sketch.quantile(0.5) == 50.0);
+            REQUIRE(sketch.quantile(1.0) == 100.0);
+            REQUIRE_THROWS_AS(sketch.quantile(1.5), std::runtime_error);
+        } /*TEST_CASE(quantile-sketch-exact)*/
+
+        TEST_CASE("quantile-sketch-accuracy", "[distribution][sketch]") {
+            std::mt19937_64 rng(4198743298712341UL);
+            std::lognormal_distribution<double> latency(0.0, 1.5);
+
+            for (std::uint32_t k : {64u, 200u, 800u}) {
+                INFO("k=" << k);
+
+                QuantileSketch<double> sketch(k);
+
+                std::size_t n = 1000000;
+                std::vector<double> v;
+                v.reserve(n);
+
+                for (std::size_t i = 0; i < n; ++i) {
+                    double x = latency(rng);
+
+                    v.push_back(x);
+                    sketch.include_sample(x);
+                }
+
+                std::sort(v.begin(), v.end());
+
+                double eps = sketch.normalized_rank_error();
+
+                REQUIRE(sketch.n_sample() == n);
+                /* bounded memory */
+                REQUIRE(sketch.n_retained() < 4 * k + 64);
+                REQUIRE(sketch.min_value() == v.front());
+                REQUIRE(sketch.max_value() == v.back());
+
+                REQUIRE(max_rank_error(sketch, v) <= eps);
+
+                for (double q : {0.01, 0.25, 0.5, 0.9, 0.99, 0.999}) {
+                    INFO("q=" << q);
+
+                    /* true rank of reported quantile */
+                    double xq = sketch.quantile(q);
+                    double rank = (std::upper_bound(v.begin(), v.end(), xq) - v.begin()) / double(n);
+
+                    REQUIRE(std::abs(rank - q) <= eps);
+                }
+            }
+        } /*TEST_CASE(quantile-sketch-accuracy)*/
+
+        TEST_CASE("quantile-sketch-merge", "[distribution][sketch]") {
+            /* e.g. one sketch per thread,  merged for reporting */
+            std::mt19937_64 rng(987123498712341UL);
+            std::normal_distribution<double> n01(0.0, 1.0);
+
+            std::uint32_t n_part = 8;
+            std::size_t n_per_part = 100000;
+
+            std::vector<rp<QuantileSketch<double>>> part_v;
+            std::vector<double> v;
+
+            for (std::uint32_t p = 0; p < n_part; ++p) {
+                part_v.push_back(QuantileSketch<double>::make(200, 1 + p /*seed*/));
+
+                for (std::size_t i = 0; i < n_per_part; ++i) {
+                    /* partitions see different sub-populations */
+                    double x = n01(rng) + 0.25 * p;
+
+                    v.push_back(x);
+                    part_v.back()->include_sample(x);
+                }
+            }
+
+            QuantileSketch<double> total(200);
+
+            for (auto const & part : part_v)
+                total.merge(*(part.get()));
+
+            std::sort(v.begin(), v.end());
+
+            REQUIRE(total.n_sample() == n_part * n_per_part);
+            REQUIRE(total.n_retained() < 4 * 200 + 64);
+            REQUIRE(total.min_value() == v.front());
+            REQUIRE(total.max_value() == v.back());
+            REQUIRE(max_rank_error(total, v) <= total.normalized_rank_error());
+
+            /* merging empty sketch is a no-op */
+            std::size_t n_retained = total.n_retained();
+            total.merge(QuantileSketch<double>(200));
+            REQUIRE(total.n_retained() == n_retained);
+        } /*TEST_CASE(quantile-sketch-merge)*/
+
+        TEST_CASE("quantile-sketch-ks", "[distribution][sketch]") {
+            std::mt19937_64 rng(12341234987UL);
+            std::uniform_real_distribution<double> u01(0.0, 1.0);
+
+            QuantileSketch<double> s1(200);
+            QuantileSketch<double> s2(200);
+            std::vector<double> v1;
+
+            std::size_t n = 20000;
+
+            for (std::size_t i = 0; i < n; ++i) {
+                double x1 = u01(rng);
+                double x2 = 0.9 * u01(rng);
+
+                s1.include_sample(x1);
+                v1.push_back(x1);
+                s2.include_sample(x2);
+            }
+
+            std::sort(v1.begin(), v1.end());
+
+            double eps = s1.normalized_rank_error();
+
+            /* vs. non-sampled distribution:  compare with exact statistic */
+            {
+                rp<Uniform> d2 = Uniform::unit();
+
+                auto ks_sketch = s1.ks_stat_1sided(*(d2.get()));
+                double ks_exact = exact_ks_1sided(v1, *(d2.get()));
+
+                REQUIRE(ks_sketch.first == n);
+                REQUIRE(std::abs(ks_sketch.second - ks_exact) <= eps);
+            }
+
+            /* vs. other sketch:  populations differ by 0.1 in cdf at x=0.9 */
+            {
+                auto ks = s1.ks_stat_2sided(s2);
+
+                REQUIRE(ks.first == Approx(n / 2.0));
+                REQUIRE(std::abs(ks.second - 0.1) <= 2 * eps);
+            }
+
+            /* identical sketches */
+            {
+                auto ks = s1.ks_stat_2sided(s1);
+
+                REQUIRE(ks.second == 0.0);
+            }
+        } /*TEST_CASE(quantile-sketch-ks)*/
+
+        /* benchmark with:
+         *   $ ./utest.distribution [!benchmark]
+         *
+         * inserts/sec = 100k / (reported mean time).
+         * Baseline is an exact tree-backed empirical distribution
+         * (same storage strategy as StdEmpirical);  continuous samples,
+         * so it retains every one.
+         */
+        TEST_CASE("quantile-sketch-benchmark", "[!benchmark]") {
+            std::mt19937_64 rng(4198743298712341UL);
+            std::lognormal_distribution<double> latency(0.0, 1.5);
+
+            std::vector<double> v(100000);
+            for (auto & x : v)
+                x = latency(rng);
+
+            BENCHMARK("std::map<double,uint32_t> insert x100k") {
+                std::map<double, std::uint32_t> e;
+                for (double x : v)
+                    ++e[x];
+                return e.size();
+            };
+
+            BENCHMARK("QuantileSketch::include_sample x100k") {
+                QuantileSketch<double> s;
+                for (double x : v)
+                    s.include_sample(x);
+                return s.n_sample();
+            };
+
+            QuantileSketch<double> s;
+            for (double x : v)
+                s.include_sample(x);
+
+            BENCHMARK("QuantileSketch::cdf") {
+                return s.cdf(1.0);
+            };
+
+            BENCHMARK("QuantileSketch::quantile") {
+                return s.quantile(0.99);
+            };
+        } /*TEST_CASE(quantile-sketch-benchmark)*/
+    } /*namespace ut*/
+} /*namespace xo*/
+
+/* end QuantileSketch.test.cpp */
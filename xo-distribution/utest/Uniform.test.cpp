@@ -1,5 +1,7 @@
 /* @file Uniform.test.cpp */
 
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
+
 #include "xo/distribution/Uniform.hpp"
 #include <catch2/catch.hpp>
 
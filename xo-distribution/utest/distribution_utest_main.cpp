@@ -1,6 +1,8 @@
 /* file distribution_utest_main.cpp */
 
 #define CATCH_CONFIG_MAIN
+/* must agree across all translation units of utest.distribution */
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
 #include "catch2/catch.hpp"
 
 /* end distribution_utest_main.cpp */
@@ -0,0 +1,121 @@
+/** @file vsmbench.cpp
+ *
+ *  @author Roland Conybeare, Oct 2026
+ *
+ *  Times the VSM eval loop on a recursive schematika function.
+ *
+ *  The point is to measure what scope logging costs in
+ *  DVirtualSchematikaMachine::execute_one() and friends when it's disabled
+ *  at runtime,  compared with compiling it out.  Build twice and compare:
+ *
+ *  @code
+ *    cmake -DXO_ENABLE_EXAMPLES=on ..                                   # runtime-gated
+ *    cmake -DXO_ENABLE_EXAMPLES=on -Dxo_interpreter2_MIN_LOG_LEVEL=info ..  # compiled out
+ *  @endcode
+ *
+ *  Each iteration reads + evaluates fact(k),  so ns/call includes an
+ *  amortized share of reader and result-printing cost.
+ *
+ *  Usage: vsmbench [n-iter [fact-arg]] > /dev/null
+ *  (interactive session echoes each value on stdout;  timing goes to stderr)
+ **/
+
+#include <xo/interpreter2/VirtualSchematikaMachine.hpp>
+#include <xo/interpreter2/init_interpreter2.hpp>
+#include <xo/alloc2/Arena.hpp>
+#include <xo/facet/FacetRegistry.hpp>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+
+namespace xo {
+    using xo::scm::DVirtualSchematikaMachine;
+    using xo::scm::VsmConfig;
+    using xo::scm::VsmResultExt;
+    using xo::mm::AAllocator;
+    using xo::mm::AGCObject;
+    using xo::mm::ArenaConfig;
+    using xo::mm::DArena;
+    using xo::facet::FacetRegistry;
+    using xo::facet::TypeRegistry;
+    using span_type = xo::mm::span<const char>;
+
+    /** read + evaluate one complete expression from @p input;  false on error **/
+    bool
+    eval1(DVirtualSchematikaMachine & vsm, const std::string & input)
+    {
+        VsmResultExt res = vsm.read_eval_print(span_type::from_cstr(input.c_str()),
+                                               false /*eof*/);
+
+        return !res.is_error();
+    }
+} /*namespace xo*/
+
+int
+main(int argc, char ** argv)
+{
+    using namespace xo;
+    using std::cerr;
+    using std::endl;
+
+    long n_iter = (argc > 1) ? std::atol(argv[1]) : 20000;
+    long fact_arg = (argc > 2) ? std::atol(argv[2]) : 20;
+
+    TypeRegistry::instance(1024);
+    FacetRegistry::instance(1024);
+
+    InitEvidence init_evidence = (InitSubsys<S_interpreter2_tag>::require());
+    (void)init_evidence;
+
+    Subsystem::initialize_all();
+
+    DArena arena(ArenaConfig().with_name("vsmbench").with_size(32 * 1024));
+
+    /* generation big enough that the timed loop doesn't collect:
+     * measuring the eval loop here, not gc
+     */
+    VsmConfig cfg
+        = (VsmConfig()
+           .with_x1_config(VsmConfig::std_x1_config().with_size(512 * 1024 * 1024)));
+
+    abox<AGCObject,DVirtualSchematikaMachine> vsm;
+    vsm.adopt(DVirtualSchematikaMachine::make(obj<AAllocator,DArena>(&arena),
+                                              cfg,
+                                              obj<AAllocator,DArena>(&arena)));
+
+    vsm->begin_interactive_session();
+
+    if (!eval1(*vsm.data(), "def fact = lambda (n) { if (n == 0) then 1 else n * fact(n - 1) };\n")) {
+        cerr << "vsmbench: error defining fact" << endl;
+        return 1;
+    }
+
+    std::string expr = "fact(" + std::to_string(fact_arg) + ");\n";
+
+    /* warmup */
+    for (long i = 0; i < n_iter / 10; ++i)
+        eval1(*vsm.data(), expr);
+
+    auto t0 = std::chrono::steady_clock::now();
+
+    for (long i = 0; i < n_iter; ++i) {
+        if (!eval1(*vsm.data(), expr)) {
+            cerr << "vsmbench: error at iteration " << i << endl;
+            return 1;
+        }
+    }
+
+    auto t1 = std::chrono::steady_clock::now();
+
+    double dt_ns = std::chrono::duration<double, std::nano>(t1 - t0).count();
+
+    cerr << "vsmbench: " << n_iter << " x " << expr.substr(0, expr.size() - 1)
+         << " " << (dt_ns / n_iter) << " ns/iter"
+         << " (" << (dt_ns / (n_iter * (fact_arg + 1))) << " ns/call)"
+         << endl;
+
+    return 0;
+}
+
+/* end vsmbench.cpp */
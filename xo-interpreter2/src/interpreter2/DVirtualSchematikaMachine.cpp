@@ -304,25 +304,31 @@ namespace xo {
         {
             scope log(XO_DEBUG_(config_.debug_flag_));
 
-            log && log(xtag("pc", pc_),
-                       xtag("cont", cont_));
-
-            auto expr_pr = expr_.to_facet<APrintable>();
-            if (expr_pr)
-                log && log(xtag("expr", expr_pr));
-
-            if (value_.value()) {
-                auto value_pr
-                    = const_cast<obj<AGCObject> *>(value_.value())->to_facet<APrintable>();
-                if (value_pr)
-                    log && log(xtag("value", value_pr));
-            } else {
-                log && log("value not present or tk error");
-            }
+            // facet lookups below are per-instruction;
+            // skip them unless logging (free when compiled out,
+            // see XO_PPSINK_MIN_LOG_LEVEL)
+            //
+            if (log) {
+                log(xtag("pc", pc_),
+                    xtag("cont", cont_));
+
+                auto expr_pr = expr_.to_facet<APrintable>();
+                if (expr_pr)
+                    log(xtag("expr", expr_pr));
+
+                if (value_.value()) {
+                    auto value_pr
+                        = const_cast<obj<AGCObject> *>(value_.value())->to_facet<APrintable>();
+                    if (value_pr)
+                        log(xtag("value", value_pr));
+                } else {
+                    log("value not present or tk error");
+                }
 
-            auto stack_pr = stack_.to_facet<APrintable>();
-            if (stack_pr)
-                log && log(xtag("stack", stack_pr));
+                auto stack_pr = stack_.to_facet<APrintable>();
+                if (stack_pr)
+                    log(xtag("stack", stack_pr));
+            }
 
             switch (pc_.opcode()) {
             case vsm_opcode::sentinel:
@@ -111,7 +111,8 @@ namespace xo {
             KalmanFilterStep step_;
 
             /* filter state as of most recent observation;
-             * result of applying KalmanFilterEngine::step() to contents of .step
+             * result of applying KalmanFilterEngine::step() (or .step_sqrt(),
+             * depending on .filter_spec.update_form()) to contents of .step
              */
             rp<KalmanFilterStateExt> state_ext_;
         }; /*KalmanFilter*/
@@ -0,0 +1,229 @@
+/* @file KalmanFilterBatchSvc.hpp */
+
+#pragma once
+
+#include "KalmanFilterInputCallback.hpp"
+#include "KalmanFilterObservable.hpp"
+#include "KalmanFilterOutputCallback.hpp"
+#include "KalmanFilterState.hpp"
+#include "KalmanFilterTransition.hpp"
+#include <xo/callback/CallbackSet.hpp>
+#include <xo/refcnt/Refcounted.hpp>
+#include <xo/timeutil/timeutil.hpp>
+#include <cstdint>
+#include <vector>
+
+namespace xo {
+    namespace kalman {
+        /* run many kalman filters of identical shape,  sharing one model
+         * (F, Q, H, R),  e.g. one filter per instrument.
+         *
+         * Compare with one KalmanFilterSvc per instrument:  there each input
+         * pays for a virtual dispatch,  a dynamically-sized filter step,
+         * and allocation of a new KalmanFilterStateExt.
+         *
+         * Here filter state lives in structure-of-arrays form:
+         * component x[i] (resp. P[i,j]) of every filter is stored contiguously.
+         * Inputs are queued by .notify_input();  .flush() advances all filters
+         * with pending inputs together,  in one pass over compact lanes,
+         * so inner loops run across filters and vectorize.
+         *
+         * Per-filter outputs are published through KalmanFilterOutputCallback,
+         * exactly as KalmanFilterSvc would publish them.  Output state objects
+         * are only created for filters that have callbacks attached.
+         *
+         * Inputs with absent observations (see KalmanFilterInput.presence)
+         * are stepped one at a time using KalmanFilterEngine::step(),
+         * with observation matrices reindexed accordingly.
+         *
+         * Not threadsafe.
+         *
+         * Use:
+         *   rp<KalmanFilterBatchSvc> svc = KalmanFilterBatchSvc::make(Fk, Hk);
+         *   uint32_t ix = svc->add_filter(s0);
+         *   svc->add_callback(ix, out_cb);
+         *
+         *   svc->notify_input(ix, zkp1);    // or via svc->input_sink(ix)
+         *   ...
+         *   svc->flush();                    // out_cb->notify_ev(..) called here
+         */
+        class KalmanFilterBatchSvc : public ref::Refcount {
+        public:
+            using utc_nanos = xo::time::utc_nanos;
+            using VectorXd = Eigen::VectorXd;
+            using MatrixXd = Eigen::MatrixXd;
+            using CallbackId = fn::CallbackId;
+
+        public:
+            /* model.  transition matrix F and system noise Q,  shared by all filters
+             * obs.    coupling matrix H and observation noise R,  shared by all filters;
+             *         must keep all observations (see KalmanFilterObservable::keep_all())
+             */
+            static rp<KalmanFilterBatchSvc> make(KalmanFilterTransition model,
+                                                 KalmanFilterObservable obs);
+
+            KalmanFilterTransition const & model() const { return model_; }
+            KalmanFilterObservable const & obs() const { return obs_; }
+
+            /* #of filters */
+            uint32_t n_filter() const { return k_v_.size(); }
+            /* #of state variables (per filter) */
+            uint32_t n_state() const { return n_; }
+            /* #of observables (per filter) */
+            uint32_t n_obs() const { return m_; }
+            /* #of inputs received,  not yet processed */
+            std::size_t n_pending() const { return pending_v_.size(); }
+            /* lifetime #of filter steps taken */
+            std::uint64_t n_step() const { return n_step_; }
+            /* lifetime #of batched steps redone through KalmanFilterEngine,
+             * because innovation covariance was not positive definite
+             */
+            std::uint64_t n_fallback() const { return n_fallback_; }
+
+            /* add filter with initial state s0;  returns index identifying new filter.
+             * Require: s0.n_state() = .n_state()
+             */
+            uint32_t add_filter(rp<KalmanFilterStateExt> const & s0);
+
+            /* current state for filter #ix */
+            std::uint32_t step_no(uint32_t ix) const { return k_v_[ix]; }
+            utc_nanos tm(uint32_t ix) const { return tk_v_[ix]; }
+            VectorXd state_v(uint32_t ix) const;
+            MatrixXd state_cov(uint32_t ix) const;
+            /* [n x m] gain from most recent step of filter #ix */
+            MatrixXd gain(uint32_t ix) const;
+            /* current state of filter #ix,  in the form KalmanFilterSvc publishes */
+            rp<KalmanFilterStateExt> state_ext(uint32_t ix) const;
+
+            /* sink that forwards input to .notify_input(ix, ..);
+             * use to attach filter #ix to a KalmanFilterInputSource
+             */
+            rp<KalmanFilterInputCallback> input_sink(uint32_t ix);
+
+            /* queue input for filter #ix;  consumed by next .flush() */
+            void notify_input(uint32_t ix, rp<KalmanFilterInput> const & input_kp1);
+
+            /* step every filter with pending input.
+             * A filter with multiple pending inputs steps once per input,
+             * in the order received.
+             * Returns #of filter steps taken
+             */
+            std::uint64_t flush();
+
+            /* publish state updates for filter #ix to cb */
+            CallbackId add_callback(uint32_t ix, rp<KalmanFilterOutputCallback> const & cb);
+            void remove_callback(uint32_t ix, CallbackId id);
+
+            void display(std::ostream & os) const;
+            std::string display_string() const;
+
+        private:
+            KalmanFilterBatchSvc(KalmanFilterTransition model,
+                                 KalmanFilterObservable obs);
+
+            /* true iff input can go through batch pass */
+            bool is_batchable(rp<KalmanFilterInput> const & input) const;
+
+            /* step filters .batch_ix_v[] with inputs .batch_input_v[],
+             * all at once
+             */
+            void run_batch();
+
+            /* step filter #ix by itself,  using KalmanFilterEngine */
+            void step_one(uint32_t ix, rp<KalmanFilterInput> const & input_kp1);
+
+            /* publish current state of filter #ix */
+            void publish(uint32_t ix);
+
+            /* make sure batch workspace holds at least nb lanes */
+            void reserve_lanes(std::size_t nb);
+
+        private:
+            /* F, Q shared by all filters */
+            KalmanFilterTransition model_;
+            /* H, R shared by all filters */
+            KalmanFilterObservable obs_;
+            /* #of state variables */
+            uint32_t n_ = 0;
+            /* #of observables */
+            uint32_t m_ = 0;
+
+            /* ----- per-filter state,  structure-of-arrays ----- */
+
+            /* .k_v[ix]:  step# for filter ix */
+            std::vector<std::uint32_t> k_v_;
+            /* .tk_v[ix]: time t(k) for filter ix */
+            std::vector<utc_nanos> tk_v_;
+            /* .x_vv[i][ix] = x[i] for filter ix;  n vectors */
+            std::vector<std::vector<double>> x_vv_;
+            /* .P_vv[i*n + j][ix] = P[i,j] for filter ix;  n*n vectors */
+            std::vector<std::vector<double>> P_vv_;
+            /* .K_vv[i*m + a][ix] = K[i,a] for filter ix;  n*m vectors */
+            std::vector<std::vector<double>> K_vv_;
+            /* .zk_v[ix]: most recent input for filter ix */
+            std::vector<rp<KalmanFilterInput>> zk_v_;
+            /* .pass_v[ix]: value of .pass_no when filter ix last stepped */
+            std::vector<std::uint64_t> pass_v_;
+            /* .pub_v[ix]: output callbacks for filter ix */
+            std::vector<fn::RpCallbackSet<KalmanFilterOutputCallback>> pub_v_;
+
+            /* ----- pending input ----- */
+
+            /* inputs received since last .flush(),  in arrival order */
+            std::vector<std::pair<uint32_t, rp<KalmanFilterInput>>> pending_v_;
+            /* inputs being processed by current pass of .flush() */
+            std::vector<std::pair<uint32_t, rp<KalmanFilterInput>>> work_v_;
+            /* inputs deferred to next pass of current .flush() */
+            std::vector<std::pair<uint32_t, rp<KalmanFilterInput>>> defer_v_;
+            /* increments once per pass in .flush() */
+            std::uint64_t pass_no_ = 0;
+            /* lifetime #of filter steps */
+            std::uint64_t n_step_ = 0;
+            /* lifetime #of lanes that fell back to .step_one() */
+            std::uint64_t n_fallback_ = 0;
+
+            /* ----- batch workspace,  reused across passes -----
+             *
+             * each array holds (#rows) x .lane_cap doubles;
+             * lane b of row r at [r * .lane_cap + b]
+             */
+
+            /* filter index for each lane */
+            std::vector<uint32_t> batch_ix_v_;
+            /* input for each lane */
+            std::vector<rp<KalmanFilterInput>> batch_input_v_;
+            /* capacity (#lanes) of workspace arrays */
+            std::size_t lane_cap_ = 0;
+            /* [n] x(k),  then x(k+1|k) */
+            std::vector<double> wx_;
+            /* [n*n] P(k) */
+            std::vector<double> wP_;
+            /* [n*n] F.P(k) */
+            std::vector<double> wFP_;
+            /* [n*n] P(k+1|k) */
+            std::vector<double> wPe_;
+            /* [n*m] P(k+1|k).H^T */
+            std::vector<double> wPHt_;
+            /* [m*m] M = H.P(k+1|k).H^T + R,  overwritten by cholesky factor */
+            std::vector<double> wM_;
+            /* [n*m] kalman gain K */
+            std::vector<double> wK_;
+            /* [m] z(k+1),  then innovation */
+            std::vector<double> wz_;
+            /* [m] scratch for triangular solves */
+            std::vector<double> wy_;
+            /* .lane_ok_v[b]: false if cholesky for lane b met a non-positive pivot;
+             * such lanes are not scattered,  and step again via .step_one()
+             */
+            std::vector<char> lane_ok_v_;
+        }; /*KalmanFilterBatchSvc*/
+
+        inline std::ostream &
+        operator<<(std::ostream & os, KalmanFilterBatchSvc const & x) {
+            x.display(os);
+            return os;
+        } /*operator<<*/
+    } /*namespace kalman*/
+} /*namespace xo*/
+
+/* end KalmanFilterBatchSvc.hpp */
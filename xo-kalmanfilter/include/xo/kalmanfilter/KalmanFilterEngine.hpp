@@ -179,6 +179,59 @@ namespace xo {
              */
             static rp<KalmanFilterStateExt> step1(KalmanFilterStep const & step_spec,
                                                        uint32_t j);
+
+            // ----- square-root form -----
+
+            /* Square-root covariance filter:
+             * propagate a square-root factor S of P (P = S.S^T)
+             * instead of P itself.  Mathematically equivalent to
+             * .extrapolate() / .correct(),  but:
+             * - P(k) is symmetric and non-negative definite by construction,
+             *   even after many steps with finite-precision arithmetic
+             * - condition number of S is sqrt of condition number of P
+             * - gain uses triangular solves;  never forms M(k+1)^-1
+             *
+             * S is carried in KalmanFilterState.state_cov_sqrt();
+             * if sk does not carry S (e.g. initial state),  factor sk.P on demand.
+             */
+
+            /* compute some S with S.S^T = P.
+             * Cholesky factor if P is positive definite;  otherwise
+             * (P non-negative definite) factor from LDLT decomposition
+             */
+            static MatrixXd cov_sqrt(MatrixXd const & P);
+
+            /* square-root version of .extrapolate():
+             *
+             *   QR-triangularize [F(k).S(k), sqrt(Q(k))] to get S(k+1|k)
+             */
+            static rp<KalmanFilterState> extrapolate_sqrt(utc_nanos tkp1,
+                                                          rp<KalmanFilterState> const & sk,
+                                                          KalmanFilterTransition const & Fk);
+
+            /* square-root version of .correct():
+             *
+             * QR-triangularize pre-array to get post-array:
+             *
+             *   | sqrt(R)  H.S(k+1|k) |      | sqrt(M)   0      |
+             *   |                     |  ->  |                  |
+             *   |   0      S(k+1|k)   |      |   Kb     S(k+1)  |
+             *
+             * with kalman gain K = Kb.sqrt(M)^-1,  via triangular solve
+             */
+            static rp<KalmanFilterStateExt> correct_sqrt(rp<KalmanFilterState> const & skp1_ext,
+                                                         KalmanFilterObservable const & Hkp1,
+                                                         rp<KalmanFilterInput> const & zkp1);
+
+            /* square-root version of .step() */
+            static rp<KalmanFilterStateExt> step_sqrt(utc_nanos tkp1,
+                                                      rp<KalmanFilterState> const & sk,
+                                                      KalmanFilterTransition const & Fk,
+                                                      KalmanFilterObservable const & Hkp1,
+                                                      rp<KalmanFilterInput> const & zkp1);
+
+            /* square-root version of .step(step_spec) */
+            static rp<KalmanFilterStateExt> step_sqrt(KalmanFilterStep const & step_spec);
         }; /*KalmanFilterEngine*/
     } /*namespace kalman*/
 } /*namespace xo*/
@@ -0,0 +1,286 @@
+/* @file KalmanFilterEngineN.hpp */
+
+#pragma once
+
+#include "KalmanFilterState.hpp"
+#include <xo/timeutil/timeutil.hpp>
+#include <Eigen/Dense>
+#include <cstdint>
+#include <stdexcept>
+#include <string>
+
+namespace xo {
+    namespace kalman {
+        /* kalman filter engine for small filters with dimensions
+         * known at compile time.
+         *
+         * Same arithmetic as KalmanFilterEngine.{extrapolate, correct, correct1, step},
+         * but:
+         * - uses fixed-size eigen types;  no heap allocation per step
+         * - owns filter state,  instead of returning a new refcounted
+         *   KalmanFilterState[Ext] from each step.
+         *   State is double-buffered:  .extrapolate() writes x(k+1|k), P(k+1|k)
+         *   into the spare buffer and flips;  .correct() updates in place.
+         *   Previous step's state remains available via .prev_state().
+         *
+         * Intended for filters with a handful (say 2..8) of state variables,
+         * where allocation and dynamic-size overhead dominate the arithmetic.
+         * Use .make_state_ext() to interoperate with KalmanFilterSvc etc.
+         *
+         * NState.  number of filter state variables n (dimension of x)
+         * NObs.    number of observables m (dimension of z).
+         *          Fixed-size engine does not support reindexing observations
+         *          (see KalmanFilterObservable.keep);  all m observations
+         *          participate in .correct()
+         */
+        template <int NState, int NObs>
+        class KalmanFilterEngineN {
+        public:
+            using utc_nanos = xo::time::utc_nanos;
+            /* [n x 1] */
+            using VectorN = Eigen::Matrix<double, NState, 1>;
+            /* [m x 1] */
+            using VectorM = Eigen::Matrix<double, NObs, 1>;
+            /* [n x n] */
+            using MatrixNN = Eigen::Matrix<double, NState, NState>;
+            /* [m x n] */
+            using MatrixMN = Eigen::Matrix<double, NObs, NState>;
+            /* [n x m] */
+            using MatrixNM = Eigen::Matrix<double, NState, NObs>;
+            /* [m x m] */
+            using MatrixMM = Eigen::Matrix<double, NObs, NObs>;
+
+            static constexpr int c_n_state = NState;
+            static constexpr int c_n_obs = NObs;
+
+            /* filter state at one step */
+            struct State {
+                /* step# k */
+                std::uint32_t k_ = 0;
+                /* time t(k) */
+                utc_nanos tk_;
+                /* [n x 1] estimated system state x(k) */
+                VectorN x_ = VectorN::Zero();
+                /* [n x n] error covariance for x(k) */
+                MatrixNN P_ = MatrixNN::Zero();
+                /* [n x m] kalman gain from most recent .correct();
+                 * for .correct1(),  only column j is populated
+                 */
+                MatrixNM K_ = MatrixNM::Zero();
+                /* observable consumed by .correct1(),  or -1 */
+                std::int32_t j_ = -1;
+            };
+
+        public:
+            KalmanFilterEngineN() = default;
+            /* t0.  time assoc'd with initial state
+             * x0.  initial state estimate x(0)
+             * P0.  error covariance for x(0)
+             */
+            KalmanFilterEngineN(utc_nanos t0, VectorN const & x0, MatrixNN const & P0) {
+                State & s = this->state_v_[0];
+
+                s.tk_ = t0;
+                s.x_ = x0;
+                s.P_ = P0;
+            }
+
+            /* initialize from dynamically-sized state s.
+             * Require: s.n_state() = NState
+             */
+            static KalmanFilterEngineN from_state(rp<KalmanFilterState> const & s) {
+                if ((s->state_v().size() != NState)
+                    || (s->state_cov().rows() != NState)
+                    || (s->state_cov().cols() != NState))
+                {
+                    throw std::runtime_error
+                        (std::string("KalmanFilterEngineN::from_state: expected n_state=")
+                         + std::to_string(NState)
+                         + ", got n_state=" + std::to_string(s->n_state()));
+                }
+
+                KalmanFilterEngineN retval(s->tm(), s->state_v(), s->state_cov());
+
+                retval.state_v_[0].k_ = s->step_no();
+
+                return retval;
+            }
+
+            State const & state() const { return state_v_[cur_ix_]; }
+            /* state before most recent .extrapolate() */
+            State const & prev_state() const { return state_v_[1 - cur_ix_]; }
+
+            std::uint32_t step_no() const { return this->state().k_; }
+            utc_nanos tm() const { return this->state().tk_; }
+            VectorN const & state_v() const { return this->state().x_; }
+            MatrixNN const & state_cov() const { return this->state().P_; }
+            MatrixNM const & gain() const { return this->state().K_; }
+
+            /* evolution of system state + account for system noise
+             * (see KalmanFilterEngine::extrapolate())
+             *   x(k) --> x(k+1|k)
+             *   P(k) --> P(k+1|k)
+             *
+             * tkp1.  time t(k+1)
+             * F.     state transition matrix F(k)
+             * Q.     system noise covariance Q(k)
+             */
+            void extrapolate(utc_nanos tkp1, MatrixNN const & F, MatrixNN const & Q) {
+                State const & s = this->state_v_[cur_ix_];
+                State & s_ext = this->state_v_[1 - cur_ix_];
+
+                s_ext.k_ = s.k_ + 1;
+                s_ext.tk_ = tkp1;
+
+                /* x(k+1|k) */
+                s_ext.x_.noalias() = F * s.x_;
+
+                /* P(k+1|k) */
+                s_ext.P_.noalias() = F * s.P_ * F.transpose();
+                s_ext.P_ += Q;
+
+                s_ext.K_.setZero();
+                s_ext.j_ = -1;
+
+                this->cur_ix_ = 1 - cur_ix_;
+            }
+
+            /* correct extrapolated state for observations z(k+1);
+             * also computes kalman gain.
+             * (see KalmanFilterEngine::correct())
+             *
+             * H.  [m x n] coupling matrix:  z(k+1) = H.x(k+1) + w(k+1)
+             * R.  [m x m] observation error covariance
+             * z.  [m x 1] observations z(k+1)
+             */
+            void correct(MatrixMN const & H, MatrixMM const & R, VectorM const & z) {
+                State & s = this->state_v_[cur_ix_];
+
+                /* P(k+1|k).H(k)^T :: [n x m] */
+                MatrixNM PHt;
+                PHt.noalias() = s.P_ * H.transpose();
+
+                /*                            T
+                 *   M = H(k).P(k+1|k).H(k) + R(k)    [m x m], symmetric
+                 */
+                MatrixMM M;
+                M.noalias() = H * PHt;
+                M += R;
+
+                /*                    -1              T           -1         T
+                 *   K = P(k+1|k).H.M       <==>     K  = M . (H.P(k+1|k))
+                 *
+                 * (P, M symmetric).  Factor M instead of forming its inverse
+                 */
+                Eigen::LDLT<MatrixMM> ldlt(M);
+
+                s.K_ = ldlt.solve(PHt.transpose()).transpose();
+
+                /* innovation: actual - predicted observations */
+                VectorM innov = z;
+                innov.noalias() -= H * s.x_;
+
+                /* x(k+1) */
+                s.x_.noalias() += s.K_ * innov;
+
+                /* P(k+1) = (I - K.H).P(k+1|k)
+                 *        = P(k+1|k) - K.(H.P(k+1|k))
+                 */
+                MatrixNN KHP;
+                KHP.noalias() = s.K_ * PHt.transpose();
+                s.P_ -= KHP;
+
+                s.j_ = -1;
+            }
+
+            /* correct extrapolated state for observation of
+             * j'th observable z(k+1)[j] only.
+             * Can use this when observation errors are uncorrelated (R diagonal).
+             * (see KalmanFilterEngine::correct1())
+             */
+            void correct1(MatrixMN const & H, MatrixMM const & R, VectorM const & z, std::uint32_t j) {
+                State & s = this->state_v_[cur_ix_];
+
+                /* Hj :: [1 x n] */
+                auto Hj = H.row(j);
+
+                /* P(k+1|k).Hj^T :: [n x 1] */
+                VectorN PHjt;
+                PHjt.noalias() = s.P_ * Hj.transpose();
+
+                /* M :: [1 x 1] */
+                double m = Hj.dot(PHjt) + R(j, j);
+
+                /* Kj :: [n x 1] */
+                VectorN Kj = PHjt / m;
+
+                double innovj = z[j] - Hj.dot(s.x_);
+
+                s.x_ += Kj * innovj;
+
+                /* P(k+1) = P(k+1|k) - Kj.(Hj.P(k+1|k)) */
+                MatrixNN KHP;
+                KHP.noalias() = Kj * PHjt.transpose();
+                s.P_ -= KHP;
+
+                s.K_.setZero();
+                s.K_.col(j) = Kj;
+                s.j_ = j;
+            }
+
+            /* step filter from t(k) -> t(k+1) (see KalmanFilterEngine::step()) */
+            void step(utc_nanos tkp1,
+                      MatrixNN const & F, MatrixNN const & Q,
+                      MatrixMN const & H, MatrixMM const & R,
+                      VectorM const & z)
+            {
+                this->extrapolate(tkp1, F, Q);
+                this->correct(H, R, z);
+            }
+
+            /* step filter from t(k) -> t(k+1),
+             * consuming only observation z(k+1)[j]
+             * (see KalmanFilterEngine::step1())
+             */
+            void step1(utc_nanos tkp1,
+                       MatrixNN const & F, MatrixNN const & Q,
+                       MatrixMN const & H, MatrixMM const & R,
+                       VectorM const & z,
+                       std::uint32_t j)
+            {
+                this->extrapolate(tkp1, F, Q);
+                this->correct1(H, R, z, j);
+            }
+
+            /* copy current state into a (heap-allocated) KalmanFilterStateExt;
+             * for interop with code that consumes dynamically-sized filter state.
+             *
+             * transition.  F, Q used for most recent step
+             * zk.          observations used for most recent step (may be null)
+             */
+            rp<KalmanFilterStateExt> make_state_ext(KalmanFilterTransition transition,
+                                                    rp<KalmanFilterInput> zk) const {
+                State const & s = this->state();
+
+                return KalmanFilterStateExt::make(s.k_,
+                                                  s.tk_,
+                                                  Eigen::VectorXd(s.x_),
+                                                  Eigen::MatrixXd(s.P_),
+                                                  std::move(transition),
+                                                  Eigen::MatrixXd(s.K_),
+                                                  s.j_,
+                                                  std::move(zk));
+            }
+
+        private:
+            /* double-buffered filter state;
+             * .state_v[.cur_ix] is current
+             */
+            State state_v_[2];
+            /* 0 or 1 */
+            std::uint32_t cur_ix_ = 0;
+        }; /*KalmanFilterEngineN*/
+    } /*namespace kalman*/
+} /*namespace xo*/
+
+/* end KalmanFilterEngineN.hpp */
@@ -6,6 +6,34 @@
 
 namespace xo {
     namespace kalman {
+        /* selects arithmetic used by KalmanFilter to step filter state */
+        enum class KalmanUpdateForm {
+            /* propagate covariance P directly;
+             * see KalmanFilterEngine::step()
+             */
+            covariance,
+            /* propagate square-root factor S of P (P = S.S^T) via QR updates;
+             * see KalmanFilterEngine::step_sqrt()
+             */
+            square_root,
+        };
+
+        inline char const *
+        update_form_descr(KalmanUpdateForm x) {
+            switch (x) {
+            case KalmanUpdateForm::covariance:  return "covariance";
+            case KalmanUpdateForm::square_root: return "square_root";
+            }
+
+            return "?update_form";
+        } /*update_form_descr*/
+
+        inline std::ostream &
+        operator<<(std::ostream & os, KalmanUpdateForm x) {
+            os << update_form_descr(x);
+            return os;
+        } /*operator<<*/
+
         /* full specification for a kalman filter.
          *
          * For a textbook linear filter,  expect a KalmanFilterStep
@@ -47,8 +75,14 @@ namespace xo {
             explicit KalmanFilterSpec(rp<KalmanFilterStateExt> s0, MkStepFn mkstepfn)
                 : start_ext_{std::move(s0)},
                   mk_step_fn_{std::move(mkstepfn)} {}
+            KalmanFilterSpec(rp<KalmanFilterStateExt> s0, MkStepFn mkstepfn,
+                             KalmanUpdateForm update_form)
+                : start_ext_{std::move(s0)},
+                  mk_step_fn_{std::move(mkstepfn)},
+                  update_form_{update_form} {}
 
             rp<KalmanFilterStateExt> const & start_ext() const { return start_ext_; }
+            KalmanUpdateForm update_form() const { return update_form_; }
             /* get step parameters (i.e. matrices F, Q, H, R)
              * for step t(k) -> t(k+1).
              *
@@ -73,6 +107,9 @@ namespace xo {
              * linear kalman filter
              */
             MkStepFn mk_step_fn_;
+
+            /* covariance or square-root filter arithmetic */
+            KalmanUpdateForm update_form_ = KalmanUpdateForm::covariance;
         }; /*KalmanFilterSpec*/
 
         inline std::ostream &
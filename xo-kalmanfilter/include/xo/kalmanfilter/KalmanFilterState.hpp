@@ -31,6 +31,15 @@ namespace xo {
                                                    VectorXd x,
                                                    MatrixXd P,
                                                    KalmanFilterTransition transition);
+            /* create state from square-root factor S of covariance matrix:
+             * state will have P = S.S^T,  and remember S.
+             * See KalmanFilterEngine::step_sqrt()
+             */
+            static rp<KalmanFilterState> make_sqrt(uint32_t k,
+                                                   utc_nanos tk,
+                                                   VectorXd x,
+                                                   MatrixXd S,
+                                                   KalmanFilterTransition transition);
             virtual ~KalmanFilterState() = default;
 
             /* reflect KalmanFilterState object representation */
@@ -45,6 +54,10 @@ namespace xo {
             uint32_t n_state() const { return x_.size(); }
             VectorXd const & state_v() const { return x_; }
             MatrixXd const & state_cov() const { return P_; }
+            /* [n x n] square-root factor S of .state_cov(),  with P = S.S^T;
+             * [0 x 0] unless state was produced by square-root filter update
+             */
+            MatrixXd const & state_cov_sqrt() const { return S_; }
 
             KalmanFilterTransition const & transition() const { return transition_; }
 
@@ -62,6 +75,12 @@ namespace xo {
                               VectorXd x,
                               MatrixXd P,
                               KalmanFilterTransition transition);
+            KalmanFilterState(uint32_t k,
+                              utc_nanos tk,
+                              VectorXd x,
+                              MatrixXd P,
+                              MatrixXd S,
+                              KalmanFilterTransition transition);
 
             friend class KalmanFilterStateExt;
 
@@ -79,6 +98,10 @@ namespace xo {
              * (= this->x_) and model state x_(k)
              */
             MatrixXd P_;
+            /* [n x n] square-root factor of .P:  P = S.S^T.
+             * Maintained only by square-root filter update;  otherwise [0 x 0]
+             */
+            MatrixXd S_;
 
             /* F, Q matrices driving .x, .P */
             KalmanFilterTransition transition_;
@@ -110,6 +133,17 @@ namespace xo {
                                                       MatrixXd K,
                                                       int32_t j,
                                                       rp<KalmanFilterInput> zk);
+            /* like .make(),  but from square-root factor S of covariance matrix;
+             * see KalmanFilterState::make_sqrt()
+             */
+            static rp<KalmanFilterStateExt> make_sqrt(uint32_t k,
+                                                      utc_nanos tk,
+                                                      VectorXd x,
+                                                      MatrixXd S,
+                                                      KalmanFilterTransition transition,
+                                                      MatrixXd K,
+                                                      int32_t j,
+                                                      rp<KalmanFilterInput> zk);
 
             /* create state object for initial filter state */
             static rp<KalmanFilterStateExt> initial(utc_nanos t0,
@@ -139,6 +173,15 @@ namespace xo {
                                  MatrixXd K,
                                  int32_t j,
                                  rp<KalmanFilterInput> zk);
+            KalmanFilterStateExt(uint32_t k,
+                                 utc_nanos tk,
+                                 VectorXd x,
+                                 MatrixXd P,
+                                 MatrixXd S,
+                                 KalmanFilterTransition transition,
+                                 MatrixXd K,
+                                 int32_t j,
+                                 rp<KalmanFilterInput> zk);
 
         private:
             /* if -1:  not used;
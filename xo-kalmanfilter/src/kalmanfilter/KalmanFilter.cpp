@@ -61,7 +61,14 @@ namespace xo {
             /* extrapolate filter state to t(k+1),
              * and correct based on z(k+1)
              */
-            this->state_ext_ = KalmanFilterEngine::step(this->step_);
+            switch (this->filter_spec_.update_form()) {
+            case KalmanUpdateForm::covariance:
+                this->state_ext_ = KalmanFilterEngine::step(this->step_);
+                break;
+            case KalmanUpdateForm::square_root:
+                this->state_ext_ = KalmanFilterEngine::step_sqrt(this->step_);
+                break;
+            }
 
             //if (lscope.enabled()) { lscope.log(xtag("state_ext", this->state_ext_)); }
         } /*notify_input*/
@@ -0,0 +1,751 @@
+/* @file KalmanFilterBatchSvc.cpp */
+
+#include "KalmanFilterBatchSvc.hpp"
+#include "KalmanFilterEngine.hpp"
+#include <xo/reactor/Sink.hpp>
+#include <xo/indentlog2/print/tostr.hpp>
+#include <xo/ppsink/tag_ostream.hpp>   /* os << xtag(..) */
+#include <cmath>
+#include <stdexcept>
+
+namespace xo {
+    using Eigen::MatrixXd;
+    using Eigen::VectorXd;
+
+    namespace kalman {
+        /* one scope in from namespace xo: a using-decl at xo scope would be
+         * *ambiguous* with legacy xo::xtag (still visible via headers that
+         * have not migrated) rather than shadowing it.
+         */
+        using xo::pp::tostr;
+        using xo::pp::xtag;
+
+        namespace {
+            /* forwards filter input to KalmanFilterBatchSvc, for one filter */
+            class BatchInputSink : public xo::reactor::SinkEndpoint<rp<KalmanFilterInput>> {
+            public:
+                BatchInputSink(rp<KalmanFilterBatchSvc> svc, uint32_t ix)
+                    : svc_{std::move(svc)}, ix_{ix} {}
+
+                // ----- inherited from Sink1<..> -----
+
+                virtual void notify_ev(rp<KalmanFilterInput> const & input_kp1) override {
+                    ++(this->n_in_ev_);
+                    this->svc_->notify_input(this->ix_, input_kp1);
+                }
+
+                // ----- inherited from AbstractSink -----
+
+                /* svc captures input pointer */
+                virtual bool allow_volatile_source() const override { return false; }
+                virtual uint32_t n_in_ev() const override { return n_in_ev_; }
+
+                virtual void display(std::ostream & os) const override {
+                    os << "<BatchInputSink"
+                       << xtag("ix", ix_)
+                       << xtag("n_in_ev", n_in_ev_)
+                       << ">";
+                }
+
+            private:
+                /* forward input to this service */
+                rp<KalmanFilterBatchSvc> svc_;
+                /* ..for this filter */
+                uint32_t ix_ = 0;
+                /* counts lifetime #of input events */
+                uint32_t n_in_ev_ = 0;
+            }; /*BatchInputSink*/
+        } /*namespace*/
+
+        rp<KalmanFilterBatchSvc>
+        KalmanFilterBatchSvc::make(KalmanFilterTransition model,
+                                   KalmanFilterObservable obs)
+        {
+            return new KalmanFilterBatchSvc(std::move(model), std::move(obs));
+        } /*make*/
+
+        KalmanFilterBatchSvc::KalmanFilterBatchSvc(KalmanFilterTransition model,
+                                                   KalmanFilterObservable obs)
+            : model_{std::move(model)},
+              obs_{std::move(obs)},
+              n_(model_.transition_mat().rows()),
+              m_(obs_.observable().rows())
+        {
+            MatrixXd const & F = model_.transition_mat();
+            MatrixXd const & Q = model_.transition_cov();
+            MatrixXd const & H = obs_.observable();
+            MatrixXd const & R = obs_.observable_cov();
+
+            if ((F.cols() != n_) || (Q.rows() != n_) || (Q.cols() != n_)
+                || (H.cols() != n_) || (R.rows() != m_) || (R.cols() != m_))
+            {
+                throw std::runtime_error
+                    (tostr("KalmanFilterBatchSvc: expect dim(F)=dim(Q)=[n x n], dim(H)=[m x n], dim(R)=[m x m]",
+                           xtag("F.rows", F.rows()), xtag("F.cols", F.cols()),
+                           xtag("Q.rows", Q.rows()), xtag("Q.cols", Q.cols()),
+                           xtag("H.rows", H.rows()), xtag("H.cols", H.cols()),
+                           xtag("R.rows", R.rows()), xtag("R.cols", R.cols())));
+            }
+
+            if (obs_.keep().size() != m_) {
+                throw std::runtime_error
+                    (tostr("KalmanFilterBatchSvc: expect obs to keep all observations",
+                           xtag("m", m_), xtag("keep.size", obs_.keep().size())));
+            }
+
+            this->x_vv_.resize(n_);
+            this->P_vv_.resize(n_ * n_);
+            this->K_vv_.resize(n_ * m_);
+        } /*ctor*/
+
+        uint32_t
+        KalmanFilterBatchSvc::add_filter(rp<KalmanFilterStateExt> const & s0)
+        {
+            VectorXd const & x = s0->state_v();
+            MatrixXd const & P = s0->state_cov();
+
+            if ((x.size() != n_) || (P.rows() != n_) || (P.cols() != n_)) {
+                throw std::runtime_error
+                    (tostr("KalmanFilterBatchSvc::add_filter: expect [n x 1] state, [n x n] covariance",
+                           xtag("n", n_),
+                           xtag("x.size", x.size()),
+                           xtag("P.rows", P.rows()), xtag("P.cols", P.cols())));
+            }
+
+            uint32_t ix = this->k_v_.size();
+
+            this->k_v_.push_back(s0->step_no());
+            this->tk_v_.push_back(s0->tm());
+
+            for (uint32_t i = 0; i < n_; ++i) {
+                this->x_vv_[i].push_back(x[i]);
+
+                for (uint32_t j = 0; j < n_; ++j)
+                    this->P_vv_[i * n_ + j].push_back(P(i, j));
+            }
+
+            MatrixXd const & K = s0->gain();
+            bool have_K = ((K.rows() == n_) && (K.cols() == m_));
+
+            for (uint32_t i = 0; i < n_; ++i) {
+                for (uint32_t a = 0; a < m_; ++a)
+                    this->K_vv_[i * m_ + a].push_back(have_K ? K(i, a) : 0.0);
+            }
+
+            this->zk_v_.push_back(s0->zk());
+            this->pass_v_.push_back(0);
+            this->pub_v_.emplace_back();
+
+            return ix;
+        } /*add_filter*/
+
+        VectorXd
+        KalmanFilterBatchSvc::state_v(uint32_t ix) const
+        {
+            VectorXd x(n_);
+
+            for (uint32_t i = 0; i < n_; ++i)
+                x[i] = this->x_vv_[i][ix];
+
+            return x;
+        } /*state_v*/
+
+        MatrixXd
+        KalmanFilterBatchSvc::state_cov(uint32_t ix) const
+        {
+            MatrixXd P(n_, n_);
+
+            for (uint32_t i = 0; i < n_; ++i) {
+                for (uint32_t j = 0; j < n_; ++j)
+                    P(i, j) = this->P_vv_[i * n_ + j][ix];
+            }
+
+            return P;
+        } /*state_cov*/
+
+        MatrixXd
+        KalmanFilterBatchSvc::gain(uint32_t ix) const
+        {
+            MatrixXd K(n_, m_);
+
+            for (uint32_t i = 0; i < n_; ++i) {
+                for (uint32_t a = 0; a < m_; ++a)
+                    K(i, a) = this->K_vv_[i * m_ + a][ix];
+            }
+
+            return K;
+        } /*gain*/
+
+        rp<KalmanFilterStateExt>
+        KalmanFilterBatchSvc::state_ext(uint32_t ix) const
+        {
+            return KalmanFilterStateExt::make(this->k_v_[ix],
+                                              this->tk_v_[ix],
+                                              this->state_v(ix),
+                                              this->state_cov(ix),
+                                              this->model_,
+                                              this->gain(ix),
+                                              -1 /*j: not used*/,
+                                              this->zk_v_[ix]);
+        } /*state_ext*/
+
+        rp<KalmanFilterInputCallback>
+        KalmanFilterBatchSvc::input_sink(uint32_t ix)
+        {
+            return new BatchInputSink(this, ix);
+        } /*input_sink*/
+
+        void
+        KalmanFilterBatchSvc::notify_input(uint32_t ix,
+                                           rp<KalmanFilterInput> const & input_kp1)
+        {
+            if (ix >= this->n_filter()) {
+                throw std::runtime_error
+                    (tostr("KalmanFilterBatchSvc::notify_input: filter index out of range",
+                           xtag("ix", ix), xtag("n_filter", this->n_filter())));
+            }
+
+            this->pending_v_.push_back(std::make_pair(ix, input_kp1));
+        } /*notify_input*/
+
+        fn::CallbackId
+        KalmanFilterBatchSvc::add_callback(uint32_t ix,
+                                           rp<KalmanFilterOutputCallback> const & cb)
+        {
+            return this->pub_v_[ix].add_callback(cb);
+        } /*add_callback*/
+
+        void
+        KalmanFilterBatchSvc::remove_callback(uint32_t ix, CallbackId id)
+        {
+            this->pub_v_[ix].remove_callback(id);
+        } /*remove_callback*/
+
+        bool
+        KalmanFilterBatchSvc::is_batchable(rp<KalmanFilterInput> const & input) const
+        {
+            if (input->z().size() != m_)
+                return false;
+
+            auto const & presence = input->presence();
+
+            return (presence.size() == 0) || presence.all();
+        } /*is_batchable*/
+
+        std::uint64_t
+        KalmanFilterBatchSvc::flush()
+        {
+            std::uint64_t n_step0 = this->n_step_;
+
+            while (!this->pending_v_.empty()) {
+                ++(this->pass_no_);
+
+                this->batch_ix_v_.clear();
+                this->batch_input_v_.clear();
+                this->defer_v_.clear();
+
+                /* output callbacks may send more input (to .pending_v)
+                 * while we work through .work_v
+                 */
+                this->work_v_.clear();
+                std::swap(this->work_v_, this->pending_v_);
+
+                /* each filter steps at most once per pass;
+                 * 2nd and later inputs for a filter wait for a later pass
+                 */
+                for (auto & ix_input : this->work_v_) {
+                    uint32_t ix = ix_input.first;
+
+                    if (this->pass_v_[ix] == this->pass_no_) {
+                        this->defer_v_.push_back(std::move(ix_input));
+                        continue;
+                    }
+
+                    this->pass_v_[ix] = this->pass_no_;
+
+                    if (this->is_batchable(ix_input.second)) {
+                        this->batch_ix_v_.push_back(ix);
+                        this->batch_input_v_.push_back(std::move(ix_input.second));
+                    } else {
+                        this->step_one(ix, ix_input.second);
+                    }
+                }
+
+                this->run_batch();
+
+                /* deferred inputs precede any that arrived during this pass */
+                this->defer_v_.insert(this->defer_v_.end(),
+                                      std::make_move_iterator(this->pending_v_.begin()),
+                                      std::make_move_iterator(this->pending_v_.end()));
+
+                std::swap(this->pending_v_, this->defer_v_);
+            }
+
+            this->work_v_.clear();
+            this->defer_v_.clear();
+            this->batch_input_v_.clear();
+
+            return this->n_step_ - n_step0;
+        } /*flush*/
+
+        void
+        KalmanFilterBatchSvc::reserve_lanes(std::size_t nb)
+        {
+            if (nb <= this->lane_cap_)
+                return;
+
+            std::size_t cap = std::max<std::size_t>(nb, 2 * this->lane_cap_);
+
+            this->lane_cap_ = cap;
+
+            this->wx_.resize(n_ * cap);
+            this->wP_.resize(n_ * n_ * cap);
+            this->wFP_.resize(n_ * n_ * cap);
+            this->wPe_.resize(n_ * n_ * cap);
+            this->wPHt_.resize(n_ * m_ * cap);
+            this->wM_.resize(m_ * m_ * cap);
+            this->wK_.resize(n_ * m_ * cap);
+            this->wz_.resize(m_ * cap);
+            this->wy_.resize(m_ * cap);
+            this->lane_ok_v_.resize(cap);
+        } /*reserve_lanes*/
+
+        void
+        KalmanFilterBatchSvc::run_batch()
+        {
+            std::size_t nb = this->batch_ix_v_.size();
+
+            if (nb == 0)
+                return;
+
+            this->reserve_lanes(nb);
+
+            std::size_t const cap = this->lane_cap_;
+            uint32_t const n = n_;
+            uint32_t const m = m_;
+
+            MatrixXd const & F = this->model_.transition_mat();
+            MatrixXd const & Q = this->model_.transition_cov();
+            MatrixXd const & H = this->obs_.observable();
+            MatrixXd const & R = this->obs_.observable_cov();
+
+            uint32_t const * lane_ix = this->batch_ix_v_.data();
+
+            /* row r of workspace array w */
+            auto row = [cap](std::vector<double> & w, std::size_t r) { return w.data() + r * cap; };
+
+            /* 1. gather x(k), P(k), z(k+1) into lanes */
+            for (uint32_t i = 0; i < n; ++i) {
+                double const * src = this->x_vv_[i].data();
+                double * dst = row(this->wx_, i);
+
+                for (std::size_t b = 0; b < nb; ++b)
+                    dst[b] = src[lane_ix[b]];
+            }
+
+            for (uint32_t ij = 0; ij < n * n; ++ij) {
+                double const * src = this->P_vv_[ij].data();
+                double * dst = row(this->wP_, ij);
+
+                for (std::size_t b = 0; b < nb; ++b)
+                    dst[b] = src[lane_ix[b]];
+            }
+
+            for (std::size_t b = 0; b < nb; ++b) {
+                VectorXd const & z = this->batch_input_v_[b]->z();
+
+                for (uint32_t a = 0; a < m; ++a)
+                    row(this->wz_, a)[b] = z[a];
+            }
+
+            /* 2. extrapolate:
+             *    x(k+1|k) = F.x(k)
+             *    P(k+1|k) = F.P(k).F^T + Q
+             *
+             *    x(k+1|k) overwrites x(k) -> need F.x(k) in a temporary;
+             *    reuse wK_ (not yet in use) for that
+             */
+            for (uint32_t i = 0; i < n; ++i) {
+                double * xe = row(this->wK_, i);
+
+                for (std::size_t b = 0; b < nb; ++b)
+                    xe[b] = 0.0;
+
+                for (uint32_t j = 0; j < n; ++j) {
+                    double f = F(i, j);
+
+                    if (f == 0.0)
+                        continue;
+
+                    double const * x = row(this->wx_, j);
+
+                    for (std::size_t b = 0; b < nb; ++b)
+                        xe[b] += f * x[b];
+                }
+            }
+
+            for (uint32_t i = 0; i < n; ++i)
+                std::copy(row(this->wK_, i), row(this->wK_, i) + nb, row(this->wx_, i));
+
+            /* FP[i,j] = sum_l F(i,l).P[l,j] */
+            for (uint32_t i = 0; i < n; ++i) {
+                for (uint32_t j = 0; j < n; ++j) {
+                    double * fp = row(this->wFP_, i * n + j);
+
+                    for (std::size_t b = 0; b < nb; ++b)
+                        fp[b] = 0.0;
+
+                    for (uint32_t l = 0; l < n; ++l) {
+                        double f = F(i, l);
+
+                        if (f == 0.0)
+                            continue;
+
+                        double const * p = row(this->wP_, l * n + j);
+
+                        for (std::size_t b = 0; b < nb; ++b)
+                            fp[b] += f * p[b];
+                    }
+                }
+            }
+
+            /* Pe[i,j] = sum_l FP[i,l].F(j,l) + Q(i,j) */
+            for (uint32_t i = 0; i < n; ++i) {
+                for (uint32_t j = 0; j < n; ++j) {
+                    double * pe = row(this->wPe_, i * n + j);
+                    double q = Q(i, j);
+
+                    for (std::size_t b = 0; b < nb; ++b)
+                        pe[b] = q;
+
+                    for (uint32_t l = 0; l < n; ++l) {
+                        double f = F(j, l);
+
+                        if (f == 0.0)
+                            continue;
+
+                        double const * fp = row(this->wFP_, i * n + l);
+
+                        for (std::size_t b = 0; b < nb; ++b)
+                            pe[b] += fp[b] * f;
+                    }
+                }
+            }
+
+            /* 3. PHt[i,a] = sum_j Pe[i,j].H(a,j) */
+            for (uint32_t i = 0; i < n; ++i) {
+                for (uint32_t a = 0; a < m; ++a) {
+                    double * pht = row(this->wPHt_, i * m + a);
+
+                    for (std::size_t b = 0; b < nb; ++b)
+                        pht[b] = 0.0;
+
+                    for (uint32_t j = 0; j < n; ++j) {
+                        double h = H(a, j);
+
+                        if (h == 0.0)
+                            continue;
+
+                        double const * pe = row(this->wPe_, i * n + j);
+
+                        for (std::size_t b = 0; b < nb; ++b)
+                            pht[b] += pe[b] * h;
+                    }
+                }
+            }
+
+            /* 4. M[a,c] = sum_i H(a,i).PHt[i,c] + R(a,c)
+             *    (lower triangle only;  M is symmetric)
+             */
+            for (uint32_t a = 0; a < m; ++a) {
+                for (uint32_t c = 0; c <= a; ++c) {
+                    double * mm = row(this->wM_, a * m + c);
+                    double r = R(a, c);
+
+                    for (std::size_t b = 0; b < nb; ++b)
+                        mm[b] = r;
+
+                    for (uint32_t i = 0; i < n; ++i) {
+                        double h = H(a, i);
+
+                        if (h == 0.0)
+                            continue;
+
+                        double const * pht = row(this->wPHt_, i * m + c);
+
+                        for (std::size_t b = 0; b < nb; ++b)
+                            mm[b] += h * pht[b];
+                    }
+                }
+            }
+
+            /* 5. cholesky M = L.L^T in place (lower triangle),  per lane.
+             *    M need not be positive definite (e.g. indefinite P);
+             *    scalar path copes (LDLT),  so lane with a non-positive pivot
+             *    is marked bad and redone by .step_one() below
+             */
+            char * lane_ok = this->lane_ok_v_.data();
+
+            for (std::size_t b = 0; b < nb; ++b)
+                lane_ok[b] = true;
+
+            for (uint32_t c = 0; c < m; ++c) {
+                double * lcc = row(this->wM_, c * m + c);
+
+                for (uint32_t l = 0; l < c; ++l) {
+                    double const * lcl = row(this->wM_, c * m + l);
+
+                    for (std::size_t b = 0; b < nb; ++b)
+                        lcc[b] -= lcl[b] * lcl[b];
+                }
+
+                for (std::size_t b = 0; b < nb; ++b) {
+                    if (lcc[b] > 0.0) {
+                        lcc[b] = std::sqrt(lcc[b]);
+                    } else {
+                        /* also catches NaN.  1.0 keeps lane arithmetic finite;
+                         * results for this lane are discarded
+                         */
+                        lane_ok[b] = false;
+                        lcc[b] = 1.0;
+                    }
+                }
+
+                for (uint32_t r = c + 1; r < m; ++r) {
+                    double * lrc = row(this->wM_, r * m + c);
+
+                    for (uint32_t l = 0; l < c; ++l) {
+                        double const * lrl = row(this->wM_, r * m + l);
+                        double const * lcl = row(this->wM_, c * m + l);
+
+                        for (std::size_t b = 0; b < nb; ++b)
+                            lrc[b] -= lrl[b] * lcl[b];
+                    }
+
+                    for (std::size_t b = 0; b < nb; ++b)
+                        lrc[b] /= lcc[b];
+                }
+            }
+
+            /* 6. gain:  K = PHt.M^-1;  row i of K solves M.k = PHt[i,:]^T
+             *    (M symmetric),  via forward + back substitution
+             */
+            for (uint32_t i = 0; i < n; ++i) {
+                /* forward:  L.y = PHt[i,:]^T */
+                for (uint32_t a = 0; a < m; ++a) {
+                    double * y = row(this->wy_, a);
+                    double const * pht = row(this->wPHt_, i * m + a);
+
+                    for (std::size_t b = 0; b < nb; ++b)
+                        y[b] = pht[b];
+
+                    for (uint32_t l = 0; l < a; ++l) {
+                        double const * lal = row(this->wM_, a * m + l);
+                        double const * yl = row(this->wy_, l);
+
+                        for (std::size_t b = 0; b < nb; ++b)
+                            y[b] -= lal[b] * yl[b];
+                    }
+
+                    double const * laa = row(this->wM_, a * m + a);
+
+                    for (std::size_t b = 0; b < nb; ++b)
+                        y[b] /= laa[b];
+                }
+
+                /* back:  L^T.k = y */
+                for (uint32_t a = m; a-- > 0; ) {
+                    double * k = row(this->wK_, i * m + a);
+                    double const * y = row(this->wy_, a);
+
+                    for (std::size_t b = 0; b < nb; ++b)
+                        k[b] = y[b];
+
+                    for (uint32_t l = a + 1; l < m; ++l) {
+                        double const * lla = row(this->wM_, l * m + a);
+                        double const * kl = row(this->wK_, i * m + l);
+
+                        for (std::size_t b = 0; b < nb; ++b)
+                            k[b] -= lla[b] * kl[b];
+                    }
+
+                    double const * laa = row(this->wM_, a * m + a);
+
+                    for (std::size_t b = 0; b < nb; ++b)
+                        k[b] /= laa[b];
+                }
+            }
+
+            /* 7. innovation:  z - H.x(k+1|k)  (in place in wz) */
+            for (uint32_t a = 0; a < m; ++a) {
+                double * z = row(this->wz_, a);
+
+                for (uint32_t i = 0; i < n; ++i) {
+                    double h = H(a, i);
+
+                    if (h == 0.0)
+                        continue;
+
+                    double const * x = row(this->wx_, i);
+
+                    for (std::size_t b = 0; b < nb; ++b)
+                        z[b] -= h * x[b];
+                }
+            }
+
+            /* 8. correct,  and scatter back to per-filter storage:
+             *    x(k+1) = x(k+1|k) + K.innov
+             *    P(k+1) = P(k+1|k) - K.PHt^T
+             */
+            for (uint32_t i = 0; i < n; ++i) {
+                double * x = row(this->wx_, i);
+
+                for (uint32_t a = 0; a < m; ++a) {
+                    double const * k = row(this->wK_, i * m + a);
+                    double const * innov = row(this->wz_, a);
+
+                    for (std::size_t b = 0; b < nb; ++b)
+                        x[b] += k[b] * innov[b];
+                }
+
+                double * dst = this->x_vv_[i].data();
+
+                for (std::size_t b = 0; b < nb; ++b) {
+                    if (lane_ok[b])
+                        dst[lane_ix[b]] = x[b];
+                }
+            }
+
+            for (uint32_t i = 0; i < n; ++i) {
+                for (uint32_t j = 0; j < n; ++j) {
+                    double * pe = row(this->wPe_, i * n + j);
+
+                    for (uint32_t a = 0; a < m; ++a) {
+                        double const * k = row(this->wK_, i * m + a);
+                        double const * pht = row(this->wPHt_, j * m + a);
+
+                        for (std::size_t b = 0; b < nb; ++b)
+                            pe[b] -= k[b] * pht[b];
+                    }
+
+                    double * dst = this->P_vv_[i * n + j].data();
+
+                    for (std::size_t b = 0; b < nb; ++b) {
+                        if (lane_ok[b])
+                            dst[lane_ix[b]] = pe[b];
+                    }
+                }
+            }
+
+            for (uint32_t ia = 0; ia < n * m; ++ia) {
+                double const * k = row(this->wK_, ia);
+                double * dst = this->K_vv_[ia].data();
+
+                for (std::size_t b = 0; b < nb; ++b) {
+                    if (lane_ok[b])
+                        dst[lane_ix[b]] = k[b];
+                }
+            }
+
+            for (std::size_t b = 0; b < nb; ++b) {
+                if (!lane_ok[b])
+                    continue;
+
+                uint32_t ix = lane_ix[b];
+
+                ++(this->k_v_[ix]);
+                this->tk_v_[ix] = this->batch_input_v_[b]->tkp1();
+                this->zk_v_[ix] = this->batch_input_v_[b];
+
+                ++(this->n_step_);
+            }
+
+            /* 9. publish;  bad lanes step (+ publish) individually,
+             *    from their untouched state
+             */
+            for (std::size_t b = 0; b < nb; ++b) {
+                if (lane_ok[b]) {
+                    this->publish(lane_ix[b]);
+                } else {
+                    ++(this->n_fallback_);
+                    this->step_one(lane_ix[b], this->batch_input_v_[b]);
+                }
+            }
+        } /*run_batch*/
+
+        void
+        KalmanFilterBatchSvc::step_one(uint32_t ix,
+                                       rp<KalmanFilterInput> const & input_kp1)
+        {
+            KalmanFilterObservable obs
+                = KalmanFilterObservable::reindex(input_kp1->make_kept_index(),
+                                                  this->obs_.observable(),
+                                                  this->obs_.observable_cov());
+
+            rp<KalmanFilterStateExt> skp1
+                = KalmanFilterEngine::step(input_kp1->tkp1(),
+                                           this->state_ext(ix),
+                                           this->model_,
+                                           obs,
+                                           input_kp1);
+
+            VectorXd const & x = skp1->state_v();
+            MatrixXd const & P = skp1->state_cov();
+            /* [n x m'], m' = #of present observations */
+            MatrixXd const & K = skp1->gain();
+            auto const & keep = obs.keep();
+
+            for (uint32_t i = 0; i < n_; ++i) {
+                this->x_vv_[i][ix] = x[i];
+
+                for (uint32_t j = 0; j < n_; ++j)
+                    this->P_vv_[i * n_ + j][ix] = P(i, j);
+
+                /* gain for absent observations is zero */
+                for (uint32_t a = 0; a < m_; ++a)
+                    this->K_vv_[i * m_ + a][ix] = 0.0;
+                for (Eigen::Index a = 0; a < keep.size(); ++a)
+                    this->K_vv_[i * m_ + keep[a]][ix] = K(i, a);
+            }
+
+            this->k_v_[ix] = skp1->step_no();
+            this->tk_v_[ix] = skp1->tm();
+            this->zk_v_[ix] = input_kp1;
+
+            ++(this->n_step_);
+
+            this->publish(ix);
+        } /*step_one*/
+
+        void
+        KalmanFilterBatchSvc::publish(uint32_t ix)
+        {
+            auto & pub = this->pub_v_[ix];
+
+            if (pub.begin() == pub.end())
+                return;
+
+            pub.invoke(&KalmanFilterOutputCallback::notify_ev, this->state_ext(ix));
+        } /*publish*/
+
+        void
+        KalmanFilterBatchSvc::display(std::ostream & os) const
+        {
+            os << "<KalmanFilterBatchSvc"
+               << xtag("n_filter", this->n_filter())
+               << xtag("n_state", n_)
+               << xtag("n_obs", m_)
+               << xtag("n_pending", this->n_pending())
+               << xtag("n_step", n_step_)
+               << ">";
+        } /*display*/
+
+        std::string
+        KalmanFilterBatchSvc::display_string() const
+        {
+            return tostr(*this);
+        } /*display_string*/
+    } /*namespace kalman*/
+} /*namespace xo*/
+
+/* end KalmanFilterBatchSvc.cpp */
@@ -15,6 +15,8 @@ namespace xo {
     using xo::time::utc_nanos;
     using logutil::matrix;
     using Eigen::LDLT;
+    using Eigen::LLT;
+    using Eigen::HouseholderQR;
     using Eigen::MatrixXd;
     using Eigen::VectorXd;
 
@@ -26,6 +28,35 @@ namespace xo {
         using xo::pp::scope;
         using xo::pp::xtag;
 
+        namespace {
+            /* lower-triangular L with L.L^T = A.A^T.
+             * Require: A.cols() >= A.rows()
+             *
+             * QR-factor A^T = Q.U;  then A.A^T = U^T.Q^T.Q.U = U^T.U,
+             * so L = U^T (using top A.rows() rows of U).
+             * Flip column signs so diagonal of L is non-negative
+             */
+            MatrixXd
+            lower_triangularize(MatrixXd const & A)
+            {
+                Eigen::Index r = A.rows();
+
+                HouseholderQR<MatrixXd> qr(A.transpose());
+
+                MatrixXd L = (qr.matrixQR()
+                              .topRows(r)
+                              .triangularView<Eigen::Upper>()
+                              .transpose());
+
+                for (Eigen::Index i = 0; i < r; ++i) {
+                    if (L(i, i) < 0.0)
+                        L.col(i) = -L.col(i);
+                }
+
+                return L;
+            } /*lower_triangularize*/
+        } /*namespace*/
+
         // ----- KalmanFilterEngine -----
 
         rp<KalmanFilterState>
@@ -363,6 +394,187 @@ namespace xo {
                          step_spec.input(),
                          j);
         } /*step1*/
+
+        MatrixXd
+        KalmanFilterEngine::cov_sqrt(MatrixXd const & P)
+        {
+            LLT<MatrixXd> llt(P);
+
+            if (llt.info() == Eigen::Success)
+                return llt.matrixL();
+
+            /* P only non-negative definite,  e.g. some state variable
+             * known exactly.  Use
+             *         T      T
+             *   P = T .L.D.L .T    (T permutation, D diagonal, D >= 0)
+             *
+             *            T          1/2
+             *   so S = T .L.D
+             */
+            LDLT<MatrixXd> ldlt(P);
+
+            VectorXd d = ldlt.vectorD().cwiseMax(0.0).cwiseSqrt();
+            MatrixXd LD = MatrixXd(ldlt.matrixL()) * d.asDiagonal();
+
+            return ldlt.transpositionsP().transpose() * LD;
+        } /*cov_sqrt*/
+
+        rp<KalmanFilterState>
+        KalmanFilterEngine::extrapolate_sqrt(utc_nanos tkp1,
+                                             rp<KalmanFilterState> const & s,
+                                             KalmanFilterTransition const & f)
+        {
+            VectorXd const & x = s->state_v();
+
+            /* S(k) */
+            MatrixXd S = ((s->state_cov_sqrt().size() > 0)
+                          ? s->state_cov_sqrt()
+                          : cov_sqrt(s->state_cov()));
+
+            MatrixXd const & F = f.transition_mat();
+            MatrixXd const & Q = f.transition_cov();
+
+            uint32_t n = x.size();
+
+            if ((F.rows() != n) || (F.cols() != n)
+                || (Q.rows() != n) || (Q.cols() != n))
+            {
+                std::string err_msg
+                    = tostr("extrapolate_sqrt: with n=x.size expect [n x n] F, Q",
+                            xtag("n", n),
+                            xtag("F.rows", F.rows()), xtag("F.cols", F.cols()),
+                            xtag("Q.rows", Q.rows()), xtag("Q.cols", Q.cols()));
+
+                throw std::runtime_error(err_msg);
+            }
+
+            /* x(k+1|k) */
+            VectorXd x_ext = F * x;
+
+            /* pre-array [F.S, sqrt(Q)] :: [n x 2n]
+             *
+             *                  T                 T
+             *   pre-array.pre-array  = F.P(k).F  + Q = P(k+1|k)
+             */
+            MatrixXd A(n, 2 * n);
+            A << F * S, cov_sqrt(Q);
+
+            /* S(k+1|k) */
+            MatrixXd S_ext = lower_triangularize(A);
+
+            return KalmanFilterState::make_sqrt(s->step_no() + 1,
+                                                tkp1,
+                                                std::move(x_ext),
+                                                std::move(S_ext),
+                                                f);
+        } /*extrapolate_sqrt*/
+
+        rp<KalmanFilterStateExt>
+        KalmanFilterEngine::correct_sqrt(rp<KalmanFilterState> const & skp1_ext,
+                                         KalmanFilterObservable const & h,
+                                         rp<KalmanFilterInput> const & zkp1)
+        {
+            scope log(XO_DEBUG_(false /*debug_enabled*/));
+
+            /* 'ext' short for 'extrapolated' */
+            VectorXd const & x_ext = skp1_ext->state_v();
+            MatrixXd S_ext = ((skp1_ext->state_cov_sqrt().size() > 0)
+                              ? skp1_ext->state_cov_sqrt()
+                              : cov_sqrt(skp1_ext->state_cov()));
+
+            MatrixXd const & H = h.observable();
+            MatrixXd const & R = h.observable_cov();
+
+            uint32_t m = H.rows();
+            uint32_t n = H.cols();
+
+            if ((S_ext.rows() != n) || (R.rows() != m) || (R.cols() != m)) {
+                std::string err_msg
+                    = tostr("correct_sqrt: with dim(H) = [m x n] expect dim(P) = [n x n], dim(R) = [m x m]",
+                            xtag("m", m), xtag("n", n),
+                            xtag("P.rows", S_ext.rows()),
+                            xtag("R.rows", R.rows()), xtag("R.cols", R.cols()));
+
+                throw std::runtime_error(err_msg);
+            }
+
+            /* z_orig[] is original observation vector before reindexing */
+            VectorXd const & z_orig = zkp1->z();
+            VectorXd z = z_orig(h.keep());
+
+            /* pre-array :: [(m+n) x (m+n)]
+             *
+             *   | sqrt(R)  H.S(k+1|k) |
+             *   |   0      S(k+1|k)   |
+             */
+            MatrixXd A = MatrixXd::Zero(m + n, m + n);
+            A.topLeftCorner(m, m) = cov_sqrt(R);
+            A.topRightCorner(m, n) = H * S_ext;
+            A.bottomRightCorner(n, n) = S_ext;
+
+            /* post-array :: [(m+n) x (m+n)], lower triangular
+             *
+             *   | Sm  0    |      Sm.Sm^T = M = H.P(k+1|k).H^T + R
+             *   | Kb  S    |      Kb = P(k+1|k).H^T.Sm^-T
+             *                     S.S^T = P(k+1)
+             */
+            MatrixXd B = lower_triangularize(A);
+
+            auto Sm = B.topLeftCorner(m, m).triangularView<Eigen::Lower>();
+            MatrixXd Kb = B.bottomLeftCorner(n, m);
+            MatrixXd Skp1 = B.bottomRightCorner(n, n);
+
+            /* innov: difference between 'actual observations'
+             * and 'predicted observations'
+             */
+            VectorXd innov = z - (H * x_ext);
+
+            /* x(k+1) = x(k+1|k) + Kb.(Sm^-1.innov) */
+            VectorXd xkp1 = x_ext + Kb * Sm.solve(innov);
+
+            /*                   -1       T      -T   T
+             * K(k+1) = Kb.Sm      <=>   K  = Sm  .Kb
+             */
+            MatrixXd K = Sm.transpose().solve(Kb.transpose()).transpose();
+
+            log && log("result",
+                       xtag("k", skp1_ext->step_no()),
+                       xtag("S(k+1|k)", matrix(S_ext)),
+                       xtag("post", matrix(B)),
+                       xtag("K", matrix(K)));
+
+            return KalmanFilterStateExt::make_sqrt(skp1_ext->step_no(),
+                                                   skp1_ext->tm(),
+                                                   std::move(xkp1),
+                                                   std::move(Skp1),
+                                                   skp1_ext->transition(),
+                                                   std::move(K),
+                                                   -1 /*j: not used*/,
+                                                   zkp1);
+        } /*correct_sqrt*/
+
+        rp<KalmanFilterStateExt>
+        KalmanFilterEngine::step_sqrt(utc_nanos tkp1,
+                                      rp<KalmanFilterState> const & sk,
+                                      KalmanFilterTransition const & Fk,
+                                      KalmanFilterObservable const & Hkp1,
+                                      rp<KalmanFilterInput> const & zkp1)
+        {
+            rp<KalmanFilterState> skp1_ext
+                = KalmanFilterEngine::extrapolate_sqrt(tkp1, sk, Fk);
+
+            return KalmanFilterEngine::correct_sqrt(skp1_ext, Hkp1, zkp1);
+        } /*step_sqrt*/
+
+        rp<KalmanFilterStateExt>
+        KalmanFilterEngine::step_sqrt(KalmanFilterStep const & step_spec)
+        {
+            return step_sqrt(step_spec.tkp1(),
+                             step_spec.state(),
+                             step_spec.model(),
+                             step_spec.obs(),
+                             step_spec.input());
+        } /*step_sqrt*/
     } /*namespace kalman*/
 } /*namespace xo*/
 
@@ -21,6 +21,7 @@ namespace xo {
         {
             os << "<KalmanFilterSpec"
                << xtag("start_ext", start_ext_)
+               << xtag("update_form", update_form_)
                << ">";
         } /*display*/
 
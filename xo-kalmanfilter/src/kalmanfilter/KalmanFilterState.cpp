@@ -55,6 +55,22 @@ namespace xo {
                                          std::move(transition));
         } /*make*/
 
+        rp<KalmanFilterState>
+        KalmanFilterState::make_sqrt(uint32_t k,
+                                     utc_nanos tk,
+                                     VectorXd x,
+                                     MatrixXd S,
+                                     KalmanFilterTransition transition)
+        {
+            MatrixXd P = S * S.transpose();
+
+            return new KalmanFilterState(k, tk,
+                                         std::move(x),
+                                         std::move(P),
+                                         std::move(S),
+                                         std::move(transition));
+        } /*make_sqrt*/
+
         void
         KalmanFilterState::reflect_self()
         {
@@ -75,8 +91,21 @@ namespace xo {
                                              VectorXd x,
                                              MatrixXd P,
                                              KalmanFilterTransition transition)
+            : KalmanFilterState(k, tk,
+                                std::move(x),
+                                std::move(P),
+                                MatrixXd() /*S*/,
+                                std::move(transition))
+        {}
+
+        KalmanFilterState::KalmanFilterState(uint32_t k,
+                                             utc_nanos tk,
+                                             VectorXd x,
+                                             MatrixXd P,
+                                             MatrixXd S,
+                                             KalmanFilterTransition transition)
             : k_{k}, tk_{tk},
-              x_{std::move(x)}, P_{std::move(P)},
+              x_{std::move(x)}, P_{std::move(P)}, S_{std::move(S)},
               transition_{std::move(transition)}
         {}
 
@@ -114,6 +143,29 @@ namespace xo {
                                             std::move(zk));
         } /*make*/
 
+        rp<KalmanFilterStateExt>
+        KalmanFilterStateExt::make_sqrt(uint32_t k,
+                                        utc_nanos tk,
+                                        VectorXd x,
+                                        MatrixXd S,
+                                        KalmanFilterTransition transition,
+                                        MatrixXd K,
+                                        int32_t j,
+                                        rp<KalmanFilterInput> zk)
+        {
+            MatrixXd P = S * S.transpose();
+
+            return new KalmanFilterStateExt(k,
+                                            tk,
+                                            std::move(x),
+                                            std::move(P),
+                                            std::move(S),
+                                            std::move(transition),
+                                            std::move(K),
+                                            j,
+                                            std::move(zk));
+        } /*make_sqrt*/
+
         void
         KalmanFilterStateExt::reflect_self()
         {
@@ -141,9 +193,29 @@ namespace xo {
                                                    MatrixXd K,
                                                    int32_t j,
                                                    rp<KalmanFilterInput> zk)
+        : KalmanFilterStateExt(k, tk,
+                               std::move(x),
+                               std::move(P),
+                               MatrixXd() /*S*/,
+                               std::move(transition),
+                               std::move(K),
+                               j,
+                               std::move(zk))
+        {}
+
+        KalmanFilterStateExt::KalmanFilterStateExt(uint32_t k,
+                                                   utc_nanos tk,
+                                                   VectorXd x,
+                                                   MatrixXd P,
+                                                   MatrixXd S,
+                                                   KalmanFilterTransition transition,
+                                                   MatrixXd K,
+                                                   int32_t j,
+                                                   rp<KalmanFilterInput> zk)
         : KalmanFilterState(k, tk,
                             std::move(x),
                             std::move(P),
+                            std::move(S),
                             std::move(transition)),
           j_{j},
           K_{std::move(K)},
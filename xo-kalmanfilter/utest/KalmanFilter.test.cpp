@@ -1,5 +1,10 @@
 /* @file KalmanFilter.test.cpp */
 
+/* must agree with filter_utest_main.cpp:  changes layout of Catch::IResultCapture,
+ * which we use directly below
+ */
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
+
 #include "xo/kalmanfilter/KalmanFilter.hpp"
 #include "xo/kalmanfilter/KalmanFilterEngine.hpp"
 #include "xo/kalmanfilter/print_eigen.hpp"
@@ -17,6 +22,8 @@
 
 namespace xo {
     using xo::kalman::KalmanFilterSpec;
+    using xo::kalman::KalmanFilter;
+    using xo::kalman::KalmanUpdateForm;
     using xo::kalman::KalmanFilterStep;
     using xo::kalman::KalmanFilterEngine;
     using xo::kalman::KalmanFilterStateExt;
@@ -650,6 +657,179 @@ namespace xo {
             REQUIRE(err == 0);
         } /*TEST_CASE(kalman-drift)*/
 
+        TEST_CASE("kalman-cov-sqrt", "[kalmanfilter][sqrt]") {
+            /* positive definite -> cholesky */
+            {
+                MatrixXd P(2, 2);
+                P << 4.0, 1.0,
+                     1.0, 3.0;
+
+                MatrixXd S = KalmanFilterEngine::cov_sqrt(P);
+
+                REQUIRE((S * S.transpose() - P).norm() < 1e-12);
+                REQUIRE(S(0, 1) == 0.0);
+            }
+
+            /* singular,  non-negative definite */
+            {
+                MatrixXd P(3, 3);
+                P << 1.0, 0.0, 1.0,
+                     0.0, 0.0, 0.0,
+                     1.0, 0.0, 1.0;
+
+                MatrixXd S = KalmanFilterEngine::cov_sqrt(P);
+
+                REQUIRE((S * S.transpose() - P).norm() < 1e-12);
+            }
+
+            /* zero */
+            {
+                MatrixXd P = MatrixXd::Zero(2, 2);
+                MatrixXd S = KalmanFilterEngine::cov_sqrt(P);
+
+                REQUIRE(S.norm() == 0.0);
+            }
+        } /*TEST_CASE(kalman-cov-sqrt)*/
+
+        /* square-root filter agrees with covariance filter */
+        TEST_CASE("kalman-sqrt", "[kalmanfilter][sqrt]") {
+            uint64_t seed = 10283749823749812371UL;
+
+            auto normal_rng
+                = (normalgen<xoshiro256ss>::make
+                   (seed,
+                    std::normal_distribution<double>(0.0 /*mean*/,
+                                                     1.0 /*sdev*/)));
+
+            /* 3 state variables;  x[1] is known exactly and never disturbed */
+            MatrixXd F(3, 3);
+            F << 0.9, 0.1, 0.0,
+                 0.0, 1.0, 0.0,
+                 0.0, 0.2, 0.8;
+
+            MatrixXd Q(3, 3);
+            Q << 0.5, 0.0, 0.1,
+                 0.0, 0.0, 0.0,
+                 0.1, 0.0, 0.3;
+
+            MatrixXd H(3, 3);
+            H << 1.0, 0.0, 0.0,
+                 0.5, 0.0, 0.5,
+                 0.0, 0.0, 1.0;
+
+            MatrixXd R(3, 3);
+            R << 1.0, 0.0, 0.0,
+                 0.0, 2.0, 0.0,
+                 0.0, 0.0, 0.5;
+
+            KalmanFilterTransition Fk(F, Q);
+
+            utc_nanos t0 = timeutil::ymd_midnight(20220707);
+
+            VectorXd x0(3);
+            x0 << 0.0, 1.0, 0.0;
+
+            /* P0 singular */
+            MatrixXd P0 = MatrixXd::Zero(3, 3);
+            P0(0, 0) = 1.0;
+            P0(2, 2) = 4.0;
+
+            rp<KalmanFilterState> sk = KalmanFilterStateExt::initial(t0, x0, P0);
+            rp<KalmanFilterState> sk_sqrt = sk;
+
+            for (uint32_t k = 1; k <= 500; ++k) {
+                INFO(xtag("k", k));
+
+                utc_nanos tkp1 = t0 + seconds(k);
+
+                VectorXd z(3);
+                z << 5.0 + normal_rng(), 3.0 + normal_rng(), 1.0 + normal_rng();
+
+                rp<KalmanFilterInput> zkp1 = KalmanFilterInput::make_present(tkp1, z);
+
+                /* every 3rd step,  drop middle observation */
+                KalmanFilterObservable Hk
+                    = ((k % 3 == 0)
+                       ? KalmanFilterObservable::reindex(Eigen::Vector2i(0, 2), H, R)
+                       : KalmanFilterObservable::keep_all(H, R));
+
+                rp<KalmanFilterStateExt> skp1
+                    = KalmanFilterEngine::step(tkp1, sk, Fk, Hk, zkp1);
+                rp<KalmanFilterStateExt> skp1_sqrt
+                    = KalmanFilterEngine::step_sqrt(tkp1, sk_sqrt, Fk, Hk, zkp1);
+
+                REQUIRE(skp1_sqrt->step_no() == skp1->step_no());
+                REQUIRE(skp1_sqrt->tm() == skp1->tm());
+                REQUIRE((skp1_sqrt->state_v() - skp1->state_v()).norm() < 1e-9);
+                REQUIRE((skp1_sqrt->state_cov() - skp1->state_cov()).norm() < 1e-9);
+                REQUIRE((skp1_sqrt->gain() - skp1->gain()).norm() < 1e-9);
+
+                /* S(k) lower triangular,  non-negative diagonal */
+                MatrixXd const & S = skp1_sqrt->state_cov_sqrt();
+
+                REQUIRE(S.rows() == 3);
+                REQUIRE(S.cols() == 3);
+                REQUIRE(MatrixXd(S.triangularView<Eigen::StrictlyUpper>()).norm() == 0.0);
+                REQUIRE(S.diagonal().minCoeff() >= 0.0);
+
+                /* covariance form doesn't maintain S */
+                REQUIRE(skp1->state_cov_sqrt().size() == 0);
+
+                sk = skp1;
+                sk_sqrt = skp1_sqrt;
+            }
+        } /*TEST_CASE(kalman-sqrt)*/
+
+        /* KalmanFilter honors KalmanFilterSpec.update_form */
+        TEST_CASE("kalman-sqrt-spec", "[kalmanfilter][sqrt]") {
+            uint64_t seed = 14950319842636922572UL;
+
+            auto normal_rng
+                = (normalgen<xoshiro256ss>::make
+                   (seed,
+                    std::normal_distribution<double>(0.0 /*mean*/,
+                                                     1.0 /*sdev*/)));
+
+            utc_nanos t0 = timeutil::ymd_midnight(20220707);
+
+            VectorXd x0(1);
+            x0 << 10.0;
+
+            MatrixXd P0 = MatrixXd::Identity(1, 1);
+
+            KalmanFilterSpec spec(KalmanFilterStateExt::initial(t0, x0, P0),
+                                  kalman_identity1_mkstep_fn());
+            KalmanFilterSpec spec_sqrt(KalmanFilterStateExt::initial(t0, x0, P0),
+                                       kalman_identity1_mkstep_fn(),
+                                       KalmanUpdateForm::square_root);
+
+            REQUIRE(spec.update_form() == KalmanUpdateForm::covariance);
+            REQUIRE(spec_sqrt.update_form() == KalmanUpdateForm::square_root);
+
+            KalmanFilter filter(spec);
+            KalmanFilter filter_sqrt(spec_sqrt);
+
+            for (uint32_t k = 1; k <= 100; ++k) {
+                INFO(xtag("k", k));
+
+                VectorXd z(1);
+                z << 10.0 + normal_rng();
+
+                rp<KalmanFilterInput> zk = KalmanFilterInput::make_present(t0 + seconds(k), z);
+
+                filter.notify_input(zk);
+                filter_sqrt.notify_input(zk);
+
+                REQUIRE(filter_sqrt.step_no() == k);
+                REQUIRE(filter_sqrt.state_ext()->state_cov_sqrt().size() == 1);
+                REQUIRE(filter.state_ext()->state_cov_sqrt().size() == 0);
+                REQUIRE(filter_sqrt.state_ext()->state_v()[0]
+                        == Approx(filter.state_ext()->state_v()[0]).epsilon(1e-12));
+                REQUIRE(filter_sqrt.state_ext()->state_cov()(0, 0)
+                        == Approx(filter.state_ext()->state_cov()(0, 0)).epsilon(1e-12));
+            }
+        } /*TEST_CASE(kalman-sqrt-spec)*/
+
 #ifdef NOT_IN_USE
         namespace {
             /* step for kalman filter with:
@@ -0,0 +1,361 @@
+/* @file KalmanFilterBatchSvc.test.cpp */
+
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
+
+#include "xo/kalmanfilter/KalmanFilterBatchSvc.hpp"
+#include "xo/kalmanfilter/KalmanFilterSvc.hpp"
+#include <xo/reactor/Sink.hpp>
+#include <xo/randomgen/normalgen.hpp>
+#include <xo/randomgen/xoshiro256.hpp>
+#include <xo/ppsink/tag_ostream.hpp>   /* os << xtag(..) */
+#include <catch2/catch.hpp>
+
+namespace xo {
+    using xo::kalman::KalmanFilterBatchSvc;
+    using xo::kalman::KalmanFilterSvc;
+    using xo::kalman::KalmanFilterSpec;
+    using xo::kalman::KalmanFilterStep;
+    using xo::kalman::KalmanFilterStateExt;
+    using xo::kalman::KalmanFilterState;
+    using xo::kalman::KalmanFilterTransition;
+    using xo::kalman::KalmanFilterObservable;
+    using xo::kalman::KalmanFilterInput;
+    using xo::kalman::KalmanFilterInputPtr;
+    using xo::reactor::SinkToFunction;
+    using xo::rng::normalgen;
+    using xo::rng::xoshiro256ss;
+    using xo::time::timeutil;
+    using xo::time::utc_nanos;
+    using xo::time::seconds;
+    using Eigen::MatrixXd;
+    using Eigen::VectorXd;
+
+    namespace ut {
+        using xo::pp::xtag;
+
+        namespace {
+            using StateSinkFn = std::function<void (rp<KalmanFilterStateExt> const &)>;
+
+            /* model shared by every instrument:
+             * n=3 state variables, m=2 observables
+             */
+            struct TestModel {
+                TestModel() {
+                    MatrixXd F(3, 3);
+                    F << 0.9, 0.1, 0.0,
+                         0.0, 1.0, 0.0,
+                         0.0, 0.2, 0.8;
+
+                    MatrixXd Q(3, 3);
+                    Q << 0.5, 0.0, 0.1,
+                         0.0, 0.1, 0.0,
+                         0.1, 0.0, 0.3;
+
+                    MatrixXd H(2, 3);
+                    H << 1.0, 0.0, 0.0,
+                         0.5, 0.0, 0.5;
+
+                    MatrixXd R(2, 2);
+                    R << 1.0, 0.2,
+                         0.2, 2.0;
+
+                    Fk_ = KalmanFilterTransition(F, Q);
+                    Hk_ = KalmanFilterObservable::keep_all(H, R);
+                }
+
+                KalmanFilterSpec::MkStepFn mk_step_fn() const {
+                    KalmanFilterTransition Fk = Fk_;
+                    KalmanFilterObservable Hk = Hk_;
+
+                    return [Fk, Hk](rp<KalmanFilterState> const & sk,
+                                    KalmanFilterInputPtr const & zkp1)
+                        {
+                            /* reindex for absent observations,
+                             * as KalmanFilterBatchSvc does
+                             */
+                            KalmanFilterObservable Hk2
+                                = KalmanFilterObservable::reindex(zkp1->make_kept_index(),
+                                                                  Hk.observable(),
+                                                                  Hk.observable_cov());
+
+                            return KalmanFilterStep(sk, Fk, Hk2, zkp1);
+                        };
+                }
+
+                KalmanFilterTransition Fk_;
+                KalmanFilterObservable Hk_;
+            };
+
+            rp<KalmanFilterStateExt>
+            initial_state(utc_nanos t0, std::uint32_t i)
+            {
+                VectorXd x0(3);
+                x0 << i, 1.0, -1.0 * i;
+
+                MatrixXd P0 = (1.0 + i % 3) * MatrixXd::Identity(3, 3);
+
+                return KalmanFilterStateExt::initial(t0, x0, P0);
+            } /*initial_state*/
+        } /*namespace*/
+
+        /* batch service matches one KalmanFilterSvc per instrument */
+        TEST_CASE("kalman-batch", "[kalmanfilter][batch]") {
+            TestModel model;
+
+            uint64_t seed = 7234987239847234987UL;
+
+            auto normal_rng
+                = (normalgen<xoshiro256ss>::make
+                   (seed,
+                    std::normal_distribution<double>(0.0 /*mean*/,
+                                                     1.0 /*sdev*/)));
+
+            utc_nanos t0 = timeutil::ymd_midnight(20220707);
+
+            std::uint32_t n_instr = 37;
+
+            rp<KalmanFilterBatchSvc> batch
+                = KalmanFilterBatchSvc::make(model.Fk_, model.Hk_);
+
+            REQUIRE(batch->n_state() == 3);
+            REQUIRE(batch->n_obs() == 2);
+
+            std::vector<rp<KalmanFilterSvc>> svc_v;
+            /* outputs published by batch service, per instrument */
+            std::vector<std::vector<rp<KalmanFilterStateExt>>> out_vv(n_instr);
+            std::vector<rp<xo::kalman::KalmanFilterInputCallback>> in_v;
+
+            for (std::uint32_t i = 0; i < n_instr; ++i) {
+                rp<KalmanFilterStateExt> s0 = initial_state(t0, i);
+
+                REQUIRE(batch->add_filter(s0) == i);
+
+                svc_v.push_back(KalmanFilterSvc::make(KalmanFilterSpec(s0, model.mk_step_fn())));
+
+                auto * p_out_v = &(out_vv[i]);
+
+                batch->add_callback(i, new SinkToFunction<rp<KalmanFilterStateExt>, StateSinkFn>
+                                    ([p_out_v](rp<KalmanFilterStateExt> const & s) { p_out_v->push_back(s); }));
+
+                in_v.push_back(batch->input_sink(i));
+            }
+
+            REQUIRE(batch->n_filter() == n_instr);
+
+            std::vector<std::uint32_t> n_expected(n_instr, 0);
+
+            for (std::uint32_t round = 0; round < 50; ++round) {
+                INFO(xtag("round", round));
+
+                utc_nanos tkp1 = t0 + seconds(round + 1);
+
+                std::uint64_t n_sent = 0;
+
+                for (std::uint32_t i = 0; i < n_instr; ++i) {
+                    /* vary participation:  some instruments idle,
+                     * some get 2 inputs this round
+                     */
+                    std::uint32_t n_in = (i + round) % 4;
+                    if (n_in == 3)
+                        n_in = 1;
+
+                    for (std::uint32_t j = 0; j < n_in; ++j) {
+                        VectorXd z(2);
+                        z << 0.1 * i + normal_rng(), normal_rng();
+
+                        Eigen::Array<bool, Eigen::Dynamic, 1> presence(2);
+                        presence << true, true;
+
+                        /* occasionally drop 2nd observation;
+                         * batch svc steps these separately
+                         */
+                        if ((i + round + j) % 7 == 0)
+                            presence[1] = false;
+
+                        rp<KalmanFilterInput> zkp1
+                            = KalmanFilterInput::make(tkp1 + seconds(j) / 10, presence, z, VectorXd());
+
+                        svc_v[i]->notify_ev(zkp1);
+
+                        /* alternate between direct input and input sink */
+                        if (j == 0)
+                            batch->notify_input(i, zkp1);
+                        else
+                            in_v[i]->notify_ev(zkp1);
+
+                        ++n_sent;
+                        ++n_expected[i];
+                    }
+                }
+
+                REQUIRE(batch->n_pending() == n_sent);
+                REQUIRE(batch->flush() == n_sent);
+                REQUIRE(batch->n_pending() == 0);
+
+                for (std::uint32_t i = 0; i < n_instr; ++i) {
+                    INFO(xtag("i", i));
+
+                    rp<KalmanFilterStateExt> const & s = svc_v[i]->filter().state_ext();
+
+                    REQUIRE(out_vv[i].size() == n_expected[i]);
+                    REQUIRE(batch->step_no(i) == s->step_no());
+                    REQUIRE(batch->tm(i) == s->tm());
+                    REQUIRE((batch->state_v(i) - s->state_v()).norm() < 1e-9);
+                    REQUIRE((batch->state_cov(i) - s->state_cov()).norm() < 1e-9);
+
+                    if (!out_vv[i].empty()) {
+                        rp<KalmanFilterStateExt> const & s_out = out_vv[i].back();
+
+                        REQUIRE(s_out->step_no() == s->step_no());
+                        REQUIRE((s_out->state_v() - s->state_v()).norm() < 1e-9);
+                        REQUIRE(s_out->zk().get() == s->zk().get());
+                    }
+                }
+            }
+        } /*TEST_CASE(kalman-batch)*/
+
+        /* lane whose innovation covariance is not positive definite
+         * falls back to scalar step;  other lanes unaffected
+         */
+        TEST_CASE("kalman-batch-fallback", "[kalmanfilter][batch]") {
+            TestModel model;
+
+            utc_nanos t0 = timeutil::ymd_midnight(20220707);
+
+            std::uint32_t n_instr = 4;
+
+            rp<KalmanFilterBatchSvc> batch
+                = KalmanFilterBatchSvc::make(model.Fk_, model.Hk_);
+
+            std::vector<rp<KalmanFilterSvc>> svc_v;
+            std::vector<std::uint32_t> n_out_v(n_instr, 0);
+
+            for (std::uint32_t i = 0; i < n_instr; ++i) {
+                rp<KalmanFilterStateExt> s0 = initial_state(t0, i);
+
+                if (i == 1) {
+                    /* indefinite prior -> H.P.H^T + R has a negative pivot */
+                    s0 = KalmanFilterStateExt::initial(t0,
+                                                       s0->state_v(),
+                                                       -5.0 * MatrixXd::Identity(3, 3));
+                }
+
+                REQUIRE(batch->add_filter(s0) == i);
+
+                svc_v.push_back(KalmanFilterSvc::make(KalmanFilterSpec(s0, model.mk_step_fn())));
+
+                auto * p_n_out = &(n_out_v[i]);
+
+                batch->add_callback(i, new SinkToFunction<rp<KalmanFilterStateExt>, StateSinkFn>
+                                    ([p_n_out](rp<KalmanFilterStateExt> const &) { ++(*p_n_out); }));
+            }
+
+            for (std::uint32_t i = 0; i < n_instr; ++i) {
+                VectorXd z(2);
+                z << 1.0 + i, -0.5 * i;
+
+                Eigen::Array<bool, Eigen::Dynamic, 1> presence(2);
+                presence << true, true;
+
+                rp<KalmanFilterInput> zkp1
+                    = KalmanFilterInput::make(t0 + seconds(1), presence, z, VectorXd());
+
+                svc_v[i]->notify_ev(zkp1);
+                batch->notify_input(i, zkp1);
+            }
+
+            REQUIRE(batch->flush() == n_instr);
+            REQUIRE(batch->n_fallback() == 1);
+            REQUIRE(batch->n_step() == n_instr);
+
+            for (std::uint32_t i = 0; i < n_instr; ++i) {
+                INFO(xtag("i", i));
+
+                rp<KalmanFilterStateExt> const & s = svc_v[i]->filter().state_ext();
+
+                REQUIRE(n_out_v[i] == 1);
+                REQUIRE(batch->step_no(i) == s->step_no());
+                REQUIRE(batch->state_v(i).allFinite());
+                REQUIRE(batch->state_cov(i).allFinite());
+                REQUIRE((batch->state_v(i) - s->state_v()).norm() < 1e-9);
+                REQUIRE((batch->state_cov(i) - s->state_cov()).norm() < 1e-9);
+            }
+        } /*TEST_CASE(kalman-batch-fallback)*/
+
+        TEST_CASE("kalman-batch-dims", "[kalmanfilter][batch]") {
+            TestModel model;
+
+            rp<KalmanFilterBatchSvc> batch
+                = KalmanFilterBatchSvc::make(model.Fk_, model.Hk_);
+
+            utc_nanos t0 = timeutil::ymd_midnight(20220707);
+
+            REQUIRE_THROWS_AS(batch->add_filter(KalmanFilterStateExt::initial(t0,
+                                                                              VectorXd::Zero(2),
+                                                                              MatrixXd::Identity(2, 2))),
+                              std::runtime_error);
+            REQUIRE_THROWS_AS(batch->notify_input(0, KalmanFilterInput::make_present(t0, VectorXd::Zero(2))),
+                              std::runtime_error);
+            REQUIRE_THROWS_AS(KalmanFilterBatchSvc::make(model.Fk_,
+                                                         KalmanFilterObservable::keep_all(MatrixXd::Identity(2, 2),
+                                                                                          MatrixXd::Identity(2, 2))),
+                              std::runtime_error);
+        } /*TEST_CASE(kalman-batch-dims)*/
+
+        /* benchmark with:
+         *   $ ./utest.filter [!benchmark]
+         *
+         * one input for each of 1000 instruments:
+         * one KalmanFilterSvc per instrument vs. KalmanFilterBatchSvc
+         */
+        TEST_CASE("kalman-batch-benchmark", "[!benchmark]") {
+            TestModel model;
+
+            utc_nanos t0 = timeutil::ymd_midnight(20220707);
+
+            std::uint32_t n_instr = 1000;
+
+            rp<KalmanFilterBatchSvc> batch
+                = KalmanFilterBatchSvc::make(model.Fk_, model.Hk_);
+            std::vector<rp<KalmanFilterSvc>> svc_v;
+
+            for (std::uint32_t i = 0; i < n_instr; ++i) {
+                rp<KalmanFilterStateExt> s0 = initial_state(t0, i);
+
+                batch->add_filter(s0);
+                svc_v.push_back(KalmanFilterSvc::make(KalmanFilterSpec(s0, model.mk_step_fn())));
+            }
+
+            VectorXd z(2);
+            z << 1.0, 2.0;
+
+            std::vector<rp<KalmanFilterInput>> input_v;
+            for (std::uint32_t k = 0; k < 64; ++k)
+                input_v.push_back(KalmanFilterInput::make_present(t0 + seconds(k + 1), z));
+
+            std::uint32_t k_svc = 0;
+
+            BENCHMARK("KalmanFilterSvc x1000") {
+                rp<KalmanFilterInput> const & zkp1 = input_v[k_svc++ % input_v.size()];
+
+                for (auto & svc : svc_v)
+                    svc->notify_ev(zkp1);
+
+                return svc_v.size();
+            };
+
+            std::uint32_t k_batch = 0;
+
+            BENCHMARK("KalmanFilterBatchSvc x1000") {
+                rp<KalmanFilterInput> const & zkp1 = input_v[k_batch++ % input_v.size()];
+
+                for (std::uint32_t i = 0; i < n_instr; ++i)
+                    batch->notify_input(i, zkp1);
+
+                return batch->flush();
+            };
+        } /*TEST_CASE(kalman-batch-benchmark)*/
+    } /*namespace ut*/
+} /*namespace xo*/
+
+/* end KalmanFilterBatchSvc.test.cpp */
@@ -0,0 +1,212 @@
+/* @file KalmanFilterEngineN.test.cpp */
+
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
+
+#include "xo/kalmanfilter/KalmanFilterEngineN.hpp"
+#include "xo/kalmanfilter/KalmanFilterEngine.hpp"
+#include <xo/randomgen/normalgen.hpp>
+#include <xo/randomgen/xoshiro256.hpp>
+#include <xo/ppsink/tag_ostream.hpp>   /* os << xtag(..) */
+#include <catch2/catch.hpp>
+
+namespace xo {
+    using xo::kalman::KalmanFilterEngineN;
+    using xo::kalman::KalmanFilterEngine;
+    using xo::kalman::KalmanFilterStateExt;
+    using xo::kalman::KalmanFilterState;
+    using xo::kalman::KalmanFilterTransition;
+    using xo::kalman::KalmanFilterObservable;
+    using xo::kalman::KalmanFilterInput;
+    using xo::rng::normalgen;
+    using xo::rng::xoshiro256ss;
+    using xo::time::timeutil;
+    using xo::time::utc_nanos;
+    using xo::time::seconds;
+    using Eigen::MatrixXd;
+    using Eigen::VectorXd;
+
+    namespace ut {
+        using xo::pp::xtag;
+
+        namespace {
+            /* n-dimensional random walk,  observed through m noisy linear
+             * combinations of state.  Model matrices are random but fixed.
+             */
+            template <int N, int M>
+            struct TestModel {
+                using Engine = KalmanFilterEngineN<N, M>;
+
+                explicit TestModel(std::uint64_t seed)
+                    : rng_{normalgen<xoshiro256ss>::make(seed,
+                                                         std::normal_distribution<double>(0.0, 1.0))}
+                {
+                    /* mildly mean-reverting transition */
+                    F_ = 0.95 * Engine::MatrixNN::Identity();
+                    for (int i = 0; i + 1 < N; ++i)
+                        F_(i, i + 1) = 0.05;
+
+                    Q_ = 0.1 * Engine::MatrixNN::Identity();
+
+                    for (int i = 0; i < M; ++i) {
+                        for (int j = 0; j < N; ++j)
+                            H_(i, j) = rng_();
+                    }
+
+                    R_ = Engine::MatrixMM::Identity();
+                }
+
+                /* observation vector for step k */
+                typename Engine::VectorM next_z() {
+                    typename Engine::VectorM z;
+                    for (int i = 0; i < M; ++i)
+                        z[i] = 10.0 + rng_();
+                    return z;
+                }
+
+                normalgen<xoshiro256ss> rng_;
+                typename Engine::MatrixNN F_;
+                typename Engine::MatrixNN Q_;
+                typename Engine::MatrixMN H_;
+                typename Engine::MatrixMM R_;
+            };
+
+            /* run fixed-size and dynamic engines side by side;
+             * require they agree
+             */
+            template <int N, int M>
+            void
+            check_vs_engine(std::uint64_t seed, bool serial_flag)
+            {
+                TestModel<N, M> model(seed);
+
+                utc_nanos t0 = timeutil::ymd_midnight(20220707);
+
+                VectorXd x0 = VectorXd::Zero(N);
+                MatrixXd P0 = 10.0 * MatrixXd::Identity(N, N);
+
+                rp<KalmanFilterState> sk
+                    = KalmanFilterStateExt::initial(t0, x0, P0);
+
+                auto engine = KalmanFilterEngineN<N, M>::from_state(sk);
+
+                KalmanFilterTransition Fk(model.F_, model.Q_);
+                KalmanFilterObservable Hk = KalmanFilterObservable::keep_all(model.H_, model.R_);
+
+                for (std::uint32_t k = 1; k <= 200; ++k) {
+                    INFO(xtag("k", k));
+
+                    utc_nanos tkp1 = t0 + seconds(k);
+                    auto z = model.next_z();
+
+                    rp<KalmanFilterInput> zkp1
+                        = KalmanFilterInput::make_present(tkp1, VectorXd(z));
+
+                    rp<KalmanFilterStateExt> skp1;
+
+                    if (serial_flag) {
+                        std::uint32_t j = k % M;
+
+                        skp1 = KalmanFilterEngine::step1(tkp1, sk, Fk, Hk, zkp1, j);
+                        engine.step1(tkp1, model.F_, model.Q_, model.H_, model.R_, z, j);
+
+                        REQUIRE(engine.state().j_ == static_cast<std::int32_t>(j));
+                        REQUIRE((engine.gain().col(j) - skp1->gain()).norm() < 1e-9);
+                    } else {
+                        skp1 = KalmanFilterEngine::step(tkp1, sk, Fk, Hk, zkp1);
+                        engine.step(tkp1, model.F_, model.Q_, model.H_, model.R_, z);
+
+                        REQUIRE((engine.gain() - skp1->gain()).norm() < 1e-9);
+                    }
+
+                    REQUIRE(engine.step_no() == skp1->step_no());
+                    REQUIRE(engine.tm() == skp1->tm());
+                    REQUIRE((engine.state_v() - skp1->state_v()).norm() < 1e-9 * (1.0 + skp1->state_v().norm()));
+                    REQUIRE((engine.state_cov() - skp1->state_cov()).norm() < 1e-9 * (1.0 + skp1->state_cov().norm()));
+
+                    /* previous buffer still holds x(k) */
+                    REQUIRE(engine.prev_state().k_ == k - 1);
+
+                    sk = skp1;
+                }
+
+                /* round trip to dynamically-sized state */
+                rp<KalmanFilterStateExt> s_ext = engine.make_state_ext(Fk, nullptr);
+
+                REQUIRE(s_ext->step_no() == engine.step_no());
+                REQUIRE(s_ext->n_state() == N);
+                REQUIRE(s_ext->state_v() == VectorXd(engine.state_v()));
+                REQUIRE(s_ext->state_cov() == MatrixXd(engine.state_cov()));
+            } /*check_vs_engine*/
+        } /*namespace*/
+
+        TEST_CASE("kalman-engine-n", "[kalmanfilter]") {
+            check_vs_engine<1, 1>(14950319842636922572UL, false /*!serial_flag*/);
+            check_vs_engine<2, 1>(5342897420591873031UL, false /*!serial_flag*/);
+            check_vs_engine<4, 2>(9813427349823479183UL, false /*!serial_flag*/);
+            check_vs_engine<8, 3>(1238479123874198237UL, false /*!serial_flag*/);
+
+            check_vs_engine<4, 2>(3498712349871234987UL, true /*serial_flag*/);
+            check_vs_engine<8, 3>(7771231239871239871UL, true /*serial_flag*/);
+        } /*TEST_CASE(kalman-engine-n)*/
+
+        TEST_CASE("kalman-engine-n-dims", "[kalmanfilter]") {
+            utc_nanos t0 = timeutil::ymd_midnight(20220707);
+
+            rp<KalmanFilterState> s0
+                = KalmanFilterStateExt::initial(t0, VectorXd::Zero(3), MatrixXd::Identity(3, 3));
+
+            REQUIRE_THROWS_AS((KalmanFilterEngineN<2, 1>::from_state(s0)), std::runtime_error);
+        } /*TEST_CASE(kalman-engine-n-dims)*/
+
+        namespace {
+            template <int N, int M>
+            void
+            benchmark_vs_engine(std::uint64_t seed)
+            {
+                TestModel<N, M> model(seed);
+
+                utc_nanos t0 = timeutil::ymd_midnight(20220707);
+
+                VectorXd x0 = VectorXd::Zero(N);
+                MatrixXd P0 = 10.0 * MatrixXd::Identity(N, N);
+
+                rp<KalmanFilterState> sk = KalmanFilterStateExt::initial(t0, x0, P0);
+
+                auto engine = KalmanFilterEngineN<N, M>::from_state(sk);
+
+                KalmanFilterTransition Fk(model.F_, model.Q_);
+                KalmanFilterObservable Hk = KalmanFilterObservable::keep_all(model.H_, model.R_);
+
+                /* same observations for both engines */
+                auto z = model.next_z();
+                rp<KalmanFilterInput> zkp1 = KalmanFilterInput::make_present(t0, VectorXd(z));
+
+                std::string suffix = "[" + std::to_string(N) + "x" + std::to_string(M) + "]";
+
+                BENCHMARK(("KalmanFilterEngine::step" + suffix).c_str()) {
+                    sk = KalmanFilterEngine::step(sk->tm() + seconds(1), sk, Fk, Hk, zkp1);
+                    return sk->step_no();
+                };
+
+                BENCHMARK(("KalmanFilterEngineN::step" + suffix).c_str()) {
+                    engine.step(engine.tm() + seconds(1),
+                                model.F_, model.Q_, model.H_, model.R_, z);
+                    return engine.step_no();
+                };
+            } /*benchmark_vs_engine*/
+        } /*namespace*/
+
+        /* benchmark with:
+         *   $ ./utest.filter [!benchmark]
+         *
+         * steps/sec = 1 / (reported mean time per step)
+         */
+        TEST_CASE("kalman-engine-n-benchmark", "[!benchmark]") {
+            benchmark_vs_engine<2, 1>(5342897420591873031UL);
+            benchmark_vs_engine<4, 2>(9813427349823479183UL);
+            benchmark_vs_engine<8, 3>(1238479123874198237UL);
+        } /*TEST_CASE(kalman-engine-n-benchmark)*/
+    } /*namespace ut*/
+} /*namespace xo*/
+
+/* end KalmanFilterEngineN.test.cpp */
@@ -0,0 +1,357 @@
+/** @file DeferredLog.hpp
+ *
+ *  @author Roland Conybeare, Oct 2026
+ *
+ *  Deferred (asynchronous) logging backend for xo::pp::scope.
+ *
+ *  Synchronous scope logging pays for timestamp formatting, pretty() of
+ *  every argument, and the write itself on the calling thread.  With
+ *  DeferredLog running, a scope instead appends a compact binary record to
+ *  a per-thread ring buffer:
+ *
+ *    - raw timestamp (int64 nanoseconds; formatted later)
+ *    - nesting level
+ *    - banner name / source location, copied as bytes
+ *    - arguments, copied as bytes (see DeferredArg)
+ *
+ *  and a background thread decodes records and does the pretty-printing.
+ *
+ *  Each record carries a pointer to the (template-instantiated) function
+ *  that knows how to decode it,  so the ring itself is untyped.
+ *
+ *  Only threads using the default sink are deferred (see
+ *  LogState::uses_default_sink);  a thread that installed its own sink
+ *  (e.g. a capture sink in a test) keeps logging synchronously.
+ *
+ *  Use:
+ *  @code
+ *    DeferredLog::start();   // background thread writes to std::clog
+ *    ...
+ *    DeferredLog::stop();    // drain + join;  back to synchronous logging
+ *  @endcode
+ **/
+
+#pragma once
+
+#include "PpSink.hpp"
+#include "tag.hpp"
+#include <atomic>
+#include <cstddef>
+#include <cstdint>
+#include <cstring>
+#include <memory>
+#include <string_view>
+#include <type_traits>
+
+namespace xo::pp {
+    /** @brief header for one record in a LogRing.
+     *
+     *  Record layout: [LogRecord][payload][string bytes], padded to a
+     *  multiple of @ref c_align.  Payload starts at offset c_align.
+     **/
+    struct LogRecord {
+        /** decode + render a record on @p sink **/
+        using render_fn_type = void (*)(PpSink & sink, LogRecord const * rec);
+
+        /** alignment (and granularity) of records within a ring **/
+        static constexpr std::uint32_t c_align = 16;
+
+        /** base address of this record;  string offsets are relative to this **/
+        char const * base() const { return reinterpret_cast<char const *>(this); }
+        char * base() { return reinterpret_cast<char *>(this); }
+
+        /** address of payload **/
+        template <typename Payload>
+        Payload const * payload() const {
+            return reinterpret_cast<Payload const *>(this->base() + c_align);
+        }
+
+        /** decoder for this record;  nullptr for padding at end of ring **/
+        render_fn_type render_ = nullptr;
+        /** record size in bytes,  including header and padding **/
+        std::uint32_t z_ = 0;
+    };
+
+    static_assert(sizeof(LogRecord) <= LogRecord::c_align);
+
+    /** @brief single-producer / single-consumer ring of variable-length LogRecords.
+     *
+     *  Producer is the owning (logging) thread,  consumer is the DeferredLog
+     *  background thread.  Neither side blocks (except consumer in close()):
+     *  a producer that finds the ring full drops its record
+     *  (see DeferredLog::n_dropped).
+     *
+     *  A record never wraps;  if it doesn't fit before the end of the ring,
+     *  producer writes a padding record and starts over at offset 0.
+     **/
+    class LogRing {
+    public:
+        /** ring with room for @p capacity bytes (rounded up to power of 2, min 256) **/
+        explicit LogRing(std::uint32_t capacity);
+        ~LogRing();
+
+        std::uint32_t capacity() const { return mask_ + 1; }
+
+        /** producer: space for a record of @p z bytes (multiple of LogRecord::c_align),
+         *  or nullptr if ring lacks room or is closed.
+         *  Non-null result must be followed by commit()
+         **/
+        LogRecord * reserve(std::uint32_t z);
+        /** producer: publish record obtained from preceding reserve() **/
+        void commit() {
+            tail_.store(tail_.load(std::memory_order_relaxed) + reserve_z_,
+                        std::memory_order_release);
+            busy_flag_.store(false, std::memory_order_release);
+        }
+
+        /** consumer: make subsequent reserve() fail,  then wait for a reservation
+         *  already in flight to commit.  Afterwards every record that will
+         *  ever be published is visible to drain()
+         **/
+        void close();
+        /** consumer: undo close() **/
+        void reopen() { closed_flag_.store(false, std::memory_order_release); }
+
+        /** consumer: render all published records on @p sink;  return #of records **/
+        std::uint64_t drain(PpSink & sink);
+
+        /** position after last published record **/
+        std::uint64_t tail_pos() const { return tail_.load(std::memory_order_acquire); }
+        /** position after last consumed record **/
+        std::uint64_t head_pos() const { return head_.load(std::memory_order_acquire); }
+
+        /** true once owning thread has exited;  ring discarded after it's drained **/
+        bool is_retired() const { return retired_flag_.load(std::memory_order_acquire); }
+        void retire() { retired_flag_.store(true, std::memory_order_release); }
+
+    private:
+        LogRecord * at(std::uint64_t pos) {
+            return reinterpret_cast<LogRecord *>(buf_.get() + (pos & mask_));
+        }
+
+    private:
+        /** capacity - 1 **/
+        std::uint32_t mask_ = 0;
+        /** storage;  aligned for LogRecord::c_align **/
+        std::unique_ptr<char[]> buf_;
+        /** bytes reserved by last .reserve(),  including any wrap padding (producer only) **/
+        std::uint32_t reserve_z_ = 0;
+        /** set when owning thread exits **/
+        std::atomic<bool> retired_flag_ = false;
+        /** set by close();  reserve() fails while set **/
+        std::atomic<bool> closed_flag_ = false;
+        /** set from reserve() until commit() (producer),  so close() can wait **/
+        std::atomic<bool> busy_flag_ = false;
+
+        /** next position to consume **/
+        alignas(64) std::atomic<std::uint64_t> head_ = 0;
+        /** next position to produce **/
+        alignas(64) std::atomic<std::uint64_t> tail_ = 0;
+    };
+
+    /** @brief string bytes stored inline in a deferred record,
+     *  at offset .off_ from the record's base
+     **/
+    struct deferred_str {
+        std::uint32_t off_ = 0;
+        std::uint32_t len_ = 0;
+    };
+
+    /** @brief copies string bytes into the tail of a record being written **/
+    class DeferredWriter {
+    public:
+        DeferredWriter(char * base, std::uint32_t off) : base_{base}, off_{off} {}
+
+        deferred_str put(std::string_view s) {
+            deferred_str retval{off_, static_cast<std::uint32_t>(s.size())};
+
+            ::memcpy(base_ + off_, s.data(), s.size());
+            off_ += s.size();
+
+            return retval;
+        }
+
+    private:
+        char * base_ = nullptr;
+        std::uint32_t off_ = 0;
+    };
+
+    /** @brief how to copy a log argument of type @p T into a deferred record.
+     *
+     *  A specialization provides:
+     *  - @c stored_type  trivially destructible image stored in the record
+     *  - @c extra_z(x)   #of string bytes needed beyond stored_type
+     *  - @c store(x, w)  make stored image,  copying string bytes via @p w
+     *  - @c restore(s, base)  value to hand to pretty() when rendering
+     *
+     *  Provided for arithmetic types, enums, strings, and tags of these.
+     *  Anything else (pointers, containers, user types) might change or
+     *  dangle before the background thread gets to it, so scope renders
+     *  such arguments to text on the calling thread instead,
+     *  and defers only the text.
+     **/
+    template <typename T, typename Enable = void>
+    struct DeferredArg {
+        static constexpr bool deferrable = false;
+    };
+
+    template <typename T>
+    struct DeferredArg<T, std::enable_if_t<std::is_arithmetic_v<T> || std::is_enum_v<T>>> {
+        static constexpr bool deferrable = true;
+        using stored_type = T;
+
+        static std::size_t extra_z(const T &) { return 0; }
+        static stored_type store(const T & x, DeferredWriter &) { return x; }
+        static const T & restore(const stored_type & x, char const *) { return x; }
+    };
+
+    template <typename T>
+    struct DeferredArg<T, std::enable_if_t<!std::is_arithmetic_v<T>
+                                           && std::is_convertible_v<const T &, std::string_view>>> {
+        static constexpr bool deferrable = true;
+        using stored_type = deferred_str;
+
+        static std::size_t extra_z(const T & x) { return view(x).size(); }
+        static stored_type store(const T & x, DeferredWriter & w) { return w.put(view(x)); }
+        static std::string_view restore(const stored_type & x, char const * base) {
+            return std::string_view(base + x.off_, x.len_);
+        }
+
+    private:
+        /** text for @p x;  null char pointer => "(null)" **/
+        static std::string_view view(const T & x) {
+            if constexpr (std::is_pointer_v<T>) {
+                if (!x)
+                    return "(null)";
+            }
+
+            return std::string_view(x);
+        }
+    };
+
+    template <bool PrefixSpace, tagstyle TagStyle, typename Name, typename Value>
+    struct DeferredArg<tag_impl<PrefixSpace, TagStyle, Name, Value>,
+                       std::enable_if_t<DeferredArg<Name>::deferrable
+                                        && DeferredArg<Value>::deferrable>> {
+        using NameArg = DeferredArg<Name>;
+        using ValueArg = DeferredArg<Value>;
+        using tag_type = tag_impl<PrefixSpace, TagStyle, Name, Value>;
+
+        static constexpr bool deferrable = true;
+        using stored_type = tag_impl<PrefixSpace, TagStyle,
+                                     typename NameArg::stored_type,
+                                     typename ValueArg::stored_type>;
+
+        static std::size_t extra_z(const tag_type & x) {
+            return NameArg::extra_z(x.name()) + ValueArg::extra_z(x.value());
+        }
+        static stored_type store(const tag_type & x, DeferredWriter & w) {
+            /* sequenced: name bytes before value bytes */
+            auto name = NameArg::store(x.name(), w);
+            auto value = ValueArg::store(x.value(), w);
+
+            return stored_type(name, value);
+        }
+        static auto restore(const stored_type & x, char const * base) {
+            using restored_name = std::decay_t<decltype(NameArg::restore(x.name(), base))>;
+            using restored_value = std::decay_t<decltype(ValueArg::restore(x.value(), base))>;
+
+            return tag_impl<PrefixSpace, TagStyle, restored_name, restored_value>
+                (NameArg::restore(x.name(), base), ValueArg::restore(x.value(), base));
+        }
+    };
+
+    /** DeferredArg for a log() argument deduced as @p T
+     *  (decay of const T, so a string literal maps to char const *)
+     **/
+    template <typename T>
+    using deferred_arg_t = DeferredArg<std::decay_t<const T>>;
+
+    /** true iff every type in @p Ts can be copied into a deferred record **/
+    template <typename... Ts>
+    inline constexpr bool deferrable_v = (deferred_arg_t<Ts>::deferrable && ...);
+
+    /** @brief process-wide deferred-logging control + per-thread rings **/
+    class DeferredLog {
+    public:
+        /** default per-thread ring size **/
+        static constexpr std::uint32_t c_default_ring_z = 1024 * 1024;
+
+        /** start background thread,  rendering deferred records on @p sink
+         *  (nullptr => FlatSink over std::clog).  Rings created from now on
+         *  have @p ring_z bytes.  No-op if already started.
+         *
+         *  @p sink is used only by the background thread until stop().
+         **/
+        static void start(PpSink * sink = nullptr, std::uint32_t ring_z = c_default_ring_z);
+        /** stop deferring,  render everything already recorded,  join background thread **/
+        static void stop();
+        /** block until records posted (by any thread) before this call are rendered **/
+        static void flush();
+
+        /** true between start() and stop() **/
+        static bool enabled() { return s_enabled_flag.load(std::memory_order_relaxed); }
+
+        /** #of records discarded because a thread's ring was full,
+         *  or because they were posted while stop() was running
+         **/
+        static std::uint64_t n_dropped();
+
+        /** append a record to calling thread's ring.
+         *  @p Payload is constructed in place by @p fill(void * addr, DeferredWriter & w),
+         *  which may copy up to @p extra_z string bytes through w.
+         *  Returns false if record dropped.
+         **/
+        template <typename Payload, typename Fill>
+        static bool post(LogRecord::render_fn_type render_fn,
+                         std::size_t extra_z,
+                         Fill && fill)
+        {
+            static_assert(std::is_trivially_destructible_v<Payload>);
+            static_assert(alignof(Payload) <= LogRecord::c_align);
+
+            constexpr std::size_t c_a = LogRecord::c_align;
+
+            std::size_t payload_end = c_a + sizeof(Payload);
+            std::size_t z = (payload_end + extra_z + c_a - 1) & ~(c_a - 1);
+
+            LogRing * ring = thread_ring();
+            LogRecord * rec = ((z <= ring->capacity() / 2)
+                               ? ring->reserve(z)
+                               : nullptr);
+
+            if (!rec) {
+                note_dropped();
+                return false;
+            }
+
+            rec->render_ = render_fn;
+            rec->z_ = z;
+
+            DeferredWriter w(rec->base(), payload_end);
+
+            fill(rec->base() + c_a, w);
+
+            ring->commit();
+
+            return true;
+        }
+
+        /** calling thread's sink for rendering non-deferrable arguments to text;
+         *  cleared on each call
+         **/
+        static PpSink & prerender_sink();
+        /** text rendered on prerender_sink() since last call to it **/
+        static std::string_view prerender_text();
+
+    private:
+        /** calling thread's ring;  created + registered on first use **/
+        static LogRing * thread_ring();
+        static void note_dropped();
+
+    private:
+        static inline std::atomic<bool> s_enabled_flag = false;
+    };
+} /*namespace xo::pp*/
+
+/* end DeferredLog.hpp */
@@ -24,6 +24,10 @@ namespace xo::pp {
     public:
         /** true iff sink never updated by set_sink() **/
         bool is_builtin_default() { return builtin_flag_; }
+        /** true iff this thread logs to the process default sink,
+         *  i.e. no sink installed,  or sink restored with set_sink(nullptr)
+         **/
+        bool uses_default_sink() const { return builtin_flag_ || !sink_; }
 
         std::uint32_t nesting_level() const { return nesting_; }
         void incr_nesting() { ++nesting_; }
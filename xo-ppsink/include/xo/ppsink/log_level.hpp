@@ -60,16 +60,16 @@ namespace xo::pp {
         return "?log_level";
     }
 
-    inline bool operator> (log_level x, log_level y) {
+    inline constexpr bool operator> (log_level x, log_level y) {
         return static_cast<std::uint8_t>(x) >  static_cast<std::uint8_t>(y);
     }
-    inline bool operator>=(log_level x, log_level y) {
+    inline constexpr bool operator>=(log_level x, log_level y) {
         return static_cast<std::uint8_t>(x) >= static_cast<std::uint8_t>(y);
     }
-    inline bool operator< (log_level x, log_level y) {
+    inline constexpr bool operator< (log_level x, log_level y) {
         return static_cast<std::uint8_t>(x) <  static_cast<std::uint8_t>(y);
     }
-    inline bool operator<=(log_level x, log_level y) {
+    inline constexpr bool operator<=(log_level x, log_level y) {
         return static_cast<std::uint8_t>(x) <= static_cast<std::uint8_t>(y);
     }
 } /*namespace xo::pp*/
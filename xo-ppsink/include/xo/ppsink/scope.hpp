@@ -21,6 +21,7 @@
 
 #pragma once
 
+#include "DeferredLog.hpp"
 #include "LogState.hpp"
 #include "PpSink.hpp"
 #include "color.hpp"
@@ -28,7 +29,9 @@
 #include "log_level.hpp"
 #include "pretty_ostream.hpp" /* pretty(): scope logs arbitrary types, so it needs the operator<< fallback */
 #include <cstdint>
+#include <new>
 #include <string_view>
+#include <tuple>
 #include <utility>
 
 namespace xo::pp {
@@ -119,6 +122,26 @@ namespace xo::pp {
         bool is_enabled() const { return level_ >= scope_config::min_log_level; }
     };
 
+    /** @brief scope_setup for a scope whose level is below the build-time
+     *  minimum (XO_PPSINK_MIN_LOG_LEVEL, see scope_macros.hpp).
+     *
+     *  A scope entered with this starts disabled without consulting
+     *  scope_config::min_log_level, so the compiler can see that
+     *  @c log && log(...) and the exit banner are dead code.  Keeps the
+     *  banner name + location anyway, so retroactively_enable() on an error
+     *  path still reports where it came from.
+     **/
+    struct scope_setup_off : scope_setup {};
+
+    /** @p setup when @p Compiled,  otherwise @p setup compiled out **/
+    template <bool Compiled>
+    constexpr auto scope_setup_if(const scope_setup & setup) {
+        if constexpr (Compiled)
+            return setup;
+        else
+            return scope_setup_off{setup};
+    }
+
     /** @brief RAII scope logger: logs entry on construction, exit on destruction,
      *  and log() lines in between, each at the current nesting indentation.
      *
@@ -148,6 +171,16 @@ namespace xo::pp {
             begin_scope(std::forward<Ts>(args)...);
         }
 
+        /** enter a scope compiled out by XO_PPSINK_MIN_LOG_LEVEL: disabled
+         *  from the start;  entry-banner @p args are ignored
+         **/
+        template <typename... Ts>
+        explicit scope(scope_setup_off setup, Ts &&...)
+            : name_{setup.name_}, name2_{setup.name2_}, style_{setup.style_},
+              file_{setup.file_}, line_{setup.line_},
+              finalized_{true}
+        {}
+
         ~scope() {
             if (!finalized_)
                 end_scope();
@@ -186,14 +219,11 @@ namespace xo::pp {
                 return false;
 
             xo::pp::LogState & st = xo::pp::ThreadLogState::thread_log_state();
-            xo::pp::PpSink & sink = st.sink();
 
-            emit_time(sink, false /*real_time: log() lines get a blank time pad*/);
-            emit_indent(st);
-            sink.begin();
-            (xo::pp::pretty(sink, args), ...);
-            sink.end();
-            sink.complete();
+            if (use_deferred(st))
+                post_line(st.nesting_level(), args...);
+            else
+                render_line(st.sink(), st.nesting_level(), args...);
 
             return true;
         }
@@ -214,30 +244,16 @@ namespace xo::pp {
             finalized_ = true;
 
             xo::pp::LogState & st = xo::pp::ThreadLogState::thread_log_state();
-            xo::pp::PpSink & sink = st.sink();
 
             st.decr_nesting();
 
-            emit_time(sink, true /*real_time*/);
-            emit_indent(st);
-            sink.put("-");
-            emit_nesting_level(sink, st.nesting_level());
-            {
-                color_guard g(sink, scope_config::function_exit_color);
-                put_function_name(sink, style_, name_);
-            }
-            /* outside the color guard: name2 is verbatim, matching legacy
-             * (function_name(style, color, name1) << name2)
-             */
-            if (!name2_.empty())
-                sink.put(name2_);
-            if constexpr (sizeof...(args) > 0) {
-                sink.put(" ");
-                sink.begin();
-                (xo::pp::pretty(sink, args), ...);
-                sink.end();
-            }
-            sink.complete();
+            banner_info banner{now_ns(), st.nesting_level(), false /*entry_flag*/,
+                               style_, name_, name2_, file_, line_};
+
+            if (use_deferred(st))
+                post_banner(banner, args...);
+            else
+                render_banner(st.sink(), banner, args...);
         }
 
         /** re-enable a disabled scope and emit its (deferred) entry banner
@@ -266,41 +282,205 @@ namespace xo::pp {
                 return;
 
             xo::pp::LogState & st = xo::pp::ThreadLogState::thread_log_state();
-            xo::pp::PpSink & sink = st.sink();
 
-            emit_time(sink, true /*real_time*/);
-            emit_indent(st);
-            sink.put("+");
-            emit_nesting_level(sink, st.nesting_level());
+            banner_info banner{now_ns(), st.nesting_level(), true /*entry_flag*/,
+                               style_, name_, name2_, file_, line_};
+
+            if (use_deferred(st))
+                post_banner(banner, args...);
+            else
+                render_banner(st.sink(), banner, args...);
+
+            st.incr_nesting();
+        }
+
+        /** everything in a +/- banner line except its arguments **/
+        template <typename Str>
+        struct banner_info_impl {
+            /** time of entry/exit, nanoseconds since epoch (0 if timestamps disabled) **/
+            std::int64_t tm_ns_ = 0;
+            /** nesting level to indent to **/
+            std::uint32_t nesting_ = 0;
+            /** true for entry banner "+name", false for exit banner "-name" **/
+            bool entry_flag_ = false;
+            xo::FunctionStyle style_ = xo::FunctionStyle::literal;
+            Str name_ = {};
+            Str name2_ = {};
+            Str file_ = {};
+            std::uint32_t line_ = 0;
+        };
+
+        using banner_info = banner_info_impl<std::string_view>;
+
+        /** deferred banner record: banner with strings copied into the record,
+         *  followed by stored images of the banner arguments
+         **/
+        template <typename... Stored>
+        struct deferred_banner {
+            banner_info_impl<deferred_str> banner_;
+            std::tuple<Stored...> arg_v_;
+        };
+
+        /** deferred log() record **/
+        template <typename... Stored>
+        struct deferred_line {
+            std::uint32_t nesting_ = 0;
+            std::tuple<Stored...> arg_v_;
+        };
+
+        /** true to hand output to DeferredLog instead of rendering here **/
+        static bool use_deferred(xo::pp::LogState & st) {
+            return DeferredLog::enabled() && st.uses_default_sink();
+        }
+
+        /** write a +/- banner line for @p banner,  with @p args, on @p sink **/
+        template <typename... Ts>
+        static void render_banner(xo::pp::PpSink & sink,
+                                  const banner_info & banner,
+                                  const Ts &... args) {
+            emit_time(sink, true /*real_time*/, banner.tm_ns_);
+            emit_indent(sink, banner.nesting_);
+            sink.put(banner.entry_flag_ ? "+" : "-");
+            emit_nesting_level(sink, banner.nesting_);
             {
-                color_guard g(sink, scope_config::function_entry_color);
-                put_function_name(sink, style_, name_);
+                color_guard g(sink, (banner.entry_flag_
+                                     ? scope_config::function_entry_color
+                                     : scope_config::function_exit_color));
+                put_function_name(sink, banner.style_, banner.name_);
             }
             /* outside the color guard: name2 is verbatim, matching legacy
              * (function_name(style, color, name1) << name2)
              */
-            if (!name2_.empty())
-                sink.put(name2_);
+            if (!banner.name2_.empty())
+                sink.put(banner.name2_);
             if constexpr (sizeof...(args) > 0) {
                 sink.put(" ");
                 sink.begin();
                 (xo::pp::pretty(sink, args), ...);
                 sink.end();
             }
-            emit_location(sink, file_, line_);
+            if (banner.entry_flag_)
+                emit_location(sink, banner.file_, banner.line_);
             sink.complete();
+        }
 
-            st.incr_nesting();
+        /** write a mid-scope log() line with @p args on @p sink **/
+        template <typename... Ts>
+        static void render_line(xo::pp::PpSink & sink,
+                                std::uint32_t nesting,
+                                const Ts &... args) {
+            emit_time(sink, false /*real_time: log() lines get a blank time pad*/, 0);
+            emit_indent(sink, nesting);
+            sink.begin();
+            (xo::pp::pretty(sink, args), ...);
+            sink.end();
+            sink.complete();
+        }
+
+        /** append banner record to the calling thread's DeferredLog ring.
+         *  arguments that can't be copied safely (see DeferredArg) are
+         *  rendered to text here,  and the text deferred instead
+         **/
+        template <typename... Ts>
+        static void post_banner(const banner_info & banner, const Ts &... args) {
+            if constexpr (deferrable_v<Ts...>) {
+                using Payload = deferred_banner<typename deferred_arg_t<Ts>::stored_type...>;
+
+                std::size_t extra_z = (banner.name_.size() + banner.name2_.size() + banner.file_.size()
+                                       + (std::size_t(0) + ... + deferred_arg_t<Ts>::extra_z(args)));
+
+                DeferredLog::post<Payload>
+                    (&render_deferred_banner<std::decay_t<const Ts>...>,
+                     extra_z,
+                     [&](void * addr, DeferredWriter & w) {
+                         banner_info_impl<deferred_str> b{banner.tm_ns_, banner.nesting_,
+                                                          banner.entry_flag_, banner.style_,
+                                                          w.put(banner.name_), w.put(banner.name2_),
+                                                          w.put(banner.file_), banner.line_};
+
+                         new (addr) Payload{b, {deferred_arg_t<Ts>::store(args, w)...}};
+                     });
+            } else {
+                PpSink & pre = DeferredLog::prerender_sink();
+
+                (xo::pp::pretty(pre, args), ...);
+
+                post_banner(banner, DeferredLog::prerender_text());
+            }
+        }
+
+        /** append log() record to the calling thread's DeferredLog ring;  see post_banner() **/
+        template <typename... Ts>
+        static void post_line(std::uint32_t nesting, const Ts &... args) {
+            if constexpr (deferrable_v<Ts...>) {
+                using Payload = deferred_line<typename deferred_arg_t<Ts>::stored_type...>;
+
+                std::size_t extra_z = (std::size_t(0) + ... + deferred_arg_t<Ts>::extra_z(args));
+
+                DeferredLog::post<Payload>
+                    (&render_deferred_line<std::decay_t<const Ts>...>,
+                     extra_z,
+                     [&](void * addr, DeferredWriter & w) {
+                         new (addr) Payload{nesting, {deferred_arg_t<Ts>::store(args, w)...}};
+                     });
+            } else {
+                PpSink & pre = DeferredLog::prerender_sink();
+
+                (xo::pp::pretty(pre, args), ...);
+
+                post_line(nesting, DeferredLog::prerender_text());
+            }
         }
 
-        /** write (nesting_level * indent_width, capped) spaces to the active sink **/
-        static void emit_indent(xo::pp::LogState & st);
+        /** decode + render a record written by post_banner();  DeferredLog background thread **/
+        template <typename... Ts>
+        static void render_deferred_banner(xo::pp::PpSink & sink, LogRecord const * rec) {
+            using Payload = deferred_banner<typename DeferredArg<Ts>::stored_type...>;
+
+            Payload const * p = rec->payload<Payload>();
+            char const * base = rec->base();
+
+            auto restore = [base](deferred_str x) { return std::string_view(base + x.off_, x.len_); };
+
+            banner_info banner{p->banner_.tm_ns_, p->banner_.nesting_,
+                               p->banner_.entry_flag_, p->banner_.style_,
+                               restore(p->banner_.name_), restore(p->banner_.name2_),
+                               restore(p->banner_.file_), p->banner_.line_};
+
+            std::apply([&](const auto &... stored) {
+                           render_banner(sink, banner, DeferredArg<Ts>::restore(stored, base)...);
+                       },
+                       p->arg_v_);
+        }
+
+        /** decode + render a record written by post_line();  DeferredLog background thread **/
+        template <typename... Ts>
+        static void render_deferred_line(xo::pp::PpSink & sink, LogRecord const * rec) {
+            using Payload = deferred_line<typename DeferredArg<Ts>::stored_type...>;
+
+            Payload const * p = rec->payload<Payload>();
+            char const * base = rec->base();
+
+            std::apply([&](const auto &... stored) {
+                           render_line(sink, p->nesting_, DeferredArg<Ts>::restore(stored, base)...);
+                       },
+                       p->arg_v_);
+        }
+
+        /** current time for a banner,  nanoseconds since epoch;
+         *  0 when timestamps are disabled (skips the clock read)
+         **/
+        static std::int64_t now_ns();
+
+        /** write (nesting * indent_width, capped) spaces to @p sink **/
+        static void emit_indent(xo::pp::PpSink & sink, std::uint32_t nesting);
 
         /** if timestamps are enabled, write the leftmost time field to @p sink:
-         *  the real UTC time when @p real_time, else a same-width blank pad
-         *  (so mid-scope log() lines align under the timestamped banner)
+         *  time @p tm_ns (nanoseconds since epoch) when @p real_time, else a
+         *  same-width blank pad (so mid-scope log() lines align under the
+         *  timestamped banner)
          **/
-        static void emit_time(xo::pp::PpSink & sink, bool real_time);
+        static void emit_time(xo::pp::PpSink & sink, bool real_time, std::int64_t tm_ns);
 
         /** if nesting_level_enabled, write "(N) " (N = @p level, colored) to
          *  @p sink -- the depth display shown after the +/- banner marker
@@ -21,16 +21,37 @@
 
 # include "scope.hpp"
 
+/** build-time minimum log level: a scope entered below this level is
+ *  compiled out (see scope_setup_off), whatever scope_config::min_log_level
+ *  says at runtime.  Spelled as a log_level enumerator, e.g.
+ *  -DXO_PPSINK_MIN_LOG_LEVEL=info.  Default @c never keeps every scope.
+ *
+ *  Set per module from cmake with -D<module>_MIN_LOG_LEVEL=..
+ *  (or -DXO_MIN_LOG_LEVEL=.. for all modules);  see xo_min_log_level_option()
+ *  in xo-cmake.
+ *
+ *  For this purpose the debug-flag forms XO_DEBUG_ / XO_DEBUG2_ count as
+ *  @c verbose:  at runtime they still log at @c always when their flag holds.
+ **/
+#ifndef XO_PPSINK_MIN_LOG_LEVEL
+# define XO_PPSINK_MIN_LOG_LEVEL never
+#endif
+
+/** true iff scopes at level @p lvl survive XO_PPSINK_MIN_LOG_LEVEL **/
+#define XO_PPSINK_LEVEL_COMPILED_(lvl) \
+    (xo::pp::log_level::lvl >= xo::pp::log_level::XO_PPSINK_MIN_LOG_LEVEL)
+
 /** capture a scope_setup for the enclosing function, at log level @p lvl.
  *  Uses __PRETTY_FUNCTION__ + the configured scope_config::function_style, so
  *  a class method banners as "Class::method" (streamlined, the default).
  **/
 #define XO_ENTER0_(lvl) \
-    xo::pp::scope_setup{ __PRETTY_FUNCTION__, \
-                         xo::pp::log_level::lvl, \
-                         xo::pp::scope_config::function_style, \
-                         __FILE__, \
-                         __LINE__ }
+    xo::pp::scope_setup_if<XO_PPSINK_LEVEL_COMPILED_(lvl)>( \
+        xo::pp::scope_setup{ __PRETTY_FUNCTION__, \
+                             xo::pp::log_level::lvl, \
+                             xo::pp::scope_config::function_style, \
+                             __FILE__, \
+                             __LINE__ })
 
 /** declare an RAII scope logger @p varname for the enclosing function **/
 #define XO_SCOPE_(varname, lvl) xo::pp::scope varname(XO_ENTER0_(lvl))
@@ -39,19 +60,25 @@
  *  true (otherwise pinned to log_level::never, i.e. disabled).  Mirrors legacy
  *  XO_ENTER1: the second arg is a runtime enable flag, NOT a banner argument.
  **/
-#define XO_ENTER1_(lvl, flag) \
-    xo::pp::scope_setup{ __PRETTY_FUNCTION__, \
-                         ((flag) ? xo::pp::log_level::lvl \
-                                 : xo::pp::log_level::never), \
-                         xo::pp::scope_config::function_style, \
-                         __FILE__, \
-                         __LINE__ }
+#define XO_ENTER1_(lvl, flag) XO_PPSINK_ENTER1_(lvl, lvl, flag)
+
+/** XO_ENTER1_ at runtime level @p lvl,  compiled out unless @p clvl
+ *  survives XO_PPSINK_MIN_LOG_LEVEL
+ **/
+#define XO_PPSINK_ENTER1_(lvl, clvl, flag) \
+    xo::pp::scope_setup_if<XO_PPSINK_LEVEL_COMPILED_(clvl)>( \
+        xo::pp::scope_setup{ __PRETTY_FUNCTION__, \
+                             ((flag) ? xo::pp::log_level::lvl \
+                                     : xo::pp::log_level::never), \
+                             xo::pp::scope_config::function_style, \
+                             __FILE__, \
+                             __LINE__ })
 
 /** capture a scope_setup enabled iff @p flag is true (at log_level::always).
  *  Use as: xo::pp::scope log(XO_DEBUG_(some_flag));  -- logs only when the
  *  flag holds.  Mirrors legacy XO_DEBUG = XO_ENTER1(always, flag).
  **/
-#define XO_DEBUG_(flag) XO_ENTER1_(always, flag)
+#define XO_DEBUG_(flag) XO_PPSINK_ENTER1_(always, verbose, flag)
 
 /** capture a scope_setup at level @p lvl, enabled only when @p flag is true,
  *  banner-named @p name1 instead of the enclosing function.  Mirrors legacy
@@ -61,18 +88,24 @@
  *  deliberately NOT applied, since an explicit name is not a function
  *  signature and there is nothing to streamline.
  **/
-#define XO_ENTER2_(lvl, flag, name1) \
-    xo::pp::scope_setup{ (name1), \
-                         ((flag) ? xo::pp::log_level::lvl \
-                                 : xo::pp::log_level::never), \
-                         xo::FunctionStyle::literal, \
-                         __FILE__, \
-                         __LINE__ }
+#define XO_ENTER2_(lvl, flag, name1) XO_PPSINK_ENTER2_(lvl, lvl, flag, name1)
+
+/** XO_ENTER2_ at runtime level @p lvl,  compiled out unless @p clvl
+ *  survives XO_PPSINK_MIN_LOG_LEVEL
+ **/
+#define XO_PPSINK_ENTER2_(lvl, clvl, flag, name1) \
+    xo::pp::scope_setup_if<XO_PPSINK_LEVEL_COMPILED_(clvl)>( \
+        xo::pp::scope_setup{ (name1), \
+                             ((flag) ? xo::pp::log_level::lvl \
+                                     : xo::pp::log_level::never), \
+                             xo::FunctionStyle::literal, \
+                             __FILE__, \
+                             __LINE__ })
 
 /** capture a scope_setup enabled iff @p flag is true (at log_level::always),
  *  banner-named @p name1.  Mirrors legacy XO_DEBUG2.
  **/
-#define XO_DEBUG2_(flag, name1) XO_ENTER2_(always, flag, name1)
+#define XO_DEBUG2_(flag, name1) XO_PPSINK_ENTER2_(always, verbose, flag, name1)
 
 /** capture a scope_setup at level @p lvl, bannered from TWO runtime names.
  *  Mirrors legacy XO_LITERAL.
@@ -85,12 +118,13 @@
  *  the banner is assembled from values rather than __PRETTY_FUNCTION__.
  **/
 #define XO_LITERAL_(lvl, name1, name2) \
-    xo::pp::scope_setup{ (name1), \
-                         xo::pp::log_level::lvl, \
-                         xo::FunctionStyle::literal, \
-                         __FILE__, \
-                         __LINE__, \
-                         (name2) }
+    xo::pp::scope_setup_if<XO_PPSINK_LEVEL_COMPILED_(lvl)>( \
+        xo::pp::scope_setup{ (name1), \
+                             xo::pp::log_level::lvl, \
+                             xo::FunctionStyle::literal, \
+                             __FILE__, \
+                             __LINE__, \
+                             (name2) })
 
 
 /** @brief throw std::runtime_error(@p msg) unless @p f holds.
@@ -0,0 +1,347 @@
+/** @file DeferredLog.cpp **/
+
+#include <xo/ppsink/DeferredLog.hpp>
+#include <xo/ppsink/FlatSink.hpp>
+#include <algorithm>
+#include <bit>
+#include <chrono>
+#include <iostream>
+#include <mutex>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+namespace xo::pp {
+    // ----- LogRing -----
+
+    LogRing::LogRing(std::uint32_t capacity)
+    {
+        std::uint32_t n = std::bit_ceil(std::max(capacity, 256u));
+
+        this->mask_ = n - 1;
+        this->buf_.reset(new (std::align_val_t(LogRecord::c_align)) char[n]);
+    }
+
+    LogRing::~LogRing()
+    {
+        /* allocated with aligned new[] */
+        ::operator delete[](this->buf_.release(), std::align_val_t(LogRecord::c_align));
+    }
+
+    LogRecord *
+    LogRing::reserve(std::uint32_t z)
+    {
+        /* announce reservation before checking .closed_flag;  close() does the
+         * reverse.  seq_cst on both sides,  so either we see the ring closed,
+         * or close() sees us busy and waits for commit()
+         */
+        this->busy_flag_.store(true, std::memory_order_seq_cst);
+
+        if (this->closed_flag_.load(std::memory_order_seq_cst)) {
+            this->busy_flag_.store(false, std::memory_order_release);
+            return nullptr;
+        }
+
+        std::uint64_t tail = this->tail_.load(std::memory_order_relaxed);
+        std::uint64_t head = this->head_.load(std::memory_order_acquire);
+
+        std::uint32_t pos = tail & this->mask_;
+        std::uint32_t contig = this->capacity() - pos;
+
+        /* record doesn't fit before end of ring -> pad to end, start at 0 */
+        std::uint32_t pad = (z > contig) ? contig : 0;
+
+        if ((tail + pad + z) - head > this->capacity()) {
+            this->busy_flag_.store(false, std::memory_order_release);
+            return nullptr;
+        }
+
+        if (pad) {
+            LogRecord * p = this->at(tail);
+
+            p->render_ = nullptr;
+            p->z_ = pad;
+        }
+
+        this->reserve_z_ = pad + z;
+
+        return this->at(tail + pad);
+    }
+
+    void
+    LogRing::close()
+    {
+        this->closed_flag_.store(true, std::memory_order_seq_cst);
+
+        /* producer is between reserve() and commit():  only copying bytes,  so brief */
+        while (this->busy_flag_.load(std::memory_order_seq_cst))
+            std::this_thread::yield();
+    }
+
+    std::uint64_t
+    LogRing::drain(PpSink & sink)
+    {
+        std::uint64_t head = this->head_.load(std::memory_order_relaxed);
+        std::uint64_t tail = this->tail_.load(std::memory_order_acquire);
+        std::uint64_t n = 0;
+
+        while (head != tail) {
+            LogRecord const * rec = this->at(head);
+
+            if (rec->render_) {
+                rec->render_(sink, rec);
+                ++n;
+            }
+
+            head += rec->z_;
+
+            /* release space to producer as we go */
+            this->head_.store(head, std::memory_order_release);
+        }
+
+        return n;
+    }
+
+    // ----- DeferredLog -----
+
+    namespace {
+        /** state shared between logging threads and the background thread **/
+        struct DeferredLogState {
+            /** protects .ring_v, .thread, .sink, .ring_z **/
+            std::mutex mutex_;
+            /** rings for all threads that have posted (or are posting) deferred records **/
+            std::vector<std::shared_ptr<LogRing>> ring_v_;
+            /** ring size for newly-created rings **/
+            std::uint32_t ring_z_ = DeferredLog::c_default_ring_z;
+            /** background thread rendering records **/
+            std::thread thread_;
+            /** tells background thread to exit **/
+            std::atomic<bool> stop_flag_ = false;
+            /** background thread renders here **/
+            PpSink * sink_ = nullptr;
+            /** sink used when start() not given one **/
+            std::unique_ptr<FlatSink> default_sink_;
+            /** #of records dropped (ring full) **/
+            std::atomic<std::uint64_t> n_dropped_ = 0;
+        };
+
+        DeferredLogState &
+        deferred_state() {
+            /* leaked on purpose: threads may still log during static destruction */
+            static DeferredLogState * s_state = new DeferredLogState();
+
+            return *s_state;
+        }
+
+        /** render everything currently in every ring;  drop drained rings of exited threads.
+         *  background thread only (or stop(), once background thread joined).
+         **/
+        std::uint64_t
+        drain_all(DeferredLogState & st)
+        {
+            std::vector<std::shared_ptr<LogRing>> ring_v;
+
+            {
+                std::lock_guard<std::mutex> lock(st.mutex_);
+
+                std::erase_if(st.ring_v_,
+                              [](auto const & ring) {
+                                  return (ring->is_retired()
+                                          && (ring->head_pos() == ring->tail_pos()));
+                              });
+
+                ring_v = st.ring_v_;
+            }
+
+            std::uint64_t n = 0;
+
+            for (auto const & ring : ring_v)
+                n += ring->drain(*st.sink_);
+
+            return n;
+        }
+
+        void
+        background_main(DeferredLogState * p_st)
+        {
+            while (!p_st->stop_flag_.load(std::memory_order_acquire)) {
+                if (drain_all(*p_st) == 0)
+                    std::this_thread::sleep_for(std::chrono::microseconds(500));
+            }
+
+            /* final pass: records posted before stop() */
+            drain_all(*p_st);
+        }
+
+        /** owns calling thread's ring;  retires it when thread exits **/
+        struct ThreadRingHandle {
+            ~ThreadRingHandle() {
+                if (ring_)
+                    ring_->retire();
+            }
+
+            std::shared_ptr<LogRing> ring_;
+        };
+
+        /** text buffer + sink for DeferredLog::prerender_sink() **/
+        struct PrerenderState {
+            PrerenderState() : sink_(sbuf_.rdbuf()) {}
+
+            std::stringstream sbuf_;
+            FlatSink sink_;
+        };
+
+        PrerenderState &
+        prerender_state() {
+            static thread_local PrerenderState s_state;
+
+            return s_state;
+        }
+    } /*namespace*/
+
+    void
+    DeferredLog::start(PpSink * sink, std::uint32_t ring_z)
+    {
+        DeferredLogState & st = deferred_state();
+
+        std::lock_guard<std::mutex> lock(st.mutex_);
+
+        if (st.thread_.joinable())
+            return;
+
+        if (!sink) {
+            if (!st.default_sink_)
+                st.default_sink_.reset(new FlatSink(std::clog.rdbuf()));
+
+            sink = st.default_sink_.get();
+        }
+
+        /* rings of live threads closed by previous stop() */
+        for (auto const & ring : st.ring_v_)
+            ring->reopen();
+
+        st.sink_ = sink;
+        st.ring_z_ = ring_z;
+        st.stop_flag_.store(false, std::memory_order_release);
+        st.thread_ = std::thread(background_main, &st);
+
+        s_enabled_flag.store(true, std::memory_order_release);
+    }
+
+    void
+    DeferredLog::stop()
+    {
+        DeferredLogState & st = deferred_state();
+
+        std::thread thread;
+
+        {
+            std::lock_guard<std::mutex> lock(st.mutex_);
+
+            if (!st.thread_.joinable())
+                return;
+
+            s_enabled_flag.store(false, std::memory_order_release);
+            st.stop_flag_.store(true, std::memory_order_release);
+
+            thread = std::move(st.thread_);
+        }
+
+        /* background thread takes .mutex while draining */
+        thread.join();
+
+        /* a thread that saw .enabled just before we cleared it may have posted
+         * a record after the background thread's final pass,  or may still be
+         * writing one.  Close every ring (waits for any such record to commit;
+         * later posts are refused and counted as dropped),  then render
+         * what's left.  Rings created from here on start closed,  see thread_ring()
+         */
+        std::vector<std::shared_ptr<LogRing>> ring_v;
+
+        {
+            std::lock_guard<std::mutex> lock(st.mutex_);
+
+            ring_v = st.ring_v_;
+        }
+
+        for (auto const & ring : ring_v)
+            ring->close();
+
+        drain_all(st);
+    }
+
+    void
+    DeferredLog::flush()
+    {
+        DeferredLogState & st = deferred_state();
+
+        std::vector<std::pair<std::shared_ptr<LogRing>, std::uint64_t>> target_v;
+
+        {
+            std::lock_guard<std::mutex> lock(st.mutex_);
+
+            if (!st.thread_.joinable())
+                return;
+
+            for (auto const & ring : st.ring_v_)
+                target_v.emplace_back(ring, ring->tail_pos());
+        }
+
+        for (auto const & [ring, tail] : target_v) {
+            while (ring->head_pos() < tail)
+                std::this_thread::sleep_for(std::chrono::microseconds(100));
+        }
+    }
+
+    std::uint64_t
+    DeferredLog::n_dropped()
+    {
+        return deferred_state().n_dropped_.load(std::memory_order_relaxed);
+    }
+
+    void
+    DeferredLog::note_dropped()
+    {
+        deferred_state().n_dropped_.fetch_add(1, std::memory_order_relaxed);
+    }
+
+    LogRing *
+    DeferredLog::thread_ring()
+    {
+        static thread_local ThreadRingHandle s_handle;
+
+        if (!s_handle.ring_) {
+            DeferredLogState & st = deferred_state();
+
+            std::lock_guard<std::mutex> lock(st.mutex_);
+
+            s_handle.ring_ = std::make_shared<LogRing>(st.ring_z_);
+
+            /* stop() in progress (or done):  too late to post */
+            if (!st.thread_.joinable())
+                s_handle.ring_->close();
+
+            st.ring_v_.push_back(s_handle.ring_);
+        }
+
+        return s_handle.ring_.get();
+    }
+
+    PpSink &
+    DeferredLog::prerender_sink()
+    {
+        PrerenderState & st = prerender_state();
+
+        st.sbuf_.str(std::string());
+
+        return st.sink_;
+    }
+
+    std::string_view
+    DeferredLog::prerender_text()
+    {
+        return prerender_state().sbuf_.view();
+    }
+} /*namespace xo::pp*/
+
+/* end DeferredLog.cpp */
@@ -5,17 +5,25 @@
 #include <string>
 
 namespace xo::pp {
+    std::int64_t
+    scope::now_ns() {
+        if (!scope_config::time_enabled)
+            return 0;
+
+        return xo::time::timeutil::now().time_since_epoch().count();
+    }
+
     void
-    scope::emit_indent(xo::pp::LogState & st) {
-        std::uint32_t n = st.nesting_level() * scope_config::indent_width;
+    scope::emit_indent(xo::pp::PpSink & sink, std::uint32_t nesting) {
+        std::uint32_t n = nesting * scope_config::indent_width;
         if (n > scope_config::max_indent_width)
             n = scope_config::max_indent_width;   /* cap deep nesting */
         std::string pad(n, ' ');
-        st.sink().put(pad);
+        sink.put(pad);
     }
 
     void
-    scope::emit_time(xo::pp::PpSink & sink, bool real_time) {
+    scope::emit_time(xo::pp::PpSink & sink, bool real_time, std::int64_t tm_ns) {
         if (!scope_config::time_enabled)
             return;
 
@@ -23,7 +31,7 @@ namespace xo::pp {
         std::uint32_t width = (scope_config::time_usec_flag ? 16 : 13);
 
         if (real_time) {
-            xo::time::utc_nanos now = xo::time::timeutil::now();
+            xo::time::utc_nanos now{xo::time::nanos(tm_ns)};
 
             /* time-of-day since midnight, in local or UTC coords */
             xo::time::nanos since_midnight =
@@ -0,0 +1,317 @@
+/** @file DeferredLog.test.cpp **/
+
+#include <xo/ppsink/DeferredLog.hpp>
+#include <xo/ppsink/FlatSink.hpp>
+#include <xo/ppsink/scope.hpp>
+#include <xo/ppsink/tag.hpp>
+#include <catch2/catch.hpp>
+#include <algorithm>
+#include <atomic>
+#include <chrono>
+#include <sstream>
+#include <thread>
+#include <vector>
+
+namespace ut {
+    using xo::pp::scope;
+    using xo::pp::scope_config;
+    using xo::pp::DeferredLog;
+    using xo::pp::FlatSink;
+    using xo::pp::LogRing;
+    using xo::pp::ThreadLogState;
+    using xo::pp::xtag;
+    using std::stringstream;
+
+    namespace {
+        /* not deferrable (see DeferredArg): rendered to text on the logging thread */
+        struct Opaque {
+            int x_ = 0;
+        };
+
+        std::ostream &
+        operator<<(std::ostream & os, const Opaque & x) {
+            os << "<Opaque " << x.x_ << ">";
+            return os;
+        }
+
+        /* the same scope tree, logged through the current path */
+        void
+        log_sample() {
+            std::string who = "world";
+
+            scope outer("outer");
+            outer.log("hello ", who);
+            {
+                scope inner("inner");
+                inner.log("n=", 42, xtag("x", 1.5), xtag("who", who));
+                inner.log(Opaque{7});
+                inner.end_scope("<- ", Opaque{8});
+            }
+            outer.log("bye");
+        }
+    }
+
+    TEST_CASE("deferredlog-matches-sync", "[scope][DeferredLog]")
+    {
+        bool saved_time = scope_config::time_enabled;
+        scope_config::time_enabled = false;
+
+        /* reference: synchronous output */
+        stringstream sync_ss;
+        {
+            FlatSink sink(sync_ss.rdbuf());
+
+            ThreadLogState::log_set_sink(&sink);
+            log_sample();
+            ThreadLogState::log_set_sink(nullptr);
+        }
+
+        /* deferred: logging thread on the default sink */
+        stringstream deferred_ss;
+        {
+            FlatSink sink(deferred_ss.rdbuf());
+
+            DeferredLog::start(&sink);
+            REQUIRE(DeferredLog::enabled());
+
+            log_sample();
+
+            DeferredLog::flush();
+            DeferredLog::stop();
+            REQUIRE(!DeferredLog::enabled());
+        }
+
+        scope_config::time_enabled = saved_time;
+
+        REQUIRE(sync_ss.str().find("<Opaque 8>") != std::string::npos);
+        REQUIRE(deferred_ss.str() == sync_ss.str());
+    }
+
+    TEST_CASE("deferredlog-explicit-sink-stays-sync", "[scope][DeferredLog]")
+    {
+        bool saved_time = scope_config::time_enabled;
+        scope_config::time_enabled = false;
+
+        stringstream bg_ss;
+        FlatSink bg_sink(bg_ss.rdbuf());
+
+        DeferredLog::start(&bg_sink);
+
+        /* thread with its own sink: not deferred */
+        stringstream ss;
+        FlatSink sink(ss.rdbuf());
+
+        ThreadLogState::log_set_sink(&sink);
+        { scope s("mine"); }
+        ThreadLogState::log_set_sink(nullptr);
+
+        REQUIRE(ss.str() == "+(0) mine\n-(0) mine\n");
+
+        DeferredLog::stop();
+
+        scope_config::time_enabled = saved_time;
+
+        REQUIRE(bg_ss.str().empty());
+    }
+
+    TEST_CASE("deferredlog-threads", "[scope][DeferredLog]")
+    {
+        bool saved_time = scope_config::time_enabled;
+        scope_config::time_enabled = true;
+
+        constexpr int c_n_thread = 4;
+        constexpr int c_n_line = 2000;
+
+        std::uint64_t dropped0 = DeferredLog::n_dropped();
+
+        stringstream ss;
+        FlatSink sink(ss.rdbuf());
+
+        /* small rings,  so some records may be dropped;  none lost silently */
+        DeferredLog::start(&sink, 4096 /*ring_z*/);
+
+        std::vector<std::thread> thread_v;
+
+        for (int t = 0; t < c_n_thread; ++t) {
+            thread_v.emplace_back([t]() {
+                                      scope log("worker");
+
+                                      for (int i = 0; i < c_n_line; ++i)
+                                          log(xtag("t", t), xtag("i", i));
+                                  });
+        }
+
+        for (auto & th : thread_v)
+            th.join();
+
+        DeferredLog::flush();
+        DeferredLog::stop();
+
+        scope_config::time_enabled = saved_time;
+
+        std::string out = ss.str();
+
+        std::uint64_t n_line = std::count(out.begin(), out.end(), '\n');
+        std::uint64_t n_dropped = DeferredLog::n_dropped() - dropped0;
+
+        /* per thread: entry banner + lines + exit banner */
+        REQUIRE(n_line + n_dropped == c_n_thread * (c_n_line + 2));
+        REQUIRE(out.find(" :t 3 :i ") != std::string::npos);
+    }
+
+    TEST_CASE("deferredlog-stop-renders-pending", "[scope][DeferredLog]")
+    {
+        bool saved_time = scope_config::time_enabled;
+        scope_config::time_enabled = false;
+
+        constexpr int c_n_line = 500;
+
+        std::uint64_t dropped0 = DeferredLog::n_dropped();
+
+        stringstream ss;
+        FlatSink sink(ss.rdbuf());
+
+        DeferredLog::start(&sink);
+
+        {
+            scope log("pending");
+
+            for (int i = 0; i < c_n_line; ++i)
+                log(xtag("i", i));
+        }
+
+        /* no flush(): stop() alone renders everything posted before it */
+        DeferredLog::stop();
+
+        scope_config::time_enabled = saved_time;
+
+        std::string out = ss.str();
+
+        REQUIRE(DeferredLog::n_dropped() == dropped0);
+        REQUIRE(std::count(out.begin(), out.end(), '\n') == c_n_line + 2);
+        REQUIRE(out.find(":i 499") != std::string::npos);
+    }
+
+    TEST_CASE("deferredlog-null-cstr", "[scope][DeferredLog]")
+    {
+        bool saved_time = scope_config::time_enabled;
+        scope_config::time_enabled = false;
+
+        stringstream ss;
+        FlatSink sink(ss.rdbuf());
+
+        DeferredLog::start(&sink);
+
+        {
+            char const * p = nullptr;
+            char const * q = "text";
+
+            scope log("nulls");
+
+            log("p=", p, xtag("p", p), xtag("q", q));
+        }
+
+        DeferredLog::stop();
+
+        scope_config::time_enabled = saved_time;
+
+        std::string out = ss.str();
+
+        REQUIRE(out.find("p=(null)") != std::string::npos);
+        REQUIRE(out.find(":p (null)") != std::string::npos);
+        REQUIRE(out.find(":q text") != std::string::npos);
+    }
+
+    TEST_CASE("logring-wrap", "[DeferredLog]")
+    {
+        LogRing ring(256);
+
+        REQUIRE(ring.capacity() == 256);
+
+        /* append a record with no renderer;  drain just consumes it */
+        auto put = [&ring](std::uint32_t z) {
+                       auto * rec = ring.reserve(z);
+
+                       if (!rec)
+                           return false;
+
+                       rec->render_ = nullptr;
+                       rec->z_ = z;
+                       ring.commit();
+
+                       return true;
+                   };
+
+        stringstream ss;
+        FlatSink sink(ss.rdbuf());
+
+        /* 96-byte records: 2 fit,  3rd doesn't */
+        REQUIRE(put(96));
+        REQUIRE(put(96));
+        REQUIRE(!put(96));
+        REQUIRE(put(16));
+
+        REQUIRE(ring.drain(sink) == 0);
+        REQUIRE(ring.head_pos() == ring.tail_pos());
+        REQUIRE(ring.tail_pos() == 208);
+
+        /* 48 bytes left before end of ring:  pad 48,  wrap to 0 */
+        REQUIRE(put(96));
+        REQUIRE(ring.tail_pos() == 256 + 96);
+
+        REQUIRE(ring.drain(sink) == 0);
+        REQUIRE(ring.head_pos() == 256 + 96);
+        REQUIRE(ss.str().empty());
+    }
+
+    TEST_CASE("logring-close", "[DeferredLog]")
+    {
+        LogRing ring(256);
+
+        /* reservation in flight when close() starts */
+        auto * rec = ring.reserve(32);
+
+        REQUIRE(rec);
+
+        std::atomic<bool> closed_flag = false;
+
+        std::thread closer([&ring, &closed_flag]() {
+                               ring.close();
+                               closed_flag.store(true);
+                           });
+
+        /* close() waits for commit() */
+        std::this_thread::sleep_for(std::chrono::milliseconds(20));
+        REQUIRE(!closed_flag.load());
+
+        rec->render_ = nullptr;
+        rec->z_ = 32;
+        ring.commit();
+
+        closer.join();
+
+        REQUIRE(closed_flag.load());
+        REQUIRE(ring.tail_pos() == 32);
+
+        /* closed: reserve refused,  ring unchanged */
+        REQUIRE(ring.reserve(32) == nullptr);
+        REQUIRE(ring.tail_pos() == 32);
+
+        /* close() on idle ring doesn't wait */
+        ring.close();
+
+        ring.reopen();
+
+        rec = ring.reserve(32);
+
+        REQUIRE(rec);
+
+        rec->render_ = nullptr;
+        rec->z_ = 32;
+        ring.commit();
+
+        REQUIRE(ring.tail_pos() == 64);
+    }
+}
+
+/* end DeferredLog.test.cpp */
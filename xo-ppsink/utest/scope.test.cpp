@@ -186,6 +186,48 @@ namespace ut {
         REQUIRE(off.empty());                              /* flag=false => never => silent */
     }
 
+    /* build-time gate: XO_PPSINK_MIN_LOG_LEVEL defaults to 'never', so every
+     * level survives;  a setup below it becomes scope_setup_off
+     */
+    static_assert(XO_PPSINK_LEVEL_COMPILED_(never));
+    static_assert(XO_PPSINK_LEVEL_COMPILED_(verbose));
+    static_assert(std::is_same_v<decltype(XO_DEBUG_(true)), xo::pp::scope_setup>);
+    static_assert(std::is_same_v<decltype(xo::pp::scope_setup_if<false>(xo::pp::scope_setup{})),
+                                 xo::pp::scope_setup_off>);
+
+    TEST_CASE("scope-compiled-out", "[scope]") {
+        /* a compiled-out scope is silent even at 'always',  but can still be
+         * retroactively enabled (error path) and keeps its banner name
+         */
+        bool saved_time = scope_config::time_enabled;
+        scope_config::time_enabled = false;   /* deterministic output */
+
+        stringstream ss;
+        FlatSink sink(ss.rdbuf());
+        ThreadLogState::log_set_sink(&sink);
+
+        std::string before;
+        {
+            scope log(xo::pp::scope_setup_if<false>(
+                          xo::pp::scope_setup{"gated", xo::pp::log_level::always}),
+                      "ctor-args");
+
+            REQUIRE(!log);
+            log && log("unseen");
+            before = ss.str();
+
+            log.retroactively_enable("late");
+        }
+
+        scope_config::time_enabled = saved_time;   /* reset BEFORE asserting */
+        ThreadLogState::log_set_sink(nullptr);
+
+        REQUIRE(before.empty());
+        REQUIRE(ss.str() ==
+                "+(0) gated late\n"
+                "-(0) gated\n");
+    }
+
     /* XO_LITERAL_ banners from two runtime names, mirroring legacy XO_LITERAL:
      * name1 is styled/colored, name2 appended verbatim with no separator (so
      * the caller supplies its own "::"), e.g. self_type + "::ctor".
@@ -0,0 +1,128 @@
+/* @file ex1.cpp
+ *
+ * benchmark: PrintJson struct printing throughput (structs/sec)
+ *
+ *   reflective: walk each struct through TaggedPtr/TypeDescr,
+ *               JsonPrinter lookup + virtual call per member
+ *   vs.
+ *   compiled:   JsonStructEncoder op list built on first encounter;
+ *               members formatted from storage with std::to_chars
+ *
+ * use:
+ *   $ printjson_ex1 [n]
+ */
+
+#include "xo/printjson/PrintJson.hpp"
+#include "xo/printjson/init_printjson.hpp"
+#include <xo/reflect/Reflect.hpp>
+#include <xo/reflect/StructReflector.hpp>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <sstream>
+
+namespace {
+    using xo::json::PrintJson;
+    using xo::reflect::Reflect;
+    using xo::reflect::StructReflector;
+    using xo::reflect::TaggedPtr;
+
+    /* sample event,  similar in shape to a market-data update */
+    struct BenchEvent {
+        std::int64_t tm_;
+        std::uint32_t seq_;
+        double bid_px_;
+        double ask_px_;
+        std::int32_t bid_sz_;
+        std::int32_t ask_sz_;
+        bool is_firm_;
+        std::string symbol_;
+    };
+
+    void
+    reflect_bench_event()
+    {
+        StructReflector<BenchEvent> sr;
+
+        if (sr.is_incomplete()) {
+            REFLECT_MEMBER(sr, tm);
+            REFLECT_MEMBER(sr, seq);
+            REFLECT_MEMBER(sr, bid_px);
+            REFLECT_MEMBER(sr, ask_px);
+            REFLECT_MEMBER(sr, bid_sz);
+            REFLECT_MEMBER(sr, ask_sz);
+            REFLECT_MEMBER(sr, is_firm);
+            REFLECT_MEMBER(sr, symbol);
+        }
+
+        sr.require_complete();
+    } /*reflect_bench_event*/
+
+    /* print n events with pjson;  report throughput */
+    void
+    bench(char const * label, PrintJson const & pjson, std::size_t n)
+    {
+        BenchEvent ev{1700000000000000, 0, 100.25, 100.50, 300, 200, true, "XYZ"};
+        TaggedPtr ev_tp = Reflect::make_tp(&ev);
+
+        std::stringstream ss;
+        std::size_t n_byte = 0;
+
+        auto t0 = std::chrono::steady_clock::now();
+
+        for (std::size_t i = 0; i < n; ++i) {
+            ev.seq_ = i;
+            ev.bid_px_ = 100.0 + 0.01 * (i % 1000);
+
+            /* reuse stream storage */
+            ss.seekp(0);
+
+            pjson.print_tp(ev_tp, &ss);
+
+            n_byte += ss.tellp();
+        }
+
+        auto t1 = std::chrono::steady_clock::now();
+
+        double dt = std::chrono::duration<double>(t1 - t0).count();
+
+        std::cout << label << ": " << (n / dt) * 1e-6 << " M structs/sec"
+                  << "  " << (n_byte / dt) * 1e-6 << " MB/sec" << std::endl;
+    } /*bench*/
+}
+
+int
+main(int argc, char ** argv)
+{
+    using namespace xo;
+
+    std::size_t n = 1000000;
+
+    if (argc > 1)
+        n = std::strtoull(argv[1], nullptr, 10);
+
+    InitSubsys<S_printjson_tag>::require();
+    Subsystem::initialize_all();
+
+    reflect_bench_event();
+
+    PrintJson pjson;
+
+    pjson.set_struct_encoder_flag(false);
+    bench("reflective", pjson, n);
+
+    pjson.set_struct_encoder_flag(true);
+    bench("compiled  ", pjson, n);
+
+    {
+        BenchEvent ev{1700000000000000, 1, 100.25, 100.50, 300, 200, true, "XYZ"};
+
+        std::cout << "sample: ";
+        pjson.print(ev, &std::cout);
+        std::cout << std::endl;
+    }
+
+    return 0;
+}
+
+/* end ex1.cpp */
@@ -10,11 +10,34 @@
 #include <xo/reflect/TypeDrivenMap.hpp>
 // #include <memory>
 #include <iostream>
+#include <cstdint>
 
 namespace xo {
     namespace json {
         class PrintJson;
 
+        /* how a compiled struct encoder (see JsonStructEncoder.hpp) may print
+         * a member whose type is handled by a particular JsonPrinter.
+         *
+         * jek_printer: no shortcut;  call JsonPrinter::print_json() on the member.
+         * other values: printer's output is known to match a built-in fast path,
+         *               applied directly to the member's storage.
+         */
+        enum class JsonEncodeKind : std::uint8_t {
+            jek_printer,
+            jek_bool,
+            jek_i16,
+            jek_u16,
+            jek_i32,
+            jek_u32,
+            jek_i64,
+            jek_u64,
+            jek_f32,
+            jek_f64,
+            jek_string,
+            jek_string_view,
+        };
+
         class JsonPrinter {
         public:
             using Reflect = xo::reflect::Reflect;
@@ -32,6 +55,11 @@ namespace xo {
             virtual void print_json(TaggedPtr tp,
                                     std::ostream * p_os) const = 0;
 
+            /* fast path compiled struct encoders may substitute for .print_json();
+             * printers that override this must produce identical output
+             */
+            virtual JsonEncodeKind encode_kind() const { return JsonEncodeKind::jek_printer; }
+
             void report_internal_type_consistency_error(TypeDescr td1,
                                                         TypeDescr td2,
                                                         std::ostream * p_os) const;
@@ -0,0 +1,119 @@
+/* @file JsonStructEncoder.hpp
+ *
+ * author: Roland Conybeare, Oct 2026
+ */
+
+#pragma once
+
+#include "JsonPrinter.hpp"
+#include <xo/reflect/TypeDescr.hpp>
+#include <xo/reflect/struct/StructMember.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <iostream>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace xo {
+    namespace json {
+        class PrintJson;
+
+        /* compiled json encoder for one reflected struct type.
+         *
+         * Without one,  PrintJson prints a struct by walking it through reflection:
+         * for each member,  build a TaggedPtr,  look up a JsonPrinter by TypeId,
+         * and dispatch through JsonPrinter::print_json().
+         *
+         * A JsonStructEncoder does that walk once,  the first time a struct type
+         * is printed,  and records a flat list of ops:
+         *   (key literal, member offset, encode kind).
+         * Subsequent instances are printed by running the op list,  formatting
+         * common member types (bool, integers, floating-point, strings) straight
+         * from member storage using std::to_chars,  into a local buffer that's
+         * written to the destination stream once per struct.
+         * Other members (e.g. nested structs, vectors, types with application-
+         * provided printers) go through PrintJson as before.
+         *
+         * Output is identical to the reflective printer.
+         *
+         * Member offsets are sampled from the first instance seen,
+         * so members must sit at a fixed offset from the start of the struct
+         * (i.e. not reached through a virtual base class).
+         *
+         * Compiled encoders are owned and cached by PrintJson;
+         * see PrintJson::require_struct_encoder()
+         */
+        class JsonStructEncoder {
+        public:
+            using TaggedPtr = xo::reflect::TaggedPtr;
+            using TypeDescr = xo::reflect::TypeDescr;
+            using StructMember = xo::reflect::StructMember;
+
+            /* one struct member */
+            struct FieldOp {
+                /* literal text preceding this member's value,  e.g.
+                 *   , "foo":
+                 */
+                std::string prefix_;
+                /* offset of member from start of struct */
+                std::ptrdiff_t offset_ = 0;
+                /* fast path for this member.
+                 * jek_printer -> print member through PrintJson::print_aux()
+                 */
+                JsonEncodeKind kind_ = JsonEncodeKind::jek_printer;
+                /* reflected member,  owned by struct's TypeDescr */
+                StructMember const * member_ = nullptr;
+            }; /*FieldOp*/
+
+        public:
+            /* compile encoder for struct type tp.td(),
+             * sampling member offsets from tp.address().
+             *
+             * require:
+             * - tp.td()->is_struct()
+             * - tp.td()->complete_flag()
+             */
+            static std::unique_ptr<JsonStructEncoder> compile(PrintJson const & pjson,
+                                                              TaggedPtr tp);
+
+            /* true if formatting state of os matches what encoder's fast paths produce;
+             * i.e. os << x would print decimal integers and %g-style floating-point
+             */
+            static bool is_plain_format(std::ostream const & os);
+
+            TypeDescr struct_td() const { return struct_td_; }
+            std::vector<FieldOp> const & op_v() const { return op_v_; }
+
+            /* #of members handled by a fast path (i.e. not jek_printer) */
+            std::uint32_t n_fast_op() const;
+
+            /* print struct at address obj on *p_os,  in json format.
+             *
+             * require:
+             * - obj refers to an instance of .struct_td
+             * - is_plain_format(*p_os)
+             */
+            void encode(PrintJson const & pjson,
+                        void * obj,
+                        std::ostream * p_os) const;
+
+        private:
+            JsonStructEncoder(TypeDescr struct_td,
+                              std::string header,
+                              std::vector<FieldOp> op_v);
+
+        private:
+            /* struct type handled by this encoder */
+            TypeDescr struct_td_ = nullptr;
+            /* literal text preceding first member,  e.g.
+             *   {"_name_": "Foo"
+             */
+            std::string header_;
+            /* one op per reflected member,  in reflection order */
+            std::vector<FieldOp> op_v_;
+        }; /*JsonStructEncoder*/
+    } /*namespace json*/
+} /*namespace xo*/
+
+/* end JsonStructEncoder.hpp */
@@ -6,10 +6,12 @@
 #pragma once
 
 #include "JsonPrinter.hpp"
+#include "JsonStructEncoder.hpp"
 #include <xo/reflect/SelfTagging.hpp>
 #include <xo/reflect/TypeDrivenMap.hpp>
 #include <iostream>
 #include <memory>
+#include <shared_mutex>
 
 namespace xo {
     namespace json {
@@ -17,6 +19,7 @@ namespace xo {
         public:
             using Reflect = xo::reflect::Reflect;
             using TypeDrivenMap = xo::reflect::TypeDrivenMap<std::unique_ptr<JsonPrinter>>;
+            using EncoderMap = xo::reflect::TypeDrivenMap<std::unique_ptr<JsonStructEncoder>>;
             using SelfTagging = xo::reflect::SelfTagging;
             using TaggedPtr = xo::reflect::TaggedPtr;
             using TaggedRcptr = xo::reflect::TaggedRcptr;
@@ -45,15 +48,43 @@ namespace xo {
 
             void provide_printer(TypeId id, std::unique_ptr<JsonPrinter> p) {
                 *(printer_map_.require(id)) = std::move(p);
+
+                /* compiled encoders may have captured previous printer */
+                this->clear_struct_encoders();
             }
 
             void provide_printer(TypeDescr td, std::unique_ptr<JsonPrinter> p) {
                 this->provide_printer(td->id(), std::move(p));
             }
 
+            /* printer for type td,  if any */
+            JsonPrinter const * lookup_printer(TypeDescr td) const {
+                std::unique_ptr<JsonPrinter> const * printer = printer_map_.lookup(td);
+
+                return printer ? printer->get() : nullptr;
+            }
+
             /* write json representation for tp on *p_os */
             void print_aux(TaggedPtr tp, std::ostream * p_os) const;
 
+            /* true (the default) to print reflected structs using compiled encoders;
+             * false to always walk structs through reflection.
+             * Output is the same either way.
+             */
+            bool struct_encoder_flag() const { return struct_encoder_flag_; }
+            void set_struct_encoder_flag(bool x) { struct_encoder_flag_ = x; }
+
+            /* compiled encoder for struct type tp.td();  compile on first use.
+             * null if tp isn't a complete struct type.
+             * see JsonStructEncoder.hpp
+             *
+             * threadsafe
+             */
+            JsonStructEncoder const * require_struct_encoder(TaggedPtr tp) const;
+
+            /* discard compiled struct encoders */
+            void clear_struct_encoders();
+
             // ----- inherited from SelfTagging -----
 
             virtual TaggedRcptr self_tp();
@@ -65,6 +96,14 @@ namespace xo {
         private:
             /* map contains specialized printers for specific c++ types */
             TypeDrivenMap printer_map_;
+            /* see .set_struct_encoder_flag() */
+            bool struct_encoder_flag_ = true;
+            /* protects .encoder_map */
+            mutable std::shared_mutex encoder_mutex_;
+            /* compiled encoders for struct types,  populated on demand
+             * by .require_struct_encoder()
+             */
+            mutable EncoderMap encoder_map_;
         }; /*PrintJson*/
 
         /* Using singleton here to collect type-specific json printers,
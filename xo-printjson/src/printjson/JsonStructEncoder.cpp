@@ -0,0 +1,299 @@
+/* file JsonStructEncoder.cpp
+ *
+ * author: Roland Conybeare, Oct 2026
+ */
+
+#include "JsonStructEncoder.hpp"
+#include "PrintJson.hpp"
+#include <xo/ppsink/escape.hpp>
+#include <xo/ppsink/quoted_ostream.hpp>     /* os << quot(..) */
+#include <charconv>
+#include <cassert>
+#include <cmath>
+#include <cstring>
+#include <string_view>
+
+namespace xo {
+    using xo::reflect::TaggedPtr;
+    using xo::reflect::TypeDescr;
+    using xo::reflect::StructMember;
+
+    namespace json {
+        using xo::pp::Escape;
+        using xo::pp::quot;
+
+        namespace {
+            /* largest stream precision for which floating-point fast path applies;
+             * bounds formatted size of one number
+             */
+            constexpr std::streamsize c_max_fast_precision = 40;
+
+            /* accumulates encoder output,  so destination stream sees one write per struct
+             * (instead of one formatted insertion per key and per value)
+             */
+            class EncodeBuffer {
+            public:
+                static constexpr std::size_t c_buf_z = 512;
+
+            public:
+                explicit EncodeBuffer(std::ostream * p_os) : p_os_{p_os} {}
+
+                /* get space for up to z bytes;  z <= c_buf_z.
+                 * follow with .commit()
+                 */
+                char * reserve(std::size_t z) {
+                    if (this->pos_ + z > c_buf_z)
+                        this->flush();
+
+                    return this->buf_ + this->pos_;
+                } /*reserve*/
+
+                /* end of bytes written into space from .reserve() */
+                void commit(char * end) { this->pos_ = end - this->buf_; }
+
+                char * end_of_buffer() { return this->buf_ + c_buf_z; }
+
+                void put(std::string_view s) {
+                    if (s.size() > c_buf_z / 2) {
+                        this->flush();
+                        this->p_os_->write(s.data(), s.size());
+                    } else {
+                        char * p = this->reserve(s.size());
+
+                        ::memcpy(p, s.data(), s.size());
+                        this->commit(p + s.size());
+                    }
+                } /*put*/
+
+                /* send buffered text to destination stream */
+                void flush() {
+                    if (this->pos_ > 0) {
+                        this->p_os_->write(this->buf_, this->pos_);
+                        this->pos_ = 0;
+                    }
+                } /*flush*/
+
+            private:
+                /* destination stream */
+                std::ostream * p_os_ = nullptr;
+                /* buffered text in [.buf, .buf + .pos) */
+                std::size_t pos_ = 0;
+                char buf_[c_buf_z];
+            }; /*EncodeBuffer*/
+
+            template <typename T>
+            void
+            encode_integer(void * addr, EncodeBuffer * p_buf)
+            {
+                /* 20 digits + sign covers 64-bit integers */
+                char * p = p_buf->reserve(24);
+
+                T x = *reinterpret_cast<T *>(addr);
+
+                p_buf->commit(std::to_chars(p, p_buf->end_of_buffer(), x).ptr);
+            } /*encode_integer*/
+
+            /* same output as JsonPrinter_floatingpoint<T> */
+            template <typename T>
+            void
+            encode_floatingpoint(void * addr,
+                                 std::streamsize precision,
+                                 EncodeBuffer * p_buf)
+            {
+                T x = *reinterpret_cast<T *>(addr);
+
+                if (std::isfinite(x)) {
+                    char * p = p_buf->reserve(c_max_fast_precision + 16);
+
+                    /* os << x uses printf %g conversion with precision os.precision();
+                     * std::to_chars with chars_format::general is specified the same way
+                     */
+                    p_buf->commit(std::to_chars(p,
+                                                p_buf->end_of_buffer(),
+                                                x,
+                                                std::chars_format::general,
+                                                static_cast<int>(precision)).ptr);
+                } else if (std::isnan(x)) {
+                    p_buf->put("NaN");
+                } else if (x > 0.0) {
+                    p_buf->put("Infinity");
+                } else {
+                    p_buf->put("-Infinity");
+                }
+            } /*encode_floatingpoint*/
+
+            /* same output as os << quot(s) */
+            void
+            encode_string(std::string_view s,
+                          EncodeBuffer * p_buf,
+                          std::ostream * p_os)
+            {
+                std::size_t esc_z = Escape::str_size(s).size;
+                std::size_t z = esc_z + Escape::c_quote_expand;
+
+                if (z > EncodeBuffer::c_buf_z) {
+                    p_buf->flush();
+                    *p_os << quot(s);
+                } else {
+                    char * p = p_buf->reserve(z);
+
+                    *p++ = Escape::c_quote;
+                    p = Escape::str_copy(s, p);
+                    *p++ = Escape::c_quote;
+
+                    p_buf->commit(p);
+                }
+            } /*encode_string*/
+        } /*namespace*/
+
+        JsonStructEncoder::JsonStructEncoder(TypeDescr struct_td,
+                                             std::string header,
+                                             std::vector<FieldOp> op_v)
+            : struct_td_{struct_td},
+              header_{std::move(header)},
+              op_v_{std::move(op_v)}
+        {}
+
+        std::unique_ptr<JsonStructEncoder>
+        JsonStructEncoder::compile(PrintJson const & pjson,
+                                   TaggedPtr tp)
+        {
+            TypeDescr td = tp.td();
+
+            assert(td->is_struct());
+            assert(td->complete_flag());
+
+            /* same text as print_generic_struct() in PrintJson.cpp */
+            std::string header;
+            header.append("{\"_name_\": \"");
+            header.append(td->short_name());
+            header.append("\"");
+
+            std::uint32_t n = td->n_child(tp.address());
+
+            std::vector<FieldOp> op_v;
+            op_v.reserve(n);
+
+            for (std::uint32_t i = 0; i < n; ++i) {
+                StructMember const & sm = td->struct_member(i);
+
+                FieldOp op;
+
+                op.prefix_.append(", \"");
+                op.prefix_.append(sm.member_name());
+                op.prefix_.append("\": ");
+
+                op.offset_ = (reinterpret_cast<char *>(sm.get_member_addr(tp.address()))
+                              - reinterpret_cast<char *>(tp.address()));
+                /* fast path only if printer for member type vouches for it */
+                JsonPrinter const * printer = pjson.lookup_printer(sm.get_member_td());
+
+                op.kind_ = (printer
+                            ? printer->encode_kind()
+                            : JsonEncodeKind::jek_printer);
+                op.member_ = &sm;
+
+                op_v.push_back(std::move(op));
+            }
+
+            return std::unique_ptr<JsonStructEncoder>(new JsonStructEncoder(td,
+                                                                            std::move(header),
+                                                                            std::move(op_v)));
+        } /*compile*/
+
+        bool
+        JsonStructEncoder::is_plain_format(std::ostream const & os)
+        {
+            constexpr std::ios_base::fmtflags c_mask = (std::ios_base::basefield
+                                                        | std::ios_base::floatfield
+                                                        | std::ios_base::showbase
+                                                        | std::ios_base::showpoint
+                                                        | std::ios_base::showpos
+                                                        | std::ios_base::uppercase);
+
+            std::ios_base::fmtflags flags = os.flags() & c_mask;
+
+            return (((flags == std::ios_base::fmtflags{}) || (flags == std::ios_base::dec))
+                    && (os.width() == 0)
+                    && (os.precision() <= c_max_fast_precision));
+        } /*is_plain_format*/
+
+        std::uint32_t
+        JsonStructEncoder::n_fast_op() const
+        {
+            std::uint32_t retval = 0;
+
+            for (FieldOp const & op : this->op_v_) {
+                if (op.kind_ != JsonEncodeKind::jek_printer)
+                    ++retval;
+            }
+
+            return retval;
+        } /*n_fast_op*/
+
+        void
+        JsonStructEncoder::encode(PrintJson const & pjson,
+                                  void * obj,
+                                  std::ostream * p_os) const
+        {
+            EncodeBuffer buf(p_os);
+            std::streamsize precision = p_os->precision();
+
+            buf.put(this->header_);
+
+            for (FieldOp const & op : this->op_v_) {
+                buf.put(op.prefix_);
+
+                void * addr = reinterpret_cast<char *>(obj) + op.offset_;
+
+                switch (op.kind_) {
+                case JsonEncodeKind::jek_bool:
+                    /* json boolean format is lower case true/false */
+                    buf.put(*reinterpret_cast<bool *>(addr) ? "true" : "false");
+                    break;
+                case JsonEncodeKind::jek_i16:
+                    encode_integer<std::int16_t>(addr, &buf);
+                    break;
+                case JsonEncodeKind::jek_u16:
+                    encode_integer<std::uint16_t>(addr, &buf);
+                    break;
+                case JsonEncodeKind::jek_i32:
+                    encode_integer<std::int32_t>(addr, &buf);
+                    break;
+                case JsonEncodeKind::jek_u32:
+                    encode_integer<std::uint32_t>(addr, &buf);
+                    break;
+                case JsonEncodeKind::jek_i64:
+                    encode_integer<std::int64_t>(addr, &buf);
+                    break;
+                case JsonEncodeKind::jek_u64:
+                    encode_integer<std::uint64_t>(addr, &buf);
+                    break;
+                case JsonEncodeKind::jek_f32:
+                    encode_floatingpoint<float>(addr, precision, &buf);
+                    break;
+                case JsonEncodeKind::jek_f64:
+                    encode_floatingpoint<double>(addr, precision, &buf);
+                    break;
+                case JsonEncodeKind::jek_string:
+                    encode_string(*reinterpret_cast<std::string *>(addr), &buf, p_os);
+                    break;
+                case JsonEncodeKind::jek_string_view:
+                    encode_string(*reinterpret_cast<std::string_view *>(addr), &buf, p_os);
+                    break;
+                case JsonEncodeKind::jek_printer:
+                    /* output so far must precede printer's */
+                    buf.flush();
+
+                    pjson.print_aux(op.member_->get_member_tp(obj), p_os);
+                    break;
+                }
+            }
+
+            buf.put("}");
+            buf.flush();
+        } /*encode*/
+    } /*namespace json*/
+} /*namespace xo*/
+
+/* end JsonStructEncoder.cpp */
@@ -11,6 +11,8 @@
 #include <xo/ppsink/tag_ostream.hpp>        /* os << xtag(..) */
 #include <xo/ppsink/pp_time_ostream.hpp>    /* os << iso8601(..) */
 #include <cmath>
+#include <mutex>
+#include <type_traits>
 
 namespace xo {
     using xo::time::utc_nanos;
@@ -158,6 +160,15 @@ namespace xo {
                         print_generic_vector(*this, tp, p_os);
                         return;
                     case Metatype::mt_struct:
+                        if (this->struct_encoder_flag_ && JsonStructEncoder::is_plain_format(*p_os)) {
+                            JsonStructEncoder const * encoder = this->require_struct_encoder(tp);
+
+                            if (encoder) {
+                                encoder->encode(*this, tp.address(), p_os);
+                                return;
+                            }
+                        }
+
                         print_generic_struct(*this, tp, p_os);
                         return;
                     case Metatype::mt_function:
@@ -182,6 +193,44 @@ namespace xo {
             }
         } /*print_aux*/
 
+        JsonStructEncoder const *
+        PrintJson::require_struct_encoder(TaggedPtr tp) const
+        {
+            TypeDescr td = tp.td();
+
+            if (!td || !td->is_struct() || !td->complete_flag())
+                return nullptr;
+
+            {
+                std::shared_lock<std::shared_mutex> lock(this->encoder_mutex_);
+
+                std::unique_ptr<JsonStructEncoder> const * encoder
+                    = this->encoder_map_.lookup(td);
+
+                if (encoder && *encoder)
+                    return encoder->get();
+            }
+
+            std::unique_lock<std::shared_mutex> lock(this->encoder_mutex_);
+
+            std::unique_ptr<JsonStructEncoder> * encoder
+                = this->encoder_map_.require(td);
+
+            /* may have lost race with another thread */
+            if (!*encoder)
+                *encoder = JsonStructEncoder::compile(*this, tp);
+
+            return encoder->get();
+        } /*require_struct_encoder*/
+
+        void
+        PrintJson::clear_struct_encoders()
+        {
+            std::unique_lock<std::shared_mutex> lock(this->encoder_mutex_);
+
+            this->encoder_map_ = EncoderMap();
+        } /*clear_struct_encoders*/
+
         void
         PrintJson::print_tp(TaggedPtr tp,
                             std::ostream * p_os) const
@@ -253,6 +302,8 @@ namespace xo {
                     *p_os << (*x ? "true" : "false");
                 }
             } /*print_json*/
+
+            virtual JsonEncodeKind encode_kind() const override { return JsonEncodeKind::jek_bool; }
         }; /*JsonPrinter_bool*/
 
         namespace {
@@ -266,6 +317,37 @@ namespace xo {
             } /*provide_bool_printer*/
         } /*namespace*/
 
+        namespace {
+            /* fast path in JsonStructEncoder matching JsonPrinter_{integer,floatingpoint,string}<T> */
+            template<typename T>
+            constexpr JsonEncodeKind
+            native_encode_kind()
+            {
+                if constexpr (std::is_same_v<T, std::int16_t>)
+                    return JsonEncodeKind::jek_i16;
+                else if constexpr (std::is_same_v<T, std::uint16_t>)
+                    return JsonEncodeKind::jek_u16;
+                else if constexpr (std::is_same_v<T, std::int32_t>)
+                    return JsonEncodeKind::jek_i32;
+                else if constexpr (std::is_same_v<T, std::uint32_t>)
+                    return JsonEncodeKind::jek_u32;
+                else if constexpr (std::is_same_v<T, std::int64_t>)
+                    return JsonEncodeKind::jek_i64;
+                else if constexpr (std::is_same_v<T, std::uint64_t>)
+                    return JsonEncodeKind::jek_u64;
+                else if constexpr (std::is_same_v<T, float>)
+                    return JsonEncodeKind::jek_f32;
+                else if constexpr (std::is_same_v<T, double>)
+                    return JsonEncodeKind::jek_f64;
+                else if constexpr (std::is_same_v<T, std::string>)
+                    return JsonEncodeKind::jek_string;
+                else if constexpr (std::is_same_v<T, std::string_view>)
+                    return JsonEncodeKind::jek_string_view;
+                else
+                    return JsonEncodeKind::jek_printer;
+            } /*native_encode_kind*/
+        } /*namespace*/
+
         template<typename T>
         class JsonPrinter_integer : public JsonPrinter {
         public:
@@ -283,6 +365,8 @@ namespace xo {
                                                            p_os);
                 }
             } /*print_json*/
+
+            virtual JsonEncodeKind encode_kind() const override { return native_encode_kind<T>(); }
         }; /*JsonPrinter_integer*/
 
         namespace {
@@ -330,6 +414,8 @@ namespace xo {
                                                                p_os);
                     }
                 } /*print_json*/
+
+            virtual JsonEncodeKind encode_kind() const override { return native_encode_kind<T>(); }
         }; /*JsonPrinter_floatingpoint*/
 
         namespace {
@@ -361,6 +447,8 @@ namespace xo {
                                                            p_os);
                 }
             } /*print_json*/
+
+            virtual JsonEncodeKind encode_kind() const override { return native_encode_kind<T>(); }
         }; /*JsonPrinter_string*/
 
         namespace {
@@ -0,0 +1,265 @@
+/* file JsonStructEncoder.test.cpp
+ *
+ * author: Roland Conybeare, Aug 2022
+ */
+
+#include "xo/printjson/PrintJson.hpp"
+#include "xo/printjson/JsonStructEncoder.hpp"
+#include "xo/printjson/init_printjson.hpp"
+#include <xo/reflect/Reflect.hpp>
+#include <xo/reflect/StructReflector.hpp>
+#include <catch2/catch.hpp>
+#include <cmath>
+#include <iomanip>
+#include <limits>
+#include <random>
+#include <sstream>
+#include <vector>
+
+namespace xo {
+    using xo::json::PrintJson;
+    using xo::json::JsonPrinter;
+    using xo::json::JsonStructEncoder;
+    using xo::reflect::Reflect;
+    using xo::reflect::StructReflector;
+    using xo::reflect::TaggedPtr;
+
+    namespace ut {
+        namespace {
+            struct EncStruct1 {
+                bool flag_;
+                std::int16_t i16_; std::uint16_t u16_;
+                std::int32_t i32_; std::uint32_t u32_;
+                std::int64_t i64_; std::uint64_t u64_;
+                float f32_; double f64_;
+                std::string s_;
+                std::string_view sv_;
+            };
+
+            struct EncStruct2 {
+                std::int32_t id_;
+                EncStruct1 inner_;
+                std::vector<double> v_;
+                char const * cstr_;
+            };
+
+            void
+            reflect_enc_structs()
+            {
+                {
+                    StructReflector<EncStruct1> sr;
+
+                    if (sr.is_incomplete()) {
+                        REFLECT_MEMBER(sr, flag);
+                        REFLECT_MEMBER(sr, i16);
+                        REFLECT_MEMBER(sr, u16);
+                        REFLECT_MEMBER(sr, i32);
+                        REFLECT_MEMBER(sr, u32);
+                        REFLECT_MEMBER(sr, i64);
+                        REFLECT_MEMBER(sr, u64);
+                        REFLECT_MEMBER(sr, f32);
+                        REFLECT_MEMBER(sr, f64);
+                        REFLECT_MEMBER(sr, s);
+                        REFLECT_MEMBER(sr, sv);
+                    }
+
+                    sr.require_complete();
+                }
+
+                {
+                    StructReflector<EncStruct2> sr;
+
+                    if (sr.is_incomplete()) {
+                        REFLECT_MEMBER(sr, id);
+                        REFLECT_MEMBER(sr, inner);
+                        REFLECT_MEMBER(sr, v);
+                        REFLECT_MEMBER(sr, cstr);
+                    }
+
+                    sr.require_complete();
+                }
+            } /*reflect_enc_structs*/
+
+            /* print tp with compiled encoders (flag=true) or via reflection (flag=false),
+             * after applying fmt to the stream
+             */
+            template <typename Fmt>
+            std::string
+            print_with(PrintJson * p_pjson, bool flag, TaggedPtr tp, Fmt && fmt)
+            {
+                std::stringstream ss;
+
+                fmt(ss);
+
+                p_pjson->set_struct_encoder_flag(flag);
+                p_pjson->print_tp(tp, &ss);
+
+                return ss.str();
+            }
+
+            std::string
+            print_with(PrintJson * p_pjson, bool flag, TaggedPtr tp)
+            {
+                return print_with(p_pjson, flag, tp, [](std::ostream &) {});
+            }
+        }
+
+        TEST_CASE("json-struct-encoder-compile", "[printjson][JsonStructEncoder]") {
+            reflect_enc_structs();
+
+            PrintJson pjson;
+
+            EncStruct1 x{};
+            EncStruct2 y{};
+
+            JsonStructEncoder const * enc1 = pjson.require_struct_encoder(Reflect::make_tp(&x));
+            JsonStructEncoder const * enc2 = pjson.require_struct_encoder(Reflect::make_tp(&y));
+
+            REQUIRE(enc1);
+            REQUIRE(enc1->struct_td() == Reflect::require<EncStruct1>());
+            REQUIRE(enc1->op_v().size() == 11);
+            REQUIRE(enc1->n_fast_op() == 11);
+            REQUIRE(enc1->op_v()[8].offset_ == offsetof(EncStruct1, f64_));
+
+            /* int32 member fast;  nested struct, vector, char const * go through PrintJson */
+            REQUIRE(enc2);
+            REQUIRE(enc2->op_v().size() == 4);
+            REQUIRE(enc2->n_fast_op() == 1);
+
+            /* cached */
+            REQUIRE(pjson.require_struct_encoder(Reflect::make_tp(&x)) == enc1);
+
+            /* not a struct */
+            double z = 0.0;
+            REQUIRE(pjson.require_struct_encoder(Reflect::make_tp(&z)) == nullptr);
+        } /*TEST_CASE(json-struct-encoder-compile)*/
+
+        TEST_CASE("json-struct-encoder-same-output", "[printjson][JsonStructEncoder]") {
+            reflect_enc_structs();
+
+            PrintJson pjson;
+
+            std::mt19937_64 rng(12345);
+            std::uniform_real_distribution<double> unif(-1.0, 1.0);
+            std::uniform_int_distribution<int> expo(-30, 30);
+
+            std::string text_v[] = { "", "hello, world", "tab\there", "quote\"back\\slash",
+                                      "ctl\x01\x7f", "utf-8 \xc3\xa9", std::string(600, 'x') };
+
+            for (int i = 0; i < 2000; ++i) {
+                double f = unif(rng) * std::pow(10.0, expo(rng));
+
+                EncStruct1 x{(i % 2 == 0),
+                             static_cast<std::int16_t>(-i), static_cast<std::uint16_t>(i),
+                             -i * 1000003, static_cast<std::uint32_t>(i) * 4000037u,
+                             -static_cast<std::int64_t>(i) << 40, static_cast<std::uint64_t>(i) << 50,
+                             static_cast<float>(f), f,
+                             text_v[i % 7], text_v[(i + 3) % 7]};
+
+                TaggedPtr tp = Reflect::make_tp(&x);
+
+                INFO("i=" << i);
+
+                REQUIRE(print_with(&pjson, true, tp) == print_with(&pjson, false, tp));
+
+                /* stream precision honored */
+                auto prec = [](std::ostream & os) { os << std::setprecision(15); };
+
+                REQUIRE(print_with(&pjson, true, tp, prec) == print_with(&pjson, false, tp, prec));
+            }
+
+            /* non-finite */
+            {
+                EncStruct1 x{};
+                x.f32_ = std::numeric_limits<float>::infinity();
+                x.f64_ = std::numeric_limits<double>::quiet_NaN();
+
+                TaggedPtr tp = Reflect::make_tp(&x);
+
+                std::string s = print_with(&pjson, true, tp);
+
+                REQUIRE(s == print_with(&pjson, false, tp));
+                REQUIRE(s.find("\"f32\": Infinity, \"f64\": NaN") != std::string::npos);
+            }
+
+            /* extreme integers */
+            {
+                EncStruct1 x{};
+                x.i16_ = std::numeric_limits<std::int16_t>::min();
+                x.i64_ = std::numeric_limits<std::int64_t>::min();
+                x.u64_ = std::numeric_limits<std::uint64_t>::max();
+
+                TaggedPtr tp = Reflect::make_tp(&x);
+
+                REQUIRE(print_with(&pjson, true, tp) == print_with(&pjson, false, tp));
+            }
+        } /*TEST_CASE(json-struct-encoder-same-output)*/
+
+        TEST_CASE("json-struct-encoder-nested", "[printjson][JsonStructEncoder]") {
+            reflect_enc_structs();
+
+            PrintJson pjson;
+
+            EncStruct2 y{7, EncStruct1{true, 1, 2, 3, 4, 5, 6, 0.5f, 0.25, "s", "sv"},
+                         {1.5, 2.5}, "cstr"};
+
+            TaggedPtr tp = Reflect::make_tp(&y);
+
+            std::string s = print_with(&pjson, true, tp);
+
+            REQUIRE(s == print_with(&pjson, false, tp));
+            REQUIRE(s == std::string("{\"_name_\": \"EncStruct2\""
+                                     ", \"id\": 7"
+                                     ", \"inner\": {\"_name_\": \"EncStruct1\""
+                                     ", \"flag\": true, \"i16\": 1, \"u16\": 2"
+                                     ", \"i32\": 3, \"u32\": 4, \"i64\": 5, \"u64\": 6"
+                                     ", \"f32\": 0.5, \"f64\": 0.25"
+                                     ", \"s\": \"s\", \"sv\": \"sv\"}"
+                                     ", \"v\": [1.5, 2.5]"
+                                     ", \"cstr\": \"cstr\"}"));
+
+            /* vector of structs */
+            std::vector<EncStruct2> v{y, y};
+            TaggedPtr vtp = Reflect::make_tp(&v);
+
+            REQUIRE(print_with(&pjson, true, vtp) == print_with(&pjson, false, vtp));
+        } /*TEST_CASE(json-struct-encoder-nested)*/
+
+        TEST_CASE("json-struct-encoder-fallback", "[printjson][JsonStructEncoder]") {
+            reflect_enc_structs();
+
+            PrintJson pjson;
+
+            EncStruct1 x{false, -1, 2, -3, 255, -5, 6, 1.25f, 100.0, "a", "b"};
+            TaggedPtr tp = Reflect::make_tp(&x);
+
+            /* stream formatting not reproduced by fast paths -> reflective printer */
+            {
+                auto hex = [](std::ostream & os) { os << std::hex; };
+                auto fixed = [](std::ostream & os) { os << std::fixed << std::setprecision(2); };
+
+                REQUIRE(!JsonStructEncoder::is_plain_format(std::stringstream() << std::hex));
+                REQUIRE(print_with(&pjson, true, tp, hex) == print_with(&pjson, false, tp, hex));
+                REQUIRE(print_with(&pjson, true, tp, hex).find("\"u32\": ff") != std::string::npos);
+                REQUIRE(print_with(&pjson, true, tp, fixed).find("\"f64\": 100.00") != std::string::npos);
+            }
+
+            /* application-provided printer replaces fast path */
+            {
+                REQUIRE(pjson.require_struct_encoder(tp)->n_fast_op() == 11);
+
+                pjson.provide_printer(Reflect::require<double>(),
+                                      std::unique_ptr<JsonPrinter>(new json::AsStringJsonPrinter<double>(&pjson)));
+
+                REQUIRE(pjson.require_struct_encoder(tp)->n_fast_op() == 10);
+
+                std::string s = print_with(&pjson, true, tp);
+
+                REQUIRE(s == print_with(&pjson, false, tp));
+                REQUIRE(s.find("\"f64\": \"100\"") != std::string::npos);
+            }
+        } /*TEST_CASE(json-struct-encoder-fallback)*/
+    } /*namespace ut*/
+} /*namespace xo*/
+
+/* end JsonStructEncoder.test.cpp */
@@ -9,6 +9,7 @@
 #include <xo/reflect/TaggedPtr.hpp>
 #include <xo/timeutil/timeutil.hpp>
 #include <xo/randomgen/normalgen.hpp>
+#include <xo/randomgen/ziggurat_normal_distribution.hpp>
 #include <chrono>
 #include <memory>
 
@@ -44,6 +45,15 @@ namespace xo {
             virtual utc_nanos t0() const override { return t0_; }
 
         protected:
+            /* bulk body of .sample_paths():
+             * on entry,  z[] holds n_paths * t_v.size() N(0,1) samples;
+             * on exit,  z[i * t_v.size() + j] is path i at time t_v[j].
+             * Each row is scaled by per-step sdev,  then cumulatively summed.
+             */
+            void sample_paths_from_normals(std::span<utc_nanos const> t_v,
+                                           std::size_t n_paths,
+                                           std::span<double> z) const;
+
             /* generate sample given a random number from N(0,1) */
             double exterior_sample_impl(utc_nanos t,
                                         event_type const & lo,
@@ -163,6 +173,14 @@ namespace xo {
                                            event_type const &lo) override;
 #endif
 
+            /* sample n_paths realizations on time grid t_v[] (see StochasticProcess).
+             * Draws all N(0,1) increments in one bulk fill (ziggurat sampler on .rng's engine),
+             * directly into out[],  then scales + sums in place.
+             */
+            virtual void sample_paths(std::span<utc_nanos const> t_v,
+                                      std::size_t n_paths,
+                                      std::span<double> out) override;
+
             /* return human-readable string identifying this process */
             virtual std::string display_string() const override {
                 return "<BrownianMotion>";
@@ -315,6 +333,26 @@ namespace xo {
             return this->exterior_sample_impl(t, lo, x0);
         } /*exterior_sample*/
 
+        template<typename RngEngine>
+        void
+        BrownianMotion<RngEngine>::sample_paths(std::span<utc_nanos const> t_v,
+                                                std::size_t n_paths,
+                                                std::span<double> out)
+        {
+            this->check_sample_paths_args(t_v, n_paths, out.size());
+
+            if constexpr (std::same_as<typename RngEngine::result_type, std::uint64_t>) {
+                xo::rng::ziggurat_normal_distribution zig;
+
+                zig.fill(this->rng_.engine(), out);
+            } else {
+                /* ziggurat sampler wants 64-bit engine output */
+                this->rng_.fill(out);
+            }
+
+            this->sample_paths_from_normals(t_v, n_paths, out);
+        } /*sample_paths*/
+
 
     }  /*namespace process*/
 }  /*namespace xo*/
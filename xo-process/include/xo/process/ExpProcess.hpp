@@ -70,6 +70,11 @@ namespace xo {
                 return m * ::exp(e);
             } /*interior_sample*/
 
+            /* sample paths of exponent process in bulk,  then exponentiate in place */
+            virtual void sample_paths(std::span<utc_nanos const> t_v,
+                                      std::size_t n_paths,
+                                      std::span<double> out) override;
+
             virtual std::string display_string() const override {
                 // return tostr("<ExpProcess ",     exponent_process_->display_string(), ">");
 
@@ -6,6 +6,8 @@
 #include <xo/timeutil/timeutil.hpp>
 // #include "refcnt/Refcounted.hpp"
 // #include "time/Time.hpp"
+#include <span>
+#include <stdexcept>
 #include <string>
 #include <utility>
 
@@ -54,6 +56,37 @@ namespace xo {
                                                event_type const & lo,
                                                event_type const & hi) = 0;
 
+            /* sample n_paths independent realizations of this process
+             * on time grid t_v[],  each starting from {.t0(), .t0_value()}.
+             * Writes row-major into out[]:
+             *   out[i * t_v.size() + j] = value of path i at time t_v[j]
+             *
+             * Require:
+             * - t_v[] non-decreasing,  with t_v[0] >= .t0()
+             * - out.size() = n_paths * t_v.size()
+             *
+             * Default implementation calls .exterior_sample() once per output;
+             * processes with cheap bulk increments (e.g. BrownianMotion) override.
+             */
+            virtual void sample_paths(std::span<utc_nanos const> t_v,
+                                      std::size_t n_paths,
+                                      std::span<T> out) {
+                check_sample_paths_args(t_v, n_paths, out.size());
+
+                std::size_t n_t = t_v.size();
+
+                for (std::size_t i = 0; i < n_paths; ++i) {
+                    event_type lo(this->t0(), this->t0_value());
+
+                    for (std::size_t j = 0; j < n_t; ++j) {
+                        T x = this->exterior_sample(t_v[j], lo);
+
+                        out[i * n_t + j] = x;
+                        lo = event_type(t_v[j], x);
+                    }
+                }
+            } /*sample_paths*/
+
 #ifdef NOT_IN_USE
             /* sample hitting time
              *    T(a) = inf{t : P(t)=a, t>t1} for process hitting value a,
@@ -66,6 +99,30 @@ namespace xo {
 
             /* human-readable string identifying this process */
             virtual std::string display_string() const = 0;
+
+        protected:
+            /* throw unless arguments satisfy .sample_paths() preconditions */
+            void check_sample_paths_args(std::span<utc_nanos const> t_v,
+                                         std::size_t n_paths,
+                                         std::size_t out_size) const {
+                if (out_size != n_paths * t_v.size()) {
+                    throw std::runtime_error("StochasticProcess::sample_paths"
+                                             ": expected out.size = n_paths * t_v.size"
+                                             ", got out.size=" + std::to_string(out_size)
+                                             + " n_paths=" + std::to_string(n_paths)
+                                             + " t_v.size=" + std::to_string(t_v.size()));
+                }
+
+                for (std::size_t j = 0; j < t_v.size(); ++j) {
+                    utc_nanos t_prev = (j == 0) ? this->t0() : t_v[j-1];
+
+                    if (t_v[j] < t_prev) {
+                        throw std::runtime_error("StochasticProcess::sample_paths"
+                                                 ": expected non-decreasing time grid starting at .t0()"
+                                                 ", violated at j=" + std::to_string(j));
+                    }
+                }
+            } /*check_sample_paths_args*/
         }; /*StochasticProcess*/
 
     } /*namespace process*/
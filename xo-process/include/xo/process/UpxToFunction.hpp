@@ -0,0 +1,28 @@
+/* @file UpxToFunction.hpp */
+
+#pragma once
+
+#include "UpxEvent.hpp"
+#include <xo/reactor/Sink.hpp>
+#include <functional>
+
+namespace xo {
+    namespace process {
+        /* sink that invokes a function for each UpxEvent.
+         * lives in process/ for the same typeinfo reason as UpxToConsole;
+         * pyprocess uses it to deliver events to a python callable
+         */
+        class UpxToFunction : public xo::reactor::SinkToFunction<UpxEvent,
+                                                                 std::function<void (UpxEvent const &)>> {
+        public:
+            using function_type = std::function<void (UpxEvent const &)>;
+
+        public:
+            explicit UpxToFunction(function_type fn);
+
+            static rp<UpxToFunction> make(function_type fn);
+        }; /*UpxToFunction*/
+    } /*namespace process*/
+} /*namespace xo*/
+
+/* end UpxToFunction.hpp */
@@ -6,6 +6,7 @@
 // #include "time/Time.hpp"
 #include "BrownianMotion.hpp"
 #include <cmath>
+#include <vector>
 
 namespace xo {
     using xo::time::utc_nanos;
@@ -26,6 +27,40 @@ namespace xo {
             return this->vol2_day_ * dt_day;
         } /*variance_dt*/
 
+        void
+        BrownianMotionBase::sample_paths_from_normals(std::span<utc_nanos const> t_v,
+                                                      std::size_t n_paths,
+                                                      std::span<double> z) const
+        {
+            std::size_t n_t = t_v.size();
+
+            /* sd_v[j]:  sdev of increment B(t_v[j]) - B(t_v[j-1]),  t_v[-1] = t0 */
+            std::vector<double> sd_v(n_t);
+
+            for (std::size_t j = 0; j < n_t; ++j) {
+                utc_nanos t_prev = (j == 0) ? this->t0() : t_v[j-1];
+
+                sd_v[j] = ::sqrt(this->variance_dt(t_v[j] - t_prev));
+            }
+
+            double const x0 = this->t0_value();
+
+            for (std::size_t i = 0; i < n_paths; ++i) {
+                double * row = z.data() + i * n_t;
+
+                /* increments;  vectorizes */
+                for (std::size_t j = 0; j < n_t; ++j)
+                    row[j] *= sd_v[j];
+
+                /* cumulative sum */
+                double x = x0;
+                for (std::size_t j = 0; j < n_t; ++j) {
+                    x += row[j];
+                    row[j] = x;
+                }
+            }
+        } /*sample_paths_from_normals*/
+
         double
         BrownianMotionBase::exterior_sample_impl(utc_nanos t,
                                                  BrownianMotionBase::event_type const & lo,
@@ -59,6 +59,19 @@ namespace xo {
             return retval;
         } /*exterior_sample*/
 
+        void
+        ExpProcess::sample_paths(std::span<utc_nanos const> t_v,
+                                 std::size_t n_paths,
+                                 std::span<double> out)
+        {
+            this->exponent_process_->sample_paths(t_v, n_paths, out);
+
+            double const m = this->scale_;
+
+            for (double & x : out)
+                x = m * ::exp(x);
+        } /*sample_paths*/
+
         TaggedRcptr
         ExpProcess::self_tp()
         {
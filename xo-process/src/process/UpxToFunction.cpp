@@ -0,0 +1,19 @@
+/* @file UpxToFunction.cpp */
+
+#include "UpxToFunction.hpp"
+
+namespace xo {
+  namespace process {
+    rp<UpxToFunction>
+    UpxToFunction::make(function_type fn)
+    {
+      return new UpxToFunction(std::move(fn));
+    } /*make*/
+
+    UpxToFunction::UpxToFunction(function_type fn)
+      : SinkToFunction(std::move(fn))
+    {}
+  } /*namespace process*/
+} /*namespace xo*/
+
+/* end UpxToFunction.cpp */
@@ -4,6 +4,7 @@
 #include "xo/process/RealizationSource.hpp"
 #include "xo/process/BrownianMotion.hpp"
 #include "xo/process/LogNormalProcess.hpp"
+#include "xo/process/UpxToFunction.hpp"
 #include <xo/simulator/Simulator.hpp>
 #include <xo/ppsink/scope.hpp>
 #include <xo/ppsink/scope_macros.hpp>
@@ -21,6 +22,8 @@ namespace xo {
   using xo::process::LogNormalProcess;
   using xo::process::ExpProcess;
   using xo::process::BrownianMotion;
+  using xo::process::UpxEvent;
+  using xo::process::UpxToFunction;
   using xo::rng::xoshiro256ss;
   using xo::reactor::SinkToConsole;
   using xo::time::timeutil;
@@ -191,6 +194,43 @@ namespace xo {
           realization->attach_sink(sink);
       } /*TEST_CASE(sim-brownian-motion-with-sink)*/
 
+      TEST_CASE("sim-upx-to-function", "[process][simulation]") {
+          utc_nanos t0 = timeutil::ymd_hms_usec(20220718 /*ymd*/,
+                                                120000 /*hms*/,
+                                                0 /*usec*/);
+
+          auto bm
+              = BrownianMotion<xoshiro256ss>::make(t0,
+                                                   0.50 /*annualized volatility*/,
+                                                   65431123UL /*seed*/);
+
+          auto tracer
+              = RealizationTracer<double>::make(bm);
+
+          auto realization
+              = RealizationSource<UpxEvent, double>::make(tracer,
+                                                          std::chrono::seconds(1) /*ev_interval_dt*/);
+
+          std::vector<UpxEvent> ev_v;
+
+          rp<UpxToFunction> sink
+              = UpxToFunction::make([&ev_v](UpxEvent const & ev) { ev_v.push_back(ev); });
+
+          realization->attach_sink(sink);
+
+          rp<Simulator> sim = Simulator::make(t0);
+
+          sim->add_source(realization);
+          sim->run_until(t0 + minutes(1));
+
+          /* 1-minute simulation with 1-second samples */
+          REQUIRE(ev_v.size() == 61);
+          REQUIRE(sink->n_in_ev() == 61);
+
+          for (size_t i = 0; i < ev_v.size(); ++i)
+              REQUIRE(ev_v[i].tm() == t0 + seconds(i));
+      } /*TEST_CASE(sim-upx-to-function)*/
+
       TEST_CASE("sim-lognormal", "[process][simulation]") {
           constexpr char const * c_self = "TEST_CASE:sim-lognormal";
           constexpr bool c_logging_enabled = false;
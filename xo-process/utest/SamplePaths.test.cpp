@@ -0,0 +1,167 @@
+/* @file SamplePaths.test.cpp */
+
+#include "xo/process/BrownianMotion.hpp"
+#include "xo/process/LogNormalProcess.hpp"
+#include <xo/randomgen/xoshiro256.hpp>
+#include <xo/ppsink/tag_ostream.hpp>   /* os << xtag(..) */
+#include <catch2/catch.hpp>
+#include <cmath>
+#include <vector>
+
+namespace xo {
+    using xo::process::BrownianMotion;
+    using xo::process::ExpProcess;
+    using xo::process::LogNormalProcess;
+    using xo::rng::xoshiro256ss;
+    using xo::time::timeutil;
+    using xo::time::utc_nanos;
+    using xo::pp::xtag;
+    using std::chrono::hours;
+
+    namespace ut {
+        namespace {
+            /* daily grid,  except first point coincides with t0 */
+            std::vector<utc_nanos>
+            make_grid(utc_nanos t0, std::size_t n_t)
+            {
+                std::vector<utc_nanos> t_v;
+
+                for (std::size_t j = 0; j < n_t; ++j)
+                    t_v.push_back(t0 + hours(24 * j));
+
+                return t_v;
+            } /*make_grid*/
+        } /*namespace*/
+
+        TEST_CASE("bm-sample-paths", "[process][sample_paths]") {
+            utc_nanos t0 = timeutil::ymd_hms_usec(20220610 /*ymd*/,
+                                                  162905 /*hms*/,
+                                                  123456 /*usec*/);
+
+            double sdev = 0.30;
+
+            rp<BrownianMotion<xoshiro256ss>> bm
+                = BrownianMotion<xoshiro256ss>::make(t0, sdev, 12345678UL /*seed*/);
+
+            std::size_t n_t = 6;
+            std::size_t n_paths = 100000;
+
+            std::vector<utc_nanos> t_v = make_grid(t0, n_t);
+            std::vector<double> out(n_paths * n_t);
+
+            bm->sample_paths(t_v, n_paths, out);
+
+            for (std::size_t j = 0; j < n_t; ++j) {
+                INFO(xtag("j", j));
+
+                /* sample moments of B(t_v[j]) */
+                double m1 = 0.0;
+                double m2 = 0.0;
+
+                for (std::size_t i = 0; i < n_paths; ++i) {
+                    double x = out[i * n_t + j];
+
+                    m1 += x;
+                    m2 += x * x;
+                }
+
+                m1 /= n_paths;
+                m2 /= n_paths;
+
+                double var = bm->variance_dt(t_v[j] - t0);
+
+                if (j == 0) {
+                    /* t_v[0] = t0 */
+                    REQUIRE(m2 == 0.0);
+                } else {
+                    /* loose (~5 sigma) bounds */
+                    REQUIRE(std::abs(m1) < 5.0 * std::sqrt(var / n_paths));
+                    REQUIRE(m2 == Approx(var).epsilon(0.05));
+                }
+            }
+
+            /* increments over disjoint intervals are uncorrelated */
+            {
+                double c12 = 0.0;
+
+                for (std::size_t i = 0; i < n_paths; ++i) {
+                    double d1 = out[i * n_t + 1] - out[i * n_t + 0];
+                    double d2 = out[i * n_t + 2] - out[i * n_t + 1];
+
+                    c12 += d1 * d2;
+                }
+
+                c12 /= n_paths;
+
+                double var1 = bm->variance_dt(hours(24));
+
+                REQUIRE(std::abs(c12) < 5.0 * var1 / std::sqrt(n_paths));
+            }
+
+            /* grid must start at or after t0 */
+            {
+                std::vector<utc_nanos> t2_v = {t0 - hours(1), t0};
+                std::vector<double> out2(2);
+
+                REQUIRE_THROWS_AS(bm->sample_paths(t2_v, 1, out2), std::runtime_error);
+            }
+
+            /* output size must match */
+            REQUIRE_THROWS_AS(bm->sample_paths(t_v, n_paths + 1, out), std::runtime_error);
+        } /*TEST_CASE(bm-sample-paths)*/
+
+        TEST_CASE("lognormal-sample-paths", "[process][sample_paths]") {
+            utc_nanos t0 = timeutil::ymd_hms_usec(20220610 /*ymd*/,
+                                                  162905 /*hms*/,
+                                                  123456 /*usec*/);
+
+            double x0 = 100.0;
+            double sdev = 0.50;
+
+            rp<ExpProcess> lnp
+                = LogNormalProcess::make<xoshiro256ss>(t0, x0, sdev, 98765432UL /*seed*/);
+
+            std::size_t n_t = 4;
+            std::size_t n_paths = 100000;
+
+            std::vector<utc_nanos> t_v = make_grid(t0 + hours(24), n_t);
+            std::vector<double> out(n_paths * n_t);
+
+            lnp->sample_paths(t_v, n_paths, out);
+
+            BrownianMotion<xoshiro256ss> const * bm
+                = dynamic_cast<BrownianMotion<xoshiro256ss> const *>(lnp->exponent_process().get());
+
+            REQUIRE(bm);
+
+            for (std::size_t j = 0; j < n_t; ++j) {
+                INFO(xtag("j", j));
+
+                /* log(X(t)/x0) ~ N(0, var) */
+                double m1 = 0.0;
+                double m2 = 0.0;
+
+                for (std::size_t i = 0; i < n_paths; ++i) {
+                    double x = out[i * n_t + j];
+
+                    REQUIRE(x > 0.0);
+
+                    double e = std::log(x / x0);
+
+                    m1 += e;
+                    m2 += e * e;
+                }
+
+                m1 /= n_paths;
+                m2 /= n_paths;
+
+                double var = bm->variance_dt(t_v[j] - t0);
+
+                REQUIRE(std::abs(m1) < 5.0 * std::sqrt(var / n_paths));
+                REQUIRE(m2 == Approx(var).epsilon(0.05));
+            }
+        } /*TEST_CASE(lognormal-sample-paths)*/
+    } /*namespace ut*/
+} /*namespace xo*/
+
+/* end SamplePaths.test.cpp */
@@ -26,7 +26,7 @@ namespace xo {
 
             py::class_<Distribution<double>,
                        rp<Distribution<double>>>(m, "Distribution")
-                .def("cdf", &Distribution<double>::cdf,
+                .def("cdf", py::overload_cast<double const &>(&Distribution<double>::cdf, py::const_),
                      "return cumulative distribution function at x",
                      py::arg("x"));
 
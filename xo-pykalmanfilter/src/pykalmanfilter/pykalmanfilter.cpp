@@ -16,14 +16,17 @@
 #include <xo/pyreactor/pyreactor.hpp>
 #include <xo/reactor/EventStore.hpp>
 #include <xo/pyutil/pyutil.hpp>
+#include <xo/pyutil/pynumpy.hpp>
 #include <xo/refcnt/Refcounted.hpp>
 #include <xo/subsys/Subsystem.hpp>
 #include <xo/timeutil/timeutil.hpp>
 #include <pybind11/chrono.h>
 #include <pybind11/eigen.h>
 #include <pybind11/functional.h>
+#include <pybind11/numpy.h>
 #include <pybind11/pybind11.h>
 #include <pybind11/stl.h>
+#include <algorithm>
 //#include <pybind11/operators.h>
 
 namespace xo {
@@ -32,6 +35,7 @@ namespace xo {
     using xo::kalman::KalmanFilterState;
     using xo::kalman::KalmanFilterEngine;
     using xo::kalman::KalmanFilterSpec;
+    using xo::kalman::KalmanUpdateForm;
     using xo::kalman::KalmanFilterStepBase;
     using xo::kalman::KalmanFilterStep;
     using xo::kalman::KalmanFilterStateToConsole;
@@ -54,6 +58,69 @@ namespace xo {
     namespace py = pybind11;
 
     namespace filter {
+        namespace {
+            /* numpy columns for a kalman filter state history:
+             *   tm       datetime64[ns]  (n,)
+             *   step_no  uint32          (n,)
+             *   x        float64         (n, n_state)
+             *   P        float64         (n, n_state, n_state)
+             *
+             * states are held by pointer,  so one bulk copy into numpy storage.
+             * all states must have the same dimension
+             */
+            py::dict
+            kf_state_columns(std::vector<rp<KalmanFilterStateExt>> const & sv)
+            {
+                using xo::pp::tostr;
+                using xo::pp::xtag;
+
+                py::ssize_t n = sv.size();
+                py::ssize_t m = sv.empty() ? 0 : sv[0]->n_state();
+
+                py::array tm_v(pyutil::datetime64_ns_dtype(), {n});
+                py::array_t<std::uint32_t> step_v({n});
+                py::array_t<double> x_v({n, m});
+                py::array_t<double> P_v({n, m, m});
+
+                auto * tm_p = static_cast<std::int64_t *>(tm_v.mutable_data());
+                auto step = step_v.mutable_unchecked<1>();
+                double * x_p = x_v.mutable_data();
+                double * P_p = P_v.mutable_data();
+
+                for (py::ssize_t i = 0; i < n; ++i) {
+                    KalmanFilterStateExt const & s = *(sv[i]);
+
+                    if (static_cast<py::ssize_t>(s.n_state()) != m) {
+                        throw std::runtime_error(tostr("kf_state_columns"
+                                                       ": expected uniform state dimension",
+                                                       xtag("i", i),
+                                                       xtag("n_state[0]", m),
+                                                       xtag("n_state[i]", s.n_state())));
+                    }
+
+                    tm_p[i] = pyutil::datetime64_ns(s.tm());
+                    step(i) = s.step_no();
+
+                    /* x contiguous;  P column-major (eigen default) -> row-major */
+                    std::copy_n(s.state_v().data(), m, x_p + i * m);
+
+                    MatrixXd const & P = s.state_cov();
+                    for (py::ssize_t r = 0; r < m; ++r) {
+                        for (py::ssize_t c = 0; c < m; ++c)
+                            P_p[(i * m + r) * m + c] = P(r, c);
+                    }
+                }
+
+                py::dict retval;
+                retval["tm"] = tm_v;
+                retval["step_no"] = step_v;
+                retval["x"] = x_v;
+                retval["P"] = P_v;
+
+                return retval;
+            } /*kf_state_columns*/
+        } /*namespace*/
+
         PYBIND11_MODULE(PYKALMANFILTER_MODULE_NAME(), m) {
             /* ensure filter/ will be initialized */
             InitSubsys<S_kalmanfilter_tag>::require();
@@ -94,6 +161,7 @@ namespace xo {
                 .def("n_state", &KalmanFilterState::n_state)
                 .def("state_v", &KalmanFilterState::state_v)
                 .def("state_cov", &KalmanFilterState::state_cov)
+                .def("state_cov_sqrt", &KalmanFilterState::state_cov_sqrt)
                 .def_property_readonly("k", &KalmanFilterState::step_no)
                 .def_property_readonly("tk", &KalmanFilterState::tm)
                 .def_property_readonly("x", &KalmanFilterState::state_v)
@@ -177,10 +245,17 @@ namespace xo {
 
             // ----- xo::kalman::KalmanFilterSpec -----
 
+            py::enum_<KalmanUpdateForm>(m, "KalmanUpdateForm")
+                .value("covariance", KalmanUpdateForm::covariance)
+                .value("square_root", KalmanUpdateForm::square_root);
+
             py::class_<KalmanFilterSpec>(m, "KalmanFilterSpec")
                 .def(py::init<rp<KalmanFilterStateExt>, KalmanFilterSpec::MkStepFn>(),
                      py::arg("s0"), py::arg("mkstepfn"))
+                .def(py::init<rp<KalmanFilterStateExt>, KalmanFilterSpec::MkStepFn, KalmanUpdateForm>(),
+                     py::arg("s0"), py::arg("mkstepfn"), py::arg("update_form"))
                 .def("start_ext", &KalmanFilterSpec::start_ext)
+                .def_property_readonly("update_form", &KalmanFilterSpec::update_form)
                 .def("make_step", &KalmanFilterSpec::make_step,
                      py::arg("sk"), py::arg("zkp1"))
                 .def("__repr__", &KalmanFilterSpec::display_string);
@@ -197,6 +272,10 @@ namespace xo {
                   &KalmanFilterEngine::correct);
             m.def("kf_engine_correct1",
                   &KalmanFilterEngine::correct1);
+            m.def("kf_engine_extrapolate_sqrt",
+                  &KalmanFilterEngine::extrapolate_sqrt);
+            m.def("kf_engine_correct_sqrt",
+                  &KalmanFilterEngine::correct_sqrt);
 
             // ----- xo::kalman::KalmanFilter -----
 
@@ -254,8 +333,25 @@ namespace xo {
                        rp<KalmanFilterStateEventStore>>
                 (m, "KalmanFilterStateEventStore")
                 .def_static("make", &KalmanFilterStateEventStore::make)
+                /* record a state directly,  without attaching to a filter */
+                .def("notify_ev", &KalmanFilterStateEventStore::notify_ev, py::arg("ev"))
                 .def("last_n", &KalmanFilterStateEventStore::last_n, py::arg("n"))
-                .def("last_dt", &KalmanFilterStateEventStore::last_dt, py::arg("dt"));
+                .def("last_dt", &KalmanFilterStateEventStore::last_dt, py::arg("dt"))
+                /* numpy equivalents of .last_n(), .last_dt():
+                 * dict of columns {tm, step_no, x, P}; see kf_state_columns()
+                 */
+                .def("last_n_columns",
+                     [](KalmanFilterStateEventStore const & self, std::uint32_t n)
+                         {
+                             return kf_state_columns(self.last_n(n));
+                         },
+                     py::arg("n"))
+                .def("last_dt_columns",
+                     [](KalmanFilterStateEventStore const & self, xo::time::nanos dt)
+                         {
+                             return kf_state_columns(self.last_dt(dt));
+                         },
+                     py::arg("dt"));
             //.def("__repr__", &KalmanFilterStateEventStore::display_string);
 
 
@@ -0,0 +1,125 @@
+"""Smoke tests for the numpy column exports on
+xo_pykalmanfilter.KalmanFilterStateEventStore.
+
+KalmanFilterStateEventStore.last_n_columns() / .last_dt_columns() return
+a dict of numpy columns {tm, step_no, x, P}, one row per filter state.
+
+Run via ctest (see CMakeLists.txt), which puts xo_pykalmanfilter and the
+modules it imports on PYTHONPATH.
+"""
+
+import datetime as dt
+import unittest
+
+import numpy as np
+
+import xo_pykalmanfilter as kf
+
+_DATETIME64_NS = np.dtype("datetime64[ns]")
+_N_STATE = 3
+_T0 = dt.datetime(2026, 10, 1, 9, 30, 0)
+
+
+def to_ns(tm):
+    """Nanoseconds since epoch for a timestamp returned by the bindings
+    (datetime.datetime, to microsecond precision).
+    """
+    return int(round(tm.timestamp() * 1_000_000)) * 1000
+
+
+def state_cov(k):
+    """Covariance for step k.  Deliberately not symmetric,
+    so a transposed copy is detectable.
+    """
+    return np.array([[100.0 * k + 10.0 * r + c for c in range(_N_STATE)]
+                     for r in range(_N_STATE)])
+
+
+def make_state(k):
+    """Filter state for step k, at T0 + k seconds."""
+    tk = _T0 + dt.timedelta(seconds=k)
+    x = np.array([k + 0.1 * r for r in range(_N_STATE)])
+    transition = kf.KalmanFilterTransition(np.eye(_N_STATE), np.eye(_N_STATE))
+    zk = kf.make_kalman_filter_input(tkp1=tk,
+                                     presence=np.array([True]),
+                                     z=np.array([1.0]),
+                                     zerr=np.array([]))
+
+    return kf.KalmanFilterStateExt.make(k=k, tk=tk, x=x, P=state_cov(k),
+                                        transition=transition,
+                                        K=np.zeros((_N_STATE, 1)),
+                                        j=-1, zk=zk)
+
+
+def make_store(n_state):
+    store = kf.KalmanFilterStateEventStore.make()
+
+    for k in range(n_state):
+        store.notify_ev(make_state(k))
+
+    return store
+
+
+class TestKalmanFilterStateColumns(unittest.TestCase):
+    def test_last_n_columns(self):
+        store = make_store(6)
+
+        cols = store.last_n_columns(4)
+
+        self.assertEqual(set(cols.keys()), {"tm", "step_no", "x", "P"})
+
+        tm = cols["tm"]
+        step_no = cols["step_no"]
+        x = cols["x"]
+        P = cols["P"]
+
+        self.assertEqual(tm.dtype, _DATETIME64_NS)
+        self.assertEqual(step_no.dtype, np.dtype(np.uint32))
+        self.assertEqual(x.dtype, np.dtype(np.float64))
+        self.assertEqual(P.dtype, np.dtype(np.float64))
+
+        self.assertEqual(tm.shape, (4,))
+        self.assertEqual(step_no.shape, (4,))
+        self.assertEqual(x.shape, (4, _N_STATE))
+        self.assertEqual(P.shape, (4, _N_STATE, _N_STATE))
+
+        self.assertTrue(P.flags["C_CONTIGUOUS"])
+
+        ev_v = store.last_n(4)
+
+        self.assertEqual(tm.astype(np.int64).tolist(),
+                         [to_ns(ev.tk) for ev in ev_v])
+        self.assertEqual(step_no.tolist(), [2, 3, 4, 5])
+
+        for i, k in enumerate(range(2, 6)):
+            with self.subTest(k=k):
+                np.testing.assert_array_equal(x[i], ev_v[i].x)
+                # row-major: P[i, r, c] is row r, column c of state i's covariance
+                np.testing.assert_array_equal(P[i], state_cov(k))
+
+    def test_last_dt_columns(self):
+        store = make_store(6)
+
+        cols = store.last_dt_columns(dt.timedelta(seconds=2))
+        ev_v = store.last_dt(dt.timedelta(seconds=2))
+
+        self.assertEqual(cols["tm"].shape, (len(ev_v),))
+        self.assertEqual(cols["x"].shape, (len(ev_v), _N_STATE))
+        self.assertEqual(cols["P"].shape, (len(ev_v), _N_STATE, _N_STATE))
+        self.assertEqual(cols["step_no"].tolist(), [ev.k for ev in ev_v])
+
+    def test_empty_store(self):
+        store = kf.KalmanFilterStateEventStore.make()
+
+        for cols in (store.last_n_columns(5),
+                     store.last_dt_columns(dt.timedelta(seconds=5))):
+            self.assertEqual(cols["tm"].dtype, _DATETIME64_NS)
+            self.assertEqual(cols["tm"].shape, (0,))
+            self.assertEqual(cols["step_no"].shape, (0,))
+            # no states -> state dimension unknown, reported as 0
+            self.assertEqual(cols["x"].shape, (0, 0))
+            self.assertEqual(cols["P"].shape, (0, 0, 0))
+
+
+if __name__ == "__main__":
+    unittest.main()
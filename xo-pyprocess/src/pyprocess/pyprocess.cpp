@@ -7,17 +7,23 @@
 #include <xo/process/RealizationSource.hpp>
 #include <xo/process/StochasticProcess.hpp>
 #include <xo/process/UpxToConsole.hpp>
+#include <xo/process/UpxToFunction.hpp>
 #include <xo/process/init_process.hpp>
 #include <xo/pyreactor/pyreactor.hpp>
 #include <xo/reactor/EventStore.hpp>
 #include <xo/reactor/PolyAdapterSink.hpp>
 #include <xo/pywebutil/pywebutil.hpp>
+#include <xo/pyutil/pycallback.hpp>
+#include <xo/pyutil/pynumpy.hpp>
 #include <xo/timeutil/timeutil.hpp>
 #include <xo/randomgen/random_seed.hpp>
 #include <xo/randomgen/xoshiro256.hpp>
 #include <pybind11/chrono.h>
+#include <pybind11/numpy.h>
 #include <pybind11/pybind11.h>
 #include <pybind11/stl.h>
+#include <algorithm>
+#include <span>
 
 /* xo::ref::intrusive_ptr<T> is an intrusively-reference-counted pointer.
  * always safe to create one from a T* p
@@ -34,9 +40,44 @@ namespace xo {
     using xo::time::utc_nanos;
     using xo::rng::Seed;
     using xo::rng::xoshiro256ss;
+    using xo::pyutil::pycallback;
     namespace py = pybind11;
 
     namespace process {
+        namespace {
+            /* numpy columns {tm: datetime64[ns], upx: float64} for events
+             * visited by visit_fn.  Store is a tree,  so this is one pass
+             * straight into column storage,  adopted by numpy without a
+             * further copy -- no per-event UpxEvent wrappers
+             *
+             * Require:
+             * - VisitFn :: (Fn) -> uint32,  Fn :: (UpxEvent -> )
+             */
+            template <typename VisitFn>
+            py::dict
+            upx_columns(std::uint32_t n_hint, VisitFn && visit_fn)
+            {
+                std::vector<std::int64_t> tm_v;
+                std::vector<double> upx_v;
+
+                tm_v.reserve(n_hint);
+                upx_v.reserve(n_hint);
+
+                visit_fn([&tm_v, &upx_v](UpxEvent const & ev)
+                    {
+                        tm_v.push_back(pyutil::datetime64_ns(ev.tm()));
+                        upx_v.push_back(ev.upx());
+                    });
+
+                py::dict retval;
+                retval["tm"] = pyutil::adopt_vector(std::move(tm_v),
+                                                    pyutil::datetime64_ns_dtype());
+                retval["upx"] = pyutil::adopt_vector(std::move(upx_v));
+
+                return retval;
+            } /*upx_columns*/
+        } /*namespace*/
+
         PYBIND11_MODULE(PYPROCESS_MODULE_NAME(), m) {
             /* ensure process/ will be initialized */
             InitSubsys<S_process_tag>::require();
@@ -79,6 +120,38 @@ namespace xo {
                 .def_property_readonly("t0", &StochasticProcess<double>::t0)
                 .def_property_readonly("t0_value", &StochasticProcess<double>::t0_value)
                 .def("exterior_sample", &StochasticProcess<double>::exterior_sample)
+                .def("sample_paths",
+                     [](StochasticProcess<double> & self,
+                        std::vector<xo::time::utc_nanos> const & t_v,
+                        std::size_t n_paths)
+                         {
+                             std::vector<double> out(n_paths * t_v.size());
+
+                             self.sample_paths(t_v, n_paths, out);
+
+                             return out;
+                         },
+                     py::doc("Sample n_paths realizations on time grid t_v.\n"
+                             "Returns flat row-major list: out[i * len(t_v) + j] is path i at t_v[j]"),
+                     py::arg("t_v"), py::arg("n_paths"))
+                .def("sample_paths_array",
+                     [](StochasticProcess<double> & self,
+                        std::vector<xo::time::utc_nanos> const & t_v,
+                        std::size_t n_paths)
+                         {
+                             py::array_t<double> out({n_paths, t_v.size()});
+
+                             /* sample straight into numpy storage */
+                             self.sample_paths(t_v,
+                                               n_paths,
+                                               std::span<double>(out.mutable_data(),
+                                                                 n_paths * t_v.size()));
+
+                             return out;
+                         },
+                     py::doc("Sample n_paths realizations on time grid t_v.\n"
+                             "Returns numpy array with shape (n_paths, len(t_v))"),
+                     py::arg("t_v"), py::arg("n_paths"))
                 .def("__repr__", &StochasticProcess<double>::display_string);
 
             py::class_<BrownianMotion<xoshiro256ss>,
@@ -147,7 +220,26 @@ namespace xo {
                 .def_property_readonly("empty", &UpxEventStore::empty)
                 .def_property_readonly("size", &UpxEventStore::size)
                 .def("last_n", &UpxEventStore::last_n, py::arg("n"))
-                .def("last_dt", &UpxEventStore::last_dt, py::arg("dt"));
+                .def("last_dt", &UpxEventStore::last_dt, py::arg("dt"))
+                /* numpy equivalents of .last_n(), .last_dt():
+                 * dict of columns {tm, upx} instead of list of UpxEvent
+                 */
+                .def("last_n_columns",
+                     [](UpxEventStore const & self, std::uint32_t n)
+                         {
+                             return upx_columns(std::min(n, self.size()),
+                                                [&self, n](auto && fn)
+                                                    { return self.visit_last_n(n, fn); });
+                         },
+                     py::arg("n"))
+                .def("last_dt_columns",
+                     [](UpxEventStore const & self, xo::time::nanos dt)
+                         {
+                             return upx_columns(0,
+                                                [&self, dt](auto && fn)
+                                                    { return self.visit_last_dt(dt, fn); });
+                         },
+                     py::arg("dt"));
             //.def("__repr__", &UpxEventStore::display_string);
 
             /* temporary -- to reveal compiler errors */
@@ -164,6 +256,22 @@ namespace xo {
              */
             m.def("make_realization_printer", &UpxToConsole::make);
 
+            py::class_<UpxToFunction,
+                       AbstractSink,
+                       rp<UpxToFunction>>
+                (m, "UpxToFunction");
+
+            /* invokes fn(ev) for each UpxEvent ev.
+             * fn runs with the GIL reacquired,  so sink may be driven from
+             * a reactor that released it (e.g. Simulator.run_until)
+             */
+            m.def("make_realization_callback",
+                  [](py::function fn)
+                      {
+                          return UpxToFunction::make(pycallback(std::move(fn)));
+                      },
+                  py::arg("fn"));
+
 #ifdef OBSOLETE
             /* this implementation fails -- looks like .so libraries
              * have separate typeinfo for std::pair<utc_nanos, double>
@@ -0,0 +1,100 @@
+"""Smoke tests for the numpy column exports on xo_pyprocess.UpxEventStore.
+
+UpxEventStore.last_n_columns() / .last_dt_columns() return a dict of numpy
+columns {tm, upx}; these must agree with the per-event lists from
+.last_n() / .last_dt().
+
+Run via ctest (see CMakeLists.txt), which puts xo_pyprocess and the
+modules it imports on PYTHONPATH.
+"""
+
+import datetime as dt
+import unittest
+
+import numpy as np
+
+import xo_pyprocess as pyprocess
+
+_DATETIME64_NS = np.dtype("datetime64[ns]")
+
+
+def to_ns(tm):
+    """Nanoseconds since epoch for a timestamp returned by the bindings.
+
+    pybind11 converts utc_nanos to datetime.datetime, keeping microseconds;
+    events here are on whole seconds, so nothing is lost.
+    """
+    return int(round(tm.timestamp() * 1_000_000)) * 1000
+
+
+def make_store(n_event):
+    """UpxEventStore holding n_event samples, one second apart."""
+    t0 = dt.datetime(2026, 10, 1, 9, 30, 0)
+    ebm = pyprocess.make_exponential_brownian_motion(t0, 100.0, 0.5)
+    src = pyprocess.make_realization_source(ebm, dt.timedelta(seconds=1))
+    store = pyprocess.UpxEventStore.make()
+
+    src.attach_sink(store)
+    src.deliver_n(n_event)
+
+    return store
+
+
+class TestUpxColumns(unittest.TestCase):
+    def assert_matches_events(self, cols, ev_v):
+        self.assertEqual(set(cols.keys()), {"tm", "upx"})
+
+        tm = cols["tm"]
+        upx = cols["upx"]
+
+        self.assertEqual(tm.dtype, _DATETIME64_NS)
+        self.assertEqual(upx.dtype, np.dtype(np.float64))
+        self.assertEqual(tm.shape, (len(ev_v),))
+        self.assertEqual(upx.shape, (len(ev_v),))
+
+        self.assertEqual(tm.astype(np.int64).tolist(),
+                         [to_ns(ev.tm) for ev in ev_v])
+        self.assertEqual(upx.tolist(), [ev.upx for ev in ev_v])
+
+    def test_last_n_columns(self):
+        store = make_store(10)
+
+        self.assertEqual(store.size, 10)
+
+        for n in (1, 4, 10, 100):
+            with self.subTest(n=n):
+                cols = store.last_n_columns(n)
+
+                self.assert_matches_events(cols, store.last_n(n))
+                self.assertEqual(cols["tm"].shape, (min(n, 10),))
+
+    def test_last_dt_columns(self):
+        store = make_store(10)
+
+        for secs in (0, 3, 60):
+            with self.subTest(secs=secs):
+                dt_ = dt.timedelta(seconds=secs)
+
+                self.assert_matches_events(store.last_dt_columns(dt_),
+                                           store.last_dt(dt_))
+
+    def test_tm_increasing_one_second_apart(self):
+        tm = make_store(5).last_n_columns(5)["tm"]
+
+        self.assertTrue(np.all(np.diff(tm) == np.timedelta64(1, "s")))
+
+    def test_empty_store(self):
+        store = pyprocess.UpxEventStore.make()
+
+        self.assertTrue(store.empty)
+
+        for cols in (store.last_n_columns(5),
+                     store.last_dt_columns(dt.timedelta(seconds=5))):
+            self.assertEqual(cols["tm"].dtype, _DATETIME64_NS)
+            self.assertEqual(cols["upx"].dtype, np.dtype(np.float64))
+            self.assertEqual(cols["tm"].shape, (0,))
+            self.assertEqual(cols["upx"].shape, (0,))
+
+
+if __name__ == "__main__":
+    unittest.main()
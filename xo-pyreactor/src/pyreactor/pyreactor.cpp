@@ -2,6 +2,7 @@
 
 #include "pyreactor.hpp"
 #include <xo/reactor/EventStore.hpp>
+#include <xo/reactor/PollingReactor.hpp>
 #include <xo/reactor/Reactor.hpp>
 #include <xo/reactor/ReactorSource.hpp>
 #include <xo/reactor/Sink.hpp>
@@ -96,9 +97,36 @@ namespace xo {
                          return self.http_endpoint_descr(PrintJsonSingleton::instance(), url_prefix);
                      },
                      py::arg("url_prefix"))
+                .def("columnar_snapshot_last_n",
+                     [](AbstractEventStore & self, std::uint32_t n) {
+                         std::stringstream ss;
+                         self.columnar_snapshot_last_n(n, &ss);
+                         return py::bytes(ss.str());
+                     },
+                     py::arg("n"))
+                .def("columnar_snapshot_last_dt",
+                     [](AbstractEventStore & self, xo::time::nanos dt) {
+                         std::stringstream ss;
+                         self.columnar_snapshot_last_dt(dt, &ss);
+                         return py::bytes(ss.str());
+                     },
+                     py::arg("dt"))
+                .def("http_colsnap_n_endpoint_descr",
+                     &AbstractEventStore::http_colsnap_n_endpoint_descr,
+                     py::arg("url_prefix"))
+                .def("http_colsnap_dt_endpoint_descr",
+                     &AbstractEventStore::http_colsnap_dt_endpoint_descr,
+                     py::arg("url_prefix"))
                 .def("clear",
                      &AbstractEventStore::clear);
 
+            /* run_one(), run_n() release the GIL while dispatching events,
+             * so reactors can run concurrently in separate python threads.
+             * Sinks that call back into python must reacquire the GIL
+             * (see xo::pyutil::pycallback).
+             * Don't touch objects reachable from a running reactor from another
+             * python thread until it returns.
+             */
             py::class_<Reactor,
                        rp<Reactor>>
                 (m, "Reactor")
@@ -110,8 +138,16 @@ namespace xo {
                      [](Reactor & self, rp<ReactorSource> src) {
                          return self.remove_source(src.borrow());
                      })
-                .def("run_one", &Reactor::run_one)
-                .def("run_n",   &Reactor::run_n, py::arg("n"));
+                .def("run_one", &Reactor::run_one,
+                     py::call_guard<py::gil_scoped_release>())
+                .def("run_n",   &Reactor::run_n, py::arg("n"),
+                     py::call_guard<py::gil_scoped_release>());
+
+            py::class_<PollingReactor,
+                       Reactor,
+                       rp<PollingReactor>>
+                (m, "PollingReactor")
+                .def_static("make", &PollingReactor::make);
 
 #ifdef NOT_IN_USE  // trying removed code in ProcessPy.cpp instead for now
             /* prints
@@ -32,6 +32,10 @@ namespace xo {
                   },
                   "create new Simulator instance");
 
+            py::enum_<SourceQueuePolicy>(m, "SourceQueuePolicy")
+                .value("binary_heap", SourceQueuePolicy::binary_heap)
+                .value("radix_heap", SourceQueuePolicy::radix_heap);
+
             py::class_<TimeSlip>(m, "TimeSlip")
                 .def_property_readonly("sim_tm", &TimeSlip::sim_tm)
                 .def_property_readonly("real_tm", &TimeSlip::real_tm)
@@ -41,13 +45,30 @@ namespace xo {
             py::class_<Simulator,
                        Reactor,
                        xo::ref::intrusive_ptr<Simulator>>(m, "Simulator")
-                .def_static("make", []() { return xo::sim::Simulator::make(xo::time::timeutil::epoch()); })
+                .def_static("make",
+                            [](SourceQueuePolicy policy) {
+                                return xo::sim::Simulator::make(xo::time::timeutil::epoch(), policy);
+                            },
+                            py::arg("policy") = SourceQueuePolicy::binary_heap)
+                .def_property_readonly("queue_policy", &Simulator::queue_policy)
                 .def_property_readonly("start_tm", &Simulator::t0)
                 .def_property_readonly("last_tm", &Simulator::last_tm)
                 .def_property_readonly("n_event", &Simulator::n_event)
                 .def_property_readonly("is_exhausted", &Simulator::is_exhausted)
                 .def("next_tm", &Simulator::next_tm)
                 .def("next_src", &Simulator::next_src)
+                /* sim loops release the GIL (like Reactor.run_one / .run_n),
+                 * so several simulations can run in separate python threads
+                 */
+                .def("run_until", &Simulator::run_until,
+                     py::arg("t1"),
+                     py::call_guard<py::gil_scoped_release>())
+                .def("run_until_batched", &Simulator::run_until_batched,
+                     py::arg("t1"),
+                     py::call_guard<py::gil_scoped_release>())
+                .def("run_throttled_until", &Simulator::run_throttled_until,
+                     py::arg("t1"), py::arg("n"), py::arg("replay_factor"),
+                     py::call_guard<py::gil_scoped_release>())
                 .def("timeslip", &Simulator::timeslip)
                 .def("throttled_event_dt", &Simulator::throttled_event_dt)
                 .def("heap_contents", &Simulator::heap_contents)
@@ -0,0 +1,69 @@
+/** @file pycallback.hpp
+ *
+ *  Author: Roland Conybeare
+ **/
+
+#pragma once
+
+#include <pybind11/pybind11.h>
+#include <utility>
+
+namespace xo {
+    namespace pyutil {
+        /** @class pycallback
+         *  @brief Python callable that c++ may invoke from a thread not holding the GIL.
+         *
+         *  Use to hand a python function to c++ code that runs with the GIL released
+         *  (see py::call_guard<py::gil_scoped_release>), e.g. a reactor sink:
+         *  the GIL is reacquired only for the duration of each call.
+         *
+         *  Copy and destruction also take the GIL,  since they adjust the python refcount.
+         *
+         *  Return value of the python function is discarded (while still holding the GIL);
+         *  a python exception propagates as pybind11::error_already_set.
+         **/
+        class pycallback {
+        public:
+            explicit pycallback(pybind11::function fn) : fn_{std::move(fn)} {}
+
+            pycallback(pycallback const & x) {
+                pybind11::gil_scoped_acquire gil;
+
+                this->fn_ = x.fn_;
+            }
+
+            pycallback(pycallback && x) noexcept = default;
+
+            ~pycallback() {
+                if (!fn_)
+                    return;
+
+                if (Py_IsInitialized()) {
+                    pybind11::gil_scoped_acquire gil;
+
+                    this->fn_ = pybind11::function();
+                } else {
+                    /* interpreter already gone (static destruction at exit):
+                     * nothing left to decref against
+                     */
+                    this->fn_.release();
+                }
+            }
+
+            pycallback & operator=(pycallback const & x) = delete;
+            pycallback & operator=(pycallback && x) = delete;
+
+            template <typename... Args>
+            void operator()(Args &&... args) const {
+                pybind11::gil_scoped_acquire gil;
+
+                fn_(std::forward<Args>(args)...);
+            }
+
+        private:
+            pybind11::function fn_;
+        }; /*pycallback*/
+    } /*namespace pyutil*/
+} /*namespace xo*/
+
+/** end pycallback.hpp **/
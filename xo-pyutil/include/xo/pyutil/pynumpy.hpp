@@ -0,0 +1,64 @@
+/** @file pynumpy.hpp
+ *
+ *  Author: Roland Conybeare
+ **/
+
+#pragma once
+
+#include <pybind11/numpy.h>
+#include <pybind11/pybind11.h>
+#include <chrono>
+#include <cstdint>
+#include <vector>
+
+namespace xo {
+    namespace pyutil {
+        /** @brief numpy dtype for nanosecond timestamps (datetime64[ns]).
+         *
+         *  Element representation is int64 nanoseconds since the unix epoch,
+         *  i.e. @c utc_nanos::time_since_epoch().count()
+         **/
+        inline pybind11::dtype
+        datetime64_ns_dtype() {
+            return pybind11::dtype::from_args(pybind11::str("datetime64[ns]"));
+        }
+
+        /** @brief numpy datetime64[ns] representation of timestamp @p tm **/
+        template <typename Clock>
+        inline std::int64_t
+        datetime64_ns(std::chrono::time_point<Clock, std::chrono::nanoseconds> tm) {
+            return tm.time_since_epoch().count();
+        }
+
+        /** @brief 1-d numpy array adopting the storage of @p v (no copy).
+         *
+         *  @p v is moved to the heap and owned by a capsule held as the array's base;
+         *  storage is freed when the last numpy view over it is released.
+         *  Use with @p dt to reinterpret elements, e.g. int64 as datetime64[ns].
+         **/
+        template <typename T>
+        pybind11::array
+        adopt_vector(std::vector<T> && v, pybind11::dtype dt) {
+            auto * p = new std::vector<T>(std::move(v));
+
+            pybind11::capsule owner(p,
+                                    [](void * x) {
+                                        delete reinterpret_cast<std::vector<T> *>(x);
+                                    });
+
+            return pybind11::array(dt,
+                                   {static_cast<pybind11::ssize_t>(p->size())},
+                                   {static_cast<pybind11::ssize_t>(sizeof(T))},
+                                   p->data(),
+                                   owner);
+        } /*adopt_vector*/
+
+        template <typename T>
+        pybind11::array
+        adopt_vector(std::vector<T> && v) {
+            return adopt_vector(std::move(v), pybind11::dtype::of<T>());
+        } /*adopt_vector*/
+    } /*namespace pyutil*/
+} /*namespace xo*/
+
+/** end pynumpy.hpp **/
@@ -12,6 +12,8 @@ namespace xo {
     using xo::web::WebserverConfig;
     using xo::web::Webserver;
     using xo::web::Runstate;
+    using xo::web::WsOverflowPolicy;
+    using xo::web::WsSessionStats;
     using xo::json::PrintJsonSingleton;
     using xo::rp;
     namespace py = pybind11;
@@ -28,16 +30,35 @@ namespace xo {
                 .value("stop_requested", Runstate::stop_requested)
                 .value("running", Runstate::running);
 
+            py::enum_<WsOverflowPolicy>(m, "WsOverflowPolicy")
+                .value("drop_newest", WsOverflowPolicy::drop_newest)
+                .value("drop_oldest", WsOverflowPolicy::drop_oldest)
+                .value("coalesce", WsOverflowPolicy::coalesce);
+
+            py::class_<WsSessionStats>(m, "WsSessionStats")
+                .def_readonly("session_id", &WsSessionStats::session_id_)
+                .def_readonly("queue_depth", &WsSessionStats::queue_depth_)
+                .def_readonly("max_queue_depth", &WsSessionStats::max_queue_depth_)
+                .def_readonly("n_enqueued", &WsSessionStats::n_enqueued_)
+                .def_readonly("n_sent", &WsSessionStats::n_sent_)
+                .def_readonly("n_dropped", &WsSessionStats::n_dropped_);
+
             py::class_<WebserverConfig>(m, "WebserverConfig")
-                .def(py::init<uint32_t, bool, bool, bool>(),
+                .def(py::init<uint32_t, bool, bool, bool, uint32_t, uint32_t, WsOverflowPolicy>(),
                      py::arg("port"),
                      py::arg("tls_flag"),
                      py::arg("host_check_flag"),
-                     py::arg("use_retry_flag"))
+                     py::arg("use_retry_flag"),
+                     py::arg("n_service_thread") = 1,
+                     py::arg("send_queue_capacity") = WebserverConfig::c_default_send_queue_capacity,
+                     py::arg("overflow_policy") = WsOverflowPolicy::drop_oldest)
                 .def_property_readonly("port", &WebserverConfig::port)
                 .def_property_readonly("tls_flag", &WebserverConfig::tls_flag)
                 .def_property_readonly("host_check_flag", &WebserverConfig::host_check_flag)
-                .def_property_readonly("use_retry_flag", &WebserverConfig::use_retry_flag);
+                .def_property_readonly("use_retry_flag", &WebserverConfig::use_retry_flag)
+                .def_property_readonly("n_service_thread", &WebserverConfig::n_service_thread)
+                .def_property_readonly("send_queue_capacity", &WebserverConfig::send_queue_capacity)
+                .def_property_readonly("overflow_policy", &WebserverConfig::overflow_policy);
 
             py::class_<Webserver, rp<Webserver>>(m, "Webserver")
                 .def_static("make",
@@ -52,6 +73,7 @@ namespace xo {
                 .def("start_webserver", &Webserver::start_webserver)
                 .def("stop_webserver", &Webserver::stop_webserver)
                 .def("join_webserver", &Webserver::join_webserver)
+                .def("session_stats", &Webserver::session_stats)
                 .def("__repr__", &Webserver::display_string);
 
             m.def("make_webserver",
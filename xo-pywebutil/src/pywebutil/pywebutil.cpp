@@ -22,6 +22,7 @@ namespace xo {
 
             py::class_<HttpEndpointDescr>(m, "EndpointDescr")
                 .def_property_readonly("uri_pattern", &HttpEndpointDescr::uri_pattern)
+                .def_property_readonly("mime_type", &HttpEndpointDescr::mime_type)
                 .def("__repr__", &HttpEndpointDescr::display_string);
 
             py::class_<StreamEndpointDescr>(m, "StreamEndpointDescr")
@@ -0,0 +1,129 @@
+/* @file ex3.cpp
+ *
+ * benchmark:  normal variates/sec,
+ *   normalgen<xoshiro256ss>       (one sample per call,  std::normal_distribution)
+ * vs.
+ *   zig_normalgen<xoshiro256ssx4> (bulk .fill(),  ziggurat)
+ *   zig_normalgen<xoshiro256ssx8>
+ *
+ * Also prints sample moments,  as a sanity check on the ziggurat sampler.
+ *
+ * use:
+ *   $ randomgen_ex3 [n_sample]
+ */
+
+#include "xo/randomgen/normalgen.hpp"
+#include "xo/randomgen/xoshiro256.hpp"
+#include "xo/randomgen/xoshiro256x.hpp"
+#include <chrono>
+#include <cmath>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+using namespace xo;
+using namespace xo::rng;
+
+namespace {
+    /* print rate + sample moments of v[] */
+    void
+    report(char const * label, std::vector<double> const & v, double dt_sec)
+    {
+        double m1 = 0.0;
+        double m2 = 0.0;
+        double m4 = 0.0;
+
+        for (double x : v) {
+            m1 += x;
+            m2 += x * x;
+            m4 += x * x * x * x;
+        }
+
+        double n = v.size();
+
+        std::cout << label
+                  << ": " << (n / dt_sec) * 1e-6 << " M normals/sec"
+                  << "  mean=" << (m1 / n)
+                  << "  var=" << (m2 / n)
+                  << "  m4=" << (m4 / n)
+                  << std::endl;
+    } /*report*/
+
+    template <typename Fn>
+    double
+    time_sec(Fn && fn)
+    {
+        auto t0 = std::chrono::steady_clock::now();
+        fn();
+        auto t1 = std::chrono::steady_clock::now();
+
+        return std::chrono::duration<double>(t1 - t0).count();
+    } /*time_sec*/
+} /*namespace*/
+
+int
+main(int argc, char ** argv) {
+    std::size_t n = 10000000;
+
+    if (argc > 1)
+        n = std::strtoull(argv[1], nullptr, 10);
+
+    std::uint64_t seed = 12345678901234567UL;
+
+    std::vector<double> v(n);
+
+    {
+        auto rng = normalgen<xoshiro256ss>::make(xoshiro256ss(seed),
+                                                 std::normal_distribution<double>(0.0, 1.0));
+
+        double dt = time_sec([&]() { for (auto & x : v) x = rng(); });
+
+        report("normalgen<xoshiro256ss>         ", v, dt);
+    }
+
+    {
+        auto rng = zig_normalgen<xoshiro256ssx4>::make(xoshiro256ssx4(seed),
+                                                       ziggurat_normal_distribution(0.0, 1.0));
+
+        double dt = time_sec([&]() { for (auto & x : v) x = rng(); });
+
+        report("zig_normalgen<xoshiro256ssx4>() ", v, dt);
+    }
+
+    {
+        auto rng = zig_normalgen<xoshiro256ssx4>::make(xoshiro256ssx4(seed),
+                                                       ziggurat_normal_distribution(0.0, 1.0));
+
+        double dt = time_sec([&]() { rng.fill(v); });
+
+        report("zig_normalgen<xoshiro256ssx4>.fill", v, dt);
+    }
+
+    {
+        auto rng = zig_normalgen<xoshiro256ssx8>::make(xoshiro256ssx8(seed),
+                                                       ziggurat_normal_distribution(0.0, 1.0));
+
+        double dt = time_sec([&]() { rng.fill(v); });
+
+        report("zig_normalgen<xoshiro256ssx8>.fill", v, dt);
+    }
+
+    /* lane 0 of multi-lane engine reproduces scalar engine */
+    {
+        xoshiro256ss rng1(seed);
+        xoshiro256ssx4 rng4(seed);
+
+        std::vector<std::uint64_t> u(4 * 1000);
+        rng4.fill(u);
+
+        std::size_t n_mismatch = 0;
+        for (std::size_t i = 0; i < 1000; ++i)
+            n_mismatch += (u[4 * i] != rng1());
+
+        std::cout << "xoshiro256ssx4 lane0 vs xoshiro256ss: n_mismatch=" << n_mismatch << std::endl;
+    }
+
+    return 0;
+} /*main*/
+
+/* end ex3.cpp */
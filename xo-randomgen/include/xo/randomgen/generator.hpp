@@ -4,6 +4,7 @@
 
 #include "distribution_concept.hpp"
 #include "engine_concept.hpp"
+#include <span>
 #include <utility>
 
 namespace xo {
@@ -29,8 +30,25 @@ namespace xo {
                 return generator(e, d);
             }
 
+            Engine & engine() { return engine_; }
+            Distribution const & distribution() const { return distribution_; }
+
             result_type operator()() { return this->distribution_(this->engine_); }
 
+            /* fill out[] with samples.
+             * Uses Distribution.fill(engine, out) when available
+             * (e.g. ziggurat_normal_distribution),  otherwise one call to
+             * .operator()() per element.
+             */
+            void fill(std::span<result_type> out) {
+                if constexpr (requires { this->distribution_.fill(this->engine_, out); }) {
+                    this->distribution_.fill(this->engine_, out);
+                } else {
+                    for (auto & x : out)
+                        x = (*this)();
+                }
+            }
+
         private:
             /* random number generator;  generates uniformly-distributed integers */
             Engine engine_;
@@ -3,6 +3,7 @@
 #pragma once
 
 #include "generator.hpp"
+#include "ziggurat_normal_distribution.hpp"
 #include <random>
 
 namespace xo {
@@ -10,5 +11,11 @@ namespace xo {
         /* Engine: e.g. xo::rng::xoshiro256 or std::mt19937 */
         template <class Engine>
         using normalgen = generator<Engine, std::normal_distribution<double>>;
+
+        /* normal generator using ziggurat sampler;  fast bulk .fill().
+         * Engine: e.g. xo::rng::xoshiro256ssx4
+         */
+        template <class Engine>
+        using zig_normalgen = generator<Engine, ziggurat_normal_distribution>;
     } /*namespace rng*/
 } /*namespace xo*/
@@ -0,0 +1,109 @@
+/* @file uniform53_distribution.hpp */
+
+#pragma once
+
+#include "xoshiro256x.hpp"
+#include <algorithm>
+#include <array>
+#include <cstdint>
+#include <cstddef>
+#include <span>
+
+namespace xo {
+    namespace rng {
+        /* uniform distribution on [lo, hi),  with 53 bits of resolution:
+         * one 64-bit engine output per sample,  mapped by
+         *   lo + (hi - lo) * (u >> 11) / 2^53
+         *
+         * Drop-in for std::uniform_real_distribution<double>
+         * (satisfies distribution_concept),  plus bulk .fill(engine, span).
+         * Unlike libstdc++'s generate_canonical(),  mapping is a fixed
+         * shift + multiply,  so .fill() vectorizes.
+         */
+        class uniform53_distribution {
+        public:
+            using result_type = double;
+
+            struct param_type {
+                using distribution_type = uniform53_distribution;
+
+                param_type() = default;
+                param_type(double lo, double hi) : lo_{lo}, hi_{hi} {}
+
+                double a() const { return lo_; }
+                double b() const { return hi_; }
+
+                bool operator==(param_type const & x) const = default;
+
+                double lo_ = 0.0;
+                double hi_ = 1.0;
+            };
+
+        public:
+            uniform53_distribution() = default;
+            explicit uniform53_distribution(param_type const & p) : p_{p} {}
+            uniform53_distribution(double lo, double hi) : p_{lo, hi} {}
+
+            double a() const { return p_.a(); }
+            double b() const { return p_.b(); }
+
+            /* no state carried between samples */
+            void reset() {}
+            param_type const & param() const { return p_; }
+            void param(param_type const & p) { p_ = p; }
+
+            double min() const { return p_.a(); }
+            double max() const { return p_.b(); }
+
+            bool operator==(uniform53_distribution const & x) const = default;
+
+            template <class Engine>
+            double operator()(Engine & eng) {
+                return (*this)(eng, p_);
+            }
+
+            template <class Engine>
+            double operator()(Engine & eng, param_type const & p) {
+                return p.a() + (p.b() - p.a()) * unit(eng());
+            }
+
+            /* fill out[] with samples */
+            template <class Engine>
+            void fill(Engine & eng, std::span<double> out) {
+                this->fill(eng, out, p_);
+            }
+
+            template <class Engine>
+            void fill(Engine & eng, std::span<double> out, param_type const & p) {
+                constexpr std::size_t c_block = 256;
+
+                std::array<std::uint64_t, c_block> bits;
+
+                double const lo = p.a();
+                double const w = p.b() - p.a();
+
+                for (std::size_t lo_ix = 0; lo_ix < out.size(); lo_ix += c_block) {
+                    std::size_t n = std::min(c_block, out.size() - lo_ix);
+                    double * y = out.data() + lo_ix;
+
+                    fill_bits(eng, std::span<std::uint64_t>(bits.data(), n));
+
+                    for (std::size_t k = 0; k < n; ++k)
+                        y[k] = lo + w * unit(bits[k]);
+                }
+            } /*fill*/
+
+        private:
+            /* bits 11..63 of u,  as uniform in [0, 1) */
+            static double unit(std::uint64_t u) {
+                return static_cast<double>(u >> 11) * 0x1.0p-53;
+            }
+
+        private:
+            param_type p_;
+        }; /*uniform53_distribution*/
+
+    } /*namespace rng*/
+} /*namespace xo*/
+
+/* end uniform53_distribution.hpp */
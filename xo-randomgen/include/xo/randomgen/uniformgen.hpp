@@ -3,6 +3,7 @@
 #pragma once
 
 #include "generator.hpp"
+#include "uniform53_distribution.hpp"
 #include <random>
 
 namespace xo {
@@ -26,6 +27,12 @@ namespace xo {
                                       std::uniform_real_distribution<double>(lo, hi));
             }
         };
+
+        /* uniform generator with 53-bit resolution;  fast bulk .fill().
+         * Engine: e.g. xo::rng::xoshiro256ssx4
+         */
+        template <class Engine>
+        using uniform53gen = generator<Engine, uniform53_distribution>;
     } /*namespace rng*/
 } /*namespace xo*/
 
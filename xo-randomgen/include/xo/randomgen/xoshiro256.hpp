@@ -53,6 +53,9 @@ namespace xo {
                     return (x << k) | (x >> (64 - k));
                 }
 
+            /* generator state;  xoshiro256ss(x.state()) == x */
+            seed_type const & state() const { return s_; }
+
             static bool equal(xoshiro256ss const & x, xoshiro256ss const & y) {
                 return ((x.s_[0] == y.s_[0])
                         && (x.s_[1] == y.s_[1])
@@ -0,0 +1,238 @@
+/* @file ziggurat_normal_distribution.hpp */
+
+#pragma once
+
+#include "xoshiro256x.hpp"
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <cstddef>
+#include <limits>
+#include <span>
+
+namespace xo {
+    namespace rng {
+        /* layer tables for ziggurat normal sampler.
+         *
+         * 256 layers of equal area v under f(x) = exp(-x^2/2),  x >= 0;
+         * layer 0 is the base strip,  including the tail beyond r.
+         * Constants from Marsaglia & Tsang (2000);  layout follows Doornik (2005):
+         *   x[0] = v/f(r),  x[1] = r,  x[i+1] = f^-1(v/x[i] + f(x[i])),  x[256] = 0
+         */
+        struct ziggurat_normal_table {
+            static constexpr std::size_t c_n_layer = 256;
+            /* right edge of base layer */
+            static constexpr double c_r = 3.6541528853610088;
+            /* area of each layer */
+            static constexpr double c_v = 0.00492867323399;
+
+            static double f(double x) { return std::exp(-0.5 * x * x); }
+
+            static ziggurat_normal_table const & instance() {
+                static ziggurat_normal_table s_table;
+                return s_table;
+            }
+
+            /* .x[i]:  right edge of layer i */
+            std::array<double, c_n_layer + 1> x_;
+            /* .ratio[i] = .x[i+1] / .x[i]:  fraction of layer i
+             * that lies entirely under f
+             */
+            std::array<double, c_n_layer> ratio_;
+            /* .fx[i] = f(.x[i]) */
+            std::array<double, c_n_layer + 1> fx_;
+
+        private:
+            ziggurat_normal_table() {
+                x_[0] = c_v / f(c_r);
+                x_[1] = c_r;
+                for (std::size_t i = 2; i < c_n_layer; ++i)
+                    x_[i] = std::sqrt(-2.0 * std::log(c_v / x_[i-1] + f(x_[i-1])));
+                x_[c_n_layer] = 0.0;
+
+                for (std::size_t i = 0; i < c_n_layer; ++i)
+                    ratio_[i] = x_[i+1] / x_[i];
+                for (std::size_t i = 0; i <= c_n_layer; ++i)
+                    fx_[i] = f(x_[i]);
+            }
+        }; /*ziggurat_normal_table*/
+
+        /* normal distribution,  sampled with the ziggurat method.
+         *
+         * Drop-in for std::normal_distribution<double> (satisfies distribution_concept),
+         * plus bulk .fill(engine, span).
+         *
+         * One 64-bit engine output per sample on the fast path (~99% of samples):
+         *   bits 0..7    select layer
+         *   bits 11..63  uniform in [-1, 1)
+         * Rejected samples draw more engine output,  one value at a time.
+         *
+         * .fill() draws engine output in blocks (see fill_bits()),
+         * so with a multi-lane engine (xoshiro256ssx) both bit generation
+         * and the fast path run across a buffer of samples.
+         */
+        class ziggurat_normal_distribution {
+        public:
+            using result_type = double;
+
+            struct param_type {
+                using distribution_type = ziggurat_normal_distribution;
+
+                param_type() = default;
+                param_type(double mean, double sdev) : mean_{mean}, sdev_{sdev} {}
+
+                double mean() const { return mean_; }
+                double stddev() const { return sdev_; }
+
+                bool operator==(param_type const & x) const = default;
+
+                double mean_ = 0.0;
+                double sdev_ = 1.0;
+            };
+
+        public:
+            ziggurat_normal_distribution() = default;
+            explicit ziggurat_normal_distribution(param_type const & p) : p_{p} {}
+            ziggurat_normal_distribution(double mean, double sdev) : p_{mean, sdev} {}
+
+            double mean() const { return p_.mean(); }
+            double stddev() const { return p_.stddev(); }
+
+            /* no state carried between samples */
+            void reset() {}
+            param_type const & param() const { return p_; }
+            void param(param_type const & p) { p_ = p; }
+
+            static constexpr double min() { return std::numeric_limits<double>::lowest(); }
+            static constexpr double max() { return std::numeric_limits<double>::max(); }
+
+            bool operator==(ziggurat_normal_distribution const & x) const = default;
+
+            template <class Engine>
+            double operator()(Engine & eng) {
+                return (*this)(eng, p_);
+            }
+
+            template <class Engine>
+            double operator()(Engine & eng, param_type const & p) {
+                return p.mean() + p.stddev() * sample(eng, eng());
+            }
+
+            /* fill out[] with samples */
+            template <class Engine>
+            void fill(Engine & eng, std::span<double> out) {
+                this->fill(eng, out, p_);
+            }
+
+            template <class Engine>
+            void fill(Engine & eng, std::span<double> out, param_type const & p) {
+                ziggurat_normal_table const & tbl = ziggurat_normal_table::instance();
+
+                constexpr std::size_t c_block = 256;
+
+                std::array<std::uint64_t, c_block> bits;
+                std::array<std::uint32_t, c_block> reject_v;
+
+                double const mean = p.mean();
+                double const sdev = p.stddev();
+
+                for (std::size_t lo = 0; lo < out.size(); lo += c_block) {
+                    std::size_t n = std::min(c_block, out.size() - lo);
+                    double * y = out.data() + lo;
+
+                    fill_bits(eng, std::span<std::uint64_t>(bits.data(), n));
+
+                    /* fast path,  branch-free;  remember rejected positions */
+                    std::size_t n_reject = 0;
+
+                    for (std::size_t k = 0; k < n; ++k) {
+                        std::uint64_t u = bits[k];
+                        std::size_t i = u & 0xff;
+                        double s = signed_unit(u);
+
+                        y[k] = mean + sdev * (s * tbl.x_[i]);
+
+                        reject_v[n_reject] = k;
+                        n_reject += !(std::fabs(s) < tbl.ratio_[i]);
+                    }
+
+                    /* slow path for rejected samples */
+                    for (std::size_t j = 0; j < n_reject; ++j) {
+                        std::uint32_t k = reject_v[j];
+
+                        y[k] = mean + sdev * sample_slow(eng, bits[k]);
+                    }
+                }
+            } /*fill*/
+
+        private:
+            /* bits 11..63 of u,  as uniform in [-1, 1) */
+            static double signed_unit(std::uint64_t u) {
+                return 2.0 * static_cast<double>(u >> 11) * 0x1.0p-53 - 1.0;
+            }
+
+            /* uniform in (0, 1] */
+            template <class Engine>
+            static double open_unit(Engine & eng) {
+                return 1.0 - static_cast<double>(eng() >> 11) * 0x1.0p-53;
+            }
+
+            /* standard normal sample,  starting from engine output u */
+            template <class Engine>
+            static double sample(Engine & eng, std::uint64_t u) {
+                ziggurat_normal_table const & tbl = ziggurat_normal_table::instance();
+
+                std::size_t i = u & 0xff;
+                double s = signed_unit(u);
+
+                if (std::fabs(s) < tbl.ratio_[i])
+                    return s * tbl.x_[i];
+
+                return sample_slow(eng, u);
+            }
+
+            /* standard normal sample,  given that u failed fast-path test */
+            template <class Engine>
+            static double sample_slow(Engine & eng, std::uint64_t u) {
+                ziggurat_normal_table const & tbl = ziggurat_normal_table::instance();
+
+                for (;;) {
+                    std::size_t i = u & 0xff;
+                    double s = signed_unit(u);
+
+                    if (std::fabs(s) < tbl.ratio_[i])
+                        return s * tbl.x_[i];
+
+                    if (i == 0) {
+                        /* tail beyond r (Marsaglia 1964) */
+                        double a = 0.0;
+                        double b = 0.0;
+
+                        do {
+                            a = -std::log(open_unit(eng)) / ziggurat_normal_table::c_r;
+                            b = -std::log(open_unit(eng));
+                        } while (b + b < a * a);
+
+                        return (s < 0.0) ? -(ziggurat_normal_table::c_r + a) : (ziggurat_normal_table::c_r + a);
+                    }
+
+                    /* wedge between layers i and i+1 */
+                    double x = s * tbl.x_[i];
+                    double w = 1.0 - open_unit(eng);
+
+                    if (tbl.fx_[i+1] + w * (tbl.fx_[i] - tbl.fx_[i+1]) < ziggurat_normal_table::f(x))
+                        return x;
+
+                    u = eng();
+                }
+            } /*sample_slow*/
+
+        private:
+            param_type p_;
+        }; /*ziggurat_normal_distribution*/
+
+    } /*namespace rng*/
+} /*namespace xo*/
+
+/* end ziggurat_normal_distribution.hpp */
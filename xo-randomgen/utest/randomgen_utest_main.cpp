@@ -0,0 +1,6 @@
+/* file randomgen_utest_main.cpp */
+
+#define CATCH_CONFIG_MAIN
+#include "catch2/catch.hpp"
+
+/* end randomgen_utest_main.cpp */
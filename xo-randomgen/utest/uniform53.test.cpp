@@ -0,0 +1,143 @@
+/* @file uniform53.test.cpp */
+
+#include "xo/randomgen/uniform53_distribution.hpp"
+#include "xo/randomgen/xoshiro256x.hpp"
+#include "xo/randomgen/xoshiro256.hpp"
+#include <catch2/catch.hpp>
+#include <algorithm>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <vector>
+
+namespace xo {
+    using xo::rng::uniform53_distribution;
+    using xo::rng::xoshiro256ss;
+    using xo::rng::xoshiro256ssx8;
+
+    namespace ut {
+        namespace {
+            /* engine that always returns the same value */
+            struct ConstEngine {
+                using result_type = std::uint64_t;
+
+                static constexpr std::uint64_t min() { return 0; }
+                static constexpr std::uint64_t max() { return std::numeric_limits<std::uint64_t>::max(); }
+
+                std::uint64_t operator()() { return value_; }
+
+                std::uint64_t value_ = 0;
+            };
+
+            /* KS statistic for sample_v vs uniform on [lo, hi) */
+            double
+            ks_stat(std::vector<double> sample_v, double lo, double hi)
+            {
+                std::sort(sample_v.begin(), sample_v.end());
+
+                double n = sample_v.size();
+                double d = 0.0;
+
+                for (std::size_t i = 0; i < sample_v.size(); ++i) {
+                    double f = (sample_v[i] - lo) / (hi - lo);
+
+                    d = std::max(d, std::max((i + 1) / n - f, f - i / n));
+                }
+
+                return d;
+            } /*ks_stat*/
+        } /*namespace*/
+
+        TEST_CASE("uniform53-extremes", "[randomgen][uniform53]") {
+            uniform53_distribution dist;
+
+            ConstEngine lo_eng{0};
+            ConstEngine hi_eng{std::numeric_limits<std::uint64_t>::max()};
+
+            REQUIRE(dist(lo_eng) == 0.0);
+            /* largest value is 1 - 2^-53:  strictly below 1 */
+            REQUIRE(dist(hi_eng) == 1.0 - 0x1.0p-53);
+            REQUIRE(dist(hi_eng) < 1.0);
+
+            /* low 11 bits are discarded */
+            ConstEngine low_bits_eng{(1UL << 11) - 1};
+
+            REQUIRE(dist(low_bits_eng) == 0.0);
+
+            /* bit 11 is the least significant bit retained */
+            ConstEngine bit11_eng{1UL << 11};
+
+            REQUIRE(dist(bit11_eng) == 0x1.0p-53);
+        } /*TEST_CASE(uniform53-extremes)*/
+
+        TEST_CASE("uniform53-fill", "[randomgen][uniform53]") {
+            xoshiro256ssx8 eng(7234987239847234987UL);
+            uniform53_distribution dist;
+
+            std::vector<double> sample_v(200001);
+            dist.fill(eng, sample_v);
+
+            double n = sample_v.size();
+            double m1 = 0.0;
+            double m2 = 0.0;
+            /* #of samples with lowest (2^-53) bit set */
+            std::size_t n_odd = 0;
+
+            for (double x : sample_v) {
+                REQUIRE(x >= 0.0);
+                REQUIRE(x < 1.0);
+
+                /* every sample is a multiple of 2^-53 */
+                double k = x * 0x1.0p53;
+
+                REQUIRE(k == std::floor(k));
+
+                if (std::fmod(k, 2.0) == 1.0)
+                    ++n_odd;
+
+                m1 += x;
+                m2 += x * x;
+            }
+
+            m1 /= n;
+            m2 = m2 / n - m1 * m1;
+
+            INFO(" m1=" << m1 << " var=" << m2 << " n_odd=" << n_odd);
+
+            /* mean 1/2 (sdev sqrt(1/12n)),  variance 1/12 (sdev sqrt(1/180n)) */
+            REQUIRE(std::abs(m1 - 0.5) < 5.0 * std::sqrt(1.0 / (12.0 * n)));
+            REQUIRE(std::abs(m2 - 1.0 / 12.0) < 5.0 * std::sqrt(1.0 / (180.0 * n)));
+
+            /* 53-bit resolution:  lowest bit set in about half the samples */
+            REQUIRE(std::abs(n_odd / n - 0.5) < 5.0 * 0.5 / std::sqrt(n));
+
+            /* critical value at 0.1% significance: 1.95/sqrt(n) */
+            REQUIRE(ks_stat(sample_v, 0.0, 1.0) < 1.95 / std::sqrt(n));
+        } /*TEST_CASE(uniform53-fill)*/
+
+        TEST_CASE("uniform53-scalar-vs-fill", "[randomgen][uniform53]") {
+            /* .fill() and .operator()() map engine bits identically */
+            xoshiro256ss eng1(42);
+            xoshiro256ss eng2(42);
+            uniform53_distribution dist(-2.0, 3.0);
+
+            std::vector<double> fill_v(1000);
+            dist.fill(eng1, fill_v);
+
+            for (double x : fill_v) {
+                REQUIRE(x >= -2.0);
+                REQUIRE(x < 3.0);
+                REQUIRE(x == dist(eng2));
+            }
+
+            /* KS on [-2, 3) */
+            std::vector<double> sample_v(100000);
+            for (double & x : sample_v)
+                x = dist(eng2);
+
+            REQUIRE(ks_stat(sample_v, -2.0, 3.0) < 1.95 / std::sqrt(static_cast<double>(sample_v.size())));
+        } /*TEST_CASE(uniform53-scalar-vs-fill)*/
+    } /*namespace ut*/
+} /*namespace xo*/
+
+/* end uniform53.test.cpp */
@@ -0,0 +1,125 @@
+/* @file xoshiro256x.test.cpp */
+
+#include "xo/randomgen/xoshiro256x.hpp"
+#include <catch2/catch.hpp>
+#include <cstdint>
+#include <vector>
+
+namespace xo {
+    using xo::rng::xoshiro256ss;
+    using xo::rng::xoshiro256ssx;
+
+    namespace ut {
+        namespace {
+            /* scalar engines equivalent to lanes of xoshiro256ssx<NLane>(seed):
+             * lane l is xoshiro256ss(seed) advanced by l jumps
+             */
+            std::vector<xoshiro256ss>
+            scalar_lanes(std::uint64_t seed, std::size_t n_lane)
+            {
+                std::vector<xoshiro256ss> retval;
+
+                xoshiro256ss eng(seed);
+
+                for (std::size_t l = 0; l < n_lane; ++l) {
+                    retval.push_back(eng);
+                    eng.jump();
+                }
+
+                return retval;
+            } /*scalar_lanes*/
+
+            template <std::size_t NLane>
+            void
+            check_fill_matches_scalar(std::uint64_t seed)
+            {
+                INFO("NLane=" << NLane << " seed=" << seed);
+
+                std::vector<xoshiro256ss> scalar_v = scalar_lanes(seed, NLane);
+
+                xoshiro256ssx<NLane> engx(seed);
+
+                std::size_t n_step = 1000;
+                std::vector<std::uint64_t> out(n_step * NLane);
+
+                engx.fill(out);
+
+                for (std::size_t k = 0; k < n_step; ++k) {
+                    for (std::size_t l = 0; l < NLane; ++l) {
+                        INFO("k=" << k << " l=" << l);
+
+                        REQUIRE(out[k * NLane + l] == scalar_v[l]());
+                    }
+                }
+            } /*check_fill_matches_scalar*/
+
+            /* .operator()() and .fill() of arbitrary sizes draw the same stream */
+            template <std::size_t NLane>
+            void
+            check_mixed_draws(std::uint64_t seed)
+            {
+                INFO("NLane=" << NLane << " seed=" << seed);
+
+                xoshiro256ssx<NLane> ref(seed);
+                xoshiro256ssx<NLane> engx(seed);
+
+                std::size_t n = 0;
+                std::vector<std::uint64_t> ref_v(4096);
+
+                ref.fill(ref_v);
+
+                for (std::size_t z = 0; n + z <= ref_v.size(); ++z) {
+                    if (z % 3 == 0) {
+                        REQUIRE(engx() == ref_v[n]);
+                        ++n;
+                    } else {
+                        std::vector<std::uint64_t> out(z);
+
+                        engx.fill(out);
+
+                        for (std::size_t i = 0; i < z; ++i)
+                            REQUIRE(out[i] == ref_v[n + i]);
+
+                        n += z;
+                    }
+                }
+            } /*check_mixed_draws*/
+        } /*namespace*/
+
+        TEST_CASE("xoshiro256ssx-lanes", "[randomgen][xoshiro256ssx]") {
+            for (std::uint64_t seed : {1UL, 7234987239847234987UL, 0xdeadbeefUL}) {
+                check_fill_matches_scalar<1>(seed);
+                check_fill_matches_scalar<4>(seed);
+                check_fill_matches_scalar<8>(seed);
+            }
+        } /*TEST_CASE(xoshiro256ssx-lanes)*/
+
+        TEST_CASE("xoshiro256ssx-mixed", "[randomgen][xoshiro256ssx]") {
+            check_mixed_draws<4>(11);
+            check_mixed_draws<8>(13);
+        } /*TEST_CASE(xoshiro256ssx-mixed)*/
+
+        TEST_CASE("xoshiro256ssx-equal", "[randomgen][xoshiro256ssx]") {
+            xoshiro256ssx<4> x(42);
+            xoshiro256ssx<4> y(42);
+
+            REQUIRE(x == y);
+
+            x();
+
+            REQUIRE(x != y);
+
+            y();
+
+            REQUIRE(x == y);
+
+            /* null state -> constant zero stream */
+            xoshiro256ssx<4> z;
+
+            for (std::size_t i = 0; i < 16; ++i)
+                REQUIRE(z() == 0);
+        } /*TEST_CASE(xoshiro256ssx-equal)*/
+    } /*namespace ut*/
+} /*namespace xo*/
+
+/* end xoshiro256x.test.cpp */
@@ -0,0 +1,146 @@
+/* @file ziggurat_normal.test.cpp */
+
+#include "xo/randomgen/ziggurat_normal_distribution.hpp"
+#include "xo/randomgen/xoshiro256x.hpp"
+#include "xo/randomgen/xoshiro256.hpp"
+#include <catch2/catch.hpp>
+#include <algorithm>
+#include <cmath>
+#include <vector>
+
+namespace xo {
+    using xo::rng::ziggurat_normal_distribution;
+    using xo::rng::xoshiro256ss;
+    using xo::rng::xoshiro256ssx4;
+
+    namespace ut {
+        namespace {
+            double
+            normal_cdf(double x, double mean, double sdev)
+            {
+                return 0.5 * std::erfc(-(x - mean) / (sdev * std::sqrt(2.0)));
+            } /*normal_cdf*/
+
+            /* kolmogorov-smirnov statistic for sample_v vs N(mean, sdev^2) */
+            double
+            ks_stat(std::vector<double> sample_v, double mean, double sdev)
+            {
+                std::sort(sample_v.begin(), sample_v.end());
+
+                double n = sample_v.size();
+                double d = 0.0;
+
+                for (std::size_t i = 0; i < sample_v.size(); ++i) {
+                    double f = normal_cdf(sample_v[i], mean, sdev);
+
+                    d = std::max(d, std::max((i + 1) / n - f, f - i / n));
+                }
+
+                return d;
+            } /*ks_stat*/
+
+            /* check sample moments + KS statistic against N(mean, sdev^2) */
+            void
+            check_normal_sample(std::vector<double> const & sample_v, double mean, double sdev)
+            {
+                double n = sample_v.size();
+
+                double m1 = 0.0;
+                for (double x : sample_v)
+                    m1 += x;
+                m1 /= n;
+
+                double m2 = 0.0;
+                double m3 = 0.0;
+                double m4 = 0.0;
+                for (double x : sample_v) {
+                    double u = (x - m1) / sdev;
+
+                    m2 += u * u;
+                    m3 += u * u * u;
+                    m4 += u * u * u * u;
+                }
+                m2 /= n;
+                m3 /= n;
+                m4 /= n;
+
+                INFO(" m1=" << m1 << " m2=" << m2 << " m3=" << m3 << " m4=" << m4);
+
+                /* sampling sdev of moments for N(0,1):
+                 *   mean: 1/sqrt(n),  variance: sqrt(2/n),
+                 *   skew: sqrt(6/n),  kurtosis: sqrt(96/n)
+                 * accept at 5 sdevs
+                 */
+                REQUIRE(std::abs(m1 - mean) < 5.0 * sdev / std::sqrt(n));
+                REQUIRE(std::abs(m2 - 1.0) < 5.0 * std::sqrt(2.0 / n));
+                REQUIRE(std::abs(m3) < 5.0 * std::sqrt(6.0 / n));
+                REQUIRE(std::abs(m4 - 3.0) < 5.0 * std::sqrt(96.0 / n));
+
+                /* critical value at 0.1% significance: 1.95/sqrt(n) */
+                double d = ks_stat(sample_v, mean, sdev);
+
+                INFO(" ks=" << d);
+
+                REQUIRE(d < 1.95 / std::sqrt(n));
+            } /*check_normal_sample*/
+        } /*namespace*/
+
+        TEST_CASE("ziggurat-table", "[randomgen][ziggurat]") {
+            auto const & tbl = xo::rng::ziggurat_normal_table::instance();
+
+            /* layer edges decrease from base to top */
+            REQUIRE(tbl.x_[1] == xo::rng::ziggurat_normal_table::c_r);
+            REQUIRE(tbl.x_[0] > tbl.x_[1]);
+            for (std::size_t i = 1; i < xo::rng::ziggurat_normal_table::c_n_layer; ++i)
+                REQUIRE(tbl.x_[i + 1] < tbl.x_[i]);
+
+            /* recurrence lands (close to) x=0 at the top layer */
+            REQUIRE(tbl.x_[xo::rng::ziggurat_normal_table::c_n_layer - 1] < 0.3);
+        } /*TEST_CASE(ziggurat-table)*/
+
+        TEST_CASE("ziggurat-normal-scalar", "[randomgen][ziggurat]") {
+            xoshiro256ss eng(7234987239847234987UL);
+            ziggurat_normal_distribution dist;
+
+            std::vector<double> sample_v(200000);
+            for (double & x : sample_v)
+                x = dist(eng);
+
+            check_normal_sample(sample_v, 0.0, 1.0);
+        } /*TEST_CASE(ziggurat-normal-scalar)*/
+
+        TEST_CASE("ziggurat-normal-fill", "[randomgen][ziggurat]") {
+            xoshiro256ssx4 eng(1234567UL);
+            ziggurat_normal_distribution dist(0.0, 1.0);
+
+            /* odd size:  exercises partial block + partial lane step */
+            std::vector<double> sample_v(200003);
+            dist.fill(eng, sample_v);
+
+            check_normal_sample(sample_v, 0.0, 1.0);
+        } /*TEST_CASE(ziggurat-normal-fill)*/
+
+        TEST_CASE("ziggurat-normal-param", "[randomgen][ziggurat]") {
+            xoshiro256ssx4 eng(99UL);
+            ziggurat_normal_distribution dist(10.0, 2.5);
+
+            REQUIRE(dist.mean() == 10.0);
+            REQUIRE(dist.stddev() == 2.5);
+
+            std::vector<double> sample_v(100000);
+            dist.fill(eng, sample_v);
+
+            check_normal_sample(sample_v, 10.0, 2.5);
+
+            /* per-call param overrides distribution's */
+            ziggurat_normal_distribution::param_type p(-3.0, 0.5);
+
+            for (double & x : sample_v)
+                x = dist(eng, p);
+
+            check_normal_sample(sample_v, -3.0, 0.5);
+        } /*TEST_CASE(ziggurat-normal-param)*/
+    } /*namespace ut*/
+} /*namespace xo*/
+
+/* end ziggurat_normal.test.cpp */
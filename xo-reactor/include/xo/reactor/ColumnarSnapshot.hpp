@@ -0,0 +1,144 @@
+/* @file ColumnarSnapshot.hpp */
+
+#pragma once
+
+#include <xo/reflect/TaggedPtr.hpp>
+#include <xo/reflect/TypeDescr.hpp>
+#include <cstddef>
+#include <cstdint>
+#include <iosfwd>
+#include <string>
+#include <vector>
+
+namespace xo {
+    namespace reactor {
+        /* column types in a ColumnarSnapshot.
+         * values are part of the wire format;  don't renumber
+         */
+        enum class ColumnType : std::uint8_t {
+            ct_bool = 1,
+            ct_i16 = 2,
+            ct_u16 = 3,
+            ct_i32 = 4,
+            ct_u32 = 5,
+            ct_i64 = 6,
+            ct_u64 = 7,
+            ct_f32 = 8,
+            ct_f64 = 9,
+            /* xo::time::utc_nanos,  as int64 nanoseconds since epoch */
+            ct_utc_nanos = 10,
+            /* variable-length utf-8 */
+            ct_string = 11,
+        };
+
+        /* binary columnar snapshot of a sequence of reflected structs.
+         * Alternative to json snapshot (see AbstractEventStore::http_snapshot()),
+         * for large event stores:  no per-row member names,  numbers stay in binary,
+         * so it's both smaller and cheaper to produce.
+         *
+         * Columns are planned once from the struct's reflected members:
+         * - atomic members of a supported type (see ColumnType) become one column each;
+         * - struct-valued members are flattened,  with dotted column names
+         *   (e.g. "quote.bid_px");
+         * - other members (vectors, pointers, unsupported atomic types) are omitted.
+         *
+         * Wire format (all integers little-endian):
+         *
+         *   offset   size   contents
+         *   0        8      magic "XOCOLSN1"
+         *   8        4      n_row  (u32)
+         *   12       4      n_col  (u32)
+         *   16       ...    n_col column descriptors:
+         *                     1 byte  ColumnType
+         *                     1 byte  reserved (0)
+         *                     2 bytes name length L (u16)
+         *                     L bytes column name (utf-8, not null-terminated)
+         *                   zero-padding to multiple of 8
+         *            ...    n_col column bodies,  in descriptor order,
+         *                   each zero-padded to multiple of 8:
+         *                   - fixed-width column: n_row values
+         *                     (ct_bool is 1 byte per value)
+         *                   - ct_string: (n_row + 1) u32 byte offsets,
+         *                     then string bytes;  value i is [offset[i], offset[i+1])
+         *
+         * Fixed-width bodies are plain arrays,  so a browser client can view them
+         * in place with e.g. Float64Array / BigInt64Array.
+         * String columns use the same offsets+bytes layout as arrow.
+         *
+         * Member offsets are sampled from the first row appended
+         * (same restriction as json::JsonStructEncoder:  no virtual bases).
+         */
+        class ColumnarSnapshot {
+        public:
+            using TaggedPtr = xo::reflect::TaggedPtr;
+            using TypeDescr = xo::reflect::TypeDescr;
+
+            /* one column */
+            struct Column {
+                /* column name;  dotted path for members of nested structs */
+                std::string name_;
+                /* column type */
+                ColumnType type_ = ColumnType::ct_bool;
+                /* member indices, from event struct to this column's atomic member */
+                std::vector<std::uint32_t> path_v_;
+                /* offset of member from start of event struct;
+                 * established by first .append()
+                 */
+                std::ptrdiff_t offset_ = 0;
+                /* fixed-width values;  or string bytes for ct_string */
+                std::vector<char> data_v_;
+                /* ct_string only: byte offsets into .data_v,  one per row + 1 */
+                std::vector<std::uint32_t> str_offset_v_;
+            }; /*Column*/
+
+        public:
+            /* snapshot for events of type event_td.
+             * if event_td is a pointer type (e.g. rp<T>),  columns come from T
+             */
+            explicit ColumnarSnapshot(TypeDescr event_td);
+
+            /* bytes per value for fixed-width column type ct;  0 for ct_string */
+            static std::uint32_t column_width(ColumnType ct);
+
+            TypeDescr struct_td() const { return struct_td_; }
+            std::uint32_t n_row() const { return n_row_; }
+            std::uint32_t n_column() const { return column_v_.size(); }
+            Column const & column(std::uint32_t i) const { return column_v_[i]; }
+
+            /* discard rows;  keep column plan */
+            void clear();
+
+            /* append one event,  as last row.
+             * require: ev_tp.td() is .struct_td
+             * (so for rp<T> events,  pass T's static type,  not most-derived type).
+             * ev_tp.address() may be null (e.g. for a null rp<T>);
+             * appends zeros / empty strings
+             */
+            void append(TaggedPtr ev_tp);
+
+            /* write snapshot in wire format on *p_os */
+            void write(std::ostream * p_os) const;
+
+        private:
+            /* plan columns for members of struct type td,  prefixing names with name_prefix */
+            void plan_columns(TypeDescr td,
+                              std::string const & name_prefix,
+                              std::vector<std::uint32_t> const & path_prefix_v);
+
+            /* establish Column.offset for each column,  from sample event at struct_addr */
+            void sample_offsets(void * struct_addr);
+
+        private:
+            /* struct type whose members provide columns */
+            TypeDescr struct_td_ = nullptr;
+            /* true once Column.offset_ established */
+            bool offset_flag_ = false;
+            /* #of rows appended */
+            std::uint32_t n_row_ = 0;
+            /* columns,  in reflection order (depth-first for nested structs) */
+            std::vector<Column> column_v_;
+        }; /*ColumnarSnapshot*/
+    } /*namespace reactor*/
+} /*namespace xo*/
+
+/* end ColumnarSnapshot.hpp */
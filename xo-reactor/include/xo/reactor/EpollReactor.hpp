@@ -0,0 +1,137 @@
+/* @file EpollReactor.hpp */
+
+#pragma once
+
+#include "Reactor.hpp"
+#include "ReactorSource.hpp"
+#include <xo/timeutil/timeutil.hpp>
+#include <atomic>
+#include <deque>
+#include <mutex>
+#include <unordered_map>
+#include <vector>
+#include <cstdint>
+
+namespace xo {
+    namespace reactor {
+        /* event-driven reactor (linux only):  visits only sources
+         * that have announced they are primed,  and parks the calling
+         * thread in epoll_wait() when no source is ready.
+         *
+         * Compare with PollingReactor,  which checks every source on every
+         * .run_one() call:  cost there grows with #of sources,
+         * and an idle reactor spins.
+         *
+         * Sources become ready by:
+         * 1. .notify_source_primed(src):  reactor thread only,
+         *    e.g. FifoQueue when it receives its first event.  No syscall.
+         * 2. .wakeup_source(src):  any thread.  Wakes a parked reactor
+         *    through an eventfd.  Use with SpscQueue, for example.
+         * 3. .notify_source_primed_at(src, tm):  reactor thread only.
+         *    Reactor visits src at (or after) time tm,  using a timerfd.
+         *
+         * Ready sources are visited in FIFO order;  a source that is still
+         * non-empty after delivering an event goes to the back of the line.
+         */
+        class EpollReactor : public Reactor {
+        public:
+            using utc_nanos = xo::time::utc_nanos;
+            using nanos = xo::time::nanos;
+
+        public:
+            ~EpollReactor();
+
+            /* park_dt.  max time .run_one() waits for a ready source,
+             *            when none is ready on entry.
+             *            0 for never wait;  negative to wait indefinitely.
+             */
+            static rp<EpollReactor> make(nanos park_dt = std::chrono::milliseconds(100));
+
+            nanos park_dt() const { return park_dt_; }
+
+            /* #of sources currently waiting to be visited.  reactor thread only */
+            std::size_t n_ready() const { return ready_q_.size(); }
+
+            /* thread-safe version of .notify_source_primed():
+             * may call from any thread,  wakes parked reactor.
+             * src must have been added to this reactor
+             */
+            void wakeup_source(bp<ReactorSource> src);
+
+            /* arrange for reactor to visit src once clock reaches tm */
+            void notify_source_primed_at(bp<ReactorSource> src, utc_nanos tm);
+
+            // ----- inherited from Reactor -----
+
+            virtual bool add_source(bp<ReactorSource> src) override;
+            virtual bool remove_source(bp<ReactorSource> src) override;
+            virtual void notify_source_primed(bp<ReactorSource> src) override;
+            virtual std::uint64_t run_one() override;
+
+            virtual void display(std::ostream & os) const override;
+
+        private:
+            EpollReactor(nanos park_dt);
+
+            /* per-source bookkeeping */
+            struct SourceState {
+                /* keeps source alive while attached */
+                ReactorSourcePtr src_;
+                /* true iff source appears in .ready_q */
+                bool ready_flag_ = false;
+            };
+
+            /* append src to .ready_q,  unless already present */
+            void enqueue_ready(ReactorSource * src);
+
+            /* wait up to timeout_ms (see epoll_wait()) for eventfd/timerfd activity,
+             * and move sources they announce to .ready_q
+             */
+            void poll_wakeups(int timeout_ms);
+
+            /* move sources from .wakeup_v to .ready_q */
+            void drain_wakeups();
+
+            /* move sources with expired timers to .ready_q,  and re-arm .timer_fd */
+            void drain_timers();
+
+            /* program .timer_fd for earliest entry in .timer_v (or disarm) */
+            void arm_timer();
+
+        private:
+            /* .run_one() waits up to this long for a ready source */
+            nanos park_dt_;
+
+            /* epoll instance watching .wake_fd and .timer_fd */
+            int epoll_fd_ = -1;
+            /* eventfd:  written by .wakeup_source() */
+            int wake_fd_ = -1;
+            /* timerfd (CLOCK_REALTIME,  absolute):  armed for earliest .timer_v entry */
+            int timer_fd_ = -1;
+
+            /* sources attached to this reactor */
+            std::unordered_map<ReactorSource *, SourceState> source_map_;
+
+            /* sources known to be primed,  in visit order */
+            std::deque<ReactorSource *> ready_q_;
+
+            /* min-heap of (tm, src) for .notify_source_primed_at() */
+            std::vector<std::pair<utc_nanos, ReactorSource *>> timer_v_;
+
+            /* #of events dispatched since last (non-blocking) check of wakeup fds;
+             * bounds wakeup latency while .ready_q stays busy
+             */
+            std::uint32_t n_since_poll_ = 0;
+
+            /* protects .wakeup_v */
+            std::mutex wakeup_mutex_;
+            /* sources announced by .wakeup_source(),  not yet in .ready_q */
+            std::vector<ReactorSourcePtr> wakeup_v_;
+            /* true when .wakeup_v may be non-empty */
+            std::atomic<bool> wakeup_flag_ = false;
+        }; /*EpollReactor*/
+
+    } /*namespace reactor*/
+} /*namespace xo*/
+
+/* end EpollReactor.hpp */
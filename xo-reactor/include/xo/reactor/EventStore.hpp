@@ -2,16 +2,20 @@
 
 #pragma once
 
+#include "ColumnarSnapshot.hpp"
 #include "EventTimeFn.hpp"
 #include "Reducer.hpp"
 #include "Sink.hpp"
 #include <xo/ordinaltree/RedBlackTree.hpp>
 #include <xo/ordinaltree/rbtree/OrdinalReduce.hpp>
 #include <xo/printjson/PrintJson.hpp>
+#include <xo/ppsink/pp_time.hpp>
 #include <xo/reflect/Reflect.hpp>
 #include <xo/webutil/HttpEndpointDescr.hpp>
 #include <xo/indentlog2/print/tostr.hpp>
 #include <xo/timeutil/timeutil.hpp>
+#include <charconv>
+#include <string_view>
 
 /* NB xo::pp names are QUALIFIED throughout this header, not brought in by
  * using-declarations.  Two reasons:
@@ -32,6 +36,7 @@ namespace xo {
             using TaggedPtr = xo::reflect::TaggedPtr;
             using HttpEndpointDescr = xo::web::HttpEndpointDescr;
             using Alist = xo::web::Alist;
+            using nanos = xo::time::nanos;
 
         public:
             /* true iff .size() == 0 */
@@ -53,6 +58,18 @@ namespace xo {
             virtual void http_snapshot(rp<PrintJson> const & pjson,
                                        std::ostream * p_os) const = 0;
 
+            /* write binary columnar snapshot (see ColumnarSnapshot.hpp)
+             * of the most recent n events to *p_os,  in increasing time order
+             */
+            virtual void columnar_snapshot_last_n(std::uint32_t n,
+                                                  std::ostream * p_os) const = 0;
+
+            /* write binary columnar snapshot of suffix of events covering
+             * interval of length dt (see EventStoreImpl::visit_last_dt())
+             */
+            virtual void columnar_snapshot_last_dt(nanos dt,
+                                                   std::ostream * p_os) const = 0;
+
             /* http endpoint; generates http output for this eventstore */
             virtual HttpEndpointDescr http_endpoint_descr(rp<PrintJson> const & pjson,
                                                           std::string const & url_prefix) const {
@@ -77,9 +94,69 @@ namespace xo {
                 return HttpEndpointDescr(url_prefix + "/snap", http_fn);
             } /*http_endpoint_descr*/
 
+            /* http endpoint; binary columnar snapshot of most recent n events,
+             * at
+             *   {url_prefix}/colsnap/n/${n}
+             */
+            virtual HttpEndpointDescr http_colsnap_n_endpoint_descr(std::string const & url_prefix) const {
+                auto http_fn = ([this]
+                                (std::string const & /*uri*/,
+                                 Alist const & alist,
+                                 std::ostream * p_os)
+                    {
+                        /* WARNING: race condition here,
+                         *          given webserver runs from a separate thread
+                         */
+
+                        this->columnar_snapshot_last_n(parse_uri_count(alist.lookup("n")), p_os);
+                    });
+
+                return HttpEndpointDescr(url_prefix + "/colsnap/n/${n}",
+                                         http_fn,
+                                         HttpEndpointDescr::c_mime_binary);
+            } /*http_colsnap_n_endpoint_descr*/
+
+            /* http endpoint; binary columnar snapshot of most recent interval,
+             * at
+             *   {url_prefix}/colsnap/dt/${ms}
+             * with interval length given in milliseconds
+             */
+            virtual HttpEndpointDescr http_colsnap_dt_endpoint_descr(std::string const & url_prefix) const {
+                auto http_fn = ([this]
+                                (std::string const & /*uri*/,
+                                 Alist const & alist,
+                                 std::ostream * p_os)
+                    {
+                        /* WARNING: race condition here,
+                         *          given webserver runs from a separate thread
+                         */
+
+                        nanos dt = std::chrono::milliseconds(parse_uri_count(alist.lookup("ms")));
+
+                        this->columnar_snapshot_last_dt(dt, p_os);
+                    });
+
+                return HttpEndpointDescr(url_prefix + "/colsnap/dt/${ms}",
+                                         http_fn,
+                                         HttpEndpointDescr::c_mime_binary);
+            } /*http_colsnap_dt_endpoint_descr*/
+
             virtual void clear() = 0;
 
             virtual void insert_tp(TaggedPtr const & ev_tp) = 0;
+
+        private:
+            /* parse non-negative decimal uri argument;  0 if malformed */
+            static std::uint32_t parse_uri_count(std::string_view s) {
+                std::uint32_t retval = 0;
+
+                auto [ptr, ec] = std::from_chars(s.data(), s.data() + s.size(), retval);
+
+                if ((ec != std::errc()) || (ptr != s.data() + s.size()))
+                    return 0;
+
+                return retval;
+            } /*parse_uri_count*/
         }; /*AbstractEventStore*/
 
         /* in-memory storage for a set of events.
@@ -229,6 +306,27 @@ namespace xo {
                 pjson->print_tp(Reflect::make_tp(&ev_v), p_os);
             } /*http_snapshot*/
 
+            virtual void columnar_snapshot_last_n(std::uint32_t n,
+                                                  std::ostream * p_os) const override {
+                ColumnarSnapshot snap(xo::reflect::Reflect::require<Event>());
+
+                /* straight from tree to columns;  no intermediate vector<Event> */
+                this->visit_last_n(n,
+                                   [&snap](Event const & ev) { snap.append(event_struct_tp(ev)); });
+
+                snap.write(p_os);
+            } /*columnar_snapshot_last_n*/
+
+            virtual void columnar_snapshot_last_dt(nanos dt,
+                                                   std::ostream * p_os) const override {
+                ColumnarSnapshot snap(xo::reflect::Reflect::require<Event>());
+
+                this->visit_last_dt(dt,
+                                    [&snap](Event const & ev) { snap.append(event_struct_tp(ev)); });
+
+                snap.write(p_os);
+            } /*columnar_snapshot_last_dt*/
+
             virtual void clear() override { this->tree_.clear(); }
 
             virtual void insert_tp(TaggedPtr const & ev_tp) override {
@@ -275,6 +373,21 @@ namespace xo {
         private:
             EventStoreImpl() = default;
 
+            /* tagged pointer to struct part of ev,  with static (not most-derived) type;
+             * dereferences pointer-like events (e.g. rp<T>)
+             */
+            static TaggedPtr event_struct_tp(Event const & ev) {
+                using xo::reflect::Reflect;
+
+                if constexpr (requires { ev.get(); }) {
+                    using T = std::remove_cvref_t<decltype(*(ev.get()))>;
+
+                    return Reflect::make_tp(const_cast<T *>(ev.get()));
+                } else {
+                    return Reflect::make_tp(const_cast<Event *>(&ev));
+                }
+            } /*event_struct_tp*/
+
             template <typename Fn>
             std::uint32_t visit_range(typename EventTree::const_iterator lo_ix,
                                       typename EventTree::const_iterator hi_ix,
@@ -10,6 +10,8 @@
 #include <xo/ppsink/scope_macros.hpp>
 #include <xo/callback/CallbackSet.hpp>
 #include <deque>
+#include <span>
+#include <vector>
 
 /* NB xo::pp names are QUALIFIED throughout this header, not brought in by
  * using-declarations.  Two reasons:
@@ -79,6 +81,51 @@ namespace xo {
                 }
             } /*notify_ev*/
 
+            /* enqueue a run of events.
+             * same effect as calling .notify_ev() for each event,
+             * but notifies reactor (at most) once.
+             */
+            virtual void notify_ev_batch(std::span<T const> ev_v) override {
+                if (ev_v.empty())
+                    return;
+
+                if (this->upstream_exhausted_) {
+                    throw std::runtime_error("FifoQueue::notify_ev_batch"
+                                             ": not allowed after upstream exhausted");
+                }
+
+                bool is_priming = this->elt_q_.empty();
+
+                for (T const & ev : ev_v) {
+                    this->elt_q_.push_back(ev);
+
+                    utc_nanos tm = evtm_fn_(ev);
+
+                    if (this->current_tm_ < tm)
+                        this->current_tm_ = tm;
+                }
+
+                this->n_in_ev_ += ev_v.size();
+
+                Reactor * reactor = this->parent_reactor_;
+
+                xo::pp::scope log(XO_DEBUG_(this->debug_sim_flag_),
+                          xo::pp::xtag("name", name_),
+                          xo::pp::xtag("reactor", (void*)reactor),
+                          xo::pp::xtag("n_ev", ev_v.size()),
+                          xo::pp::xtag("is_priming", is_priming));
+
+                if (reactor) {
+                    if (is_priming) {
+                        /* reactor/simulator takes delivery/sequencing responsibility from here */
+                        reactor->notify_source_primed(bp<ReactorSource>::from_native(this));
+                    }
+                } else {
+                    /* if no reactor,  deliver immediately */
+                    this->deliver_batch(utc_nanos::max(), ev_v.size(), nullptr);
+                }
+            } /*notify_ev_batch*/
+
             // ----- inherited from AbstractSink -----
 
             /* we don't care about volatile sources -- fifo queue copies incoming events */
@@ -113,6 +160,55 @@ namespace xo {
                 return this->deliver_one_aux(true /*replay_flag*/);
             } /*deliver_one*/
 
+            /* hands the run of queued events with timestamp before limit_tm
+             * to each sink with a single .notify_ev_batch() call
+             */
+            virtual uint64_t deliver_batch(utc_nanos limit_tm,
+                                           uint64_t max_n,
+                                           utc_nanos * p_last_tm) override {
+                xo::pp::scope log(XO_DEBUG_(this->debug_sim_flag_),
+                          xo::pp::xtag("name", this->name_),
+                          xo::pp::xtag("elt_q.size", this->elt_q_.size()),
+                          xo::pp::xtag("max_n", max_n));
+
+                /* borrow .batch_v storage for the duration of this call;
+                 * callbacks may reenter this queue
+                 */
+                std::vector<T> batch_v;
+                std::swap(batch_v, this->batch_v_);
+                batch_v.clear();
+
+                while (!this->elt_q_.empty() && (batch_v.size() < max_n)) {
+                    utc_nanos tm = evtm_fn_(this->elt_q_.front());
+
+                    if (tm >= limit_tm)
+                        break;
+
+                    batch_v.push_back(std::move(this->elt_q_.front()));
+                    this->elt_q_.pop_front();
+
+                    if (p_last_tm)
+                        *p_last_tm = tm;
+                }
+
+                uint64_t n = batch_v.size();
+
+                if (n > 0) {
+                    log && log(xo::pp::xtag("deliver-n", n),
+                               xo::pp::xtag("elt_q.size", this->elt_q_.size()));
+
+                    this->n_out_ev_ += n;
+                    this->cb_set_.invoke(&EventSink::notify_ev_batch,
+                                         std::span<T const>(batch_v));
+                }
+
+                /* return storage for reuse */
+                batch_v.clear();
+                std::swap(batch_v, this->batch_v_);
+
+                return n;
+            } /*deliver_batch*/
+
             virtual uint64_t sim_advance_until(utc_nanos target_tm,
                                                bool replay_flag) override {
                 uint64_t retval = 0;
@@ -253,6 +349,11 @@ namespace xo {
             /* events waiting for delivery */
             std::deque<T> elt_q_;
 
+            /* scratch storage for .deliver_batch();  retained to avoid
+             * reallocating on every batch
+             */
+            std::vector<T> batch_v_;
+
             /* lifetime #of events received */
             uint32_t n_in_ev_ = 0;
             /* lifetime #of events delivered */
@@ -4,6 +4,9 @@
 
 #include "Reducer.hpp"
 #include <xo/timeutil/timeutil.hpp>
+#include <algorithm>
+#include <span>
+#include <vector>
 
 namespace xo {
     namespace reactor {
@@ -47,6 +50,58 @@ namespace xo {
                                std::greater<Event>());
             } /*include_event*/
 
+            /* include a run of events.
+             * same effect as calling .include_event() for each event
+             */
+            void include_events(std::span<Event const> ev_v) {
+                std::size_t n0 = this->event_heap_.size();
+
+                this->event_heap_.insert(this->event_heap_.end(),
+                                         ev_v.begin(), ev_v.end());
+
+                if (ev_v.size() > n0) {
+                    /* rebuild is O(n0+k),  cheaper than k pushes */
+                    std::make_heap(this->event_heap_.begin(),
+                                   this->event_heap_.end(),
+                                   std::greater<Event>());
+                } else {
+                    for (std::size_t i = n0 + 1, n = this->event_heap_.size(); i <= n; ++i) {
+                        std::push_heap(this->event_heap_.begin(),
+                                       this->event_heap_.begin() + i,
+                                       std::greater<Event>());
+                    }
+                }
+            } /*include_events*/
+
+            /* remove up to max_n events with timestamp before limit_tm,
+             * appending them to *p_ev_v in increasing timestamp order.
+             * the last such event also becomes .last_annexed_ev()
+             *
+             * returns #of events removed
+             */
+            std::size_t annex_batch(utc_nanos limit_tm,
+                                    std::size_t max_n,
+                                    std::vector<Event> * p_ev_v) {
+                std::size_t n = 0;
+
+                while ((n < max_n)
+                       && !this->event_heap_.empty()
+                       && (this->next_tm() < limit_tm))
+                {
+                    std::pop_heap(this->event_heap_.begin(),
+                                  this->event_heap_.end(),
+                                  std::greater<Event>());
+                    p_ev_v->push_back(std::move(this->event_heap_.back()));
+                    this->event_heap_.pop_back();
+                    ++n;
+                }
+
+                if (n > 0)
+                    this->annexed_ev_ = p_ev_v->back();
+
+                return n;
+            } /*annex_batch*/
+
             Event & annex_one() {
                 this->annexed_ev_ = this->event_heap_.front();
                 std::pop_heap(this->event_heap_.begin(),
@@ -92,6 +92,23 @@ namespace xo {
              */
             virtual std::uint64_t sim_advance_until(utc_nanos tm, bool replay_flag) = 0;
 
+            /* deliver a run of consecutive events,  in timestamp order,
+             * stopping before the first event with timestamp >= limit_tm,
+             * or after max_n events,  whichever comes first.
+             *
+             * Sources that can hand a run of events to their sinks with a
+             * single dispatch (see Sink1::notify_ev_batch()) should override;
+             * default implementation calls .deliver_one() repeatedly.
+             *
+             * p_last_tm.  if non-null,  on return *p_last_tm is the timestamp of
+             *             the last event delivered (unchanged if none delivered)
+             *
+             * returns #of events delivered
+             */
+            virtual std::uint64_t deliver_batch(utc_nanos limit_tm,
+                                                std::uint64_t max_n,
+                                                utc_nanos * p_last_tm);
+
             /* informs source when it's added to a reactor
 
              * (see Reactor.add_source())
@@ -10,6 +10,7 @@
 #include <xo/ppsink/scope_macros.hpp>
 #include <xo/callback/CallbackSet.hpp>
 #include <xo/cxxutil/demangle.hpp>
+#include <span>
 #include <vector>
 
 /* NB xo::pp names are QUALIFIED throughout this header, not brought in by
@@ -102,8 +103,13 @@ namespace xo {
                      */
                     bool is_priming = this->reducer_.is_empty();
 
-                    for (Event const & ev : v)
-                        this->reducer_.include_event(ev);
+                    if constexpr (requires { this->reducer_.include_events(std::span<Event const>(v)); }) {
+                        /* contiguous events + reducer with bulk insert */
+                        this->reducer_.include_events(std::span<Event const>(v));
+                    } else {
+                        for (Event const & ev : v)
+                            this->reducer_.include_event(ev);
+                    }
 
                     Reactor * reactor = this->parent_reactor_;
 
@@ -163,6 +169,45 @@ namespace xo {
                 return this->deliver_one_aux(true /*replay_flag*/);
             }
 
+            /* if Reducer supports .annex_batch() (e.g. HeapReducer):
+             * hands the run of events with timestamp before limit_tm
+             * to each sink with a single .notify_ev_batch() call
+             */
+            virtual std::uint64_t deliver_batch(utc_nanos limit_tm,
+                                                std::uint64_t max_n,
+                                                utc_nanos * p_last_tm) override
+                {
+                    if constexpr (requires (std::vector<Event> * p_ev_v) {
+                            this->reducer_.annex_batch(limit_tm, max_n, p_ev_v); })
+                    {
+                        /* borrow .batch_v storage for the duration of this call;
+                         * callbacks may reenter this source
+                         */
+                        std::vector<Event> batch_v;
+                        std::swap(batch_v, this->batch_v_);
+                        batch_v.clear();
+
+                        std::uint64_t n = this->reducer_.annex_batch(limit_tm, max_n, &batch_v);
+
+                        if (n > 0) {
+                            if (p_last_tm)
+                                *p_last_tm = this->reducer_.event_tm(batch_v.back());
+
+                            this->n_out_ev_ += n;
+                            this->cb_set_.invoke(&EventSink::notify_ev_batch,
+                                                 std::span<Event const>(batch_v));
+                        }
+
+                        /* return storage for reuse */
+                        batch_v.clear();
+                        std::swap(batch_v, this->batch_v_);
+
+                        return n;
+                    } else {
+                        return ReactorSource::deliver_batch(limit_tm, max_n, p_last_tm);
+                    }
+                } /*deliver_batch*/
+
             virtual std::uint64_t sim_advance_until(utc_nanos target_tm,
                                                     bool replay_flag) override
                 {
@@ -350,6 +395,9 @@ namespace xo {
              */
             Reducer reducer_;
 
+            /* scratch storage for .deliver_batch() */
+            std::vector<Event> batch_v_;
+
             /* reactor/simulator being used to schedule consumption.  if ommitted,
              * will borrow thread calling .notify_secondary_event()
              */
@@ -12,6 +12,7 @@
 #include <xo/ppsink/tag_ostream.hpp>   /* os << xo::pp::xtag(..) */
 #include <xo/timeutil/timeutil.hpp>
 #include <xo/cxxutil/demangle.hpp>
+#include <span>
 #include <typeinfo>
 #include <xo/ppsink/pretty_pair.hpp>      /* Prettifier<std::pair<T,U>> */
 
@@ -117,6 +118,17 @@ namespace xo {
             /* accept incoming event */
             virtual void notify_ev(T const & ev) = 0;
 
+            /* accept a run of incoming events,  in delivery order.
+             * lets a source hand over many events with one virtual dispatch;
+             * sinks that can consume a run more cheaply than one event
+             * at a time should override.
+             * default implementation calls .notify_ev() for each event
+             */
+            virtual void notify_ev_batch(std::span<T const> ev_v) {
+                for (T const & ev : ev_v)
+                    this->notify_ev(ev);
+            } /*notify_ev_batch*/
+
             /* invoke these when this sink added to, or removed from, a source */
             virtual void notify_add_callback() {}
             virtual void notify_remove_callback() {}
@@ -178,6 +190,12 @@ namespace xo {
                 fn_(ev);
             } /*notify_ev*/
 
+            virtual void notify_ev_batch(std::span<T const> ev_v) override {
+                this->n_in_ev_ += ev_v.size();
+                for (T const & ev : ev_v)
+                    fn_(ev);
+            } /*notify_ev_batch*/
+
             virtual void display(std::ostream & os) const override {
 
                 os << "<SinkToFunction"
@@ -0,0 +1,379 @@
+/* @file SpscQueue.hpp */
+
+#pragma once
+
+#include "EventSource.hpp"
+#include "EventTimeFn2.hpp"
+#include "Sink.hpp"
+#include <xo/ppsink/scope.hpp>
+#include <xo/ppsink/scope_macros.hpp>
+#include <xo/callback/CallbackSet.hpp>
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <span>
+#include <vector>
+#include <cstdint>
+
+namespace xo {
+    namespace reactor {
+        /* bounded single-producer / single-consumer ingress queue.
+         *
+         * Lets one foreign thread (network reader, file reader, ..)
+         * hand events to a reactor without locks:
+         * - producer thread calls .push() / .push_batch()
+         * - reactor thread consumes through the usual ReactorSource api
+         *   (.deliver_one(), .deliver_batch()),  e.g. from PollingReactor::run_one()
+         *
+         * Events are copied into a fixed-size ring buffer.
+         * .head (next slot to consume) and .tail (next slot to fill)
+         * live on separate cache lines,  each next to a cached copy of the
+         * other side's index,  so that in steady state producer and consumer
+         * touch each other's cache line only when their cached view runs out.
+         *
+         * Consumer side publishes .head lazily:  after every .consume_batch
+         * events,  or when it catches up with its cached .tail.
+         * Producer side publishes .tail once per .push_batch() call.
+         *
+         * Not suitable for reactors that rely on .notify_source_primed()
+         * (e.g. Simulator):  the producer thread never calls into the reactor.
+         * PollingReactor discovers new events by polling .is_empty().
+         *
+         * require:
+         *   T default constructible
+         *   T movable
+         *   T satisfies EventTimeConcept (see FifoQueue)
+         */
+        template <typename T, typename EvTimeFn = EventTimeFn<T>>
+        class SpscQueue : public EventSource<Sink1<T>> {
+        public:
+            using EventSink = Sink1<T>;
+            template<typename Fn>
+            using RpCallbackSet = xo::fn::RpCallbackSet<Fn>;
+            using CallbackId = xo::fn::CallbackId;
+            using Reflect = xo::reflect::Reflect;
+            using TypeDescr = xo::reflect::TypeDescr;
+            using utc_nanos = xo::time::utc_nanos;
+
+            /* upper bound for .consume_batch */
+            static constexpr std::uint64_t c_max_consume_batch = 64;
+
+        public:
+            /* create queue with room for at least capacity events
+             * (rounded up to a power of 2)
+             */
+            static rp<SpscQueue> make(std::size_t capacity,
+                                      EvTimeFn evtm_fn = EvTimeFn()) {
+                return new SpscQueue(capacity, std::move(evtm_fn));
+            }
+
+            std::size_t capacity() const { return ring_v_.size(); }
+
+            // ----- producer api:  producer thread only -----
+
+            /* enqueue ev.  returns false (and drops ev) if queue is full */
+            bool push(T const & ev) {
+                return this->push_batch(std::span<T const>(&ev, 1)) == 1;
+            } /*push*/
+
+            /* enqueue a prefix of ev_v,  as much as fits;
+             * makes the whole prefix visible to consumer at once.
+             *
+             * returns #of events enqueued
+             */
+            std::size_t push_batch(std::span<T const> ev_v) {
+                std::uint64_t tail = this->prod_.tail_.load(std::memory_order_relaxed);
+                std::uint64_t cap = this->ring_v_.size();
+
+                if (tail + ev_v.size() - this->prod_.head_cache_ > cap) {
+                    /* refresh view of consumer progress */
+                    this->prod_.head_cache_ = this->cons_.head_.load(std::memory_order_acquire);
+                }
+
+                std::uint64_t n_avail = cap - (tail - this->prod_.head_cache_);
+                std::uint64_t n = std::min(n_avail, static_cast<std::uint64_t>(ev_v.size()));
+
+                for (std::uint64_t i = 0; i < n; ++i)
+                    this->ring_v_[(tail + i) & this->mask_] = ev_v[i];
+
+                if (n > 0)
+                    this->prod_.tail_.store(tail + n, std::memory_order_release);
+
+                return n;
+            } /*push_batch*/
+
+            /* announce that producer will publish no more events.
+             * queue becomes exhausted once consumer drains it
+             */
+            void close() { this->closed_.store(true, std::memory_order_release); }
+
+            // ----- inherited from ReactorSource -----
+
+            /* consumer thread only */
+            virtual bool is_empty() const override {
+                SpscQueue * self = const_cast<SpscQueue *>(this);
+
+                return self->refresh_tail() == 0;
+            } /*is_empty*/
+
+            virtual bool is_exhausted() const override {
+                /* check .closed first:  all events pushed before .close()
+                 * are then visible to .is_empty()
+                 */
+                return this->closed_.load(std::memory_order_acquire) && this->is_empty();
+            } /*is_exhausted*/
+
+            virtual utc_nanos sim_current_tm() const override {
+                if (this->is_empty())
+                    return this->current_tm_;
+
+                return evtm_fn_(this->ring_v_[this->cons_.head_local_ & this->mask_]);
+            } /*sim_current_tm*/
+
+            virtual std::uint64_t sim_advance_until(utc_nanos tm, bool replay_flag) override {
+                std::uint64_t retval = 0;
+
+                while (!this->is_empty() && (this->sim_current_tm() < tm)) {
+                    if (replay_flag) {
+                        retval += this->deliver_one();
+                    } else {
+                        ++(this->cons_.head_local_);
+                        this->publish_head(false /*!force*/);
+                    }
+                }
+
+                return retval;
+            } /*sim_advance_until*/
+
+            virtual std::uint64_t deliver_one() override {
+                if (this->refresh_tail() == 0)
+                    return 0;
+
+                /* move event out of ring:  callbacks may reenter this queue */
+                T ev = std::move(this->ring_v_[this->cons_.head_local_ & this->mask_]);
+
+                ++(this->cons_.head_local_);
+                this->publish_head(false /*!force*/);
+
+                this->current_tm_ = evtm_fn_(ev);
+                ++(this->n_out_ev_);
+
+                this->cb_set_.invoke(&EventSink::notify_ev, ev);
+
+                return 1;
+            } /*deliver_one*/
+
+            /* hands available events (with timestamp before limit_tm)
+             * to each sink via .notify_ev_batch(),  directly from ring storage:
+             * at most two spans,  if the run wraps around the end of the ring.
+             */
+            virtual std::uint64_t deliver_batch(utc_nanos limit_tm,
+                                                std::uint64_t max_n,
+                                                utc_nanos * p_last_tm) override {
+                std::uint64_t n_avail = std::min(this->refresh_tail(max_n), max_n);
+                std::uint64_t head = this->cons_.head_local_;
+
+                /* find length of run with timestamps before limit_tm */
+                std::uint64_t n = 0;
+                while (n < n_avail) {
+                    utc_nanos tm = evtm_fn_(this->ring_v_[(head + n) & this->mask_]);
+
+                    if (tm >= limit_tm)
+                        break;
+
+                    this->current_tm_ = tm;
+                    ++n;
+                }
+
+                if (n == 0)
+                    return 0;
+
+                if (p_last_tm)
+                    *p_last_tm = this->current_tm_;
+
+                /* claim run before invoking callbacks;  slots stay valid
+                 * because .head isn't published until callbacks complete
+                 */
+                this->cons_.head_local_ = head + n;
+                this->n_out_ev_ += n;
+
+                std::uint64_t lo = head & this->mask_;
+                std::uint64_t n1 = std::min(n, this->ring_v_.size() - lo);
+
+                this->cb_set_.invoke(&EventSink::notify_ev_batch,
+                                     std::span<T const>(&(this->ring_v_[lo]), n1));
+
+                if (n1 < n) {
+                    this->cb_set_.invoke(&EventSink::notify_ev_batch,
+                                         std::span<T const>(&(this->ring_v_[0]), n - n1));
+                }
+
+                this->publish_head(true /*force*/);
+
+                return n;
+            } /*deliver_batch*/
+
+            // ----- inherited from AbstractSource -----
+
+            virtual TypeDescr source_ev_type() const override { return Reflect::require<T>(); }
+            /* events are delivered from ring storage,
+             * which is reused once consumer moves past them
+             */
+            virtual bool is_volatile() const override { return true; }
+            virtual uint32_t n_queued_out_ev() const override {
+                return (this->prod_.tail_.load(std::memory_order_acquire)
+                        - this->cons_.head_local_);
+            }
+            virtual uint32_t n_out_ev() const override { return n_out_ev_; }
+            virtual bool debug_sim_flag() const override { return debug_sim_flag_; }
+            virtual void set_debug_sim_flag(bool x) override { this->debug_sim_flag_ = x; }
+
+            virtual CallbackId attach_sink(rp<AbstractSink> const & sink) override {
+                rp<EventSink> native_sink
+                    = EventSink::require_native("SpscQueue::attach_sink", sink);
+
+                if (native_sink) {
+                    if (native_sink->allow_volatile_source()) {
+                        return this->add_callback(native_sink);
+                    } else {
+                        throw std::runtime_error("SpscQueue::attach_sink"
+                                                 ": sink requires non-volatile source "
+                                                 + std::string(reflect::type_name<T>()));
+                    }
+                } else {
+                    throw std::runtime_error("SpscQueue::attach_sink"
+                                             ": expected sink accepting "
+                                             + std::string(reflect::type_name<T>()));
+                }
+            } /*attach_sink*/
+
+            virtual void detach_sink(CallbackId id) override {
+                this->remove_callback(id);
+            }
+
+            // ----- inherited from EventSource -----
+
+            virtual CallbackId add_callback(rp<EventSink> const & cb) override {
+                return this->cb_set_.add_callback(cb);
+            }
+
+            virtual void remove_callback(CallbackId id) override {
+                this->cb_set_.remove_callback(id);
+            }
+
+            // ----- inherited from AbstractEventProcessor -----
+
+            virtual std::string const & name() const override { return name_; }
+            virtual void set_name(std::string const & x) override { this->name_ = x; }
+
+            virtual void visit_direct_consumers(std::function<void (bp<AbstractEventProcessor> ep)> const & fn) override {
+                for (auto x : this->cb_set_)
+                    fn(x.fn_.borrow());
+            } /*visit_direct_consumers*/
+
+            virtual void display(std::ostream & os) const override {
+                os << "<SpscQueue"
+                   << xo::pp::xtag("name", name_)
+                   << xo::pp::xtag("addr", (void *)this)
+                   << xo::pp::xtag("capacity", ring_v_.size())
+                   << xo::pp::xtag("T", reflect::type_name<T>())
+                   << ">";
+            } /*display*/
+
+        private:
+            SpscQueue(std::size_t capacity, EvTimeFn evtm_fn)
+                : evtm_fn_{std::move(evtm_fn)},
+                  ring_v_(std::bit_ceil(std::max(capacity, std::size_t(1)))),
+                  mask_{ring_v_.size() - 1},
+                  consume_batch_{std::clamp(ring_v_.size() / 8,
+                                            std::size_t(1),
+                                            std::size_t(c_max_consume_batch))} {}
+
+            /* consumer thread:  #of events available to consume,
+             * reloading producer's .tail only if cached view has fewer than want
+             */
+            std::uint64_t refresh_tail(std::uint64_t want = 1) {
+                if (this->cons_.tail_cache_ - this->cons_.head_local_ < want) {
+                    /* catching up with producer:  release consumed slots first */
+                    this->publish_head(true /*force*/);
+
+                    this->cons_.tail_cache_ = this->prod_.tail_.load(std::memory_order_acquire);
+                }
+
+                return this->cons_.tail_cache_ - this->cons_.head_local_;
+            } /*refresh_tail*/
+
+            /* consumer thread:  make consumed slots available to producer.
+             * unless force,  only publishes once every .consume_batch events
+             */
+            void publish_head(bool force) {
+                std::uint64_t head = this->cons_.head_local_;
+
+                if (force
+                    ? (head != this->cons_.head_published_)
+                    : (head - this->cons_.head_published_ >= this->consume_batch_))
+                {
+                    this->cons_.head_.store(head, std::memory_order_release);
+                    this->cons_.head_published_ = head;
+                }
+            } /*publish_head*/
+
+        private:
+            /* producer-owned state */
+            struct alignas(64) ProducerState {
+                /* next slot to fill.  written by producer only */
+                std::atomic<std::uint64_t> tail_ = 0;
+                /* producer's (possibly stale) copy of ConsumerState.head */
+                std::uint64_t head_cache_ = 0;
+            };
+
+            /* consumer-owned state */
+            struct alignas(64) ConsumerState {
+                /* consumed slots published to producer.  written by consumer only */
+                std::atomic<std::uint64_t> head_ = 0;
+                /* next slot to consume;  may run ahead of .head */
+                std::uint64_t head_local_ = 0;
+                /* last value stored to .head */
+                std::uint64_t head_published_ = 0;
+                /* consumer's (possibly stale) copy of ProducerState.tail */
+                std::uint64_t tail_cache_ = 0;
+            };
+
+            /* name (ideally unique) for this queue */
+            std::string name_;
+
+            /* extract timestamp from an event */
+            EvTimeFn evtm_fn_;
+
+            /* if true, reactor will report interaction with this source */
+            bool debug_sim_flag_ = false;
+
+            /* timestamp of most recently delivered event */
+            utc_nanos current_tm_;
+
+            /* lifetime #of events delivered.  consumer only */
+            uint32_t n_out_ev_ = 0;
+
+            /* ring storage.  size is a power of 2 */
+            std::vector<T> ring_v_;
+            /* .ring_v.size() - 1 */
+            std::uint64_t mask_ = 0;
+            /* consumer publishes .head at least once every .consume_batch events;
+             * small relative to capacity,  so producer doesn't see a full queue
+             * while consumer sits on many unpublished slots
+             */
+            std::uint64_t consume_batch_ = 1;
+
+            /* set by producer in .close() */
+            std::atomic<bool> closed_ = false;
+
+            /* invoke callbacks in this set to deliver events.  consumer only */
+            RpCallbackSet<EventSink> cb_set_;
+
+            alignas(64) ProducerState prod_;
+            alignas(64) ConsumerState cons_;
+        }; /*SpscQueue*/
+    } /*namespace reactor*/
+} /*namespace xo*/
+
+/* end SpscQueue.hpp */
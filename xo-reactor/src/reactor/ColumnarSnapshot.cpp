@@ -0,0 +1,289 @@
+/* @file ColumnarSnapshot.cpp */
+
+#include "ColumnarSnapshot.hpp"
+#include <xo/reflect/Reflect.hpp>
+#include <xo/reflect/struct/StructMember.hpp>
+#include <xo/indentlog2/print/tostr.hpp>
+#include <xo/timeutil/timeutil.hpp>
+#include <bit>
+#include <cstring>
+#include <limits>
+#include <ostream>
+#include <stdexcept>
+#include <string_view>
+
+namespace xo {
+    using xo::reflect::Reflect;
+    using xo::reflect::StructMember;
+    using xo::reflect::TaggedPtr;
+    using xo::reflect::TypeDescr;
+    using xo::time::utc_nanos;
+
+    namespace reactor {
+        /* wire format writes host byte order */
+        static_assert(std::endian::native == std::endian::little);
+
+        namespace {
+            constexpr char c_magic[8] = {'X', 'O', 'C', 'O', 'L', 'S', 'N', '1'};
+
+            /* column type for reflected atomic type td;  false if unsupported */
+            bool
+            column_type_for(TypeDescr td, ColumnType * p_ct)
+            {
+                struct Entry { TypeDescr td_; ColumnType ct_; };
+
+                static Entry const s_entry_v[] = {
+                    {Reflect::require<bool>(), ColumnType::ct_bool},
+                    {Reflect::require<std::int16_t>(), ColumnType::ct_i16},
+                    {Reflect::require<std::uint16_t>(), ColumnType::ct_u16},
+                    {Reflect::require<std::int32_t>(), ColumnType::ct_i32},
+                    {Reflect::require<std::uint32_t>(), ColumnType::ct_u32},
+                    {Reflect::require<std::int64_t>(), ColumnType::ct_i64},
+                    {Reflect::require<std::uint64_t>(), ColumnType::ct_u64},
+                    {Reflect::require<float>(), ColumnType::ct_f32},
+                    {Reflect::require<double>(), ColumnType::ct_f64},
+                    {Reflect::require<utc_nanos>(), ColumnType::ct_utc_nanos},
+                    {Reflect::require<std::string>(), ColumnType::ct_string},
+                };
+
+                for (Entry const & e : s_entry_v) {
+                    if (e.td_ == td) {
+                        *p_ct = e.ct_;
+                        return true;
+                    }
+                }
+
+                return false;
+            } /*column_type_for*/
+
+            template <typename T>
+            void
+            put_pod(std::ostream * p_os, T x)
+            {
+                p_os->write(reinterpret_cast<char const *>(&x), sizeof(x));
+            }
+
+            /* zero-pad *p_os from position z up to multiple of 8 */
+            std::size_t
+            pad8(std::ostream * p_os, std::size_t z)
+            {
+                static constexpr char c_zero[8] = {};
+
+                std::size_t pad = (8 - (z % 8)) % 8;
+
+                p_os->write(c_zero, pad);
+
+                return z + pad;
+            } /*pad8*/
+        } /*namespace*/
+
+        ColumnarSnapshot::ColumnarSnapshot(TypeDescr event_td)
+        {
+            using xo::pp::tostr;
+            using xo::pp::xtag;
+
+            TypeDescr td = event_td;
+
+            while (td && td->is_pointer())
+                td = td->fixed_child_td(0);
+
+            if (!td || !td->is_struct()) {
+                throw std::runtime_error(tostr("ColumnarSnapshot::ctor"
+                                               ": expected struct event type",
+                                               xtag("event_td", event_td ? std::string(event_td->canonical_name()) : std::string("nullptr"))));
+            }
+
+            this->struct_td_ = td;
+            this->plan_columns(td, "", {});
+        } /*ctor*/
+
+        std::uint32_t
+        ColumnarSnapshot::column_width(ColumnType ct)
+        {
+            switch (ct) {
+            case ColumnType::ct_bool:
+                return 1;
+            case ColumnType::ct_i16:
+            case ColumnType::ct_u16:
+                return 2;
+            case ColumnType::ct_i32:
+            case ColumnType::ct_u32:
+            case ColumnType::ct_f32:
+                return 4;
+            case ColumnType::ct_i64:
+            case ColumnType::ct_u64:
+            case ColumnType::ct_f64:
+            case ColumnType::ct_utc_nanos:
+                return 8;
+            case ColumnType::ct_string:
+                return 0;
+            }
+
+            return 0;
+        } /*column_width*/
+
+        void
+        ColumnarSnapshot::plan_columns(TypeDescr td,
+                                       std::string const & name_prefix,
+                                       std::vector<std::uint32_t> const & path_prefix_v)
+        {
+            for (std::uint32_t i = 0, n = td->n_child_fixed(); i < n; ++i) {
+                StructMember const & sm = td->struct_member(i);
+                TypeDescr member_td = sm.get_member_td();
+
+                std::string name = name_prefix + sm.member_name();
+                std::vector<std::uint32_t> path_v = path_prefix_v;
+                path_v.push_back(i);
+
+                ColumnType ct;
+
+                if (column_type_for(member_td, &ct)) {
+                    Column col;
+                    col.name_ = std::move(name);
+                    col.type_ = ct;
+                    col.path_v_ = std::move(path_v);
+
+                    if (ct == ColumnType::ct_string)
+                        col.str_offset_v_.push_back(0);
+
+                    this->column_v_.push_back(std::move(col));
+                } else if (member_td->is_struct()) {
+                    this->plan_columns(member_td, name + ".", path_v);
+                }
+
+                /* anything else omitted */
+            }
+        } /*plan_columns*/
+
+        void
+        ColumnarSnapshot::sample_offsets(void * struct_addr)
+        {
+            for (Column & col : this->column_v_) {
+                TypeDescr td = this->struct_td_;
+                void * addr = struct_addr;
+
+                for (std::uint32_t ix : col.path_v_) {
+                    StructMember const & sm = td->struct_member(ix);
+
+                    addr = sm.get_member_addr(addr);
+                    td = sm.get_member_td();
+                }
+
+                col.offset_ = (reinterpret_cast<char *>(addr)
+                               - reinterpret_cast<char *>(struct_addr));
+            }
+
+            this->offset_flag_ = true;
+        } /*sample_offsets*/
+
+        void
+        ColumnarSnapshot::clear()
+        {
+            for (Column & col : this->column_v_) {
+                col.data_v_.clear();
+
+                if (col.type_ == ColumnType::ct_string) {
+                    col.str_offset_v_.clear();
+                    col.str_offset_v_.push_back(0);
+                }
+            }
+
+            this->n_row_ = 0;
+        } /*clear*/
+
+        void
+        ColumnarSnapshot::append(TaggedPtr ev_tp)
+        {
+            using xo::pp::tostr;
+            using xo::pp::xtag;
+
+            if (ev_tp.td() != this->struct_td_) {
+                throw std::runtime_error(tostr("ColumnarSnapshot::append"
+                                               ": unexpected event type",
+                                               xtag("expected", this->struct_td_->canonical_name()),
+                                               xtag("actual", (ev_tp.td()
+                                                               ? std::string(ev_tp.td()->canonical_name())
+                                                               : std::string("nullptr")))));
+            }
+
+            char * obj = reinterpret_cast<char *>(ev_tp.address());
+
+            if (obj && !this->offset_flag_)
+                this->sample_offsets(obj);
+
+            for (Column & col : this->column_v_) {
+                if (col.type_ == ColumnType::ct_string) {
+                    if (obj) {
+                        std::string const & s = *reinterpret_cast<std::string const *>(obj + col.offset_);
+
+                        col.data_v_.insert(col.data_v_.end(), s.begin(), s.end());
+                    }
+
+                    if (col.data_v_.size() > std::numeric_limits<std::uint32_t>::max()) {
+                        throw std::runtime_error(tostr("ColumnarSnapshot::append"
+                                                       ": string column exceeds 4GB",
+                                                       xtag("column", col.name_)));
+                    }
+
+                    col.str_offset_v_.push_back(col.data_v_.size());
+                } else {
+                    std::uint32_t w = column_width(col.type_);
+                    std::size_t z = col.data_v_.size();
+
+                    col.data_v_.resize(z + w);
+
+                    if (obj) {
+                        /* bool: normalize to 0/1 */
+                        if (col.type_ == ColumnType::ct_bool)
+                            col.data_v_[z] = *reinterpret_cast<bool const *>(obj + col.offset_) ? 1 : 0;
+                        else
+                            ::memcpy(&(col.data_v_[z]), obj + col.offset_, w);
+                    }
+                }
+            }
+
+            ++(this->n_row_);
+        } /*append*/
+
+        void
+        ColumnarSnapshot::write(std::ostream * p_os) const
+        {
+            std::size_t z = 0;
+
+            p_os->write(c_magic, sizeof(c_magic));
+            put_pod<std::uint32_t>(p_os, this->n_row_);
+            put_pod<std::uint32_t>(p_os, this->column_v_.size());
+            z += sizeof(c_magic) + 8;
+
+            for (Column const & col : this->column_v_) {
+                std::uint16_t name_z = std::min(col.name_.size(),
+                                                std::size_t(std::numeric_limits<std::uint16_t>::max()));
+
+                put_pod<std::uint8_t>(p_os, static_cast<std::uint8_t>(col.type_));
+                put_pod<std::uint8_t>(p_os, 0);
+                put_pod<std::uint16_t>(p_os, name_z);
+                p_os->write(col.name_.data(), name_z);
+
+                z += 4 + name_z;
+            }
+
+            z = pad8(p_os, z);
+
+            for (Column const & col : this->column_v_) {
+                if (col.type_ == ColumnType::ct_string) {
+                    std::size_t off_z = col.str_offset_v_.size() * sizeof(std::uint32_t);
+
+                    p_os->write(reinterpret_cast<char const *>(col.str_offset_v_.data()), off_z);
+                    z += off_z;
+                }
+
+                p_os->write(col.data_v_.data(), col.data_v_.size());
+                z += col.data_v_.size();
+
+                z = pad8(p_os, z);
+            }
+        } /*write*/
+    } /*namespace reactor*/
+} /*namespace xo*/
+
+/* end ColumnarSnapshot.cpp */
@@ -0,0 +1,338 @@
+/* @file EpollReactor.cpp */
+
+#include "EpollReactor.hpp"
+#include <xo/ppsink/scope.hpp>
+#include <xo/ppsink/scope_macros.hpp>
+#include <xo/ppsink/tag_ostream.hpp>
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#include <sys/timerfd.h>
+#include <unistd.h>
+#include <algorithm>
+#include <cassert>
+#include <cerrno>
+#include <cstring>
+#include <stdexcept>
+#include <string>
+
+namespace xo {
+    using std::uint64_t;
+
+    namespace reactor {
+        using xo::pp::scope;
+        using xo::pp::xtag;
+        using xo::time::utc_nanos;
+
+        namespace {
+            /* check that OS call returned non-negative result */
+            int
+            check_syscall(int rc, char const * what)
+            {
+                if (rc < 0) {
+                    throw std::runtime_error(std::string("EpollReactor: ")
+                                             + what + " failed: "
+                                             + ::strerror(errno));
+                }
+
+                return rc;
+            } /*check_syscall*/
+
+            /* min-heap on timestamp */
+            struct TimerGreater {
+                bool operator()(std::pair<utc_nanos, ReactorSource *> const & x,
+                                std::pair<utc_nanos, ReactorSource *> const & y) const {
+                    return x.first > y.first;
+                }
+            };
+
+            /* after this many dispatches with a busy ready queue,
+             * check wakeup fds without blocking
+             */
+            constexpr std::uint32_t c_poll_interval = 64;
+        } /*namespace*/
+
+        rp<EpollReactor>
+        EpollReactor::make(nanos park_dt)
+        {
+            return new EpollReactor(park_dt);
+        } /*make*/
+
+        EpollReactor::EpollReactor(nanos park_dt)
+            : park_dt_{park_dt}
+        {
+            this->epoll_fd_ = check_syscall(::epoll_create1(EPOLL_CLOEXEC),
+                                            "epoll_create1");
+            this->wake_fd_ = check_syscall(::eventfd(0, EFD_NONBLOCK | EFD_CLOEXEC),
+                                           "eventfd");
+            this->timer_fd_ = check_syscall(::timerfd_create(CLOCK_REALTIME,
+                                                             TFD_NONBLOCK | TFD_CLOEXEC),
+                                            "timerfd_create");
+
+            for (int fd : { this->wake_fd_, this->timer_fd_ }) {
+                struct epoll_event ev;
+                ev.events = EPOLLIN;
+                ev.data.fd = fd;
+
+                check_syscall(::epoll_ctl(this->epoll_fd_, EPOLL_CTL_ADD, fd, &ev),
+                              "epoll_ctl");
+            }
+        } /*ctor*/
+
+        EpollReactor::~EpollReactor()
+        {
+            for (int fd : { this->timer_fd_, this->wake_fd_, this->epoll_fd_ }) {
+                if (fd >= 0)
+                    ::close(fd);
+            }
+        } /*dtor*/
+
+        bool
+        EpollReactor::add_source(bp<ReactorSource> src)
+        {
+            if (this->source_map_.contains(src.get())) {
+                throw std::runtime_error("EpollReactor::add_source; source already present");
+                return false;
+            }
+
+            this->source_map_[src.get()] = SourceState{src.get(), false};
+
+            src->notify_reactor_add(this);
+
+            /* source may already have events */
+            if (src->is_nonempty())
+                this->enqueue_ready(src.get());
+
+            return true;
+        } /*add_source*/
+
+        bool
+        EpollReactor::remove_source(bp<ReactorSource> src)
+        {
+            auto ix = this->source_map_.find(src.get());
+
+            if (ix == this->source_map_.end())
+                return false;
+
+            /* keep src alive until we're done with it */
+            ReactorSourcePtr keep = ix->second.src_;
+
+            src->notify_reactor_remove(this);
+
+            if (ix->second.ready_flag_)
+                std::erase(this->ready_q_, src.get());
+
+            this->source_map_.erase(ix);
+
+            /* stale .timer_v entries are discarded when they expire */
+
+            return true;
+        } /*remove_source*/
+
+        void
+        EpollReactor::notify_source_primed(bp<ReactorSource> src)
+        {
+            this->enqueue_ready(src.get());
+        } /*notify_source_primed*/
+
+        void
+        EpollReactor::wakeup_source(bp<ReactorSource> src)
+        {
+            {
+                std::lock_guard<std::mutex> lock(this->wakeup_mutex_);
+
+                this->wakeup_v_.push_back(src.get());
+            }
+
+            this->wakeup_flag_.store(true, std::memory_order_release);
+
+            uint64_t one = 1;
+
+            /* EAGAIN only if counter would overflow;  reactor is awake in that case */
+            (void)::write(this->wake_fd_, &one, sizeof(one));
+        } /*wakeup_source*/
+
+        void
+        EpollReactor::notify_source_primed_at(bp<ReactorSource> src, utc_nanos tm)
+        {
+            bool rearm = (this->timer_v_.empty() || (tm < this->timer_v_.front().first));
+
+            this->timer_v_.push_back(std::make_pair(tm, src.get()));
+            std::push_heap(this->timer_v_.begin(), this->timer_v_.end(), TimerGreater());
+
+            if (rearm)
+                this->arm_timer();
+        } /*notify_source_primed_at*/
+
+        void
+        EpollReactor::enqueue_ready(ReactorSource * src)
+        {
+            auto ix = this->source_map_.find(src);
+
+            if (ix == this->source_map_.end()) {
+                /* not attached (or since removed) */
+                return;
+            }
+
+            if (!ix->second.ready_flag_) {
+                ix->second.ready_flag_ = true;
+                this->ready_q_.push_back(src);
+            }
+        } /*enqueue_ready*/
+
+        void
+        EpollReactor::arm_timer()
+        {
+            struct itimerspec spec;
+            std::memset(&spec, 0, sizeof(spec));
+
+            if (!this->timer_v_.empty()) {
+                std::int64_t ns = this->timer_v_.front().first.time_since_epoch().count();
+
+                /* it_value all-zero disarms timer;  stay clear of that */
+                if (ns <= 0)
+                    ns = 1;
+
+                spec.it_value.tv_sec = ns / 1000000000;
+                spec.it_value.tv_nsec = ns % 1000000000;
+            }
+
+            check_syscall(::timerfd_settime(this->timer_fd_, TFD_TIMER_ABSTIME, &spec, nullptr),
+                          "timerfd_settime");
+        } /*arm_timer*/
+
+        void
+        EpollReactor::drain_wakeups()
+        {
+            if (!this->wakeup_flag_.exchange(false, std::memory_order_acquire))
+                return;
+
+            std::vector<ReactorSourcePtr> wakeup_v;
+
+            {
+                std::lock_guard<std::mutex> lock(this->wakeup_mutex_);
+
+                std::swap(wakeup_v, this->wakeup_v_);
+            }
+
+            for (ReactorSourcePtr const & src : wakeup_v)
+                this->enqueue_ready(src.get());
+        } /*drain_wakeups*/
+
+        void
+        EpollReactor::drain_timers()
+        {
+            utc_nanos now = xo::time::timeutil::now();
+
+            std::size_t n = 0;
+
+            while (!this->timer_v_.empty() && (this->timer_v_.front().first <= now)) {
+                ReactorSource * src = this->timer_v_.front().second;
+
+                std::pop_heap(this->timer_v_.begin(), this->timer_v_.end(), TimerGreater());
+                this->timer_v_.pop_back();
+
+                this->enqueue_ready(src);
+                ++n;
+            }
+
+            if (n > 0)
+                this->arm_timer();
+        } /*drain_timers*/
+
+        void
+        EpollReactor::poll_wakeups(int timeout_ms)
+        {
+            constexpr int c_max_event = 2;
+            struct epoll_event ev_v[c_max_event];
+
+            int n = ::epoll_wait(this->epoll_fd_, ev_v, c_max_event, timeout_ms);
+
+            if ((n < 0) && (errno != EINTR))
+                check_syscall(n, "epoll_wait");
+
+            for (int i = 0; i < n; ++i) {
+                uint64_t count = 0;
+
+                /* reset fd readiness;  nonblocking,  so harmless if already drained */
+                (void)::read(ev_v[i].data.fd, &count, sizeof(count));
+            }
+
+            /* also picks up wakeups/timers that arrived without an epoll event
+             * having been reported yet
+             */
+            this->drain_wakeups();
+            this->drain_timers();
+        } /*poll_wakeups*/
+
+        uint64_t
+        EpollReactor::run_one()
+        {
+            scope log(XO_DEBUG_(this->loglevel() <= xo::pp::log_level::chatty));
+
+            if (this->ready_q_.empty()) {
+                int timeout_ms = 0;
+
+                if (this->park_dt_.count() < 0) {
+                    timeout_ms = -1;
+                } else if (this->park_dt_.count() > 0) {
+                    /* round up:  never spin on a sub-millisecond park time */
+                    timeout_ms = std::max<std::int64_t>(1, (this->park_dt_.count() + 999999) / 1000000);
+                }
+
+                this->poll_wakeups(timeout_ms);
+                this->n_since_poll_ = 0;
+            } else if ((++(this->n_since_poll_) >= c_poll_interval)
+                       || this->wakeup_flag_.load(std::memory_order_relaxed))
+            {
+                this->poll_wakeups(0 /*timeout_ms*/);
+                this->n_since_poll_ = 0;
+            }
+
+            while (!this->ready_q_.empty()) {
+                ReactorSource * src = this->ready_q_.front();
+
+                this->ready_q_.pop_front();
+
+                auto ix = this->source_map_.find(src);
+
+                /* (removed sources are also removed from .ready_q) */
+                assert(ix != this->source_map_.end());
+
+                ix->second.ready_flag_ = false;
+
+                /* keep src alive across delivery:  callbacks may remove it */
+                ReactorSourcePtr keep = ix->second.src_;
+
+                if (src->is_empty()) {
+                    /* spurious wakeup.  source will announce itself again */
+                    continue;
+                }
+
+                log && log(xtag("src.name", src->name()));
+
+                uint64_t retval = src->deliver_one();
+
+                /* round robin:  source with more work goes to back of line */
+                if (src->is_nonempty())
+                    this->enqueue_ready(src);
+
+                log.end_scope(xtag("retval", retval));
+
+                return retval;
+            }
+
+            return 0;
+        } /*run_one*/
+
+        void
+        EpollReactor::display(std::ostream & os) const {
+            os << "<EpollReactor"
+               << xtag("source_map.size", source_map_.size())
+               << xtag("ready_q.size", ready_q_.size())
+               << xtag("timer_v.size", timer_v_.size())
+               << ">";
+        } /*display*/
+    } /*namespace reactor*/
+} /*namespace xo*/
+
+/* end EpollReactor.cpp */
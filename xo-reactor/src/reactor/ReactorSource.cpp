@@ -22,6 +22,33 @@ namespace xo {
             return time::timeutil::epoch();
         } /*online_current_tm*/
 
+        std::uint64_t
+        ReactorSource::deliver_batch(utc_nanos limit_tm,
+                                     std::uint64_t max_n,
+                                     utc_nanos * p_last_tm)
+        {
+            std::uint64_t n = 0;
+
+            while ((n < max_n) && this->is_primed()) {
+                utc_nanos tm = this->sim_current_tm();
+
+                if (tm >= limit_tm)
+                    break;
+
+                std::uint64_t k = this->deliver_one();
+
+                if (k == 0)
+                    break;
+
+                n += k;
+
+                if (p_last_tm)
+                    *p_last_tm = tm;
+            }
+
+            return n;
+        } /*deliver_batch*/
+
         std::uint64_t
         ReactorSource::online_advance_until(utc_nanos /*tm*/,
                                             bool /*replay_flag*/)
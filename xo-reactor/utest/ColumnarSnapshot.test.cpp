@@ -0,0 +1,258 @@
+/* @file ColumnarSnapshot.test.cpp */
+
+#include "xo/reactor/ColumnarSnapshot.hpp"
+#include "xo/reactor/EventStore.hpp"
+#include "catch2/catch.hpp"
+#include <xo/reflect/Reflect.hpp>
+#include <xo/reflect/StructReflector.hpp>
+#include <xo/timeutil/timeutil.hpp>
+#include <cstring>
+#include <sstream>
+
+namespace xo {
+    using xo::reactor::ColumnarSnapshot;
+    using xo::reactor::ColumnType;
+    using xo::reactor::StructEventStore;
+    using xo::reflect::Reflect;
+    using xo::reflect::StructReflector;
+    using xo::time::utc_nanos;
+    using xo::time::timeutil;
+    using xo::time::seconds;
+    using xo::time::milliseconds;
+
+    namespace {
+        struct SnapQuote {
+            double bid_px_;
+            double ask_px_;
+        };
+
+        struct SnapEvent {
+            utc_nanos tm() const { return tm_; }
+
+            utc_nanos tm_;
+            std::int32_t seq_;
+            bool firm_;
+            SnapQuote quote_;
+            std::string symbol_;
+            /* not columnar -> omitted */
+            std::vector<double> extra_v_;
+        };
+
+        inline std::ostream &
+        operator<<(std::ostream & os, SnapEvent const & x) {
+            os << "<SnapEvent :seq " << x.seq_ << ">";
+            return os;
+        }
+
+        void
+        reflect_snap_event()
+        {
+            {
+                StructReflector<SnapQuote> sr;
+
+                if (sr.is_incomplete()) {
+                    REFLECT_MEMBER(sr, bid_px);
+                    REFLECT_MEMBER(sr, ask_px);
+                }
+
+                sr.require_complete();
+            }
+
+            {
+                StructReflector<SnapEvent> sr;
+
+                if (sr.is_incomplete()) {
+                    REFLECT_MEMBER(sr, tm);
+                    REFLECT_MEMBER(sr, seq);
+                    REFLECT_MEMBER(sr, firm);
+                    REFLECT_MEMBER(sr, quote);
+                    REFLECT_MEMBER(sr, symbol);
+                    REFLECT_MEMBER(sr, extra_v);
+                }
+
+                sr.require_complete();
+            }
+        } /*reflect_snap_event*/
+
+        /* minimal reader for ColumnarSnapshot wire format */
+        class SnapReader {
+        public:
+            struct Col {
+                ColumnType type_;
+                std::string name_;
+                char const * body_ = nullptr;
+            };
+
+            explicit SnapReader(std::string bytes) : bytes_{std::move(bytes)} {
+                REQUIRE(bytes_.size() >= 16);
+                REQUIRE(bytes_.substr(0, 8) == "XOCOLSN1");
+
+                n_row_ = get<std::uint32_t>(8);
+                std::uint32_t n_col = get<std::uint32_t>(12);
+
+                std::size_t z = 16;
+                for (std::uint32_t i = 0; i < n_col; ++i) {
+                    Col col;
+                    col.type_ = static_cast<ColumnType>(bytes_[z]);
+                    std::uint16_t name_z = get<std::uint16_t>(z + 2);
+                    col.name_ = bytes_.substr(z + 4, name_z);
+                    z += 4 + name_z;
+
+                    col_v_.push_back(col);
+                }
+
+                z = pad8(z);
+
+                for (Col & col : col_v_) {
+                    col.body_ = bytes_.data() + z;
+
+                    if (col.type_ == ColumnType::ct_string) {
+                        std::uint32_t n_byte = get<std::uint32_t>(z + 4 * n_row_);
+                        z += 4 * (n_row_ + 1) + n_byte;
+                    } else {
+                        z += n_row_ * ColumnarSnapshot::column_width(col.type_);
+                    }
+
+                    z = pad8(z);
+                }
+
+                REQUIRE(z == bytes_.size());
+            }
+
+            std::uint32_t n_row() const { return n_row_; }
+            std::vector<Col> const & col_v() const { return col_v_; }
+
+            template <typename T>
+            T value(std::uint32_t j, std::uint32_t i) const {
+                T x;
+                ::memcpy(&x, col_v_[j].body_ + i * sizeof(T), sizeof(T));
+                return x;
+            }
+
+            std::string str_value(std::uint32_t j, std::uint32_t i) const {
+                char const * body = col_v_[j].body_;
+                std::uint32_t lo, hi;
+                ::memcpy(&lo, body + 4 * i, 4);
+                ::memcpy(&hi, body + 4 * (i + 1), 4);
+
+                return std::string(body + 4 * (n_row_ + 1) + lo, hi - lo);
+            }
+
+        private:
+            template <typename T>
+            T get(std::size_t z) const {
+                T x;
+                ::memcpy(&x, bytes_.data() + z, sizeof(T));
+                return x;
+            }
+
+            static std::size_t pad8(std::size_t z) { return (z + 7) & ~std::size_t(7); }
+
+        private:
+            std::string bytes_;
+            std::uint32_t n_row_ = 0;
+            std::vector<Col> col_v_;
+        }; /*SnapReader*/
+    } /*namespace*/
+
+    namespace ut {
+        TEST_CASE("columnar-snapshot-plan", "[reactor][ColumnarSnapshot]") {
+            reflect_snap_event();
+
+            ColumnarSnapshot snap(Reflect::require<SnapEvent>());
+
+            REQUIRE(snap.struct_td() == Reflect::require<SnapEvent>());
+            REQUIRE(snap.n_row() == 0);
+            REQUIRE(snap.n_column() == 6);
+
+            REQUIRE(snap.column(0).name_ == "tm");
+            REQUIRE(snap.column(0).type_ == ColumnType::ct_utc_nanos);
+            REQUIRE(snap.column(1).name_ == "seq");
+            REQUIRE(snap.column(1).type_ == ColumnType::ct_i32);
+            REQUIRE(snap.column(2).name_ == "firm");
+            REQUIRE(snap.column(2).type_ == ColumnType::ct_bool);
+            REQUIRE(snap.column(3).name_ == "quote.bid_px");
+            REQUIRE(snap.column(3).type_ == ColumnType::ct_f64);
+            REQUIRE(snap.column(4).name_ == "quote.ask_px");
+            REQUIRE(snap.column(4).type_ == ColumnType::ct_f64);
+            REQUIRE(snap.column(5).name_ == "symbol");
+            REQUIRE(snap.column(5).type_ == ColumnType::ct_string);
+
+            /* not a struct */
+            REQUIRE_THROWS(ColumnarSnapshot(Reflect::require<double>()));
+
+            /* wrong event type */
+            SnapQuote q{1.0, 2.0};
+            REQUIRE_THROWS(snap.append(Reflect::make_tp(&q)));
+        } /*TEST_CASE(columnar-snapshot-plan)*/
+
+        TEST_CASE("columnar-snapshot-eventstore", "[reactor][ColumnarSnapshot]") {
+            reflect_snap_event();
+
+            utc_nanos t0 = timeutil::ymd_hms_usec(20220923 /*ymd*/, 93000 /*hms*/, 0 /*usec*/);
+
+            auto store = StructEventStore<SnapEvent>::make();
+
+            char const * sym_v[] = { "AB", "", "XYZW" };
+
+            for (std::int32_t i = 0; i < 10; ++i) {
+                store->insert(SnapEvent{t0 + seconds(i), i, (i % 2 == 0),
+                                        SnapQuote{100.0 + i, 100.5 + i},
+                                        sym_v[i % 3], {1.0, 2.0}});
+            }
+
+            /* last 4 events */
+            {
+                std::stringstream ss;
+                store->columnar_snapshot_last_n(4, &ss);
+
+                SnapReader rd(ss.str());
+
+                REQUIRE(rd.n_row() == 4);
+                REQUIRE(rd.col_v().size() == 6);
+                REQUIRE(rd.col_v()[3].name_ == "quote.bid_px");
+
+                for (std::uint32_t i = 0; i < 4; ++i) {
+                    std::int32_t k = 6 + i;
+
+                    INFO("i=" << i);
+
+                    REQUIRE(rd.value<std::int64_t>(0, i)
+                            == (t0 + seconds(k)).time_since_epoch().count());
+                    REQUIRE(rd.value<std::int32_t>(1, i) == k);
+                    REQUIRE(rd.value<std::uint8_t>(2, i) == ((k % 2 == 0) ? 1 : 0));
+                    REQUIRE(rd.value<double>(3, i) == 100.0 + k);
+                    REQUIRE(rd.value<double>(4, i) == 100.5 + k);
+                    REQUIRE(rd.str_value(5, i) == sym_v[k % 3]);
+                }
+            }
+
+            /* events within 2.5 seconds of last event */
+            {
+                std::stringstream ss;
+                store->columnar_snapshot_last_dt(milliseconds(2500), &ss);
+
+                SnapReader rd(ss.str());
+
+                REQUIRE(rd.n_row() == 4);
+                REQUIRE(rd.value<std::int32_t>(1, 0) == 6);
+                REQUIRE(rd.value<std::int32_t>(1, 3) == 9);
+            }
+
+            /* empty store */
+            {
+                store->clear();
+
+                std::stringstream ss;
+                store->columnar_snapshot_last_n(100, &ss);
+
+                SnapReader rd(ss.str());
+
+                REQUIRE(rd.n_row() == 0);
+                REQUIRE(rd.col_v().size() == 6);
+            }
+        } /*TEST_CASE(columnar-snapshot-eventstore)*/
+    } /*namespace ut*/
+} /*namespace xo*/
+
+/* end ColumnarSnapshot.test.cpp */
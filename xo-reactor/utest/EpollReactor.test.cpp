@@ -0,0 +1,294 @@
+/* @file EpollReactor.test.cpp */
+
+#include "xo/reactor/EpollReactor.hpp"
+#include "catch2/catch.hpp"
+#include "xo/reactor/FifoQueue.hpp"
+#include "xo/reactor/SpscQueue.hpp"
+#include "xo/reactor/Sink.hpp"
+#include "xo/reactor/init_reactor.hpp"
+#include <xo/ppsink/pretty_pair.hpp>   /* Prettifier<std::pair<T,U>> */
+#include <xo/ppsink/tag_ostream.hpp>
+#include <xo/randomgen/xoshiro256.hpp>
+#include <xo/reflect/Reflect.hpp>
+#include <xo/timeutil/timeutil.hpp>
+#include <algorithm>
+#include <chrono>
+#include <set>
+#include <thread>
+
+namespace xo {
+    using xo::reactor::EpollReactor;
+    using xo::reactor::ReactorSource;
+    using xo::reactor::AbstractSink;
+    using xo::reactor::AbstractEventProcessor;
+    using xo::reactor::FifoQueue;
+    using xo::reactor::SpscQueue;
+    using xo::reactor::SinkToFunction;
+    using xo::reflect::Reflect;
+    using xo::reflect::TypeDescr;
+    using xo::time::timeutil;
+    using xo::time::utc_nanos;
+    using xo::time::nanos;
+    using xo::time::microseconds;
+    using std::chrono::milliseconds;
+
+    namespace {
+        using TestEvent = std::pair<utc_nanos, std::uint64_t>;
+        using TestSinkFn = std::function<void (TestEvent const &)>;
+
+        /* source with one event,  that becomes available at .due_tm (wall clock) */
+        class AlarmSource : public ReactorSource {
+        public:
+            explicit AlarmSource(utc_nanos due_tm) : due_tm_{due_tm} {}
+
+            utc_nanos fired_tm() const { return fired_tm_; }
+
+            // ----- inherited from ReactorSource -----
+
+            virtual bool is_empty() const override {
+                return (n_out_ev_ > 0) || (timeutil::now() < due_tm_);
+            }
+            virtual bool is_exhausted() const override { return n_out_ev_ > 0; }
+            virtual utc_nanos sim_current_tm() const override { return due_tm_; }
+            virtual std::uint64_t sim_advance_until(utc_nanos, bool) override { return 0; }
+            virtual std::uint64_t deliver_one() override {
+                if (this->is_empty())
+                    return 0;
+
+                this->fired_tm_ = timeutil::now();
+                ++(this->n_out_ev_);
+
+                return 1;
+            }
+
+            // ----- inherited from AbstractSource -----
+
+            virtual TypeDescr source_ev_type() const override { return Reflect::require<utc_nanos>(); }
+            virtual bool is_volatile() const override { return false; }
+            virtual uint32_t n_queued_out_ev() const override { return 1 - n_out_ev_; }
+            virtual uint32_t n_out_ev() const override { return n_out_ev_; }
+            virtual bool debug_sim_flag() const override { return false; }
+            virtual void set_debug_sim_flag(bool) override {}
+            virtual CallbackId attach_sink(rp<AbstractSink> const &) override { return CallbackId(); }
+            virtual void detach_sink(CallbackId) override {}
+
+            // ----- inherited from AbstractEventProcessor -----
+
+            virtual std::string const & name() const override { return name_; }
+            virtual void set_name(std::string const & x) override { name_ = x; }
+            virtual void visit_direct_consumers(std::function<void (bp<AbstractEventProcessor>)> const &) override {}
+            virtual void display(std::ostream & os) const override { os << "<AlarmSource>"; }
+
+        private:
+            std::string name_;
+            utc_nanos due_tm_;
+            utc_nanos fired_tm_;
+            uint32_t n_out_ev_ = 0;
+        }; /*AlarmSource*/
+    } /*namespace*/
+
+    static InitEvidence s_evidence = InitSubsys<S_reactor_tag>::require();
+
+    namespace ut {
+        using xo::pp::xtag;
+
+        TEST_CASE("epoll0", "[reactor][epoll]") {
+            Subsystem::initialize_all();
+
+            /* never park */
+            {
+                rp<EpollReactor> reactor = EpollReactor::make(nanos(0));
+                reactor->set_loglevel(xo::pp::log_level::error);
+
+                REQUIRE(reactor->n_ready() == 0);
+
+                for (std::uint32_t i = 0; i < 3; ++i) {
+                    INFO(xtag("i", i));
+                    REQUIRE(reactor->run_one() == 0);
+                }
+            }
+
+            /* idle reactor parks for .park_dt */
+            {
+                rp<EpollReactor> reactor = EpollReactor::make(milliseconds(20));
+                reactor->set_loglevel(xo::pp::log_level::error);
+
+                auto t0 = std::chrono::steady_clock::now();
+
+                REQUIRE(reactor->run_one() == 0);
+
+                auto dt = std::chrono::steady_clock::now() - t0;
+
+                REQUIRE(dt >= milliseconds(15));
+            }
+        } /*TEST_CASE(epoll0)*/
+
+        /* many sources,  few of them active:  reactor visits only primed sources */
+        TEST_CASE("epoll-fifo", "[reactor][epoll]") {
+            Subsystem::initialize_all();
+
+            uint64_t seed = 3719940385723409151UL;
+            auto rgen = xo::rng::xoshiro256ss(seed);
+
+            rp<EpollReactor> reactor = EpollReactor::make(nanos(0));
+            reactor->set_loglevel(xo::pp::log_level::error);
+
+            std::size_t n_src = 1000;
+
+            std::vector<rp<FifoQueue<TestEvent>>> q_v;
+            std::vector<std::vector<std::uint64_t>> out_vv(n_src);
+
+            for (std::size_t i = 0; i < n_src; ++i) {
+                rp<FifoQueue<TestEvent>> q = FifoQueue<TestEvent>::make();
+
+                std::vector<std::uint64_t> * p_out = &(out_vv[i]);
+
+                q->add_callback(new SinkToFunction<TestEvent, TestSinkFn>
+                                ([p_out](TestEvent const & x) { p_out->push_back(x.second); }));
+
+                REQUIRE(reactor->add_source(q));
+
+                q_v.push_back(q);
+            }
+
+            utc_nanos t0 = timeutil::ymd_hms(20240101 /*ymd*/, 93000 /*hms*/);
+
+            /* .second: global sequence# */
+            std::uint64_t n_ev = 0;
+            std::uint64_t n_delivered = 0;
+
+            for (std::uint32_t round = 0; round < 20; ++round) {
+                INFO(xtag("round", round));
+
+                /* a handful of sources receive events */
+                std::set<std::size_t> active_set;
+
+                for (std::uint32_t j = 0; j < 5; ++j) {
+                    std::size_t i = rgen() % n_src;
+
+                    active_set.insert(i);
+
+                    std::uint64_t k = 1 + rgen() % 10;
+                    for (std::uint64_t m = 0; m < k; ++m) {
+                        q_v[i]->notify_ev(TestEvent(t0 + microseconds(n_ev), n_ev));
+                        ++n_ev;
+                    }
+                }
+
+                REQUIRE(reactor->n_ready() == active_set.size());
+
+                while (reactor->run_one() > 0)
+                    ++n_delivered;
+
+                REQUIRE(n_delivered == n_ev);
+                REQUIRE(reactor->n_ready() == 0);
+            }
+
+            /* each queue delivers its events in the order received */
+            std::uint64_t n_out = 0;
+            for (std::size_t i = 0; i < n_src; ++i) {
+                INFO(xtag("i", i));
+
+                REQUIRE(std::is_sorted(out_vv[i].begin(), out_vv[i].end()));
+                n_out += out_vv[i].size();
+            }
+
+            REQUIRE(n_out == n_ev);
+
+            /* removed source is no longer visited */
+            q_v[0]->notify_ev(TestEvent(t0 + microseconds(n_ev), n_ev));
+
+            REQUIRE(reactor->n_ready() == 1);
+            REQUIRE(reactor->remove_source(q_v[0]));
+            REQUIRE(!reactor->remove_source(q_v[0]));
+            REQUIRE(reactor->n_ready() == 0);
+            REQUIRE(reactor->run_one() == 0);
+        } /*TEST_CASE(epoll-fifo)*/
+
+        /* producer thread feeds SpscQueue,  wakes parked reactor through eventfd */
+        TEST_CASE("epoll-wakeup", "[reactor][epoll]") {
+            Subsystem::initialize_all();
+
+            rp<EpollReactor> reactor = EpollReactor::make(milliseconds(500));
+            reactor->set_loglevel(xo::pp::log_level::error);
+
+            rp<SpscQueue<TestEvent>> q = SpscQueue<TestEvent>::make(256);
+
+            std::uint64_t n_recv = 0;
+            bool order_ok = true;
+
+            q->add_callback(new SinkToFunction<TestEvent, TestSinkFn>
+                            ([&n_recv, &order_ok](TestEvent const & x)
+                                {
+                                    order_ok &= (x.second == n_recv);
+                                    ++n_recv;
+                                }));
+
+            reactor->add_source(q);
+
+            std::uint64_t n_ev = 20000;
+            utc_nanos t0 = timeutil::ymd_hms(20240101 /*ymd*/, 93000 /*hms*/);
+
+            std::thread producer
+                ([reactor, q, n_ev, t0]()
+                    {
+                        for (std::uint64_t i = 0; i < n_ev; ) {
+                            if (q->push(TestEvent(t0 + nanos(i), i))) {
+                                ++i;
+
+                                /* wake reactor once per burst */
+                                if (i % 100 == 0)
+                                    reactor->wakeup_source(q);
+                            } else {
+                                reactor->wakeup_source(q);
+                                std::this_thread::yield();
+                            }
+                        }
+
+                        q->close();
+                        reactor->wakeup_source(q);
+                    });
+
+            while (!q->is_exhausted())
+                reactor->run_one();
+
+            producer.join();
+
+            REQUIRE(order_ok);
+            REQUIRE(n_recv == n_ev);
+        } /*TEST_CASE(epoll-wakeup)*/
+
+        /* timerfd wakeup */
+        TEST_CASE("epoll-timer", "[reactor][epoll]") {
+            Subsystem::initialize_all();
+
+            rp<EpollReactor> reactor = EpollReactor::make(std::chrono::seconds(2));
+            reactor->set_loglevel(xo::pp::log_level::error);
+
+            utc_nanos now = timeutil::now();
+
+            rp<AlarmSource> a1 = new AlarmSource(now + milliseconds(30));
+            rp<AlarmSource> a2 = new AlarmSource(now + milliseconds(10));
+
+            reactor->add_source(a1);
+            reactor->add_source(a2);
+
+            REQUIRE(reactor->n_ready() == 0);
+
+            reactor->notify_source_primed_at(a1, now + milliseconds(30));
+            reactor->notify_source_primed_at(a2, now + milliseconds(10));
+
+            /* alarms fire in due order;  reactor sleeps in between */
+            REQUIRE(reactor->run_one() == 1);
+            REQUIRE(a2->is_exhausted());
+            REQUIRE(!a1->is_exhausted());
+            REQUIRE(a2->fired_tm() >= now + milliseconds(10));
+
+            REQUIRE(reactor->run_one() == 1);
+            REQUIRE(a1->is_exhausted());
+            REQUIRE(a1->fired_tm() >= now + milliseconds(30));
+        } /*TEST_CASE(epoll-timer)*/
+    } /*namespace ut*/
+} /*namespace xo*/
+
+/* end EpollReactor.test.cpp */
@@ -3,6 +3,7 @@
 #include "xo/reactor/Sink.hpp"
 #include "catch2/catch.hpp"
 #include "xo/reactor/PollingReactor.hpp"
+#include "xo/reactor/FifoQueue.hpp"
 #include <xo/ppsink/pretty_pair.hpp>   /* Prettifier<std::pair<T,U>> */
 #include <xo/timeutil/timeutil.hpp>
 
@@ -13,7 +14,11 @@ namespace xo {
     using xo::reactor::Sink1;
     using xo::reactor::SinkEndpoint;
     using xo::reactor::SinkToConsole;
+    using xo::reactor::SinkToFunction;
+    using xo::reactor::FifoQueue;
     using xo::time::utc_nanos;
+    using xo::time::timeutil;
+    using xo::time::seconds;
 
     namespace {
         class TestSink : public SinkEndpoint<int> {
@@ -37,6 +42,24 @@ namespace xo {
         }; /*TestSink2*/
 
         using TestSink3 = SinkToConsole<std::pair<utc_nanos, double>>;
+
+        /* sink relying on default Sink1<T>::notify_ev_batch() */
+        class TestSink4 : public SinkEndpoint<int> {
+        public:
+            TestSink4() = default;
+
+            std::vector<int> const & ev_v() const { return ev_v_; }
+
+            virtual uint32_t n_in_ev() const override { return ev_v_.size(); }
+            virtual bool allow_volatile_source() const override { return true; }
+            virtual void notify_ev(int const & ev) override { ev_v_.push_back(ev); }
+            virtual void display(std::ostream & os) const override { os << "<TestSink4>"; }
+
+        private:
+            std::vector<int> ev_v_;
+        }; /*TestSink4*/
+
+        using TestEvent = std::pair<utc_nanos, int>;
     } /*namespace*/
 
     namespace ut {
@@ -94,6 +117,79 @@ namespace xo {
 
             REQUIRE(test_sink.get() == ev_sink2.get());
         } /*TEST_CASE(sink-cast3)*/
+
+        TEST_CASE("sink-batch", "[reactor][sink]") {
+            rp<TestSink4> test_sink = new TestSink4();
+
+            std::vector<int> v = { 3, 1, 4, 1, 5 };
+
+            test_sink->notify_ev_batch(std::span<int const>(v));
+
+            REQUIRE(test_sink->ev_v() == v);
+            REQUIRE(test_sink->n_in_ev() == v.size());
+        } /*TEST_CASE(sink-batch)*/
+
+        TEST_CASE("fifo-batch", "[reactor][fifo]") {
+            utc_nanos t0 = timeutil::ymd_hms(20231011 /*ymd*/, 131300 /*hms*/);
+
+            std::vector<TestEvent> ev_v;
+            for (int i = 0; i < 10; ++i)
+                ev_v.push_back(TestEvent(t0 + seconds(i), i));
+
+            std::vector<TestEvent> out_ev_v;
+            auto sink_fn
+                = ([&out_ev_v](TestEvent const & x) { out_ev_v.push_back(x); });
+
+            using TestQueue = FifoQueue<TestEvent>;
+
+            SECTION("no-reactor") {
+                /* without reactor,  fifo delivers immediately */
+                rp<TestQueue> q = TestQueue::make();
+
+                q->add_callback(new SinkToFunction
+                                <TestEvent, std::function<void (TestEvent const &)>>(sink_fn));
+
+                q->notify_ev_batch(std::span<TestEvent const>(ev_v));
+
+                REQUIRE(out_ev_v == ev_v);
+                REQUIRE(q->n_in_ev() == ev_v.size());
+                REQUIRE(q->n_out_ev() == ev_v.size());
+                REQUIRE(q->is_empty());
+            }
+
+            SECTION("reactor") {
+                rp<PollingReactor> reactor = PollingReactor::make();
+                rp<TestQueue> q = TestQueue::make();
+
+                q->add_callback(new SinkToFunction
+                                <TestEvent, std::function<void (TestEvent const &)>>(sink_fn));
+                reactor->add_source(q);
+
+                q->notify_ev_batch(std::span<TestEvent const>(ev_v));
+
+                /* with reactor,  events wait to be delivered */
+                REQUIRE(out_ev_v.empty());
+                REQUIRE(q->n_queued_out_ev() == ev_v.size());
+
+                /* deliver events before t0+4s */
+                utc_nanos last_tm = t0;
+                REQUIRE(q->deliver_batch(t0 + seconds(4), 100, &last_tm) == 4);
+                REQUIRE(last_tm == t0 + seconds(3));
+                REQUIRE(out_ev_v.size() == 4);
+                REQUIRE(q->sim_current_tm() == t0 + seconds(4));
+
+                /* max_n limits run length */
+                REQUIRE(q->deliver_batch(utc_nanos::max(), 2, &last_tm) == 2);
+                REQUIRE(last_tm == t0 + seconds(5));
+
+                /* remainder one at a time */
+                while (reactor->run_one() > 0)
+                    ;
+
+                REQUIRE(out_ev_v == ev_v);
+                REQUIRE(q->is_empty());
+            }
+        } /*TEST_CASE(fifo-batch)*/
     } /*namespace ut*/
 } /*namespace xo*/
 
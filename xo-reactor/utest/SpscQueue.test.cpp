@@ -0,0 +1,318 @@
+/* @file SpscQueue.test.cpp */
+
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
+
+#include "xo/reactor/SpscQueue.hpp"
+#include "catch2/catch.hpp"
+#include "xo/reactor/PollingReactor.hpp"
+#include "xo/reactor/Sink.hpp"
+#include "xo/reactor/init_reactor.hpp"
+#include <xo/ppsink/pretty_pair.hpp>   /* Prettifier<std::pair<T,U>> */
+#include <xo/ppsink/tag_ostream.hpp>
+#include <xo/randomgen/xoshiro256.hpp>
+#include <xo/timeutil/timeutil.hpp>
+#include <algorithm>
+#include <chrono>
+#include <thread>
+
+namespace xo {
+    using xo::reactor::PollingReactor;
+    using xo::reactor::SpscQueue;
+    using xo::reactor::SinkToFunction;
+    using xo::time::timeutil;
+    using xo::time::utc_nanos;
+    using xo::time::nanos;
+    using xo::time::microseconds;
+
+    namespace {
+        using TestEvent = std::pair<utc_nanos, std::uint64_t>;
+        using TestQueue = SpscQueue<TestEvent>;
+        using TestSinkFn = std::function<void (TestEvent const &)>;
+    } /*namespace*/
+
+    static InitEvidence s_evidence = InitSubsys<S_reactor_tag>::require();
+
+    namespace ut {
+        using xo::pp::xtag;
+
+        TEST_CASE("spsc-basic", "[reactor][spsc]") {
+            Subsystem::initialize_all();
+
+            rp<TestQueue> q = TestQueue::make(5);
+
+            /* capacity rounds up to power of 2 */
+            REQUIRE(q->capacity() == 8);
+            REQUIRE(q->is_empty());
+            REQUIRE(!q->is_exhausted());
+            REQUIRE(q->deliver_one() == 0);
+
+            std::vector<TestEvent> out_ev_v;
+
+            q->add_callback(new SinkToFunction<TestEvent, TestSinkFn>
+                            ([&out_ev_v](TestEvent const & x) { out_ev_v.push_back(x); }));
+
+            utc_nanos t0 = timeutil::ymd_hms(20240101 /*ymd*/, 93000 /*hms*/);
+
+            /* next event to push / expected next event to deliver */
+            std::uint64_t i_push = 0;
+            std::uint64_t i_recv = 0;
+
+            auto make_ev = ([t0](std::uint64_t i) { return TestEvent(t0 + microseconds(i), i); });
+
+            /* fill to capacity */
+            for (std::size_t j = 0; j < q->capacity(); ++j) {
+                REQUIRE(q->push(make_ev(i_push)));
+                ++i_push;
+            }
+
+            REQUIRE(!q->push(make_ev(i_push)));
+            REQUIRE(q->n_queued_out_ev() == q->capacity());
+            REQUIRE(q->sim_current_tm() == t0);
+
+            /* interleave pushes and deliveries,  so ring wraps repeatedly.
+             * deliver_batch() sees runs that straddle the end of the ring
+             */
+            for (std::uint32_t round = 0; round < 50; ++round) {
+                INFO(xtag("round", round));
+
+                std::uint64_t k = 1 + (round % q->capacity());
+
+                if (round % 2 == 0) {
+                    for (std::uint64_t j = 0; j < k; ++j)
+                        REQUIRE(q->deliver_one() == 1);
+                } else {
+                    utc_nanos last_tm;
+
+                    REQUIRE(q->deliver_batch(utc_nanos::max(), k, &last_tm) == k);
+                    REQUIRE(last_tm == t0 + microseconds(i_recv + k - 1));
+                }
+
+                i_recv += k;
+
+                REQUIRE(out_ev_v.size() == i_recv);
+
+                /* refill */
+                std::vector<TestEvent> ev_v;
+                for (std::size_t j = 0; j < q->capacity(); ++j)
+                    ev_v.push_back(make_ev(i_push + j));
+
+                std::size_t n = q->push_batch(ev_v);
+
+                REQUIRE(n == k);
+
+                i_push += n;
+            }
+
+            /* deliver_batch() honors limit_tm */
+            REQUIRE(q->deliver_batch(t0 + microseconds(i_recv + 2), 100, nullptr) == 2);
+            i_recv += 2;
+
+            q->close();
+
+            REQUIRE(!q->is_exhausted());
+
+            while (q->deliver_one() > 0)
+                ;
+
+            REQUIRE(q->is_empty());
+            REQUIRE(q->is_exhausted());
+            REQUIRE(q->n_out_ev() == i_push);
+            REQUIRE(out_ev_v.size() == i_push);
+
+            for (std::uint64_t i = 0; i < out_ev_v.size(); ++i) {
+                INFO(xtag("i", i));
+                REQUIRE(out_ev_v[i].second == i);
+            }
+        } /*TEST_CASE(spsc-basic)*/
+
+        /* producer on a separate thread,  consumer is PollingReactor::run_one() */
+        TEST_CASE("spsc-threaded", "[reactor][spsc]") {
+            Subsystem::initialize_all();
+
+            uint64_t seed = 6202938519482281121UL;
+            auto rgen = xo::rng::xoshiro256ss(seed);
+
+            for (std::size_t capacity = 1; capacity <= 1024; capacity *= 8) {
+                INFO(xtag("capacity", capacity));
+
+                std::uint64_t n_ev = 20000;
+
+                rp<PollingReactor> reactor = PollingReactor::make();
+                reactor->set_loglevel(xo::pp::log_level::error);
+
+                rp<TestQueue> q = TestQueue::make(capacity);
+
+                reactor->add_source(q);
+
+                std::uint64_t n_recv = 0;
+                bool order_ok = true;
+
+                q->add_callback(new SinkToFunction<TestEvent, TestSinkFn>
+                                ([&n_recv, &order_ok](TestEvent const & x)
+                                    {
+                                        order_ok &= (x.second == n_recv);
+                                        ++n_recv;
+                                    }));
+
+                utc_nanos t0 = timeutil::ymd_hms(20240101 /*ymd*/, 93000 /*hms*/);
+                std::uint64_t producer_seed = rgen();
+
+                std::thread producer
+                    ([q, n_ev, t0, producer_seed]()
+                        {
+                            xo::rng::xoshiro256ss prng(producer_seed);
+                            std::vector<TestEvent> ev_v;
+
+                            std::uint64_t i = 0;
+                            while (i < n_ev) {
+                                /* random batch size,  so .tail advances unevenly */
+                                std::uint64_t k = std::min(1 + (prng() % 100), n_ev - i);
+
+                                ev_v.clear();
+                                for (std::uint64_t j = 0; j < k; ++j)
+                                    ev_v.push_back(TestEvent(t0 + nanos(i + j), i + j));
+
+                                std::span<TestEvent const> todo(ev_v);
+
+                                while (!todo.empty()) {
+                                    std::size_t n = q->push_batch(todo);
+
+                                    todo = todo.subspan(n);
+
+                                    if (n == 0)
+                                        std::this_thread::yield();
+                                }
+
+                                i += k;
+                            }
+
+                            q->close();
+                        });
+
+                while (!q->is_exhausted()) {
+                    /* yield when idle:  producer may share our cpu */
+                    if (reactor->run_one() == 0)
+                        std::this_thread::yield();
+                }
+
+                producer.join();
+
+                REQUIRE(order_ok);
+                REQUIRE(n_recv == n_ev);
+                REQUIRE(q->n_out_ev() == n_ev);
+            }
+        } /*TEST_CASE(spsc-threaded)*/
+
+        /* benchmark with:
+         *   $ ./utest.reactor [!benchmark]
+         *
+         * 1. round-trip cost of push + PollingReactor.run_one() on one thread
+         * 2. producer-timestamp -> sink latency,  with a producer thread
+         *    publishing at a fixed rate (>= 1M events/sec).
+         *    reports latency percentiles as warnings.
+         */
+        TEST_CASE("spsc-benchmark", "[!benchmark]") {
+            Subsystem::initialize_all();
+
+            rp<PollingReactor> reactor = PollingReactor::make();
+            reactor->set_loglevel(xo::pp::log_level::error);
+
+            rp<TestQueue> q = TestQueue::make(4096);
+
+            reactor->add_source(q);
+
+            std::uint64_t n_recv = 0;
+
+            q->add_callback(new SinkToFunction<TestEvent, TestSinkFn>
+                            ([&n_recv](TestEvent const &) { ++n_recv; }));
+
+            utc_nanos t0 = timeutil::ymd_hms(20240101 /*ymd*/, 93000 /*hms*/);
+
+            BENCHMARK("push+run_one") {
+                q->push(TestEvent(t0, 0));
+                return reactor->run_one();
+            };
+
+            for (std::uint64_t rate : { 1000000UL, 4000000UL }) {
+                std::uint64_t n_ev = 2 * rate;
+                /* producer publishes in batches of this size */
+                std::uint64_t k_batch = 16;
+
+                std::vector<std::int64_t> latency_v;
+                latency_v.reserve(n_ev);
+
+                rp<PollingReactor> reactor2 = PollingReactor::make();
+                reactor2->set_loglevel(xo::pp::log_level::error);
+
+                rp<TestQueue> q2 = TestQueue::make(65536);
+
+                reactor2->add_source(q2);
+
+                q2->add_callback(new SinkToFunction<TestEvent, TestSinkFn>
+                                 ([&latency_v](TestEvent const & x)
+                                     {
+                                         utc_nanos now = std::chrono::system_clock::now();
+                                         latency_v.push_back((now - x.first).count());
+                                     }));
+
+                std::thread producer
+                    ([q2, n_ev, rate, k_batch]()
+                        {
+                            auto start = std::chrono::steady_clock::now();
+                            std::vector<TestEvent> ev_v(k_batch);
+
+                            for (std::uint64_t i = 0; i < n_ev; i += k_batch) {
+                                /* pace to target rate */
+                                auto due = start + nanos((i * 1000000000UL) / rate);
+                                while (std::chrono::steady_clock::now() < due)
+                                    std::this_thread::yield();
+
+                                utc_nanos now = std::chrono::system_clock::now();
+                                for (std::uint64_t j = 0; j < k_batch; ++j)
+                                    ev_v[j] = TestEvent(now, i + j);
+
+                                std::span<TestEvent const> todo(ev_v);
+                                while (!todo.empty()) {
+                                    std::size_t n = q2->push_batch(todo);
+
+                                    todo = todo.subspan(n);
+
+                                    if (n == 0)
+                                        std::this_thread::yield();
+                                }
+                            }
+
+                            q2->close();
+                        });
+
+                auto start = std::chrono::steady_clock::now();
+
+                while (!q2->is_exhausted()) {
+                    if (reactor2->run_one() == 0)
+                        std::this_thread::yield();
+                }
+
+                auto elapsed = std::chrono::steady_clock::now() - start;
+
+                producer.join();
+
+                REQUIRE(latency_v.size() == n_ev);
+
+                std::sort(latency_v.begin(), latency_v.end());
+
+                auto pctile = ([&latency_v](double p)
+                    { return latency_v[std::min(latency_v.size() - 1,
+                                                static_cast<std::size_t>(p * latency_v.size()))]; });
+
+                WARN(xtag("rate", rate)
+                     << xtag("achieved", (n_ev * 1.0e9) / elapsed.count())
+                     << xtag("p50_ns", pctile(0.50))
+                     << xtag("p99_ns", pctile(0.99))
+                     << xtag("p999_ns", pctile(0.999))
+                     << xtag("max_ns", latency_v.back()));
+            }
+        } /*TEST_CASE(spsc-benchmark)*/
+    } /*namespace ut*/
+} /*namespace xo*/
+
+/* end SpscQueue.test.cpp */
@@ -1,6 +1,7 @@
 /* @file reactor_utest_main.cpp */
 
 #define CATCH_CONFIG_MAIN
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
 #include "catch2/catch.hpp"
 
 /* end reactor_utest_main.cpp */
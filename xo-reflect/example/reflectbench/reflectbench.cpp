@@ -0,0 +1,218 @@
+/** @file reflectbench.cpp
+ *
+ *  @author Roland Conybeare, Oct 2026
+ *
+ *  Times reflective traversal of a (nested) struct,  the way PrintJson
+ *  and event-store snapshots walk events.  Compares:
+ *
+ *  - layout:   TaggedPtr::get_child(),  which uses the frozen StructLayout
+ *              (resolved offsets,  no member-accessor call)
+ *  - accessor: StructMember::get_member_tp(),  i.e. virtual
+ *              AbstractStructMemberAccessor per member
+ *
+ *  and member lookup by name:
+ *
+ *  - phash:    TypeDescr::struct_member_index() (perfect hash)
+ *  - linear:   scan of TypeDescr::struct_member_name()
+ *
+ *  Usage: reflectbench [n-recd [n-pass]]
+ **/
+
+#include <xo/reflect/StructReflector.hpp>
+#include <xo/reflect/Reflect.hpp>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <vector>
+
+namespace xo {
+    using xo::reflect::Reflect;
+    using xo::reflect::StructReflector;
+    using xo::reflect::TaggedPtr;
+    using xo::reflect::TypeDescr;
+
+    namespace {
+        struct Level { double px_; double qty_; };
+
+        struct Tick {
+            double bid_;
+            double ask_;
+            int bid_sz_;
+            int ask_sz_;
+            long seq_;
+            Level last_;
+        };
+
+        void
+        reflect_types()
+        {
+            {
+                StructReflector<Level> sr;
+
+                REFLECT_MEMBER(sr, px);
+                REFLECT_MEMBER(sr, qty);
+            }
+            {
+                StructReflector<Tick> sr;
+
+                REFLECT_MEMBER(sr, bid);
+                REFLECT_MEMBER(sr, ask);
+                REFLECT_MEMBER(sr, bid_sz);
+                REFLECT_MEMBER(sr, ask_sz);
+                REFLECT_MEMBER(sr, seq);
+                REFLECT_MEMBER(sr, last);
+            }
+        } /*reflect_types*/
+
+        /* visit every leaf of tp;  returns sum of double-valued leaves */
+        double
+        sum_via_layout(TaggedPtr tp, TypeDescr f64_td, std::uint64_t * p_n)
+        {
+            double sum = 0.0;
+
+            for (std::uint32_t i = 0, n = tp.n_child(); i < n; ++i) {
+                TaggedPtr child = tp.get_child(i);
+
+                if (child.is_struct()) {
+                    sum += sum_via_layout(child, f64_td, p_n);
+                } else {
+                    ++(*p_n);
+
+                    if (child.td() == f64_td)
+                        sum += *reinterpret_cast<double *>(child.address());
+                }
+            }
+
+            return sum;
+        } /*sum_via_layout*/
+
+        double
+        sum_via_accessor(TaggedPtr tp, TypeDescr f64_td, std::uint64_t * p_n)
+        {
+            double sum = 0.0;
+
+            TypeDescr td = tp.td();
+
+            for (std::uint32_t i = 0, n = tp.n_child(); i < n; ++i) {
+                TaggedPtr child = td->struct_member(i).get_member_tp(tp.address());
+
+                if (child.is_struct()) {
+                    sum += sum_via_accessor(child, f64_td, p_n);
+                } else {
+                    ++(*p_n);
+
+                    if (child.td() == f64_td)
+                        sum += *reinterpret_cast<double *>(child.address());
+                }
+            }
+
+            return sum;
+        } /*sum_via_accessor*/
+
+        std::int32_t
+        linear_member_index(TypeDescr td, std::string const & name)
+        {
+            for (std::uint32_t i = 0, n = td->n_child_fixed(); i < n; ++i) {
+                if (td->struct_member_name(i) == name)
+                    return i;
+            }
+
+            return -1;
+        } /*linear_member_index*/
+
+        template <typename Fn>
+        double
+        time_ns(Fn && fn)
+        {
+            auto t0 = std::chrono::steady_clock::now();
+            fn();
+            auto t1 = std::chrono::steady_clock::now();
+
+            return std::chrono::duration<double, std::nano>(t1 - t0).count();
+        } /*time_ns*/
+    } /*namespace*/
+} /*namespace xo*/
+
+int
+main(int argc, char ** argv)
+{
+    using namespace xo;
+    using std::cout;
+    using std::endl;
+
+    long n_recd = (argc > 1) ? std::atol(argv[1]) : 10000;
+    long n_pass = (argc > 2) ? std::atol(argv[2]) : 100;
+
+    reflect_types();
+
+    TypeDescr f64_td = Reflect::require<double>();
+    TypeDescr tick_td = Reflect::require<Tick>();
+
+    std::vector<Tick> tick_v(n_recd);
+    for (long i = 0; i < n_recd; ++i)
+        tick_v[i] = Tick{100.0 + i, 100.5 + i, 10, 20, i, Level{100.25 + i, 1.0}};
+
+    /* ----- traversal ----- */
+
+    std::uint64_t n_layout = 0;
+    double sum_layout = 0.0;
+
+    double dt_layout = time_ns([&]
+        {
+            for (long k = 0; k < n_pass; ++k) {
+                for (Tick & x : tick_v)
+                    sum_layout += sum_via_layout(Reflect::make_tp(&x), f64_td, &n_layout);
+            }
+        });
+
+    std::uint64_t n_accessor = 0;
+    double sum_accessor = 0.0;
+
+    double dt_accessor = time_ns([&]
+        {
+            for (long k = 0; k < n_pass; ++k) {
+                for (Tick & x : tick_v)
+                    sum_accessor += sum_via_accessor(Reflect::make_tp(&x), f64_td, &n_accessor);
+            }
+        });
+
+    if ((n_layout != n_accessor) || (sum_layout != sum_accessor)) {
+        std::cerr << "reflectbench: traversal mismatch" << endl;
+        return 1;
+    }
+
+    cout << "traverse layout:   " << (dt_layout / n_layout) << " ns/leaf" << endl;
+    cout << "traverse accessor: " << (dt_accessor / n_accessor) << " ns/leaf" << endl;
+
+    /* ----- lookup by name ----- */
+
+    std::vector<std::string> name_v = {"bid", "ask", "bid_sz", "ask_sz", "seq", "last", "nope"};
+    long n_lookup = n_recd * n_pass;
+    std::int64_t chk_phash = 0;
+    std::int64_t chk_linear = 0;
+
+    double dt_phash = time_ns([&]
+        {
+            for (long k = 0; k < n_lookup; ++k)
+                chk_phash += tick_td->struct_member_index(name_v[k % name_v.size()]);
+        });
+
+    double dt_linear = time_ns([&]
+        {
+            for (long k = 0; k < n_lookup; ++k)
+                chk_linear += linear_member_index(tick_td, name_v[k % name_v.size()]);
+        });
+
+    if (chk_phash != chk_linear) {
+        std::cerr << "reflectbench: lookup mismatch" << endl;
+        return 1;
+    }
+
+    cout << "lookup phash:      " << (dt_phash / n_lookup) << " ns/lookup" << endl;
+    cout << "lookup linear:     " << (dt_linear / n_lookup) << " ns/lookup" << endl;
+
+    return 0;
+}
+
+/* end reflectbench.cpp */
@@ -55,6 +55,7 @@ namespace xo {
 
         /* runtime description of a struct/class instance variable */
         class StructMember;
+        class StructLayout;
 
         class TypeDescrBase;
 
@@ -397,6 +398,17 @@ namespace xo {
                 return *sm;
             } /*struct_member*/
 
+            /* frozen member layout: resolved offsets, member types, names.
+             * nullptr unless .is_struct() = true
+             */
+            StructLayout const * struct_layout() const { return this->tdextra_->struct_layout(); }
+
+            /* index of reflected instance variable with name member_name,
+             * or -1 if no such member (or not a struct).
+             * Perfect-hash lookup,  see StructLayout::lookup()
+             */
+            std::int32_t struct_member_index(std::string_view member_name) const;
+
             /** nullptr for non-function types **/
             const FunctionTdxInfo * fn_info() const { return this->tdextra_->fn_info(); }
             uint32_t n_fn_arg() const { return this->tdextra_->n_fn_arg(); }
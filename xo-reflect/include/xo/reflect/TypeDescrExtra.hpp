@@ -11,6 +11,7 @@ namespace xo {
     namespace reflect {
         /* forward-declaring here.  see [reflect/struct/StructMember.hpp] */
         class StructMember;
+        class StructLayout;
         class FunctionTdxInfo;
         class TypeDescrBase;
         class TaggedPtr;
@@ -72,6 +73,10 @@ namespace xo {
             virtual std::string const & struct_member_name(uint32_t i) const = 0;
             /* nullptr unless *this represents a struct/class type */
             virtual StructMember const * struct_member(uint32_t i) const;
+            /* frozen member layout (see [reflect/struct/StructLayout.hpp]);
+             * nullptr unless *this represents a struct/class type
+             */
+            virtual StructLayout const * struct_layout() const { return nullptr; }
 
             // methods for working with reflected functions/methods
 
@@ -0,0 +1,105 @@
+/* @file StructLayout.hpp */
+
+#pragma once
+
+#include "StructMember.hpp"
+#include "xo/reflect/TypeDescr.hpp"
+#include <cstddef>
+#include <cstdint>
+#include <memory>
+#include <string_view>
+#include <vector>
+
+namespace xo {
+    namespace reflect {
+        /* Frozen,  contiguous description of a reflected struct's members.
+         * Built once,  when reflection for the struct completes
+         * (see StructReflector::require_complete(), StructTdx::make()).
+         *
+         * One allocation holds:
+         *   [Field x n_field] [slot x n_slot] [member names]
+         *
+         * - Field carries member TypeDescr and (where possible) resolved byte offset,
+         *   so traversal of a standard-layout struct needs no call through
+         *   AbstractStructMemberAccessor.
+         * - slots are a perfect hash table over member names:
+         *   .lookup(name) probes exactly one slot and compares one name.
+         */
+        class StructLayout {
+        public:
+            struct Field {
+                /* type description for this member (declared type) */
+                TypeDescr member_td_ = nullptr;
+                /* byte offset of member from struct address;  valid iff .fixed_offset_flag */
+                std::uint32_t offset_ = 0;
+                /* member name at .name_area()[.name_pos .. .name_pos + .name_len] */
+                std::uint32_t name_pos_ = 0;
+                std::uint32_t name_len_ = 0;
+                /* true iff member address is struct address + .offset */
+                bool fixed_offset_flag_ = false;
+            }; /*Field*/
+
+            /* perfect-hash slot: 1 + member index,  or 0 for empty slot */
+            using slot_type = std::uint16_t;
+
+        public:
+            /* freeze description of members in member_v */
+            static std::unique_ptr<StructLayout> freeze(std::vector<StructMember> const & member_v);
+
+            std::uint32_t n_field() const { return n_field_; }
+            /* true iff every member has a fixed offset */
+            bool all_fixed_offset() const { return all_fixed_offset_; }
+
+            /* require: i < .n_field() */
+            Field const & field(std::uint32_t i) const { return this->field_v()[i]; }
+            std::string_view field_name(std::uint32_t i) const {
+                Field const & f = this->field(i);
+
+                return std::string_view(this->name_area() + f.name_pos_, f.name_len_);
+            } /*field_name*/
+
+            /* address of member i of struct at *object.
+             * require: .field(i).fixed_offset_flag
+             */
+            void * field_addr(std::uint32_t i, void * object) const {
+                return static_cast<char *>(object) + this->field(i).offset_;
+            }
+
+            /* index of member with name member_name,  or -1 if no such member.
+             * if the same name appears more than once (e.g. shadowed ancestor member),
+             * reports the first
+             */
+            std::int32_t lookup(std::string_view member_name) const;
+
+        private:
+            StructLayout() = default;
+
+            /* hash for member-name lookup */
+            static std::uint64_t hash(std::string_view s, std::uint64_t seed);
+
+            Field const * field_v() const { return reinterpret_cast<Field const *>(block_.get()); }
+            slot_type const * slot_v() const {
+                return reinterpret_cast<slot_type const *>(block_.get() + n_field_ * sizeof(Field));
+            }
+            char const * name_area() const {
+                return reinterpret_cast<char const *>(block_.get()
+                                                      + n_field_ * sizeof(Field)
+                                                      + n_slot_ * sizeof(slot_type));
+            }
+
+        private:
+            /* #of members */
+            std::uint32_t n_field_ = 0;
+            /* #of perfect-hash slots;  power of 2 (or 0 if no members) */
+            std::uint32_t n_slot_ = 0;
+            /* seed for .hash(),  chosen so that member names don't collide */
+            std::uint64_t seed_ = 0;
+            /* true iff every member has fixed offset */
+            bool all_fixed_offset_ = true;
+            /* fields, slots, names;  see class comment */
+            std::unique_ptr<std::byte[]> block_;
+        }; /*StructLayout*/
+    } /*namespace reflect*/
+} /*namespace xo*/
+
+/* end StructLayout.hpp */
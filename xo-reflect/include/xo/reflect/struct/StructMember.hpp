@@ -6,7 +6,10 @@
 #include "xo/reflect/TaggedPtr.hpp"
 #include "xo/reflect/TypeDescr.hpp"
 #include <memory>
+#include <new>
 #include <string>
+#include <type_traits>
+#include <cstdint>
 
 namespace xo {
     namespace reflect {
@@ -33,7 +36,50 @@ namespace xo {
             /* get address of a particular member,  given parent address */
             virtual void * address(void * struct_addr) const = 0;
 
+            /* true if this member always sits at the same byte offset from the
+             * start of its struct,  so that .address() reduces to
+             *   struct_addr + .fixed_offset()
+             * (see StructLayout)
+             */
+            virtual bool has_fixed_offset() const { return false; }
+
+            /* byte offset of this member;  meaningful only if .has_fixed_offset() */
+            virtual std::uint32_t fixed_offset() const { return 0; }
+
             virtual std::unique_ptr<AbstractStructMemberAccessor> clone() const = 0;
+
+        protected:
+            /* offset of base/member subobject of a StructT instance.
+             * Require StructT standard-layout (no virtual bases),  so the
+             * answer doesn't depend on the instance.
+             *
+             * Probes storage local to this call.  If StructT is trivially
+             * default-constructible,  starts a real StructT there first
+             * (costs nothing,  no side effects);  otherwise doesn't run
+             * StructT's ctor,  and relies on fn() using only the static
+             * type of its argument.
+             *
+             * Require:
+             * - Fn :: (StructT *) -> void *
+             */
+            template <typename StructT, typename Fn>
+            static std::uint32_t probe_offset(Fn && fn) {
+                static_assert(std::is_standard_layout_v<StructT>);
+
+                alignas(StructT) unsigned char storage[sizeof(StructT)];
+
+                StructT * probe = nullptr;
+
+                if constexpr (std::is_trivially_default_constructible_v<StructT>
+                              && std::is_trivially_destructible_v<StructT>)
+                {
+                    probe = ::new (static_cast<void *>(storage)) StructT;
+                } else {
+                    probe = reinterpret_cast<StructT *>(storage);
+                }
+
+                return (reinterpret_cast<unsigned char *>(fn(probe)) - storage);
+            } /*probe_offset*/
         }; /*AbstractStructMemberAccessor*/
 
         /* GeneralStructMemberAccessor
@@ -60,10 +106,24 @@ namespace xo {
             /* pointer to a OwnerT member of type MemberT */
             using Memptr = MemberT OwnerT::*;
 
+        public:
+            /* true iff member offset does not depend on the StructT instance */
+            static constexpr bool c_fixed_offset = std::is_standard_layout_v<StructT>;
+
         public:
             GeneralStructMemberAccessor(Memptr memptr)
                 : member_td_{EstablishTypeDescr::establish<MemberT>()},
-                  memptr_{memptr} {}
+                  memptr_{memptr}
+            {
+                if constexpr (c_fixed_offset) {
+                    this->offset_ = probe_offset<StructT>([memptr](StructT * p)
+                        {
+                            OwnerT * owner = p;
+
+                            return static_cast<void *>(std::addressof(owner->*memptr));
+                        });
+                }
+            }
             GeneralStructMemberAccessor(GeneralStructMemberAccessor const & x) = default;
             virtual ~GeneralStructMemberAccessor() = default;
 
@@ -100,6 +160,9 @@ namespace xo {
                 return this->address_impl(reinterpret_cast<StructT *>(struct_addr));
             } /*address*/
 
+            virtual bool has_fixed_offset() const override { return c_fixed_offset; }
+            virtual std::uint32_t fixed_offset() const override { return this->offset_; }
+
             virtual std::unique_ptr<AbstractStructMemberAccessor> clone() const override {
                 return std::unique_ptr<AbstractStructMemberAccessor>
                     (new GeneralStructMemberAccessor(*this));
@@ -112,6 +175,8 @@ namespace xo {
             TypeDescr member_td_ = nullptr;
             /* pointer to member of OwnerT */
             Memptr memptr_ = nullptr;
+            /* byte offset of member within StructT,  if .c_fixed_offset */
+            std::uint32_t offset_ = 0;
         }; /*GeneralStructMemberAccessor*/
 
         /* struct-member accessor via delegation,
@@ -135,7 +200,23 @@ namespace xo {
         class AncestorStructMemberAccessor : public AbstractStructMemberAccessor {
         public:
             AncestorStructMemberAccessor(std::unique_ptr<AbstractStructMemberAccessor> ancestor_accessor)
-                : ancestor_accessor_{std::move(ancestor_accessor)} {}
+                : ancestor_accessor_{std::move(ancestor_accessor)}
+            {
+                if constexpr (std::is_standard_layout_v<StructT>) {
+                    if (this->ancestor_accessor_->has_fixed_offset()) {
+                        std::uint32_t base_offset
+                            = probe_offset<StructT>([](StructT * p)
+                                {
+                                    AncestorT * ancestor = p;
+
+                                    return static_cast<void *>(ancestor);
+                                });
+
+                        this->fixed_offset_flag_ = true;
+                        this->offset_ = base_offset + this->ancestor_accessor_->fixed_offset();
+                    }
+                }
+            }
             AncestorStructMemberAccessor(AncestorStructMemberAccessor const & x) = default;
             virtual ~AncestorStructMemberAccessor() = default;
 
@@ -169,6 +250,9 @@ namespace xo {
                 return this->address_impl(reinterpret_cast<StructT *>(struct_addr));
             }
 
+            virtual bool has_fixed_offset() const override { return fixed_offset_flag_; }
+            virtual std::uint32_t fixed_offset() const override { return offset_; }
+
             virtual std::unique_ptr<AbstractStructMemberAccessor> clone() const override {
                 return std::unique_ptr<AbstractStructMemberAccessor>
                     (new AncestorStructMemberAccessor(std::move(this->ancestor_accessor_->clone())));
@@ -177,6 +261,10 @@ namespace xo {
         private:
             /* .ancestor_accessor fetches some particular member of AncestorT */
             std::unique_ptr<AbstractStructMemberAccessor> ancestor_accessor_;
+            /* true iff StructT standard-layout and ancestor member has fixed offset */
+            bool fixed_offset_flag_ = false;
+            /* byte offset of member within StructT,  if .fixed_offset_flag */
+            std::uint32_t offset_ = 0;
         }; /*AncestorStructMemberAccessor*/
 
         /* describes a member of a struct/class
@@ -199,7 +287,11 @@ namespace xo {
             TaggedPtr get_member_tp(void * struct_addr) const { return this->accessor_->member_tp(struct_addr); }
             TypeDescr get_struct_td() const { return this->accessor_->struct_td(); }
             TypeDescr get_member_td() const { return this->accessor_->member_td(); }
-            //void * get_member_addr(void * struct_addr) const { return this->accessor_->address(struct_addr); }
+            /* address of this member within the struct at *struct_addr */
+            void * get_member_addr(void * struct_addr) const { return this->accessor_->address(struct_addr); }
+            /* true if member sits at fixed byte offset .fixed_offset() from struct address */
+            bool has_fixed_offset() const { return this->accessor_->has_fixed_offset(); }
+            std::uint32_t fixed_offset() const { return this->accessor_->fixed_offset(); }
 
             /* make copy that accesses this member,  but starting
              * from pointer to some derived class DescendantT,
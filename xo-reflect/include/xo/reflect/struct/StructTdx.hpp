@@ -2,6 +2,7 @@
 
 #pragma once
 
+#include "StructLayout.hpp"
 #include "StructMember.hpp"
 #include "xo/reflect/TaggedPtr.hpp"
 #include "xo/reflect/TypeDescrExtra.hpp"
@@ -74,18 +75,24 @@ namespace xo {
             virtual TypeDescr fixed_child_td(uint32_t i) const override;
             virtual std::string const & struct_member_name(uint32_t i) const override;
             virtual StructMember const * struct_member(uint32_t i) const override;
+            virtual StructLayout const * struct_layout() const override { return layout_.get(); }
 
         private:
             StructTdx(std::vector<StructMember> member_v,
                       bool have_to_self_tp,
                       std::function<TaggedPtr (void*)> to_self_tp)
                 : member_v_{std::move(member_v)},
+                  layout_{StructLayout::freeze(member_v_)},
                   have_to_self_tp_{have_to_self_tp},
                   to_self_tp_{std::move(to_self_tp)} {}
 
         private:
             /* per-instance-variable reflection details */
             std::vector<StructMember> member_v_;
+            /* frozen copy of offsets / types / names from .member_v,
+             * for accessor-free traversal + name lookup
+             */
+            std::unique_ptr<StructLayout> layout_;
             /* true if .to_self_tp() is defined */
             bool have_to_self_tp_ = false;
             /* get TaggedPtr for most-derived subtype of supplied T-instance */
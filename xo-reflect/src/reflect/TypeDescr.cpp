@@ -6,6 +6,7 @@
 #include "TypeDescrExtra.hpp"
 #include "atomic/AtomicTdx.hpp"
 #include "function/FunctionTdx.hpp"
+#include "struct/StructLayout.hpp"
 #include <xo/indentlog2/print/tostr.hpp>
 #include <xo/ppsink/pretty_struct.hpp>
 #include <xo/ppsink/scope.hpp>
@@ -307,6 +308,17 @@ namespace xo {
             return this->tdextra_->child_tp(i, object);
         } /*child_tp*/
 
+        std::int32_t
+        TypeDescrBase::struct_member_index(std::string_view member_name) const
+        {
+            StructLayout const * layout = this->struct_layout();
+
+            if (!layout)
+                return -1;
+
+            return layout->lookup(member_name);
+        } /*struct_member_index*/
+
         /* DRIFT WARNING: the field list here is duplicated by the legacy
          * ppdetail<> in TypeDescr_ppdetail.hpp.  Keep the two in step.
          *
@@ -0,0 +1,202 @@
+/* @file StructLayout.cpp */
+
+#include "struct/StructLayout.hpp"
+#include <xo/indentlog2/print/tostr.hpp>
+#include <xo/ppsink/tag.hpp>
+#include <algorithm>
+#include <bit>
+#include <limits>
+#include <new>
+#include <stdexcept>
+#include <unordered_set>
+
+namespace xo {
+    using xo::pp::xtag;
+    using xo::pp::tostr;
+
+    namespace reflect {
+        namespace {
+            /* #of seeds to try for each slot-table size,  before doubling table size */
+            constexpr std::uint32_t c_seeds_per_size = 32;
+            /* give up if slot table would need more than this many slots per member.
+             * with distinct names, reached with vanishing probability
+             */
+            constexpr std::uint32_t c_max_slots_per_field = 16;
+
+            /* try to place each name named by key_v in a distinct slot,  using seed.
+             * on success,  slot_v[s] = 1 + member index for name in slot s
+             */
+            template <typename HashFn>
+            bool
+            try_seed(std::vector<std::string_view> const & name_v,
+                     std::vector<std::uint32_t> const & key_v,
+                     std::uint64_t seed,
+                     HashFn && hash_fn,
+                     std::vector<StructLayout::slot_type> * p_slot_v)
+            {
+                std::uint64_t mask = p_slot_v->size() - 1;
+
+                std::fill(p_slot_v->begin(), p_slot_v->end(), 0);
+
+                for (std::uint32_t i : key_v) {
+                    StructLayout::slot_type & slot = (*p_slot_v)[hash_fn(name_v[i], seed) & mask];
+
+                    if (slot != 0)
+                        return false;
+
+                    slot = i + 1;
+                }
+
+                return true;
+            } /*try_seed*/
+        } /*namespace*/
+
+        std::uint64_t
+        StructLayout::hash(std::string_view s, std::uint64_t seed)
+        {
+            /* FNV-1a,  then a splitmix64 finalizer so the low bits
+             * (used to select a slot) depend on every byte
+             */
+            std::uint64_t h = 0xcbf29ce484222325ull ^ (seed * 0x9e3779b97f4a7c15ull);
+
+            for (char ch : s) {
+                h ^= static_cast<unsigned char>(ch);
+                h *= 0x100000001b3ull;
+            }
+
+            h ^= (h >> 30);
+            h *= 0xbf58476d1ce4e5b9ull;
+            h ^= (h >> 27);
+            h *= 0x94d049bb133111ebull;
+            h ^= (h >> 31);
+
+            return h;
+        } /*hash*/
+
+        std::unique_ptr<StructLayout>
+        StructLayout::freeze(std::vector<StructMember> const & member_v)
+        {
+            std::size_t n = member_v.size();
+
+            if (n >= std::numeric_limits<slot_type>::max()) {
+                throw std::runtime_error(tostr("StructLayout::freeze"
+                                               ": too many struct members",
+                                               xtag("n", n),
+                                               xtag("max", std::numeric_limits<slot_type>::max() - 1)));
+            }
+
+            std::unique_ptr<StructLayout> retval(new StructLayout());
+
+            retval->n_field_ = n;
+
+            std::vector<std::string_view> name_v;
+            name_v.reserve(n);
+
+            /* indices of members to hash: first occurrence of each name */
+            std::vector<std::uint32_t> key_v;
+            key_v.reserve(n);
+
+            std::size_t name_z = 0;
+            {
+                std::unordered_set<std::string_view> seen;
+
+                for (std::uint32_t i = 0; i < n; ++i) {
+                    std::string_view name = member_v[i].member_name();
+
+                    name_v.push_back(name);
+                    name_z += name.size();
+
+                    if (seen.insert(name).second)
+                        key_v.push_back(i);
+                }
+            }
+
+            /* choose slot-table size + seed s.t. names hash to distinct slots */
+            std::vector<slot_type> slot_v;
+
+            if (n > 0) {
+                std::uint32_t n_slot = std::bit_ceil(static_cast<std::uint32_t>(2 * n));
+                std::uint32_t max_slot = c_max_slots_per_field * std::bit_ceil(static_cast<std::uint32_t>(n));
+                bool ok = false;
+
+                while (!ok && (n_slot <= max_slot)) {
+                    slot_v.resize(n_slot);
+
+                    for (std::uint32_t seed = 0; !ok && (seed < c_seeds_per_size); ++seed) {
+                        if (try_seed(name_v, key_v, seed, &StructLayout::hash, &slot_v)) {
+                            retval->seed_ = seed;
+                            ok = true;
+                        }
+                    }
+
+                    n_slot *= 2;
+                }
+
+                if (!ok) {
+                    throw std::runtime_error(tostr("StructLayout::freeze"
+                                                   ": unable to find perfect hash for member names",
+                                                   xtag("n", n)));
+                }
+            }
+
+            retval->n_slot_ = slot_v.size();
+
+            std::size_t block_z = (n * sizeof(Field)
+                                   + slot_v.size() * sizeof(slot_type)
+                                   + name_z);
+
+            retval->block_.reset(new std::byte[block_z]);
+
+            std::byte * field_area = retval->block_.get();
+            std::byte * slot_area = field_area + n * sizeof(Field);
+            char * name_area = reinterpret_cast<char *>(slot_area + slot_v.size() * sizeof(slot_type));
+
+            std::uint32_t name_pos = 0;
+
+            for (std::uint32_t i = 0; i < n; ++i) {
+                StructMember const & sm = member_v[i];
+
+                Field f;
+                f.member_td_ = sm.get_member_td();
+                f.fixed_offset_flag_ = sm.has_fixed_offset();
+                f.offset_ = (f.fixed_offset_flag_ ? sm.fixed_offset() : 0);
+                f.name_pos_ = name_pos;
+                f.name_len_ = name_v[i].size();
+
+                new (field_area + i * sizeof(Field)) Field(f);
+
+                std::copy(name_v[i].begin(), name_v[i].end(), name_area + name_pos);
+                name_pos += f.name_len_;
+
+                retval->all_fixed_offset_ = retval->all_fixed_offset_ && f.fixed_offset_flag_;
+            }
+
+            std::copy(slot_v.begin(),
+                      slot_v.end(),
+                      reinterpret_cast<slot_type *>(slot_area));
+
+            return retval;
+        } /*freeze*/
+
+        std::int32_t
+        StructLayout::lookup(std::string_view member_name) const
+        {
+            if (n_slot_ == 0)
+                return -1;
+
+            slot_type slot = this->slot_v()[hash(member_name, seed_) & (n_slot_ - 1)];
+
+            if (slot == 0)
+                return -1;
+
+            std::uint32_t i = slot - 1;
+
+            if (this->field_name(i) != member_name)
+                return -1;
+
+            return i;
+        } /*lookup*/
+    } /*namespace reflect*/
+} /*namespace xo*/
+
+/* end StructLayout.cpp */
@@ -25,6 +25,12 @@ namespace xo {
                 return TaggedPtr::universal_null();
             }
 
+            StructLayout::Field const & field = this->layout_->field(i);
+
+            /* fast path: no call through member accessor */
+            if (field.fixed_offset_flag_)
+                return field.member_td_->most_derived_self_tp(this->layout_->field_addr(i, object));
+
             const StructMember & member_info = this->member_v_[i];
 
             return member_info.get_member_tp(object);
@@ -37,9 +43,7 @@ namespace xo {
             if (i >= this->member_v_.size())
                 return nullptr;
 
-            const StructMember & member_info = this->member_v_[i];
-
-            return member_info.get_member_td();
+            return this->layout_->field(i).member_td_;
         } /*fixed_child_td*/
 
         std::string const &
@@ -0,0 +1,175 @@
+/* @file StructLayout.test.cpp */
+
+#include "xo/reflect/StructReflector.hpp"
+#include "xo/reflect/Reflect.hpp"
+#include "xo/reflect/struct/StructLayout.hpp"
+#include <catch2/catch.hpp>
+#include <cstddef>
+#include <string>
+
+namespace xo {
+    using xo::reflect::Reflect;
+    using xo::reflect::StructLayout;
+    using xo::reflect::StructReflector;
+    using xo::reflect::TaggedPtr;
+    using xo::reflect::TypeDescr;
+
+    namespace ut {
+        namespace {
+            struct LayoutS1 { int x_; char y_; double z_; };
+
+            struct LayoutBase { int a_; double b_; };
+            /* no members of its own,  so still standard-layout */
+            struct LayoutDerived : public LayoutBase {};
+
+            /* virtual dtor -> not standard-layout -> no fixed offsets */
+            struct LayoutVirtual {
+                virtual ~LayoutVirtual() = default;
+
+                int p_ = 0;
+                double q_ = 0.0;
+            };
+
+            struct LayoutWide {
+                int m00_, m01_, m02_, m03_, m04_, m05_, m06_, m07_, m08_, m09_;
+                int m10_, m11_, m12_, m13_, m14_, m15_, m16_, m17_, m18_, m19_;
+            };
+        } /*namespace*/
+
+        TEST_CASE("struct-layout-s1", "[reflect][layout]") {
+            {
+                StructReflector<LayoutS1> sr;
+
+                REFLECT_MEMBER(sr, x);
+                REFLECT_MEMBER(sr, y);
+                REFLECT_MEMBER(sr, z);
+            }
+
+            TypeDescr td = Reflect::require<LayoutS1>();
+            StructLayout const * layout = td->struct_layout();
+
+            REQUIRE(layout);
+            REQUIRE(layout->n_field() == 3);
+            REQUIRE(layout->all_fixed_offset());
+
+            REQUIRE(layout->field_name(0) == "x");
+            REQUIRE(layout->field_name(1) == "y");
+            REQUIRE(layout->field_name(2) == "z");
+
+            REQUIRE(layout->field(0).offset_ == offsetof(LayoutS1, x_));
+            REQUIRE(layout->field(1).offset_ == offsetof(LayoutS1, y_));
+            REQUIRE(layout->field(2).offset_ == offsetof(LayoutS1, z_));
+
+            REQUIRE(layout->field(0).member_td_ == Reflect::require<int>());
+            REQUIRE(layout->field(1).member_td_ == Reflect::require<char>());
+            REQUIRE(layout->field(2).member_td_ == Reflect::require<double>());
+
+            REQUIRE(td->struct_member_index("x") == 0);
+            REQUIRE(td->struct_member_index("y") == 1);
+            REQUIRE(td->struct_member_index("z") == 2);
+            REQUIRE(td->struct_member_index("w") == -1);
+            REQUIRE(td->struct_member_index("") == -1);
+            REQUIRE(td->struct_member_index("xx") == -1);
+
+            /* traversal via layout agrees with member addresses */
+            LayoutS1 recd{666, 'Y', -1.234};
+            TaggedPtr tp = Reflect::make_tp(&recd);
+
+            REQUIRE(tp.get_child(0).address() == &(recd.x_));
+            REQUIRE(tp.get_child(1).address() == &(recd.y_));
+            REQUIRE(tp.get_child(2).address() == &(recd.z_));
+            REQUIRE(tp.get_child(3).is_universal_null());
+
+            /* non-struct types have no layout */
+            REQUIRE(Reflect::require<int>()->struct_layout() == nullptr);
+            REQUIRE(Reflect::require<int>()->struct_member_index("x") == -1);
+        } /*TEST_CASE(struct-layout-s1)*/
+
+        TEST_CASE("struct-layout-ancestor", "[reflect][layout]") {
+            {
+                StructReflector<LayoutBase> sr;
+
+                REFLECT_MEMBER(sr, a);
+                REFLECT_MEMBER(sr, b);
+            }
+            {
+                StructReflector<LayoutDerived> sr;
+
+                sr.adopt_ancestors<LayoutBase>();
+            }
+
+            TypeDescr td = Reflect::require<LayoutDerived>();
+            StructLayout const * layout = td->struct_layout();
+
+            REQUIRE(layout);
+            REQUIRE(layout->n_field() == 2);
+            REQUIRE(layout->all_fixed_offset());
+            REQUIRE(td->struct_member_index("b") == 1);
+
+            LayoutDerived recd;
+            recd.a_ = 1;
+            recd.b_ = 2.5;
+
+            TaggedPtr tp = Reflect::make_tp(&recd);
+
+            REQUIRE(tp.get_child(0).address() == &(recd.a_));
+            REQUIRE(tp.get_child(1).address() == &(recd.b_));
+            REQUIRE(tp.get_child(1).td() == Reflect::require<double>());
+        } /*TEST_CASE(struct-layout-ancestor)*/
+
+        TEST_CASE("struct-layout-not-standard", "[reflect][layout]") {
+            {
+                StructReflector<LayoutVirtual> sr;
+
+                REFLECT_MEMBER(sr, p);
+                REFLECT_MEMBER(sr, q);
+            }
+
+            TypeDescr td = Reflect::require<LayoutVirtual>();
+            StructLayout const * layout = td->struct_layout();
+
+            REQUIRE(layout);
+            REQUIRE(!layout->all_fixed_offset());
+            REQUIRE(!layout->field(0).fixed_offset_flag_);
+            /* name lookup doesn't depend on layout */
+            REQUIRE(td->struct_member_index("q") == 1);
+
+            /* falls back to member accessor */
+            LayoutVirtual recd;
+            TaggedPtr tp = Reflect::make_tp(&recd);
+
+            REQUIRE(tp.get_child(0).address() == &(recd.p_));
+            REQUIRE(tp.get_child(1).address() == &(recd.q_));
+        } /*TEST_CASE(struct-layout-not-standard)*/
+
+        TEST_CASE("struct-layout-wide", "[reflect][layout]") {
+            {
+                StructReflector<LayoutWide> sr;
+
+                REFLECT_MEMBER(sr, m00); REFLECT_MEMBER(sr, m01); REFLECT_MEMBER(sr, m02);
+                REFLECT_MEMBER(sr, m03); REFLECT_MEMBER(sr, m04); REFLECT_MEMBER(sr, m05);
+                REFLECT_MEMBER(sr, m06); REFLECT_MEMBER(sr, m07); REFLECT_MEMBER(sr, m08);
+                REFLECT_MEMBER(sr, m09); REFLECT_MEMBER(sr, m10); REFLECT_MEMBER(sr, m11);
+                REFLECT_MEMBER(sr, m12); REFLECT_MEMBER(sr, m13); REFLECT_MEMBER(sr, m14);
+                REFLECT_MEMBER(sr, m15); REFLECT_MEMBER(sr, m16); REFLECT_MEMBER(sr, m17);
+                REFLECT_MEMBER(sr, m18); REFLECT_MEMBER(sr, m19);
+            }
+
+            TypeDescr td = Reflect::require<LayoutWide>();
+
+            REQUIRE(td->struct_layout()->n_field() == 20);
+
+            /* every member name hashes to its own slot */
+            for (std::uint32_t i = 0; i < 20; ++i) {
+                std::string name = td->struct_member_name(i);
+
+                INFO(name);
+
+                REQUIRE(td->struct_member_index(name) == static_cast<std::int32_t>(i));
+                REQUIRE(td->struct_member_index(name + "_") == -1);
+            }
+        } /*TEST_CASE(struct-layout-wide)*/
+    } /*namespace ut*/
+} /*namespace xo*/
+
+/* end StructLayout.test.cpp */
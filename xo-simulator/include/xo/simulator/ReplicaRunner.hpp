@@ -0,0 +1,211 @@
+/* @file ReplicaRunner.hpp */
+
+#pragma once
+
+#include "Simulator.hpp"
+#include <xo/randomgen/xoshiro256.hpp>
+#include <functional>
+#include <mutex>
+#include <vector>
+#include <cstdint>
+
+namespace xo {
+    namespace sim {
+        /* configuration for a ReplicaRunner */
+        class ReplicaConfig {
+        public:
+            using utc_nanos = xo::time::utc_nanos;
+
+        public:
+            ReplicaConfig() = default;
+            ReplicaConfig(utc_nanos t0,
+                          utc_nanos t1,
+                          std::uint32_t n_replica,
+                          std::uint32_t n_thread,
+                          std::uint64_t seed,
+                          SourceQueuePolicy policy = SourceQueuePolicy::binary_heap,
+                          bool batch_flag = false)
+                : t0_{t0}, t1_{t1},
+                  n_replica_{n_replica}, n_thread_{n_thread},
+                  seed_{seed}, policy_{policy}, batch_flag_{batch_flag} {}
+
+            utc_nanos t0() const { return t0_; }
+            utc_nanos t1() const { return t1_; }
+            std::uint32_t n_replica() const { return n_replica_; }
+            std::uint32_t n_thread() const { return n_thread_; }
+            std::uint64_t seed() const { return seed_; }
+            SourceQueuePolicy policy() const { return policy_; }
+            bool batch_flag() const { return batch_flag_; }
+
+        private:
+            /* each replica's simulator starts at this time */
+            utc_nanos t0_;
+            /* horizon: each replica runs until next event is later than t1 */
+            utc_nanos t1_;
+            /* #of independent replicas to simulate */
+            std::uint32_t n_replica_ = 0;
+            /* #of worker threads.  0 -> std::thread::hardware_concurrency() */
+            std::uint32_t n_thread_ = 0;
+            /* seed for replica 0's random stream;  replica i's stream
+             * is obtained by i applications of xoshiro256ss::jump()
+             */
+            std::uint64_t seed_ = 0;
+            /* event-queue implementation for each replica's simulator */
+            SourceQueuePolicy policy_ = SourceQueuePolicy::binary_heap;
+            /* if true,  run replicas with Simulator.run_until_batched();
+             * see caveat on Simulator.advance_one_batch()
+             */
+            bool batch_flag_ = false;
+        }; /*ReplicaConfig*/
+
+        /* non-template machinery for ReplicaRunner<Result> */
+        class ReplicaRunnerUtil {
+        public:
+            using rng_type = xo::rng::xoshiro256ss;
+
+        public:
+            /* #of worker threads to use for config cfg:
+             * cfg.n_thread (or hardware concurrency if 0),
+             * but not more than cfg.n_replica,  and at least 1
+             */
+            static std::uint32_t resolve_n_thread(ReplicaConfig const & cfg);
+
+            /* random streams for replicas [0 .. cfg.n_replica):
+             * element i is xoshiro256ss(cfg.seed) with i jumps applied,
+             * so streams are non-overlapping for 2^128 draws each
+             */
+            static std::vector<rng_type> replica_rng_v(ReplicaConfig const & cfg);
+
+            /* split replicas [0 .. n_replica) into n_thread contiguous blocks;
+             * invoke fn(k, lo, hi) for block k on its own thread.
+             * Returns after all threads complete.
+             * If any invocation throws,  rethrows the exception from the
+             * lowest-numbered failing block.
+             */
+            static void run_blocks(std::uint32_t n_replica,
+                                   std::uint32_t n_thread,
+                                   std::function<void (std::uint32_t k,
+                                                       std::uint32_t lo,
+                                                       std::uint32_t hi)> const & fn);
+
+            /* run simulator to horizon cfg.t1,
+             * using .run_until() or .run_until_batched() according to cfg.batch_flag
+             */
+            static void run_to_horizon(ReplicaConfig const & cfg, Simulator * sim);
+        }; /*ReplicaRunnerUtil*/
+
+        /* Monte Carlo driver:  run many independent replicas of the same
+         * source graph (e.g. RealizationSource over a BrownianMotion)
+         * on a pool of threads,  and reduce per-replica results.
+         *
+         * - each replica gets its own Simulator,
+         *   and its own xoshiro256ss stream (see ReplicaRunnerUtil::replica_rng_v())
+         * - replicas are partitioned into contiguous blocks,  one per thread;
+         *   each thread accumulates into its own copy of a Result
+         *   (e.g. Accumulator / Histogram style statistics);
+         * - per-thread results are merged in block order once all threads complete.
+         *
+         * Replica i sees the same random stream regardless of thread count,
+         * so a per-replica outcome is reproducible;  merged floating-point
+         * statistics are reproducible for a given .n_thread.
+         *
+         * Source-graph construction (Factory calls) is serialized:
+         * reflection registries and subsystem init are not thread-safe.
+         * Sources in a replica must not share mutable state with sources
+         * in another replica.
+         *
+         * Use:
+         *   ReplicaRunner<MyStats> runner(cfg, factory, merge);
+         *   MyStats stats = runner.run(MyStats(..));
+         */
+        template <typename Result>
+        class ReplicaRunner {
+        public:
+            using rng_type = ReplicaRunnerUtil::rng_type;
+            /* invoked after a replica reaches its horizon,  e.g. to record terminal values */
+            using finish_type = std::function<void ()>;
+            /* factory(sim, rng, p_result):
+             * populate sim with one replica's source graph.
+             * sources draw randomness from rng (e.g. pass rng as seed to BrownianMotion::make());
+             * sinks accumulate into *p_result (shared by replicas on the same thread).
+             * may return a finish_type to run after the replica completes;  may be empty
+             */
+            using factory_type = std::function<finish_type (Simulator * sim,
+                                                            rng_type const & rng,
+                                                            Result * p_result)>;
+            /* merge(p_lhs, rhs):  fold rhs into *p_lhs */
+            using merge_type = std::function<void (Result * p_lhs, Result const & rhs)>;
+
+        public:
+            ReplicaRunner(ReplicaConfig const & cfg,
+                          factory_type factory,
+                          merge_type merge)
+                : config_{cfg}, factory_{std::move(factory)}, merge_{std::move(merge)} {}
+
+            ReplicaConfig const & config() const { return config_; }
+
+            /* run all replicas;  return reduction of per-thread results.
+             * each thread's result starts as a copy of init
+             */
+            Result run(Result const & init) const {
+                std::uint32_t n_thread = ReplicaRunnerUtil::resolve_n_thread(this->config_);
+                std::vector<rng_type> rng_v = ReplicaRunnerUtil::replica_rng_v(this->config_);
+                std::vector<Result> result_v(n_thread, init);
+
+                /* serializes .factory calls */
+                std::mutex build_mutex;
+
+                auto run_block = ([this, &rng_v, &result_v, &build_mutex]
+                                  (std::uint32_t k, std::uint32_t lo, std::uint32_t hi)
+                    {
+                        for (std::uint32_t i = lo; i < hi; ++i)
+                            this->run_replica(rng_v[i], &build_mutex, &(result_v[k]));
+                    });
+
+                ReplicaRunnerUtil::run_blocks(this->config_.n_replica(), n_thread, run_block);
+
+                Result retval = std::move(result_v[0]);
+
+                for (std::uint32_t k = 1; k < n_thread; ++k)
+                    this->merge_(&retval, result_v[k]);
+
+                return retval;
+            } /*run*/
+
+        private:
+            /* build + run one replica,  accumulating into *p_result */
+            void run_replica(rng_type const & rng,
+                             std::mutex * p_build_mutex,
+                             Result * p_result) const
+            {
+                rp<Simulator> sim;
+                finish_type finish;
+
+                {
+                    std::lock_guard<std::mutex> lock(*p_build_mutex);
+
+                    sim = Simulator::make(this->config_.t0(), this->config_.policy());
+                    sim->set_loglevel(xo::pp::log_level::error);
+
+                    finish = this->factory_(sim.get(), rng, p_result);
+                }
+
+                ReplicaRunnerUtil::run_to_horizon(this->config_, sim.get());
+
+                if (finish)
+                    finish();
+            } /*run_replica*/
+
+        private:
+            /* replica count, horizon, seed etc. */
+            ReplicaConfig config_;
+            /* builds source graph for one replica */
+            factory_type factory_;
+            /* combines per-thread results */
+            merge_type merge_;
+        }; /*ReplicaRunner*/
+
+    } /*namespace sim*/
+} /*namespace xo*/
+
+/* end ReplicaRunner.hpp */
@@ -3,11 +3,14 @@
 #pragma once
 
 #include "SourceTimestamp.hpp"
+#include "SourceQueue.hpp"
 #include <xo/reactor/Reactor.hpp>
 #include <xo/reactor/ReactorSource.hpp>
 #include <xo/refcnt/Refcounted.hpp>
 #include <xo/ppsink/scope.hpp>
 // #include "time/Time.hpp"
+#include <memory>
+#include <unordered_set>
 #include <vector>
 
 namespace xo {
@@ -75,7 +78,13 @@ namespace xo {
         public:
             ~Simulator();
 
-            static rp<Simulator> make(utc_nanos t0);
+            /* create simulator starting at time t0.
+             * policy chooses event-queue implementation (see SourceQueuePolicy);
+             * binary heap is a good choice for up to a few thousand sources,
+             * radix heap scales better beyond that.
+             */
+            static rp<Simulator> make(utc_nanos t0,
+                                      SourceQueuePolicy policy = SourceQueuePolicy::binary_heap);
 
             /* value of .t0() is estabished in ctor.
              * it will not change except across call to .advance_one()
@@ -83,6 +92,9 @@ namespace xo {
              */
             utc_nanos t0() const { return t0_; }
 
+            /* event-queue implementation used by this simulator */
+            SourceQueuePolicy queue_policy() const { return sim_heap_->policy(); }
+
             /* timestamp of last event delivered */
             utc_nanos last_tm() const { return last_tm_; }
             /* total #of events delivered since sim start */
@@ -151,7 +163,7 @@ namespace xo {
                                      double replay_factor) const;
 
             /* current contents of simulation heap,  in increasing time order.
-             * copies heap to drain it in heap order
+             * copies + sorts heap contents
              */
             std::vector<SourceTimestamp> heap_contents() const;
 
@@ -169,10 +181,31 @@ namespace xo {
              */
             std::uint64_t advance_one_event();
 
-            /* run simulation until earliest event time t satisfies t > t1
+            /* like .advance_one_event(),  but lets the source with the earliest
+             * event deliver a run of consecutive events in one step
+             * (see ReactorSource::deliver_batch(), Sink1::notify_ev_batch()).
+             * The run stops before the next event from any other source,
+             * and before any event later than t1.
+             *
+             * Only appropriate when sinks attached to simulator sources do not
+             * themselves publish events back into this simulator
+             * (e.g. through a SecondarySource):  such events would be
+             * sequenced after the whole run.
+             *
+             * returns the #of events dispatched
+             */
+            std::uint64_t advance_one_batch(utc_nanos t1);
+
+            /* run simulation until earliest event time t satisfies t > t1,
+             * or no source has a pending event
              */
             void run_until(utc_nanos t1);
 
+            /* same as .run_until(),  but dispatches events with .advance_one_batch().
+             * same caveat applies
+             */
+            void run_until_batched(utc_nanos t1);
+
             /* run simulation at realtime speed,  throttling according to replay_factor,
              * until either:
              * - simulation exhausted
@@ -181,10 +214,11 @@ namespace xo {
              *
              * see also .run_one(), .run_until(), .run_n(), .run()
              *
-             * note: this method not suitable for use from python wrappers;
-             *       would hold GIL until complete.
-             *       for that use case better to implement throttled sim loop
-             *       in python
+             * note: python wrapper (pysimulator) releases the GIL for the
+             *       duration,  so other python threads run while this sleeps.
+             *       for a sim loop that interleaves with python code on the
+             *       same thread,  implement throttled sim loop in python
+             *       (see .throttled_event_dt())
              *
              * t1.  if > .t0,  limit sim to events with t < t1
              * n.   if > 0,  sim at most n events
@@ -222,23 +256,14 @@ namespace xo {
             virtual void display(std::ostream & os) const override;
 
         private:
-            explicit Simulator(utc_nanos t0);
+            Simulator(utc_nanos t0, SourceQueuePolicy policy);
 
-            /* updates source timestamp in simulation heap.
-             * preserves
+            /* insert source into .sim_heap,  at its current timestamp.
+             * increase sim_heap.size() by +1
              *
              * Require:
              * - src->is_primed()
-             * - .sim_heap[.sim_heap.size - 1] already refers to src
-             *
-             * need_pop_flag,  if true, src is at back of heap vector,
-             * need to pop before re-inserting.
-             */
-            void heap_update_source(ReactorSource * src,
-                                    bool need_pop_flag);
-
-            /* insert source into .sim_heap.
-             * increase sim_heap.size() by +1
+             * - src does not already appear in .sim_heap
              */
             void heap_insert_source(ReactorSource * src);
 
@@ -264,7 +289,7 @@ namespace xo {
              *   - s.is_exhausted() = false
              *   - s.t0() >= .t0
              */
-            std::vector<SourceTimestamp> sim_heap_;
+            std::unique_ptr<SourceQueue> sim_heap_;
 
             /* initial simulation clock */
             utc_nanos t0_;
@@ -286,6 +311,9 @@ namespace xo {
              */
             std::vector<ReactorSourcePtr> src_v_;
 
+            /* same members as .src_v,  for O(1) .is_source_present() */
+            std::unordered_set<ReactorSource *> src_set_;
+
             /* reentrancy protection.  set during .advance_one_event() */
             bool delivery_in_progress_ = false;
 
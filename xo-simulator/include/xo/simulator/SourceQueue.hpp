@@ -0,0 +1,165 @@
+/* @file SourceQueue.hpp */
+
+#pragma once
+
+#include "SourceTimestamp.hpp"
+#include <array>
+#include <memory>
+#include <vector>
+#include <cstdint>
+
+namespace xo {
+    namespace sim {
+        /* selects event-queue implementation used by a Simulator
+         * to sequence its sources.
+         *
+         * binary_heap: std::push_heap / std::pop_heap over a vector.
+         *              O(log n) per event, general-purpose.
+         * radix_heap:  monotone radix heap keyed on utc_nanos.
+         *              O(1) amortized insert;  extract cost amortizes
+         *              over the 64 key bits instead of log(n) comparisons.
+         *              Relies on simulation time being (mostly) monotone;
+         *              keys earlier than the last extracted key are still
+         *              handled correctly,  but lose the amortization benefit.
+         */
+        enum class SourceQueuePolicy { binary_heap, radix_heap };
+
+        /* priority queue of (timestamp, source) pairs,
+         * in increasing SourceTimestamp order.
+         *
+         * Implementations must agree exactly on extraction order
+         * (including tie-breaking by source address,  see SourceTimestamp::compare),
+         * so that a simulation replays identically regardless of policy.
+         */
+        class SourceQueue {
+        public:
+            using ReactorSource = xo::reactor::ReactorSource;
+
+        public:
+            virtual ~SourceQueue() = default;
+
+            /* create empty queue using policy p */
+            static std::unique_ptr<SourceQueue> make(SourceQueuePolicy p);
+
+            virtual SourceQueuePolicy policy() const = 0;
+
+            virtual bool empty() const = 0;
+            virtual std::size_t size() const = 0;
+
+            /* smallest timestamp in queue.
+             * require: !.empty()
+             */
+            virtual SourceTimestamp const & front() const = 0;
+
+            /* insert x */
+            virtual void push(SourceTimestamp const & x) = 0;
+
+            /* remove .front()
+             * require: !.empty()
+             */
+            virtual void pop() = 0;
+
+            /* true iff src appears in queue.  O(n) */
+            virtual bool contains(ReactorSource * src) const = 0;
+
+            /* remove all entries referring to src.  O(n) */
+            virtual void remove(ReactorSource * src) = 0;
+
+            /* discard all entries */
+            virtual void clear() = 0;
+
+            /* copy of queue contents,  in increasing timestamp order.
+             * intended for diagnostics
+             */
+            virtual std::vector<SourceTimestamp> contents() const = 0;
+        }; /*SourceQueue*/
+
+        /* SourceQueue implementation using a binary heap */
+        class BinaryHeapSourceQueue : public SourceQueue {
+        public:
+            BinaryHeapSourceQueue() = default;
+
+            // ----- inherited from SourceQueue -----
+
+            virtual SourceQueuePolicy policy() const override { return SourceQueuePolicy::binary_heap; }
+            virtual bool empty() const override { return heap_.empty(); }
+            virtual std::size_t size() const override { return heap_.size(); }
+            virtual SourceTimestamp const & front() const override { return heap_.front(); }
+            virtual void push(SourceTimestamp const & x) override;
+            virtual void pop() override;
+            virtual bool contains(ReactorSource * src) const override;
+            virtual void remove(ReactorSource * src) override;
+            virtual void clear() override { heap_.clear(); }
+            virtual std::vector<SourceTimestamp> contents() const override;
+
+        private:
+            /* min-heap: smallest timestamp at .heap[0] */
+            std::vector<SourceTimestamp> heap_;
+        }; /*BinaryHeapSourceQueue*/
+
+        /* SourceQueue implementation using a monotone radix heap
+         * (Ahuja, Mehlhorn, Orlin & Tarjan 1990),  keyed on utc_nanos.
+         *
+         * Entries live in 65 buckets relative to .last_key,
+         * the key of the most recently exposed minimum:
+         *   bucket 0:  keys <= .last_key
+         *   bucket b:  keys k with highest bit of (k ^ .last_key) at position b-1
+         *
+         * Bucket 0 is kept as a binary min-heap on SourceTimestamp,
+         * so that ties (common when many sources share a timestamp)
+         * and out-of-order keys resolve exactly as BinaryHeapSourceQueue would.
+         * Other buckets are unordered.
+         *
+         * Invariant:
+         * - .empty() || !.bucket_v[0].empty()
+         */
+        class RadixHeapSourceQueue : public SourceQueue {
+        public:
+            RadixHeapSourceQueue() = default;
+
+            // ----- inherited from SourceQueue -----
+
+            virtual SourceQueuePolicy policy() const override { return SourceQueuePolicy::radix_heap; }
+            virtual bool empty() const override { return size_ == 0; }
+            virtual std::size_t size() const override { return size_; }
+            virtual SourceTimestamp const & front() const override { return bucket_v_[0].front(); }
+            virtual void push(SourceTimestamp const & x) override;
+            virtual void pop() override;
+            virtual bool contains(ReactorSource * src) const override;
+            virtual void remove(ReactorSource * src) override;
+            virtual void clear() override;
+            virtual std::vector<SourceTimestamp> contents() const override;
+
+        private:
+            static constexpr std::size_t c_n_bucket = 65;
+
+            /* unsigned radix key for timestamp t.
+             * flips sign bit so that pre-epoch times order correctly
+             */
+            static std::uint64_t radix_key(SourceTimestamp const & x);
+
+            /* bucket index for key k,  relative to .last_key */
+            std::size_t bucket_index(std::uint64_t k) const;
+
+            /* append x to bucket ix (maintaining heap order if ix=0) */
+            void bucket_insert(std::size_t ix, SourceTimestamp const & x);
+
+            /* restore invariant after .bucket_v[0] drained:
+             * advance .last_key to smallest key in first non-empty bucket,
+             * and redistribute that bucket.
+             */
+            void normalize();
+
+        private:
+            /* key of most recently exposed minimum */
+            std::uint64_t last_key_ = 0;
+            /* #of entries across all buckets */
+            std::size_t size_ = 0;
+            /* see class comment for bucket assignment */
+            std::array<std::vector<SourceTimestamp>, c_n_bucket> bucket_v_;
+        }; /*RadixHeapSourceQueue*/
+
+    } /*namespace sim*/
+} /*namespace xo*/
+
+/* end SourceQueue.hpp */
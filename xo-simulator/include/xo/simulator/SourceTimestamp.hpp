@@ -7,6 +7,7 @@
 
 #include <xo/reactor/ReactorSource.hpp>
 #include <xo/timeutil/timeutil.hpp>
+#include <functional>
 
 namespace xo {
     namespace sim {
@@ -42,11 +43,17 @@ namespace xo {
                 else if(dt > nanos(0))
                     return +1;
 
-                /* timestamps are equal */
-
-                std::ptrdiff_t dptr = (x.src() - y.src());
+                /* timestamps are equal.
+                 * compare addresses with std::less<>:  raw pointer difference
+                 * is unspecified across objects,  and would be truncated
+                 * by int32_t return type
+                 */
+                if (std::less<ReactorSource *>()(x.src(), y.src()))
+                    return -1;
+                else if (std::less<ReactorSource *>()(y.src(), x.src()))
+                    return +1;
 
-                return dptr;
+                return 0;
             } /*compare*/
 
             utc_nanos t0() const { return t0_; }
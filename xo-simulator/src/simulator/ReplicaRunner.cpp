@@ -0,0 +1,97 @@
+/* @file ReplicaRunner.cpp */
+
+#include "ReplicaRunner.hpp"
+#include <exception>
+#include <thread>
+
+namespace xo {
+    namespace sim {
+        std::uint32_t
+        ReplicaRunnerUtil::resolve_n_thread(ReplicaConfig const & cfg)
+        {
+            std::uint32_t n = cfg.n_thread();
+
+            if (n == 0)
+                n = std::thread::hardware_concurrency();
+
+            if (n > cfg.n_replica())
+                n = cfg.n_replica();
+
+            if (n == 0)
+                n = 1;
+
+            return n;
+        } /*resolve_n_thread*/
+
+        std::vector<ReplicaRunnerUtil::rng_type>
+        ReplicaRunnerUtil::replica_rng_v(ReplicaConfig const & cfg)
+        {
+            std::vector<rng_type> retval;
+            retval.reserve(cfg.n_replica());
+
+            rng_type rng(cfg.seed());
+
+            for (std::uint32_t i = 0; i < cfg.n_replica(); ++i) {
+                retval.push_back(rng);
+                rng.jump();
+            }
+
+            return retval;
+        } /*replica_rng_v*/
+
+        void
+        ReplicaRunnerUtil::run_blocks(std::uint32_t n_replica,
+                                      std::uint32_t n_thread,
+                                      std::function<void (std::uint32_t k,
+                                                          std::uint32_t lo,
+                                                          std::uint32_t hi)> const & fn)
+        {
+            std::vector<std::exception_ptr> error_v(n_thread);
+
+            auto run_one_block = ([n_replica, n_thread, &fn, &error_v](std::uint32_t k)
+                {
+                    /* block k is [lo, hi);  block sizes differ by at most 1 */
+                    std::uint32_t lo = (std::uint64_t(n_replica) * k) / n_thread;
+                    std::uint32_t hi = (std::uint64_t(n_replica) * (k + 1)) / n_thread;
+
+                    try {
+                        fn(k, lo, hi);
+                    } catch (...) {
+                        error_v[k] = std::current_exception();
+                    }
+                });
+
+            if (n_thread <= 1) {
+                run_one_block(0);
+            } else {
+                std::vector<std::thread> thread_v;
+                thread_v.reserve(n_thread - 1);
+
+                for (std::uint32_t k = 1; k < n_thread; ++k)
+                    thread_v.emplace_back(run_one_block, k);
+
+                /* calling thread takes block 0 */
+                run_one_block(0);
+
+                for (std::thread & t : thread_v)
+                    t.join();
+            }
+
+            for (std::exception_ptr const & err : error_v) {
+                if (err)
+                    std::rethrow_exception(err);
+            }
+        } /*run_blocks*/
+
+        void
+        ReplicaRunnerUtil::run_to_horizon(ReplicaConfig const & cfg, Simulator * sim)
+        {
+            if (cfg.batch_flag())
+                sim->run_until_batched(cfg.t1());
+            else
+                sim->run_until(cfg.t1());
+        } /*run_to_horizon*/
+    } /*namespace sim*/
+} /*namespace xo*/
+
+/* end ReplicaRunner.cpp */
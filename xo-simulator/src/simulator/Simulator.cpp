@@ -13,6 +13,7 @@
 #include <xo/ppsink/tag_ostream.hpp>
 #include <xo/ppsink/log_level_ostream.hpp>
 #include <algorithm>
+#include <limits>
 #include <string_view>
 #include <thread>
 
@@ -39,11 +40,12 @@ namespace xo {
         }; /*RaiiDeliveryWork*/
 
         rp<Simulator>
-        Simulator::make(utc_nanos t0) {
-            return new Simulator(t0);
+        Simulator::make(utc_nanos t0, SourceQueuePolicy policy) {
+            return new Simulator(t0, policy);
         } /*make*/
 
-        Simulator::Simulator(utc_nanos t0) : t0_(t0)
+        Simulator::Simulator(utc_nanos t0, SourceQueuePolicy policy)
+            : sim_heap_{SourceQueue::make(policy)}, t0_(t0)
         {
             XO_SUBSYSTEM_REQUIRE(simulator);
         } /*ctor*/
@@ -51,7 +53,7 @@ namespace xo {
         Simulator::~Simulator() {
             scope log(XO_ENTER0_(verbose), "clear heap..");
 
-            this->sim_heap_.clear();
+            this->sim_heap_->clear();
 
             if (log.enabled()) {
                 log("visit .src_v", xtag("size", this->src_v_.size()));
@@ -62,38 +64,34 @@ namespace xo {
 
             log && log("clear .src_v", xtag("size", this->src_v_.size()));
 
+            this->src_set_.clear();
             this->src_v_.clear();
         } /*dtor*/
 
         bool
         Simulator::is_source_present(bp<ReactorSource> src) const
         {
-            for (ReactorSourcePtr const & s : this->src_v_) {
-                if (s == src)
-                    return true;
-            }
-
-            return false;
+            return this->src_set_.contains(src.get());
         } /*is_source_pesent*/
 
         utc_nanos
         Simulator::next_tm() const {
-            if(this->sim_heap_.empty()) {
+            if(this->sim_heap_->empty()) {
                 /* 0 remaining events in simulator */
                 return this->t0();
             }
 
-            return this->sim_heap_.front().t0();
+            return this->sim_heap_->front().t0();
         } /*next_tm*/
 
         ReactorSource*
         Simulator::next_src() const {
-            if (this->sim_heap_.empty()) {
+            if (this->sim_heap_->empty()) {
                 /* 0 remaining events in simulator */
                 return nullptr;
             }
 
-            return this->sim_heap_.front().src();
+            return this->sim_heap_->front().src();
         } /*next_src*/
 
         void
@@ -112,7 +110,7 @@ namespace xo {
 
             log && log(xtag("sim.name", sim_src->name()),
                        xtag("src.current_tm", sim_src->sim_current_tm()),
-                       xtag("sim_heap.size", this->sim_heap_.size()));
+                       xtag("sim_heap.size", this->sim_heap_->size()));
 
             if (this->delivery_in_progress_) {
                 log && log("reentrant call to .notify_source_primed(), defer",
@@ -142,15 +140,8 @@ namespace xo {
         Simulator::complete_add_source(bp<ReactorSource> src)
         {
             /* also add to simulation heap */
-            this->sim_heap_.push_back(SourceTimestamp(src->sim_current_tm(),
-                                                      src.get()));
-
-            /* use std::greater<> because we need a min-heap;
-             * smallest timestamp at the front
-             */
-            std::push_heap(this->sim_heap_.begin(),
-                           this->sim_heap_.end(),
-                           std::greater<SourceTimestamp>());
+            this->sim_heap_->push(SourceTimestamp(src->sim_current_tm(),
+                                                  src.get()));
         } /*complete_add_source*/
 
         bool
@@ -171,6 +162,7 @@ namespace xo {
             sim_src->sim_advance_until(this->t0(), false /*!replay_flag*/);
 
             this->src_v_.push_back(sim_src.promote());
+            this->src_set_.insert(sim_src.get());
 
             if(sim_src->is_exhausted()) {
                 log && log("source exhausted!");
@@ -209,24 +201,8 @@ namespace xo {
         void
         Simulator::complete_remove_source(bp<ReactorSource> sim_src)
         {
-            /* rebuild .sim_heap,  with sim_src removed */
-            std::vector<SourceTimestamp> sim_heap2;
-
-            for(SourceTimestamp const & item : this->sim_heap_) {
-                if(item.src() == sim_src.get()) {
-                    /* item refers to the source we are removing -> discard */
-                    ;
-                } else {
-                    sim_heap2.push_back(item);
-
-                    std::push_heap(sim_heap2.begin(),
-                                   sim_heap2.end(),
-                                   std::greater<SourceTimestamp>());
-                }
-
-                /* now discard .sim_heap,  replacing with sim_heap2 */
-                this->sim_heap_ = std::move(sim_heap2);
-            }
+            /* discard any .sim_heap entry for sim_src */
+            this->sim_heap_->remove(sim_src.get());
         } /*complete_remove_source*/
 
         bool
@@ -264,49 +240,21 @@ namespace xo {
         } /*run_one*/
 
         void
-        Simulator::heap_update_source(ReactorSource * src, bool need_pop_flag)
+        Simulator::heap_insert_source(ReactorSource * src)
         {
-            /* Require:
-             *   .sim_heap[.sim_heap.size - 1] already refers to src
-             * just updating timestamp here
-             */
-
-            std::size_t simheap_z
-                = this->sim_heap_.size();
-
             scope log(XO_DEBUG_(src->debug_sim_flag()),
                       xtag("src.name", src->name()),
-                      xtag("simheap_z", simheap_z),
+                      xtag("simheap_z", this->sim_heap_->size()),
                       xtag("src.sim_current_tm", src->sim_current_tm()));
 
-            if (need_pop_flag)
-                this->sim_heap_.pop_back();
-            /* re-insert at new timestamp */
-            this->sim_heap_.push_back(SourceTimestamp(src->sim_current_tm(), src));
-
-            /* use std::greater<> because we need a min-heap;
-             * smallest timestamp at the front
+#ifndef NDEBUG
+            /* sanity check -- src should not currently appear in heap.
+             * O(n),  so debug builds only
              */
-            std::push_heap(this->sim_heap_.begin(),
-                           this->sim_heap_.end(),
-                           std::greater<SourceTimestamp>());
-        } /*heap_update_source*/
-
-        void
-        Simulator::heap_insert_source(ReactorSource * src)
-        {
-            /* santify check -- src should not currently appear in heap */
-            for (SourceTimestamp const & src_recd : this->sim_heap_) {
-                if(src_recd.src() == src) {
-                    /* uh oh.   src is already present in heap! */
-                    assert(false);
-                }
-            }
-
-            // don't need this: .heap_update_source() will insert
-            //this->sim_heap_.push_back(SourceTimestamp(src->sim_current_tm(), src));
+            assert(!this->sim_heap_->contains(src));
+#endif
 
-            this->heap_update_source(src, false /*!need_pop_flag*/);
+            this->sim_heap_->push(SourceTimestamp(src->sim_current_tm(), src));
         } /*heap_insert_source*/
 
         void
@@ -371,40 +319,21 @@ namespace xo {
         std::vector<SourceTimestamp>
         Simulator::heap_contents() const
         {
-            std::vector<SourceTimestamp> heap = this->sim_heap_;
-            std::vector<SourceTimestamp> retval;
-
-            while (!heap.empty()) {
-                retval.push_back(heap.front());
-
-                std::pop_heap(heap.begin(), heap.end(),
-                              std::greater<SourceTimestamp>());
-                heap.pop_back();
-            }
-
-            return retval;
+            return this->sim_heap_->contents();
         } /*heap_contents*/
 
         void
         Simulator::log_heap_contents(scope * p_scope) const
         {
-            std::vector<SourceTimestamp> heap = this->sim_heap_;
-
             p_scope->log("/ sim heap contents:");
             p_scope->log("| t0 name n_in_ev n_queued_out_ev n_out_ev");
 
-            while(!heap.empty()) {
-                SourceTimestamp const & ts = heap.front();
-
+            for (SourceTimestamp const & ts : this->sim_heap_->contents()) {
                 p_scope->log("|"
                              , " ", ts.t0()
                              , " ", ts.src()->name()
                              , " ", ts.src()->n_queued_out_ev()
                              , " ", ts.src()->n_out_ev());
-
-                std::pop_heap(heap.begin(), heap.end(),
-                              std::greater<SourceTimestamp>());
-                heap.pop_back();
             }
 
             p_scope->log("\\");
@@ -421,20 +350,20 @@ namespace xo {
         {
             bool debug_flag = (this->loglevel() <= xo::pp::log_level::chatty);
 
-            if(this->sim_heap_.empty()) {
+            if(this->sim_heap_->empty()) {
                 scope log(XO_DEBUG_(debug_flag));
 
                 /* nothing todo */
                 return 0;
             }
 
-            uint32_t old_heap_z = this->sim_heap_.size();
+            uint32_t old_heap_z = this->sim_heap_->size();
 
             /* *src is source with earliest timestamp */
             ReactorSource * src
-                = this->sim_heap_.front().src();
+                = this->sim_heap_->front().src();
 
-            utc_nanos src_tm = this->sim_heap_.front().t0();
+            utc_nanos src_tm = this->sim_heap_->front().t0();
 
             scope log(XO_DEBUG_(debug_flag),
                       xtag("threshold-loglevel", this->loglevel()),
@@ -459,26 +388,22 @@ namespace xo {
 
                 /* note that src.t0 may have advanced */
 
-                /* moves just-consumed timestamp event for src
-                 * to back of .sim_heap
-                 */
-                std::pop_heap(this->sim_heap_.begin(),
-                              this->sim_heap_.end(),
-                              std::greater<SourceTimestamp>());
-
-                /* now .sim_heap[.sim_heap.size() = 1].src() is src,
-                 * with stale timestamp
+                /* discard just-consumed (now stale) timestamp for src.
+                 * reentrant work was deferred during delivery,
+                 * so src is still at the front of .sim_heap
                  */
+                this->sim_heap_->pop();
 
                 if(src->is_exhausted() || src->is_notprimed()) {
-                    /* remove src from .sim_
+                    /* leave src out of .sim_heap
                      * - if src->is_exhausted(),  permanently
                      * - if src->is_notready(),  until source calls
                      *   .notify_source_ready()
                      */
-                    this->sim_heap_.pop_back();
+                    ;
                 } else {
-                    this->heap_update_source(src, true /*need_pop_flag*/);
+                    /* re-insert at new timestamp */
+                    this->heap_insert_source(src);
                 }
 
                 assert(raii_work.sim_);
@@ -487,12 +412,90 @@ namespace xo {
             return retval;
         } /*advance_one_event*/
 
+        std::uint64_t
+        Simulator::advance_one_batch(utc_nanos t1)
+        {
+            if (this->sim_heap_->empty())
+                return 0;
+
+            /* *src is source with earliest timestamp */
+            ReactorSource * src
+                = this->sim_heap_->front().src();
+
+            utc_nanos src_tm = this->sim_heap_->front().t0();
+
+            if (src_tm > t1)
+                return 0;
+
+            bool debug_flag = (this->loglevel() <= xo::pp::log_level::chatty);
+
+            scope log(XO_DEBUG_(debug_flag),
+                      xtag("src.name", src->name()),
+                      xtag("sim.src_tm", src_tm),
+                      xtag("heap_z", this->sim_heap_->size()));
+
+            uint64_t retval = 0;
+
+            {
+                RaiiDeliveryWork raii_work(this);
+
+                /* remove src while it delivers,  to expose the next-earliest
+                 * source.  reentrant work is deferred until delivery completes,
+                 * so .sim_heap doesn't otherwise change in the meantime
+                 */
+                this->sim_heap_->pop();
+
+                /* run may extend up to,  but not including,
+                 * next event from any other source
+                 */
+                utc_nanos limit_tm = ((t1 < utc_nanos::max())
+                                      ? t1 + nanos(1)
+                                      : t1);
+
+                if (!this->sim_heap_->empty())
+                    limit_tm = std::min(limit_tm, this->sim_heap_->front().t0());
+
+                utc_nanos last_tm = src_tm;
+
+                retval = src->deliver_batch(limit_tm,
+                                            std::numeric_limits<uint64_t>::max(),
+                                            &last_tm);
+
+                if (retval == 0) {
+                    /* src ties with next source on timestamp,
+                     * and wins on tie-break:  deliver just its first event
+                     */
+                    retval = src->deliver_one();
+                }
+
+                this->last_tm_ = last_tm;
+                this->n_event_ += retval;
+
+                log && log(xtag("n", retval), xtag("last_tm", last_tm));
+
+                if(src->is_exhausted() || src->is_notprimed()) {
+                    /* leave src out of .sim_heap;  see .advance_one_event() */
+                    ;
+                } else {
+                    this->heap_insert_source(src);
+                }
+            }
+
+            return retval;
+        } /*advance_one_batch*/
+
         void
         Simulator::run_until(utc_nanos t1)
         {
             assert(!this->delivery_in_progress_);
 
             while(!this->is_exhausted()) {
+                /* remaining sources are all non-primed (e.g. drained fifo queues);
+                 * nothing further to simulate
+                 */
+                if (this->sim_heap_->empty())
+                    break;
+
                 utc_nanos t = this->next_tm();
 
                 if(t > t1)
@@ -502,6 +505,15 @@ namespace xo {
             } /*loop until done*/
         } /*run_until*/
 
+        void
+        Simulator::run_until_batched(utc_nanos t1)
+        {
+            assert(!this->delivery_in_progress_);
+
+            while (this->advance_one_batch(t1) > 0)
+                ;
+        } /*run_until_batched*/
+
         uint64_t
         Simulator::run_throttled_until(utc_nanos t1,
                                        int32_t n_max,
@@ -556,7 +568,7 @@ namespace xo {
         Simulator::display(std::ostream & os) const
         {
             os << "<Simulator"
-               << xtag("sim_heap.size", sim_heap_.size())
+               << xtag("sim_heap.size", sim_heap_->size())
                << xtag("n_event", n_event_)
                << xtag("src_v.size", src_v_.size())
                << ">";
@@ -0,0 +1,229 @@
+/* @file SourceQueue.cpp */
+
+#include "SourceQueue.hpp"
+#include <algorithm>
+#include <bit>
+#include <stdexcept>
+
+namespace xo {
+    using xo::reactor::ReactorSource;
+
+    namespace sim {
+        std::unique_ptr<SourceQueue>
+        SourceQueue::make(SourceQueuePolicy p)
+        {
+            switch (p) {
+            case SourceQueuePolicy::binary_heap:
+                return std::make_unique<BinaryHeapSourceQueue>();
+            case SourceQueuePolicy::radix_heap:
+                return std::make_unique<RadixHeapSourceQueue>();
+            }
+
+            throw std::runtime_error("SourceQueue::make: unexpected policy");
+        } /*make*/
+
+        // ----- BinaryHeapSourceQueue -----
+
+        void
+        BinaryHeapSourceQueue::push(SourceTimestamp const & x)
+        {
+            this->heap_.push_back(x);
+
+            /* use std::greater<> because we need a min-heap;
+             * smallest timestamp at the front
+             */
+            std::push_heap(this->heap_.begin(),
+                           this->heap_.end(),
+                           std::greater<SourceTimestamp>());
+        } /*push*/
+
+        void
+        BinaryHeapSourceQueue::pop()
+        {
+            std::pop_heap(this->heap_.begin(),
+                          this->heap_.end(),
+                          std::greater<SourceTimestamp>());
+            this->heap_.pop_back();
+        } /*pop*/
+
+        bool
+        BinaryHeapSourceQueue::contains(ReactorSource * src) const
+        {
+            for (SourceTimestamp const & x : this->heap_) {
+                if (x.src() == src)
+                    return true;
+            }
+
+            return false;
+        } /*contains*/
+
+        void
+        BinaryHeapSourceQueue::remove(ReactorSource * src)
+        {
+            std::size_t n = std::erase_if(this->heap_,
+                                          [src](SourceTimestamp const & x) { return x.src() == src; });
+
+            if (n > 0) {
+                std::make_heap(this->heap_.begin(),
+                               this->heap_.end(),
+                               std::greater<SourceTimestamp>());
+            }
+        } /*remove*/
+
+        std::vector<SourceTimestamp>
+        BinaryHeapSourceQueue::contents() const
+        {
+            std::vector<SourceTimestamp> retval = this->heap_;
+
+            std::sort(retval.begin(), retval.end());
+
+            return retval;
+        } /*contents*/
+
+        // ----- RadixHeapSourceQueue -----
+
+        std::uint64_t
+        RadixHeapSourceQueue::radix_key(SourceTimestamp const & x)
+        {
+            std::int64_t k = x.t0().time_since_epoch().count();
+
+            return static_cast<std::uint64_t>(k) ^ (std::uint64_t(1) << 63);
+        } /*radix_key*/
+
+        std::size_t
+        RadixHeapSourceQueue::bucket_index(std::uint64_t k) const
+        {
+            if (k <= this->last_key_)
+                return 0;
+
+            /* 1 + position of highest bit in which k differs from .last_key */
+            return std::bit_width(k ^ this->last_key_);
+        } /*bucket_index*/
+
+        void
+        RadixHeapSourceQueue::bucket_insert(std::size_t ix, SourceTimestamp const & x)
+        {
+            std::vector<SourceTimestamp> & bucket = this->bucket_v_[ix];
+
+            bucket.push_back(x);
+
+            if (ix == 0) {
+                std::push_heap(bucket.begin(),
+                               bucket.end(),
+                               std::greater<SourceTimestamp>());
+            }
+        } /*bucket_insert*/
+
+        void
+        RadixHeapSourceQueue::normalize()
+        {
+            if ((this->size_ == 0) || !this->bucket_v_[0].empty())
+                return;
+
+            std::size_t ix = 1;
+            while (this->bucket_v_[ix].empty())
+                ++ix;
+
+            /* take over bucket ix;  its contents will all move to lower buckets */
+            std::vector<SourceTimestamp> bucket = std::move(this->bucket_v_[ix]);
+            this->bucket_v_[ix].clear();
+
+            std::uint64_t lo_key = radix_key(bucket.front());
+            for (SourceTimestamp const & x : bucket)
+                lo_key = std::min(lo_key, radix_key(x));
+
+            this->last_key_ = lo_key;
+
+            for (SourceTimestamp const & x : bucket)
+                this->bucket_insert(this->bucket_index(radix_key(x)), x);
+
+            /* recycle storage: bucket ix will likely be needed again */
+            bucket.clear();
+            this->bucket_v_[ix] = std::move(bucket);
+        } /*normalize*/
+
+        void
+        RadixHeapSourceQueue::push(SourceTimestamp const & x)
+        {
+            this->bucket_insert(this->bucket_index(radix_key(x)), x);
+            ++(this->size_);
+
+            this->normalize();
+        } /*push*/
+
+        void
+        RadixHeapSourceQueue::pop()
+        {
+            std::vector<SourceTimestamp> & bucket0 = this->bucket_v_[0];
+
+            std::pop_heap(bucket0.begin(),
+                          bucket0.end(),
+                          std::greater<SourceTimestamp>());
+            bucket0.pop_back();
+            --(this->size_);
+
+            this->normalize();
+        } /*pop*/
+
+        bool
+        RadixHeapSourceQueue::contains(ReactorSource * src) const
+        {
+            for (std::vector<SourceTimestamp> const & bucket : this->bucket_v_) {
+                for (SourceTimestamp const & x : bucket) {
+                    if (x.src() == src)
+                        return true;
+                }
+            }
+
+            return false;
+        } /*contains*/
+
+        void
+        RadixHeapSourceQueue::remove(ReactorSource * src)
+        {
+            for (std::size_t ix = 0; ix < c_n_bucket; ++ix) {
+                std::vector<SourceTimestamp> & bucket = this->bucket_v_[ix];
+
+                std::size_t n = std::erase_if(bucket,
+                                              [src](SourceTimestamp const & x) { return x.src() == src; });
+
+                if (n > 0) {
+                    this->size_ -= n;
+
+                    if (ix == 0) {
+                        std::make_heap(bucket.begin(),
+                                       bucket.end(),
+                                       std::greater<SourceTimestamp>());
+                    }
+                }
+            }
+
+            this->normalize();
+        } /*remove*/
+
+        void
+        RadixHeapSourceQueue::clear()
+        {
+            for (std::vector<SourceTimestamp> & bucket : this->bucket_v_)
+                bucket.clear();
+
+            this->size_ = 0;
+        } /*clear*/
+
+        std::vector<SourceTimestamp>
+        RadixHeapSourceQueue::contents() const
+        {
+            std::vector<SourceTimestamp> retval;
+            retval.reserve(this->size_);
+
+            for (std::vector<SourceTimestamp> const & bucket : this->bucket_v_)
+                retval.insert(retval.end(), bucket.begin(), bucket.end());
+
+            std::sort(retval.begin(), retval.end());
+
+            return retval;
+        } /*contents*/
+    } /*namespace sim*/
+} /*namespace xo*/
+
+/* end SourceQueue.cpp */
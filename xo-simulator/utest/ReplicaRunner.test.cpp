@@ -0,0 +1,239 @@
+/* @file ReplicaRunner.test.cpp */
+
+#include "xo/simulator/ReplicaRunner.hpp"
+#include "xo/simulator/init_simulator.hpp"
+#include "catch2/catch.hpp"
+#include <xo/reflect/Reflect.hpp>
+#include <xo/ppsink/tag_ostream.hpp>
+#include <xo/randomgen/xoshiro256.hpp>
+#include <xo/timeutil/timeutil.hpp>
+#include <stdexcept>
+
+namespace xo {
+    using xo::sim::Simulator;
+    using xo::sim::ReplicaConfig;
+    using xo::sim::ReplicaRunner;
+    using xo::sim::ReplicaRunnerUtil;
+    using xo::reactor::ReactorSource;
+    using xo::reactor::AbstractSink;
+    using xo::reactor::AbstractEventProcessor;
+    using xo::reflect::Reflect;
+    using xo::reflect::TypeDescr;
+    using xo::rng::xoshiro256ss;
+    using xo::time::timeutil;
+    using xo::time::utc_nanos;
+    using xo::time::nanos;
+    using xo::time::microseconds;
+
+    namespace {
+        /* per-thread result for replica tests */
+        struct WalkStats {
+            /* #of steps,  across all replicas */
+            std::uint64_t n_step_ = 0;
+            /* terminal walk positions,  in replica order */
+            std::vector<double> terminal_v_;
+        };
+
+        /* never-exhausted source:  +/-1 random walk,  one step every .dt,
+         * first step at .t0.  reports each step to .step_fn
+         */
+        class RandomWalkSource : public ReactorSource {
+        public:
+            RandomWalkSource(utc_nanos t0, nanos dt,
+                             xoshiro256ss const & rng,
+                             std::function<void (double)> step_fn)
+                : next_tm_{t0}, dt_{dt}, rng_{rng}, step_fn_{std::move(step_fn)} {}
+
+            double x() const { return x_; }
+
+            // ----- inherited from ReactorSource -----
+
+            virtual bool is_empty() const override { return false; }
+            virtual bool is_exhausted() const override { return false; }
+            virtual utc_nanos sim_current_tm() const override { return next_tm_; }
+            virtual std::uint64_t sim_advance_until(utc_nanos tm, bool replay_flag) override {
+                std::uint64_t n = 0;
+                while (this->next_tm_ < tm) {
+                    if (replay_flag)
+                        n += this->deliver_one();
+                    else
+                        this->next_tm_ += this->dt_;
+                }
+                return n;
+            }
+            virtual std::uint64_t deliver_one() override {
+                double dx = (this->rng_() & 1) ? +1.0 : -1.0;
+
+                this->x_ += dx;
+                this->next_tm_ += this->dt_;
+                ++(this->n_out_ev_);
+
+                this->step_fn_(dx);
+
+                return 1;
+            }
+
+            // ----- inherited from AbstractSource -----
+
+            virtual TypeDescr source_ev_type() const override { return Reflect::require<double>(); }
+            virtual bool is_volatile() const override { return false; }
+            virtual uint32_t n_queued_out_ev() const override { return 1; }
+            virtual uint32_t n_out_ev() const override { return n_out_ev_; }
+            virtual bool debug_sim_flag() const override { return false; }
+            virtual void set_debug_sim_flag(bool) override {}
+            virtual CallbackId attach_sink(rp<AbstractSink> const &) override { return CallbackId(); }
+            virtual void detach_sink(CallbackId) override {}
+
+            // ----- inherited from AbstractEventProcessor -----
+
+            virtual std::string const & name() const override { return name_; }
+            virtual void set_name(std::string const & x) override { name_ = x; }
+            virtual void visit_direct_consumers(std::function<void (bp<AbstractEventProcessor>)> const &) override {}
+            virtual void display(std::ostream & os) const override { os << "<RandomWalkSource>"; }
+
+        private:
+            std::string name_;
+            utc_nanos next_tm_;
+            nanos dt_;
+            xoshiro256ss rng_;
+            std::function<void (double)> step_fn_;
+            double x_ = 0.0;
+            uint32_t n_out_ev_ = 0;
+        }; /*RandomWalkSource*/
+
+        using WalkRunner = ReplicaRunner<WalkStats>;
+
+        /* one random walk per replica */
+        WalkRunner::finish_type
+        make_walk_replica(Simulator * sim,
+                          xoshiro256ss const & rng,
+                          WalkStats * p_stats)
+        {
+            rp<RandomWalkSource> src
+                = new RandomWalkSource(sim->t0(), microseconds(10), rng,
+                                       [p_stats](double) { ++(p_stats->n_step_); });
+
+            sim->add_source(src);
+
+            return [src, p_stats]() { p_stats->terminal_v_.push_back(src->x()); };
+        } /*make_walk_replica*/
+
+        void
+        merge_walk_stats(WalkStats * p_lhs, WalkStats const & rhs)
+        {
+            p_lhs->n_step_ += rhs.n_step_;
+            p_lhs->terminal_v_.insert(p_lhs->terminal_v_.end(),
+                                      rhs.terminal_v_.begin(), rhs.terminal_v_.end());
+        } /*merge_walk_stats*/
+    } /*namespace*/
+
+    static InitEvidence s_evidence = InitSubsys<S_simulator_tag>::require();
+
+    namespace ut {
+        using xo::pp::xtag;
+
+        TEST_CASE("replica-rng", "[simulator][replica]") {
+            utc_nanos t0 = timeutil::ymd_hms(20240101 /*ymd*/, 93000 /*hms*/);
+
+            ReplicaConfig cfg(t0, t0, 8 /*n_replica*/, 1 /*n_thread*/, 9876543210UL /*seed*/);
+
+            std::vector<xoshiro256ss> rng_v = ReplicaRunnerUtil::replica_rng_v(cfg);
+
+            REQUIRE(rng_v.size() == 8);
+            REQUIRE(rng_v[0] == xoshiro256ss(9876543210UL));
+
+            for (std::size_t i = 1; i < rng_v.size(); ++i) {
+                INFO(xtag("i", i));
+
+                xoshiro256ss expected = rng_v[i-1];
+                expected.jump();
+
+                REQUIRE(rng_v[i] == expected);
+                REQUIRE(rng_v[i] != rng_v[i-1]);
+            }
+        } /*TEST_CASE(replica-rng)*/
+
+        TEST_CASE("replica-runner", "[simulator][replica]") {
+            Subsystem::initialize_all();
+
+            utc_nanos t0 = timeutil::ymd_hms(20240101 /*ymd*/, 93000 /*hms*/);
+            /* 101 steps per replica:  t0, t0+10us, .. t0+1000us */
+            utc_nanos t1 = t0 + microseconds(1000);
+            std::uint32_t n_step = 101;
+            std::uint32_t n_replica = 400;
+
+            std::vector<double> terminal1_v;
+
+            for (bool batch_flag : { false, true }) {
+                for (std::uint32_t n_thread : { 1u, 3u, 8u }) {
+                    INFO(xtag("batch_flag", batch_flag));
+                    INFO(xtag("n_thread", n_thread));
+
+                    ReplicaConfig cfg(t0, t1, n_replica, n_thread, 1283793486513782109UL,
+                                      xo::sim::SourceQueuePolicy::binary_heap, batch_flag);
+
+                    WalkRunner runner(cfg, &make_walk_replica, &merge_walk_stats);
+
+                    WalkStats stats = runner.run(WalkStats());
+
+                    REQUIRE(stats.n_step_ == std::uint64_t(n_replica) * n_step);
+                    REQUIRE(stats.terminal_v_.size() == n_replica);
+
+                    if (terminal1_v.empty()) {
+                        terminal1_v = stats.terminal_v_;
+                    } else {
+                        /* replica i sees the same stream regardless of thread count */
+                        REQUIRE(stats.terminal_v_ == terminal1_v);
+                    }
+                }
+            }
+
+            /* terminal position of a 101-step +/-1 walk has mean 0, variance 101.
+             * with 400 replicas:
+             *   stderr(mean) ~ 0.5,  stderr(variance) ~ 7.1
+             */
+            double sum = 0.0;
+            double sum2 = 0.0;
+            for (double x : terminal1_v) {
+                sum += x;
+                sum2 += x * x;
+            }
+
+            double mean = sum / n_replica;
+            double var = (sum2 - n_replica * mean * mean) / (n_replica - 1);
+
+            INFO(xtag("mean", mean));
+            INFO(xtag("var", var));
+
+            REQUIRE(std::abs(mean) < 2.5);
+            REQUIRE(std::abs(var - n_step) < 35.0);
+        } /*TEST_CASE(replica-runner)*/
+
+        TEST_CASE("replica-runner-error", "[simulator][replica]") {
+            Subsystem::initialize_all();
+
+            utc_nanos t0 = timeutil::ymd_hms(20240101 /*ymd*/, 93000 /*hms*/);
+
+            ReplicaConfig cfg(t0, t0 + microseconds(100), 16 /*n_replica*/, 4 /*n_thread*/, 1UL /*seed*/);
+
+            std::uint32_t n_build = 0;
+
+            auto factory = ([&n_build](Simulator * sim,
+                                       xoshiro256ss const & rng,
+                                       WalkStats * p_stats) -> WalkRunner::finish_type
+                {
+                    /* factory calls are serialized,  so unguarded counter is ok */
+                    if (++n_build == 7)
+                        throw std::runtime_error("replica-runner-error: expected failure");
+
+                    return make_walk_replica(sim, rng, p_stats);
+                });
+
+            WalkRunner runner(cfg, factory, &merge_walk_stats);
+
+            REQUIRE_THROWS_AS(runner.run(WalkStats()), std::runtime_error);
+        } /*TEST_CASE(replica-runner-error)*/
+    } /*namespace ut*/
+} /*namespace xo*/
+
+/* end ReplicaRunner.test.cpp */
@@ -0,0 +1,244 @@
+/* @file Simulator.test.cpp */
+
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
+
+#include "xo/simulator/Simulator.hpp"
+#include "xo/simulator/init_simulator.hpp"
+#include "catch2/catch.hpp"
+#include "xo/reactor/FifoQueue.hpp"
+#include "xo/reactor/Sink.hpp"
+#include <xo/ppsink/pretty_pair.hpp>   /* Prettifier<std::pair<T,U>> */
+#include <xo/ppsink/tag_ostream.hpp>
+#include <xo/randomgen/xoshiro256.hpp>
+#include <xo/timeutil/timeutil.hpp>
+
+namespace xo {
+    using xo::sim::Simulator;
+    using xo::sim::SourceQueuePolicy;
+    using xo::reactor::ReactorSource;
+    using xo::reactor::AbstractSink;
+    using xo::reactor::AbstractEventProcessor;
+    using xo::reactor::FifoQueue;
+    using xo::reactor::SinkToFunction;
+    using xo::reflect::Reflect;
+    using xo::reflect::TypeDescr;
+    using xo::time::timeutil;
+    using xo::time::utc_nanos;
+    using xo::time::nanos;
+    using xo::time::microseconds;
+
+    namespace {
+        using TestEvent = std::pair<utc_nanos, std::uint64_t>;
+        using TestQueue = FifoQueue<TestEvent>;
+
+        /* never-exhausted source with one event every .dt,
+         * starting at .t0.  events are discarded;
+         * use to measure simulator overhead
+         */
+        class PeriodicSource : public ReactorSource {
+        public:
+            PeriodicSource(utc_nanos t0, nanos dt) : next_tm_{t0}, dt_{dt} {}
+
+            // ----- inherited from ReactorSource -----
+
+            virtual bool is_empty() const override { return false; }
+            virtual bool is_exhausted() const override { return false; }
+            virtual utc_nanos sim_current_tm() const override { return next_tm_; }
+            virtual std::uint64_t sim_advance_until(utc_nanos tm, bool replay_flag) override {
+                std::uint64_t n = 0;
+                while (this->next_tm_ < tm)
+                    n += this->deliver_one_aux(replay_flag);
+                return n;
+            }
+            virtual std::uint64_t deliver_one() override { return this->deliver_one_aux(true); }
+
+            // ----- inherited from AbstractSource -----
+
+            virtual TypeDescr source_ev_type() const override { return Reflect::require<utc_nanos>(); }
+            virtual bool is_volatile() const override { return false; }
+            virtual uint32_t n_queued_out_ev() const override { return 1; }
+            virtual uint32_t n_out_ev() const override { return n_out_ev_; }
+            virtual bool debug_sim_flag() const override { return false; }
+            virtual void set_debug_sim_flag(bool) override {}
+            virtual CallbackId attach_sink(rp<AbstractSink> const &) override { return CallbackId(); }
+            virtual void detach_sink(CallbackId) override {}
+
+            // ----- inherited from AbstractEventProcessor -----
+
+            virtual std::string const & name() const override { return name_; }
+            virtual void set_name(std::string const & x) override { name_ = x; }
+            virtual void visit_direct_consumers(std::function<void (bp<AbstractEventProcessor>)> const &) override {}
+            virtual void display(std::ostream & os) const override { os << "<PeriodicSource>"; }
+
+        private:
+            std::uint64_t deliver_one_aux(bool replay_flag) {
+                this->next_tm_ += this->dt_;
+                if (replay_flag) {
+                    ++(this->n_out_ev_);
+                    return 1;
+                }
+                return 0;
+            }
+
+        private:
+            std::string name_;
+            utc_nanos next_tm_;
+            nanos dt_;
+            uint32_t n_out_ev_ = 0;
+        }; /*PeriodicSource*/
+    } /*namespace*/
+
+    static InitEvidence s_evidence = InitSubsys<S_simulator_tag>::require();
+
+    namespace ut {
+        using xo::pp::xtag;
+
+        /* simulate n_src fifo queues, with n_ev events in total,
+         * at distinct random times.
+         * return (time, payload) pairs in delivery order.
+         *
+         * batch_flag.  if true,  run with .run_until_batched()
+         */
+        std::vector<TestEvent>
+        run_fifo_simulation(SourceQueuePolicy policy,
+                            bool batch_flag,
+                            std::size_t n_src,
+                            std::vector<std::uint64_t> const & perm)
+        {
+            utc_nanos t0 = timeutil::ymd_hms(20240101 /*ymd*/, 93000 /*hms*/);
+
+            rp<Simulator> sim = Simulator::make(t0, policy);
+
+            REQUIRE(sim->queue_policy() == policy);
+
+            sim->set_loglevel(xo::pp::log_level::error);
+
+            std::vector<TestEvent> out_ev_v;
+
+            auto sink_fn
+                = ([&out_ev_v](TestEvent const & x) { out_ev_v.push_back(x); });
+
+            std::vector<rp<TestQueue>> src_v;
+            for (std::size_t i = 0; i < n_src; ++i) {
+                rp<TestQueue> q = TestQueue::make();
+
+                q->add_callback(new SinkToFunction
+                                <TestEvent, std::function<void (TestEvent const &)>>(sink_fn));
+
+                REQUIRE(sim->add_source(q));
+                REQUIRE(sim->is_source_present(q));
+
+                src_v.push_back(q);
+            }
+
+            /* each fifo queue needs its events in increasing time order;
+             * distribute events round-robin,  by increasing time
+             */
+            std::vector<std::vector<std::uint64_t>> u_vv(n_src);
+            for (std::size_t i = 0; i < perm.size(); ++i)
+                u_vv[perm[i] % n_src].push_back(perm[i]);
+
+            for (std::size_t j = 0; j < n_src; ++j) {
+                std::sort(u_vv[j].begin(), u_vv[j].end());
+
+                for (std::uint64_t u : u_vv[j])
+                    src_v[j]->notify_ev(TestEvent(t0 + microseconds(1 + u), u));
+            }
+
+            if (batch_flag) {
+                sim->run_until_batched(t0 + microseconds(perm.size() + 1));
+            } else {
+                /* note: fifo queues never report exhausted,
+                 * so rely on empty heap to end simulation
+                 */
+                while (sim->advance_one_event() > 0)
+                    ;
+            }
+
+            REQUIRE(sim->last_tm() == t0 + microseconds(perm.size()));
+
+            REQUIRE(sim->n_event() == perm.size());
+            REQUIRE(sim->heap_contents().empty());
+
+            return out_ev_v;
+        } /*run_fifo_simulation*/
+
+        TEST_CASE("simulator-policy", "[simulator]") {
+            Subsystem::initialize_all();
+
+            uint64_t seed = 1283793486513782109UL;
+            auto rgen = xo::rng::xoshiro256ss(seed);
+
+            for (std::size_t n_src = 1; n_src <= 256; n_src *= 4) {
+                INFO(xtag("n_src", n_src));
+
+                std::size_t n_ev = 8 * n_src;
+
+                std::vector<std::uint64_t> perm(n_ev);
+                for (std::size_t i = 0; i < n_ev; ++i)
+                    perm[i] = i;
+                std::shuffle(perm.begin(), perm.end(), rgen);
+
+                std::vector<TestEvent> v1
+                    = run_fifo_simulation(SourceQueuePolicy::binary_heap, false, n_src, perm);
+                std::vector<TestEvent> v2
+                    = run_fifo_simulation(SourceQueuePolicy::radix_heap, false, n_src, perm);
+                std::vector<TestEvent> v3
+                    = run_fifo_simulation(SourceQueuePolicy::binary_heap, true, n_src, perm);
+
+                REQUIRE(v1.size() == n_ev);
+                REQUIRE(v1 == v2);
+                REQUIRE(v1 == v3);
+
+                /* events are delivered in increasing time order */
+                for (std::size_t i = 0; i < n_ev; ++i) {
+                    INFO(xtag("i", i));
+                    REQUIRE(v1[i].second == i);
+                }
+            }
+        } /*TEST_CASE(simulator-policy)*/
+
+        /* benchmark with:
+         *   $ ./utest.simulator [!benchmark]
+         *
+         * cost of Simulator.advance_one_event() as #of sources grows,
+         * for each SourceQueuePolicy.  Sources have staggered periods
+         * so that heap order changes from one event to the next.
+         */
+        TEST_CASE("simulator-benchmark", "[!benchmark]") {
+            Subsystem::initialize_all();
+
+            utc_nanos t0 = timeutil::ymd_hms(20240101 /*ymd*/, 93000 /*hms*/);
+
+            for (std::size_t n_src = 10; n_src <= 100000; n_src *= 10) {
+                for (SourceQueuePolicy policy : { SourceQueuePolicy::binary_heap,
+                                                  SourceQueuePolicy::radix_heap })
+                {
+                    rp<Simulator> sim = Simulator::make(t0, policy);
+                    sim->set_loglevel(xo::pp::log_level::error);
+
+                    std::vector<rp<PeriodicSource>> src_v;
+                    for (std::size_t i = 0; i < n_src; ++i) {
+                        rp<PeriodicSource> src
+                            = new PeriodicSource(t0 + microseconds(1 + i),
+                                                 microseconds(1000 + (i % 97)));
+
+                        sim->add_source(src);
+                        src_v.push_back(src);
+                    }
+
+                    std::string name
+                        = (std::string(policy == SourceQueuePolicy::binary_heap
+                                       ? "binary_heap" : "radix_heap")
+                           + " n_src=" + std::to_string(n_src));
+
+                    BENCHMARK(name.c_str()) {
+                        return sim->advance_one_event();
+                    };
+                }
+            }
+        } /*TEST_CASE(simulator-benchmark)*/
+    } /*namespace ut*/
+} /*namespace xo*/
+
+/* end Simulator.test.cpp */
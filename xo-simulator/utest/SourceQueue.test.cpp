@@ -0,0 +1,133 @@
+/* @file SourceQueue.test.cpp */
+
+#include "xo/simulator/SourceQueue.hpp"
+#include "catch2/catch.hpp"
+#include "xo/reactor/FifoQueue.hpp"
+#include <xo/ppsink/pretty_pair.hpp>   /* Prettifier<std::pair<T,U>> */
+#include <xo/ppsink/tag_ostream.hpp>
+#include <xo/randomgen/xoshiro256.hpp>
+#include <xo/timeutil/timeutil.hpp>
+
+namespace xo {
+    using xo::sim::SourceQueue;
+    using xo::sim::SourceQueuePolicy;
+    using xo::sim::SourceTimestamp;
+    using xo::reactor::ReactorSource;
+    using xo::reactor::FifoQueue;
+    using xo::time::timeutil;
+    using xo::time::utc_nanos;
+    using xo::time::nanos;
+
+    namespace {
+        using TestEvent = std::pair<utc_nanos, std::uint64_t>;
+        using TestQueue = FifoQueue<TestEvent>;
+    } /*namespace*/
+
+    namespace ut {
+        using xo::pp::xtag;
+
+        /* drive a binary-heap queue and a radix-heap queue with the same
+         * random sequence of operations;  verify they agree at every step.
+         *
+         * times advance monotonically (simulator-like),  except that with
+         * probability ~1/8 a push uses a time earlier than the last pop,
+         * to exercise the radix heap's fallback path.
+         */
+        void
+        run_sourcequeue_test(std::size_t n_src,
+                             std::size_t n_op,
+                             xo::rng::xoshiro256ss * p_rgen)
+        {
+            /* sources only supply addresses for tie-breaking;  never dereferenced */
+            std::vector<rp<TestQueue>> src_v;
+            for (std::size_t i = 0; i < n_src; ++i)
+                src_v.push_back(TestQueue::make());
+
+            auto q1 = SourceQueue::make(SourceQueuePolicy::binary_heap);
+            auto q2 = SourceQueue::make(SourceQueuePolicy::radix_heap);
+
+            REQUIRE(q1->policy() == SourceQueuePolicy::binary_heap);
+            REQUIRE(q2->policy() == SourceQueuePolicy::radix_heap);
+
+            utc_nanos t0 = timeutil::ymd_hms(20240101 /*ymd*/, 93000 /*hms*/);
+            utc_nanos last_tm = t0;
+
+            for (std::size_t i = 0; i < n_op; ++i) {
+                INFO(xtag("i", i));
+
+                std::uint64_t r = p_rgen->generate();
+
+                if (q1->empty() || (r % 3 != 0)) {
+                    /* push.  coarse time grid so that ties are common */
+                    nanos dt = nanos(1000 * ((r >> 8) % 64));
+                    utc_nanos tm = (((r >> 16) % 8) == 0) ? last_tm - dt : last_tm + dt;
+                    ReactorSource * src = src_v[(r >> 24) % n_src].get();
+
+                    q1->push(SourceTimestamp(tm, src));
+                    q2->push(SourceTimestamp(tm, src));
+                } else if ((r >> 32) % 16 == 0) {
+                    /* remove all entries for one source */
+                    ReactorSource * src = src_v[(r >> 40) % n_src].get();
+
+                    REQUIRE(q1->contains(src) == q2->contains(src));
+
+                    q1->remove(src);
+                    q2->remove(src);
+
+                    REQUIRE(!q1->contains(src));
+                    REQUIRE(!q2->contains(src));
+                } else {
+                    REQUIRE(q1->front() == q2->front());
+
+                    last_tm = q1->front().t0();
+
+                    q1->pop();
+                    q2->pop();
+                }
+
+                REQUIRE(q1->size() == q2->size());
+                REQUIRE(q1->empty() == q2->empty());
+
+                if (!q1->empty()) {
+                    REQUIRE(q1->front() == q2->front());
+                }
+            }
+
+            /* contents() agree,  and are sorted */
+            std::vector<SourceTimestamp> v1 = q1->contents();
+            std::vector<SourceTimestamp> v2 = q2->contents();
+
+            REQUIRE(v1 == v2);
+            REQUIRE(std::is_sorted(v1.begin(), v1.end()));
+
+            /* drain */
+            while (!q1->empty()) {
+                REQUIRE(q1->front() == q2->front());
+
+                q1->pop();
+                q2->pop();
+            }
+
+            REQUIRE(q2->empty());
+
+            q1->clear();
+            q2->clear();
+        } /*run_sourcequeue_test*/
+
+        TEST_CASE("sourcequeue", "[simulator][sourcequeue]") {
+            uint64_t seed = 7116533974310288469UL;
+            auto rgen = xo::rng::xoshiro256ss(seed);
+
+            for (std::size_t n_src = 1; n_src <= 64; n_src *= 4) {
+                for (std::size_t n_op = 16; n_op <= 4096; n_op *= 4) {
+                    INFO(xtag("n_src", n_src));
+                    INFO(xtag("n_op", n_op));
+
+                    run_sourcequeue_test(n_src, n_op, &rgen);
+                }
+            }
+        } /*TEST_CASE(sourcequeue)*/
+    } /*namespace ut*/
+} /*namespace xo*/
+
+/* end SourceQueue.test.cpp */
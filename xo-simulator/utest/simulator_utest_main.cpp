@@ -0,0 +1,7 @@
+/* @file simulator_utest_main.cpp */
+
+#define CATCH_CONFIG_MAIN
+#define CATCH_CONFIG_ENABLE_BENCHMARKING
+#include "catch2/catch.hpp"
+
+/* end simulator_utest_main.cpp */
@@ -1,8 +1,182 @@
 /* @file Accumulator.hpp */
 
+#pragma once
+
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <cstddef>
+#include <cstdint>
+#include <span>
+
 namespace xo {
-  nmaespace statistics {
+  namespace statistics {
+    /* accumulate sample moments (mean + central moments 2..4) online.
+     *
+     * Mergeable:  accumulators built from disjoint samples
+     * (e.g. one per thread) combine with .merge(),  giving the same
+     * result (up to rounding) as one accumulator that saw all samples.
+     * Uses pairwise update formulas of Chan, Golub & LeVeque (1979)
+     * for mean / M2,  extended to M3, M4 by Pebay (2008).
+     *
+     * .include_sample() is the special case of .merge() with a one-sample
+     * accumulator.  .include_samples() computes moments for a block of samples
+     * directly (two passes per cache-sized chunk,  with lane-wise partial sums
+     * the compiler can vectorize),  then merges the block.
+     *
+     * Notation (n samples x(i),  mean u):
+     *   Mk = Sum (x(i) - u)^k
+     */
     class Accumulator {
+    public:
+      Accumulator() = default;
+      Accumulator(std::uint64_t n, double mean, double m2, double m3, double m4)
+        : n_sample_{n}, mean_{mean}, moment2_{m2}, moment3_{m3}, moment4_{m4} {}
+
+      /* accumulator for samples xv[] */
+      static Accumulator from_samples(std::span<double const> xv) {
+        Accumulator retval;
+        retval.include_samples(xv);
+        return retval;
+      }
+
+      std::uint64_t n_sample() const { return n_sample_; }
+      double mean() const { return mean_; }
+      /* M2 = sum of squared deviations from mean */
+      double moment2() const { return moment2_; }
+      double moment3() const { return moment3_; }
+      double moment4() const { return moment4_; }
+
+      /* variance estimate with Bessel correction.  require: n_sample >= 2 */
+      double sample_variance() const { return moment2_ / (n_sample_ - 1); }
+      /* biased variance estimate.  require: n_sample >= 1 */
+      double variance() const { return moment2_ / n_sample_; }
+      /* (biased) sample skewness  g1 = sqrt(n).M3 / M2^(3/2) */
+      double skewness() const {
+        return std::sqrt(static_cast<double>(n_sample_)) * moment3_ / std::pow(moment2_, 1.5);
+      }
+      /* (biased) sample excess kurtosis  g2 = n.M4 / M2^2 - 3 */
+      double excess_kurtosis() const {
+        return n_sample_ * moment4_ / (moment2_ * moment2_) - 3.0;
+      }
+
+      void include_sample(double x) {
+        this->merge(Accumulator(1, x, 0.0, 0.0, 0.0));
+      } /*include_sample*/
+
+      /* include all samples xv[];
+       * same result (up to rounding) as calling .include_sample() on each
+       */
+      void include_samples(std::span<double const> xv) {
+        for (std::size_t lo = 0; lo < xv.size(); lo += c_chunk) {
+          std::size_t n = std::min(c_chunk, xv.size() - lo);
+
+          this->merge(chunk_moments(xv.data() + lo, n));
+        }
+      } /*include_samples*/
+
+      /* fold samples represented by y into this accumulator */
+      void merge(Accumulator const & y) {
+        if (y.n_sample_ == 0)
+          return;
+
+        if (this->n_sample_ == 0) {
+          *this = y;
+          return;
+        }
+
+        double na = this->n_sample_;
+        double nb = y.n_sample_;
+        double n = na + nb;
+
+        double d = y.mean_ - this->mean_;
+        double d_n = d / n;
+        double d2 = d * d;
+
+        double m2a = this->moment2_;
+        double m3a = this->moment3_;
+        double m2b = y.moment2_;
+        double m3b = y.moment3_;
+
+        /* Pebay (2008),  eqs. 2.1, 2.2 */
+        this->moment4_ = (this->moment4_ + y.moment4_
+                          + d2 * d2 * na * nb * (na * na - na * nb + nb * nb) / (n * n * n)
+                          + 6.0 * d2 * (na * na * m2b + nb * nb * m2a) / (n * n)
+                          + 4.0 * d_n * (na * m3b - nb * m3a));
+        this->moment3_ = (m3a + m3b
+                          + d2 * d * na * nb * (na - nb) / (n * n)
+                          + 3.0 * d_n * (na * m2b - nb * m2a));
+        this->moment2_ = m2a + m2b + d2 * na * nb / n;
+        this->mean_ = this->mean_ + d_n * nb;
+        this->n_sample_ += y.n_sample_;
+      } /*merge*/
+
+    private:
+      /* moments for n samples at x[],  computed directly.
+       * Lane-wise partial sums let the compiler vectorize the reductions
+       * without reassociating floating-point adds.
+       */
+      static Accumulator chunk_moments(double const * x, std::size_t n) {
+        constexpr std::size_t c_lane = 4;
+
+        std::array<double, c_lane> s1 = {};
+
+        std::size_t n4 = n - (n % c_lane);
+
+        for (std::size_t i = 0; i < n4; i += c_lane) {
+          for (std::size_t l = 0; l < c_lane; ++l)
+            s1[l] += x[i + l];
+        }
+
+        double sum = (s1[0] + s1[1]) + (s1[2] + s1[3]);
+        for (std::size_t i = n4; i < n; ++i)
+          sum += x[i];
+
+        double u = sum / n;
+
+        std::array<double, c_lane> s2 = {};
+        std::array<double, c_lane> s3 = {};
+        std::array<double, c_lane> s4 = {};
+
+        for (std::size_t i = 0; i < n4; i += c_lane) {
+          for (std::size_t l = 0; l < c_lane; ++l) {
+            double d = x[i + l] - u;
+            double dd = d * d;
+
+            s2[l] += dd;
+            s3[l] += dd * d;
+            s4[l] += dd * dd;
+          }
+        }
+
+        double m2 = (s2[0] + s2[1]) + (s2[2] + s2[3]);
+        double m3 = (s3[0] + s3[1]) + (s3[2] + s3[3]);
+        double m4 = (s4[0] + s4[1]) + (s4[2] + s4[3]);
+
+        for (std::size_t i = n4; i < n; ++i) {
+          double d = x[i] - u;
+          double dd = d * d;
+
+          m2 += dd;
+          m3 += dd * d;
+          m4 += dd * dd;
+        }
+
+        return Accumulator(n, u, m2, m3, m4);
+      } /*chunk_moments*/
+
+    private:
+      /* #of samples per .chunk_moments() call;  keeps chunk in L1 */
+      static constexpr std::size_t c_chunk = 2048;
+
+      /* #of samples */
+      std::uint64_t n_sample_ = 0;
+      /* sample mean */
+      double mean_ = 0.0;
+      /* central moments Mk = Sum (x(i) - mean)^k,  k = 2,3,4 */
+      double moment2_ = 0.0;
+      double moment3_ = 0.0;
+      double moment4_ = 0.0;
     }; /*Accumulator*/
   } /*namespace statistics*/
 } /*namespace xo*/
@@ -2,10 +2,16 @@
 
 #pragma once
 
-#include "logutil/scope.hpp"
-#include "statistics/SampleStatistics.hpp"
+#include "SampleStatistics.hpp"
+#include <xo/ppsink/scope.hpp>
+#include <xo/ppsink/scope_macros.hpp>
+#include <xo/ppsink/tag.hpp>
 #include <cmath>
 #include <cstdint>
+#include <limits>
+#include <span>
+#include <stdexcept>
+#include <string>
 #include <vector>
 
 namespace xo {
@@ -54,8 +60,8 @@ namespace xo {
       
       /* add one sample, x, to this bucket */
       void include_sample(double x) {
-	using logutil::scope;
-	using logutil::xtag;
+	using xo::pp::scope;
+	using xo::pp::xtag;
 
 	constexpr char const * c_self = "Bucket::include_sample";
 	constexpr bool c_logging_enabled = false;
@@ -72,7 +78,7 @@ namespace xo {
 	double mom2_np1 = SampleStatistics::update_online_moment2(x,
 								  mean_np1, mean_n,
 								  mom2_n);
-	scope lscope(c_self, c_logging_enabled);
+	scope lscope(XO_DEBUG2_(c_logging_enabled, c_self));
 	if(c_logging_enabled) {
 	lscope.log("update",
 		   xtag("x", x), xtag("n", n),
@@ -87,6 +93,14 @@ namespace xo {
 	this->moment2_ = mom2_np1;
       } /*include_sample*/
 
+      /* fold samples in bucket y into this bucket */
+      void merge(Bucket const & y) {
+        this->sum_ += y.sum_;
+
+        SampleStatistics::merge_online_moment2(&(this->n_sample_), &(this->mean_), &(this->moment2_),
+                                               y.n_sample_, y.mean_, y.moment2_);
+      } /*merge*/
+
     private:
       /* #of samples in this bucket (will be #of times .sample() has been called) */
       uint32_t n_sample_ = 0;
@@ -196,6 +210,30 @@ namespace xo {
 	this->bucket_v_[ix].include_sample(x);
       } /*include_sample*/
 
+      /* include all samples xv[] */
+      void include_samples(std::span<double const> xv) {
+        for (double x : xv)
+          this->include_sample(x);
+      } /*include_samples*/
+
+      /* fold contents of histogram y into this histogram,
+       * e.g. to combine per-thread histograms.
+       * Require: y has same bucket layout as *this
+       */
+      void merge(Histogram const & y) {
+        if ((y.n_interior_bucket_ != this->n_interior_bucket_)
+            || (y.lo_bucket_ != this->lo_bucket_)
+            || (y.hi_bucket_ != this->hi_bucket_))
+        {
+          throw std::runtime_error("Histogram::merge: expected histograms with identical bucket layout");
+        }
+
+        this->n_sample_ += y.n_sample_;
+
+        for (uint32_t i = 0, n = this->n_bucket(); i < n; ++i)
+          this->bucket_v_[i].merge(y.bucket_v_[i]);
+      } /*merge*/
+
     private:
       /* #of samples across all buckets */
       uint32_t n_sample_ = 0;
@@ -0,0 +1,317 @@
+/* @file LogHistogram.hpp */
+
+#pragma once
+
+#include "Accumulator.hpp"
+#include <xo/indentlog2/print/tostr.hpp>
+#include <xo/ppsink/tag.hpp>
+#include <algorithm>
+#include <array>
+#include <bit>
+#include <cmath>
+#include <cstdint>
+#include <limits>
+#include <span>
+#include <stdexcept>
+#include <vector>
+
+namespace xo {
+  namespace statistics {
+    /* histogram with logarithmically-spaced buckets (HDR-style),
+     * for heavy-tailed positive data such as latencies.
+     *
+     * Range [lo, hi) is split into octaves [lo.2^e, lo.2^(e+1)),
+     * each octave into 2^sub_bucket_bits equal-width sub-buckets.
+     * Bucket width is at most 2^-sub_bucket_bits relative to bucket value,
+     * so .quantile() reports values with relative error <= 2^-sub_bucket_bits
+     * (for samples in [lo, hi)),  using memory proportional to
+     *   log2(hi/lo) * 2^sub_bucket_bits
+     * independent of #of samples.
+     *
+     * hi is rounded up to a whole number of octaves above lo.
+     *
+     * Bucket layout:
+     *   [0]          underflow:  x < lo
+     *   [1 .. n]     log-spaced buckets
+     *   [n+1]        overflow:   x >= hi
+     *
+     * Bucket lookup avoids log():  with s = x/lo in [1, 2^n_octave),
+     * IEEE-754 exponent of s gives the octave,  and the top sub_bucket_bits
+     * bits of its mantissa give the sub-bucket.  Since s is rounded,
+     * that guess is then checked against the bucket's edges
+     * (see .bucket_lo_edge()),  so that lookup agrees exactly with reported edges.
+     *
+     * Also tracks exact mean/moments (see Accumulator) and min/max.
+     * NaN samples are counted separately (see .n_nan()),  and otherwise ignored.
+     * Mergeable:  histograms with the same layout combine with .merge().
+     */
+    class LogHistogram {
+    public:
+      LogHistogram(double lo, double hi, uint32_t sub_bucket_bits = 7)
+        : sub_bucket_bits_{sub_bucket_bits}
+      {
+        using xo::pp::tostr;
+        using xo::pp::xtag;
+
+        if (!(lo > 0.0) || !(hi > lo) || !std::isfinite(hi)) {
+          throw std::runtime_error(tostr("LogHistogram: expected 0 < lo < hi < +oo",
+                                         xtag("lo", lo), xtag("hi", hi)));
+        }
+
+        if (sub_bucket_bits > c_max_sub_bucket_bits) {
+          throw std::runtime_error(tostr("LogHistogram: expected sub_bucket_bits <= max",
+                                         xtag("sub_bucket_bits", sub_bucket_bits),
+                                         xtag("max", c_max_sub_bucket_bits)));
+        }
+
+        int n_octave = std::max(1, static_cast<int>(std::ceil(std::log2(hi / lo))));
+
+        this->lo_ = lo;
+        this->hi_ = std::ldexp(lo, n_octave);
+        this->n_log_bucket_ = static_cast<uint32_t>(n_octave) << sub_bucket_bits;
+        this->count_v_.resize(this->n_log_bucket_ + 2);
+      } /*ctor*/
+
+      uint64_t n_sample() const { return acc_.n_sample(); }
+      /* #of NaN samples seen;  not included in .n_sample() */
+      uint64_t n_nan() const { return n_nan_; }
+      uint32_t n_bucket() const { return n_log_bucket_ + 2; }
+      uint32_t sub_bucket_bits() const { return sub_bucket_bits_; }
+      double lo() const { return lo_; }
+      double hi() const { return hi_; }
+      /* bound on relative error of .quantile() for samples in [lo, hi) */
+      double relative_error() const { return std::ldexp(1.0, -static_cast<int>(sub_bucket_bits_)); }
+
+      /* exact moments over all samples */
+      Accumulator const & moments() const { return acc_; }
+      double mean() const { return acc_.mean(); }
+      double min_value() const { return min_; }
+      double max_value() const { return max_; }
+
+      uint64_t count(uint32_t ix) const { return count_v_[ix]; }
+
+      double bucket_lo_edge(uint32_t ix) const {
+        if (ix == 0)
+          return -std::numeric_limits<double>::infinity();
+
+        if (ix > n_log_bucket_)
+          return this->hi_;
+
+        return this->log_bucket_lo_edge(ix - 1);
+      } /*bucket_lo_edge*/
+
+      double bucket_hi_edge(uint32_t ix) const {
+        if (ix > n_log_bucket_)
+          return std::numeric_limits<double>::infinity();
+
+        if (ix == n_log_bucket_)
+          return this->hi_;
+
+        return this->bucket_lo_edge(ix + 1);
+      } /*bucket_hi_edge*/
+
+      /* index (into .count_v[]) of bucket for a sample with value x.
+       * NaN reports underflow here,  but .include_sample() doesn't bucket it.
+       */
+      uint32_t bucket_ix(double x) const {
+        /* explicit:  NaN must never reach the integer conversion below */
+        if (std::isnan(x) || (x < this->lo_))
+          return 0;
+
+        if (x >= this->hi_)
+          return this->n_log_bucket_ + 1;
+
+        /* s in [1, 2^n_octave);  rounding can't push it outside */
+        double s = std::max(1.0, x / this->lo_);
+        uint64_t bits = std::bit_cast<uint64_t>(s);
+
+        uint32_t k = static_cast<uint32_t>((bits >> (52 - sub_bucket_bits_))
+                                           - (uint64_t{1023} << sub_bucket_bits_));
+
+        k = std::min(k, this->n_log_bucket_ - 1);
+
+        /* s is rounded,  and so are the edges;  guess may be off by one
+         * when x is within an ulp or so of an edge (e.g. lo not a power of 2).
+         * Edges are monotone in k,  so one step in either direction settles it.
+         * k=0 never moves down,  since x >= lo = edge(0)
+         */
+        if (x < this->log_bucket_lo_edge(k))
+          --k;
+        else if ((k + 1 < this->n_log_bucket_) && (x >= this->log_bucket_lo_edge(k + 1)))
+          ++k;
+
+        return 1 + k;
+      } /*bucket_ix*/
+
+      void include_sample(double x) {
+        if (std::isnan(x)) {
+          ++(this->n_nan_);
+          return;
+        }
+
+        ++(this->count_v_[this->bucket_ix(x)]);
+
+        this->acc_.include_sample(x);
+        this->min_ = std::min(this->min_, x);
+        this->max_ = std::max(this->max_, x);
+      } /*include_sample*/
+
+      /* include all samples xv[];  same result as calling .include_sample() on each.
+       * Bucket indices are computed a block at a time,  separately from
+       * the (scattered) count increments,  so the index computation vectorizes.
+       */
+      void include_samples(std::span<double const> xv) {
+        constexpr std::size_t c_block = 256;
+
+        /* NaN would poison moments and min/max;  rare,  so take slow path */
+        if (std::any_of(xv.begin(), xv.end(), [](double x) { return std::isnan(x); })) {
+          for (double x : xv)
+            this->include_sample(x);
+
+          return;
+        }
+
+        std::array<uint32_t, c_block> ix_v;
+
+        for (std::size_t lo = 0; lo < xv.size(); lo += c_block) {
+          std::size_t n = std::min(c_block, xv.size() - lo);
+          double const * x = xv.data() + lo;
+
+          for (std::size_t i = 0; i < n; ++i)
+            ix_v[i] = this->bucket_ix(x[i]);
+
+          for (std::size_t i = 0; i < n; ++i)
+            ++(this->count_v_[ix_v[i]]);
+        }
+
+        if (!xv.empty()) {
+          auto [lo_p, hi_p] = std::minmax_element(xv.begin(), xv.end());
+
+          this->min_ = std::min(this->min_, *lo_p);
+          this->max_ = std::max(this->max_, *hi_p);
+        }
+
+        this->acc_.include_samples(xv);
+      } /*include_samples*/
+
+      /* fold contents of histogram y into this histogram,
+       * e.g. to combine per-thread histograms.
+       * Require: y has same bucket layout as *this
+       */
+      void merge(LogHistogram const & y) {
+        if ((y.lo_ != this->lo_)
+            || (y.hi_ != this->hi_)
+            || (y.sub_bucket_bits_ != this->sub_bucket_bits_))
+        {
+          throw std::runtime_error("LogHistogram::merge: expected histograms with identical bucket layout");
+        }
+
+        for (uint32_t i = 0, n = this->n_bucket(); i < n; ++i)
+          this->count_v_[i] += y.count_v_[i];
+
+        this->n_nan_ += y.n_nan_;
+        this->acc_.merge(y.acc_);
+        this->min_ = std::min(this->min_, y.min_);
+        this->max_ = std::max(this->max_, y.max_);
+      } /*merge*/
+
+      /* approximate q'th quantile (q in [0,1]):
+       * midpoint of bucket containing sample with rank ceil(q.n),
+       * clamped to [.min_value, .max_value].
+       * Under/overflow samples report .min_value / .max_value resp.
+       */
+      double quantile(double q) const {
+        using xo::pp::tostr;
+        using xo::pp::xtag;
+
+        if (this->n_sample() == 0)
+          throw std::runtime_error("LogHistogram::quantile: expected non-empty histogram");
+
+        if (!(q >= 0.0 && q <= 1.0))
+          throw std::runtime_error(tostr("LogHistogram::quantile: expected q in [0,1]", xtag("q", q)));
+
+        uint64_t rank = std::max(uint64_t{1},
+                                 static_cast<uint64_t>(std::ceil(q * this->n_sample())));
+        uint64_t cum = 0;
+
+        for (uint32_t ix = 0, n = this->n_bucket(); ix < n; ++ix) {
+          cum += this->count_v_[ix];
+
+          if (cum >= rank) {
+            if (ix == 0)
+              return this->min_;
+            if (ix > this->n_log_bucket_)
+              return this->max_;
+
+            double mid = 0.5 * (this->bucket_lo_edge(ix) + this->bucket_hi_edge(ix));
+
+            return std::clamp(mid, this->min_, this->max_);
+          }
+        }
+
+        return this->max_;
+      } /*quantile*/
+
+      /* approximate fraction of samples <= x;
+       * interpolates linearly within the bucket containing x
+       * (under/overflow buckets span [.min_value, lo) / [hi, .max_value]).
+       */
+      double cdf(double x) const {
+        if (this->n_sample() == 0 || x < this->min_)
+          return 0.0;
+        if (x >= this->max_)
+          return 1.0;
+
+        uint32_t ix = this->bucket_ix(x);
+        uint64_t below = 0;
+
+        for (uint32_t i = 0; i < ix; ++i)
+          below += this->count_v_[i];
+
+        double lo_edge = std::max(this->min_, this->bucket_lo_edge(ix));
+        double hi_edge = std::min(this->max_, this->bucket_hi_edge(ix));
+        double frac = (hi_edge > lo_edge) ? (x - lo_edge) / (hi_edge - lo_edge) : 1.0;
+
+        return (below + frac * this->count_v_[ix]) / this->n_sample();
+      } /*cdf*/
+
+    private:
+      /* left edge of k'th log-spaced bucket (i.e. .count_v[1+k]).
+       * require: k < .n_log_bucket
+       */
+      double log_bucket_lo_edge(uint32_t k) const {
+        uint32_t mask = (1u << sub_bucket_bits_) - 1;
+
+        return std::ldexp(this->lo_ * (1.0 + std::ldexp(static_cast<double>(k & mask),
+                                                        -static_cast<int>(sub_bucket_bits_))),
+                          static_cast<int>(k >> sub_bucket_bits_));
+      } /*log_bucket_lo_edge*/
+
+    private:
+      /* mantissa bits available in a double */
+      static constexpr uint32_t c_max_sub_bucket_bits = 20;
+
+      /* #of sub-buckets per octave is 2^.sub_bucket_bits */
+      uint32_t sub_bucket_bits_ = 0;
+      /* #of log-spaced buckets (excludes under/overflow) */
+      uint32_t n_log_bucket_ = 0;
+      /* left edge of first log-spaced bucket */
+      double lo_ = 0.0;
+      /* right edge of last log-spaced bucket */
+      double hi_ = 0.0;
+
+      /* #of NaN samples;  excluded from everything else */
+      uint64_t n_nan_ = 0;
+      /* exact moments */
+      Accumulator acc_;
+      /* smallest / largest sample seen */
+      double min_ = std::numeric_limits<double>::infinity();
+      double max_ = -std::numeric_limits<double>::infinity();
+
+      /* .count_v[i]:  #of samples in bucket i */
+      std::vector<uint64_t> count_v_;
+    }; /*LogHistogram*/
+  } /*namespace statistics*/
+} /*namespace xo*/
+
+/* end LogHistogram.hpp */
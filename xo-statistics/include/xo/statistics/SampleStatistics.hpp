@@ -2,7 +2,9 @@
 
 #pragma once
 
+#include "Accumulator.hpp"
 #include <cstdint>
+#include <span>
 
 namespace xo {
   namespace statistics {
@@ -86,6 +88,32 @@ namespace xo {
 	return moment2 + (x - mean_n) * (x - mean_np1);
       } /*update_online_moment2*/
 
+      /* combine statistics for two disjoint samples A, B
+       * (Chan, Golub & LeVeque 1979):
+       *
+       *   n = na + nb,   d = mean(B) - mean(A)
+       *
+       *   mean(A+B) = mean(A) + d . nb / n
+       *   M2(A+B)   = M2(A) + M2(B) + d^2 . na . nb / n
+       *
+       * na, mean_a, moment2_a.  n, mean, M2 for A;  updated in place to A+B
+       * nb, mean_b, moment2_b.  n, mean, M2 for B
+       */
+      static void merge_online_moment2(uint32_t * p_na, double * p_mean_a, double * p_moment2_a,
+                                       uint32_t nb, double mean_b, double moment2_b)
+      {
+        if (nb == 0)
+          return;
+
+        double na = *p_na;
+        double n = na + nb;
+        double d = mean_b - *p_mean_a;
+
+        *p_moment2_a += moment2_b + d * d * na * nb / n;
+        *p_mean_a += d * nb / n;
+        *p_na += nb;
+      } /*merge_online_moment2*/
+
       uint32_t n_sample() const { return n_sample_; }
       double mean() const { return mean_; }
       double moment2() const { return moment2_; }
@@ -117,6 +145,25 @@ namespace xo {
 	this->moment2_  = moment2_np1;
       } /*include_sample*/
 
+      /* include all samples xv[];
+       * same result (up to rounding) as calling .include_sample() on each,
+       * but vectorizes (see Accumulator::include_samples())
+       */
+      void include_samples(std::span<double const> xv) {
+        Accumulator acc = Accumulator::from_samples(xv);
+
+        merge_online_moment2(&(this->n_sample_), &(this->mean_), &(this->moment2_),
+                             acc.n_sample(), acc.mean(), acc.moment2());
+      } /*include_samples*/
+
+      /* fold sample represented by y into this one,
+       * e.g. to combine per-thread statistics
+       */
+      void merge(SampleStatistics const & y) {
+        merge_online_moment2(&(this->n_sample_), &(this->mean_), &(this->moment2_),
+                             y.n_sample_, y.mean_, y.moment2_);
+      } /*merge*/
+
     private:
       uint32_t n_sample_ = 0;
       /* estimated mean */
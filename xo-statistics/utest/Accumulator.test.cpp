@@ -0,0 +1,188 @@
+/* @file Accumulator.test.cpp */
+
+#include "xo/statistics/Accumulator.hpp"
+#include "xo/statistics/SampleStatistics.hpp"
+#include <catch2/catch.hpp>
+#include <cmath>
+#include <random>
+#include <span>
+#include <vector>
+
+namespace xo {
+    using xo::statistics::Accumulator;
+    using xo::statistics::SampleStatistics;
+
+    namespace ut {
+        namespace {
+            /* skewed sample,  offset from zero,  so every moment is non-trivial */
+            std::vector<double>
+            make_samples(std::size_t n, std::uint64_t seed)
+            {
+                std::mt19937_64 eng(seed);
+                std::lognormal_distribution<double> dist(0.0, 0.75);
+
+                std::vector<double> retval(n);
+                for (double & x : retval)
+                    x = 1000.0 + dist(eng);
+
+                return retval;
+            } /*make_samples*/
+
+            /* two-pass reference moments,  in long double */
+            struct RefMoments {
+                explicit RefMoments(std::span<double const> xv) {
+                    long double n = xv.size();
+                    long double sum = 0.0;
+
+                    for (double x : xv)
+                        sum += x;
+
+                    mean_ = sum / n;
+
+                    for (double x : xv) {
+                        long double d = x - mean_;
+
+                        m2_ += d * d;
+                        m3_ += d * d * d;
+                        m4_ += d * d * d * d;
+                    }
+                }
+
+                long double mean_ = 0.0;
+                long double m2_ = 0.0;
+                long double m3_ = 0.0;
+                long double m4_ = 0.0;
+            };
+
+            bool
+            near(double x, double y, double rtol, double scale)
+            {
+                return std::abs(x - y) <= rtol * std::max(std::abs(scale), 1.0);
+            } /*near*/
+
+            void
+            require_same(Accumulator const & x, Accumulator const & y)
+            {
+                REQUIRE(x.n_sample() == y.n_sample());
+
+                if (x.n_sample() == 0)
+                    return;
+
+                REQUIRE(near(x.mean(), y.mean(), 1e-12, y.mean()));
+                REQUIRE(near(x.moment2(), y.moment2(), 1e-9, y.moment2()));
+                REQUIRE(near(x.moment3(), y.moment3(), 1e-7, y.moment2()));
+                REQUIRE(near(x.moment4(), y.moment4(), 1e-7, y.moment4()));
+            } /*require_same*/
+
+            /* split points to try for an n-element sample */
+            std::vector<std::size_t>
+            split_points(std::size_t n)
+            {
+                return {0, 1, n / 3, n / 2, n - 1, n};
+            } /*split_points*/
+        } /*namespace*/
+
+        TEST_CASE("accumulator-single-pass", "[statistics][accumulator]") {
+            std::vector<double> xv = make_samples(10007, 1);
+
+            RefMoments ref(xv);
+
+            Accumulator acc_bulk = Accumulator::from_samples(xv);
+
+            Accumulator acc_one;
+            for (double x : xv)
+                acc_one.include_sample(x);
+
+            for (Accumulator const * acc : {&acc_bulk, &acc_one}) {
+                REQUIRE(acc->n_sample() == xv.size());
+                REQUIRE(near(acc->mean(), ref.mean_, 1e-12, ref.mean_));
+                REQUIRE(near(acc->moment2(), ref.m2_, 1e-9, ref.m2_));
+                REQUIRE(near(acc->moment3(), ref.m3_, 1e-7, ref.m2_));
+                REQUIRE(near(acc->moment4(), ref.m4_, 1e-7, ref.m4_));
+            }
+
+            require_same(acc_one, acc_bulk);
+        } /*TEST_CASE(accumulator-single-pass)*/
+
+        TEST_CASE("accumulator-merge", "[statistics][accumulator]") {
+            std::vector<double> xv = make_samples(5003, 2);
+
+            Accumulator whole = Accumulator::from_samples(xv);
+
+            for (std::size_t k : split_points(xv.size())) {
+                INFO("k=" << k);
+
+                std::span<double const> lo(xv.data(), k);
+                std::span<double const> hi(xv.data() + k, xv.size() - k);
+
+                /* merge(a,b) and merge(b,a) both match single pass over a+b */
+                Accumulator a = Accumulator::from_samples(lo);
+                Accumulator b = Accumulator::from_samples(hi);
+
+                Accumulator ab = a;
+                ab.merge(b);
+
+                Accumulator ba = b;
+                ba.merge(a);
+
+                require_same(ab, whole);
+                require_same(ba, whole);
+            }
+
+            /* both sides empty */
+            Accumulator e1;
+            Accumulator e2;
+
+            e1.merge(e2);
+
+            REQUIRE(e1.n_sample() == 0);
+        } /*TEST_CASE(accumulator-merge)*/
+
+        TEST_CASE("sample-statistics-merge", "[statistics][samplestatistics]") {
+            std::vector<double> xv = make_samples(5003, 3);
+
+            SampleStatistics whole;
+            for (double x : xv)
+                whole.include_sample(x);
+
+            RefMoments ref(xv);
+
+            REQUIRE(near(whole.mean(), ref.mean_, 1e-12, ref.mean_));
+            REQUIRE(near(whole.variance(), ref.m2_ / xv.size(), 1e-9, ref.m2_ / xv.size()));
+
+            for (std::size_t k : split_points(xv.size())) {
+                INFO("k=" << k);
+
+                SampleStatistics a;
+                SampleStatistics b;
+
+                /* one side per-sample,  other side bulk */
+                for (std::size_t i = 0; i < k; ++i)
+                    a.include_sample(xv[i]);
+                b.include_samples(std::span<double const>(xv.data() + k, xv.size() - k));
+
+                SampleStatistics ab = a;
+                ab.merge(b);
+
+                SampleStatistics ba = b;
+                ba.merge(a);
+
+                for (SampleStatistics const * s : {&ab, &ba}) {
+                    REQUIRE(s->n_sample() == whole.n_sample());
+                    REQUIRE(near(s->mean(), whole.mean(), 1e-12, whole.mean()));
+                    REQUIRE(near(s->sample_variance(), whole.sample_variance(), 1e-9, whole.sample_variance()));
+                }
+            }
+
+            SampleStatistics e1;
+            SampleStatistics e2;
+
+            e1.merge(e2);
+
+            REQUIRE(e1.n_sample() == 0);
+            REQUIRE(e1.mean() == 0.0);
+        } /*TEST_CASE(sample-statistics-merge)*/
+    } /*namespace ut*/
+} /*namespace xo*/
+
+/* end Accumulator.test.cpp */
@@ -0,0 +1,91 @@
+/* @file Histogram.test.cpp */
+
+#include "xo/statistics/Histogram.hpp"
+#include <catch2/catch.hpp>
+#include <cmath>
+#include <random>
+#include <vector>
+
+namespace xo {
+    using xo::statistics::Bucket;
+    using xo::statistics::Histogram;
+
+    namespace ut {
+        namespace {
+            std::vector<double>
+            make_samples(std::size_t n, std::uint64_t seed)
+            {
+                std::mt19937_64 eng(seed);
+                std::normal_distribution<double> dist(5.0, 3.0);
+
+                std::vector<double> retval(n);
+                for (double & x : retval)
+                    x = dist(eng);
+
+                return retval;
+            } /*make_samples*/
+
+            void
+            require_same(Histogram const & x, Histogram const & y)
+            {
+                REQUIRE(x.n_sample() == y.n_sample());
+                REQUIRE(x.n_bucket() == y.n_bucket());
+
+                for (std::uint32_t i = 0; i < x.n_bucket(); ++i) {
+                    INFO("i=" << i);
+
+                    Bucket const & bx = x.lookup(i);
+                    Bucket const & by = y.lookup(i);
+
+                    REQUIRE(bx.n_sample() == by.n_sample());
+                    REQUIRE(bx.sum() == Approx(by.sum()).epsilon(1e-12).margin(1e-12));
+                    REQUIRE(bx.mean() == Approx(by.mean()).epsilon(1e-12).margin(1e-12));
+                    REQUIRE(bx.sample_variance() == Approx(by.sample_variance()).epsilon(1e-9).margin(1e-12));
+                }
+            } /*require_same*/
+        } /*namespace*/
+
+        TEST_CASE("histogram-merge", "[statistics][histogram]") {
+            std::vector<double> xv = make_samples(4001, 11);
+
+            Histogram whole(20, 0.0, 10.0);
+            whole.include_samples(xv);
+
+            REQUIRE(whole.n_sample() == xv.size());
+
+            /* samples land in both tails as well as interior */
+            REQUIRE(whole.lookup(0).n_sample() > 0);
+            REQUIRE(whole.lookup(whole.n_bucket() - 1).n_sample() > 0);
+
+            for (std::size_t k : {std::size_t{0}, std::size_t{1}, xv.size() / 2, xv.size() - 1, xv.size()}) {
+                INFO("k=" << k);
+
+                Histogram a(20, 0.0, 10.0);
+                Histogram b(20, 0.0, 10.0);
+
+                for (std::size_t i = 0; i < k; ++i)
+                    a.include_sample(xv[i]);
+                for (std::size_t i = k; i < xv.size(); ++i)
+                    b.include_sample(xv[i]);
+
+                Histogram ab = a;
+                ab.merge(b);
+
+                Histogram ba = b;
+                ba.merge(a);
+
+                require_same(ab, whole);
+                require_same(ba, whole);
+            }
+        } /*TEST_CASE(histogram-merge)*/
+
+        TEST_CASE("histogram-merge-layout", "[statistics][histogram]") {
+            Histogram a(20, 0.0, 10.0);
+
+            REQUIRE_THROWS_AS(a.merge(Histogram(10, 0.0, 10.0)), std::runtime_error);
+            REQUIRE_THROWS_AS(a.merge(Histogram(20, 0.0, 11.0)), std::runtime_error);
+        } /*TEST_CASE(histogram-merge-layout)*/
+    } /*namespace ut*/
+} /*namespace xo*/
+
+/* end Histogram.test.cpp */
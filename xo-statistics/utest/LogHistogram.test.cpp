@@ -0,0 +1,223 @@
+/* @file LogHistogram.test.cpp */
+
+#include "xo/statistics/LogHistogram.hpp"
+#include <catch2/catch.hpp>
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <random>
+#include <tuple>
+#include <vector>
+
+namespace xo {
+    using xo::statistics::LogHistogram;
+
+    namespace ut {
+        namespace {
+            std::vector<double>
+            make_samples(std::size_t n, std::uint64_t seed)
+            {
+                std::mt19937_64 eng(seed);
+                std::lognormal_distribution<double> dist(0.0, 1.5);
+
+                std::vector<double> retval(n);
+                for (double & x : retval)
+                    x = dist(eng);
+
+                return retval;
+            } /*make_samples*/
+        } /*namespace*/
+
+        TEST_CASE("loghistogram-edges", "[statistics][loghistogram]") {
+            /* lo deliberately not a power of 2,  for most cases */
+            for (auto [lo, hi, bits] : {std::make_tuple(0.3, 1000.0, 4u),
+                                        std::make_tuple(1.0, 1024.0, 7u),
+                                        std::make_tuple(1e-6, 1.0, 5u),
+                                        std::make_tuple(0.1, 0.7, 0u),
+                                        std::make_tuple(3.7, 1e6, 10u)})
+            {
+                LogHistogram h(lo, hi, bits);
+
+                INFO("lo=" << lo << " hi=" << h.hi() << " bits=" << bits);
+
+                uint32_t n_log = h.n_bucket() - 2;
+
+                REQUIRE(h.bucket_lo_edge(1) == lo);
+                REQUIRE(h.bucket_hi_edge(n_log) == h.hi());
+
+                for (uint32_t ix = 1; ix <= n_log; ++ix) {
+                    INFO("ix=" << ix);
+
+                    double lo_edge = h.bucket_lo_edge(ix);
+                    double hi_edge = h.bucket_hi_edge(ix);
+
+                    REQUIRE(lo_edge < hi_edge);
+
+                    /* left edge belongs to its bucket,  value just below it doesn't */
+                    REQUIRE(h.bucket_ix(lo_edge) == ix);
+                    REQUIRE(h.bucket_ix(std::nextafter(lo_edge, 0.0)) == ix - 1);
+                    /* value just below right edge belongs to bucket */
+                    REQUIRE(h.bucket_ix(std::nextafter(hi_edge, 0.0)) == ix);
+                    /* as does midpoint */
+                    REQUIRE(h.bucket_ix(0.5 * (lo_edge + hi_edge)) == ix);
+
+                    /* bucket width is within relative error bound */
+                    REQUIRE(hi_edge - lo_edge <= h.relative_error() * lo_edge * (1.0 + 1e-12));
+                }
+
+                REQUIRE(h.bucket_ix(h.hi()) == n_log + 1);
+            }
+
+            /* octave boundary,  lo not a power of 2 */
+            LogHistogram h(0.3, 1000.0, 4);
+
+            REQUIRE(h.bucket_ix(h.bucket_lo_edge(16)) == 16);
+            REQUIRE(h.bucket_ix(h.bucket_lo_edge(17)) == 17);
+        } /*TEST_CASE(loghistogram-edges)*/
+
+        TEST_CASE("loghistogram-out-of-range", "[statistics][loghistogram]") {
+            LogHistogram h(1.0, 100.0, 3);
+
+            uint32_t n_log = h.n_bucket() - 2;
+            double nan = std::numeric_limits<double>::quiet_NaN();
+            double inf = std::numeric_limits<double>::infinity();
+
+            REQUIRE(h.bucket_ix(0.999) == 0);
+            REQUIRE(h.bucket_ix(0.0) == 0);
+            REQUIRE(h.bucket_ix(-5.0) == 0);
+            REQUIRE(h.bucket_ix(-inf) == 0);
+            REQUIRE(h.bucket_ix(nan) == 0);
+            REQUIRE(h.bucket_ix(h.hi()) == n_log + 1);
+            REQUIRE(h.bucket_ix(1e300) == n_log + 1);
+            REQUIRE(h.bucket_ix(inf) == n_log + 1);
+
+            std::vector<double> xv = {0.5, -1.0, 2.0, 3.0, 500.0, 1e9};
+
+            LogHistogram h1(1.0, 100.0, 3);
+            for (double x : xv)
+                h1.include_sample(x);
+
+            LogHistogram h2(1.0, 100.0, 3);
+            h2.include_samples(xv);
+
+            for (LogHistogram const * p : {&h1, &h2}) {
+                REQUIRE(p->n_sample() == xv.size());
+                REQUIRE(p->count(0) == 2);
+                REQUIRE(p->count(n_log + 1) == 2);
+                REQUIRE(p->min_value() == -1.0);
+                REQUIRE(p->max_value() == 1e9);
+
+                /* under/overflow quantiles report exact extremes */
+                REQUIRE(p->quantile(0.0) == -1.0);
+                REQUIRE(p->quantile(1.0) == 1e9);
+
+                REQUIRE(p->cdf(-2.0) == 0.0);
+                REQUIRE(p->cdf(1e9) == 1.0);
+            }
+
+            REQUIRE_THROWS_AS(LogHistogram(0.0, 1.0), std::runtime_error);
+            REQUIRE_THROWS_AS(LogHistogram(2.0, 1.0), std::runtime_error);
+            REQUIRE_THROWS_AS(LogHistogram(1.0, inf), std::runtime_error);
+            REQUIRE_THROWS_AS(LogHistogram(1.0, 2.0, 21), std::runtime_error);
+            REQUIRE_THROWS_AS(LogHistogram(1.0, 2.0).quantile(0.5), std::runtime_error);
+        } /*TEST_CASE(loghistogram-out-of-range)*/
+
+        TEST_CASE("loghistogram-nan", "[statistics][loghistogram]") {
+            double nan = std::numeric_limits<double>::quiet_NaN();
+
+            std::vector<double> xv = {0.5, 2.0, nan, 3.0, 500.0, nan};
+
+            LogHistogram h1(1.0, 100.0, 3);
+            for (double x : xv)
+                h1.include_sample(x);
+
+            LogHistogram h2(1.0, 100.0, 3);
+            h2.include_samples(xv);
+
+            LogHistogram h3(1.0, 100.0, 3);
+            h3.merge(h1);
+
+            /* NaN counted separately;  buckets, moments and min/max see only the rest */
+            for (LogHistogram const * p : {&h1, &h2, &h3}) {
+                REQUIRE(p->n_nan() == 2);
+                REQUIRE(p->n_sample() == 4);
+                REQUIRE(p->count(0) == 1);
+                REQUIRE(p->count(p->n_bucket() - 1) == 1);
+                REQUIRE(p->mean() == Approx((0.5 + 2.0 + 3.0 + 500.0) / 4));
+                REQUIRE(p->min_value() == 0.5);
+                REQUIRE(p->max_value() == 500.0);
+                REQUIRE(p->quantile(1.0) == 500.0);
+            }
+
+            /* bucket_ix() doesn't attempt index arithmetic on NaN */
+            REQUIRE(h1.bucket_ix(nan) == 0);
+            REQUIRE(h1.bucket_ix(-nan) == 0);
+        } /*TEST_CASE(loghistogram-nan)*/
+
+        TEST_CASE("loghistogram-quantile", "[statistics][loghistogram]") {
+            std::vector<double> xv = make_samples(100000, 21);
+
+            for (uint32_t bits : {3u, 7u}) {
+                /* wide enough that every sample is in range */
+                LogHistogram h(0.3e-4, 1e5, bits);
+
+                h.include_samples(xv);
+
+                REQUIRE(h.count(0) == 0);
+                REQUIRE(h.count(h.n_bucket() - 1) == 0);
+
+                std::vector<double> sorted_v = xv;
+                std::sort(sorted_v.begin(), sorted_v.end());
+
+                for (double q : {0.0, 0.001, 0.01, 0.1, 0.25, 0.5, 0.75, 0.9, 0.99, 0.999, 1.0}) {
+                    INFO("bits=" << bits << " q=" << q);
+
+                    std::size_t rank = std::max<std::size_t>(1, std::ceil(q * xv.size()));
+                    double exact = sorted_v[rank - 1];
+                    double approx = h.quantile(q);
+
+                    REQUIRE(std::abs(approx - exact) <= h.relative_error() * exact);
+                }
+            }
+        } /*TEST_CASE(loghistogram-quantile)*/
+
+        TEST_CASE("loghistogram-merge", "[statistics][loghistogram]") {
+            std::vector<double> xv = make_samples(20000, 31);
+
+            LogHistogram whole(0.01, 100.0, 5);
+            whole.include_samples(xv);
+
+            /* some samples out of range on both sides */
+            REQUIRE(whole.count(0) > 0);
+            REQUIRE(whole.count(whole.n_bucket() - 1) > 0);
+
+            for (std::size_t k : {std::size_t{0}, std::size_t{1}, xv.size() / 3, xv.size()}) {
+                INFO("k=" << k);
+
+                LogHistogram a(0.01, 100.0, 5);
+                LogHistogram b(0.01, 100.0, 5);
+
+                a.include_samples(std::span<double const>(xv.data(), k));
+                for (std::size_t i = k; i < xv.size(); ++i)
+                    b.include_sample(xv[i]);
+
+                LogHistogram ab = a;
+                ab.merge(b);
+
+                REQUIRE(ab.n_sample() == whole.n_sample());
+                REQUIRE(ab.min_value() == whole.min_value());
+                REQUIRE(ab.max_value() == whole.max_value());
+                REQUIRE(ab.mean() == Approx(whole.mean()).epsilon(1e-12));
+
+                for (uint32_t i = 0; i < whole.n_bucket(); ++i)
+                    REQUIRE(ab.count(i) == whole.count(i));
+            }
+
+            LogHistogram other(0.01, 100.0, 6);
+
+            REQUIRE_THROWS_AS(whole.merge(other), std::runtime_error);
+        } /*TEST_CASE(loghistogram-merge)*/
+    } /*namespace ut*/
+} /*namespace xo*/
+
+/* end LogHistogram.test.cpp */
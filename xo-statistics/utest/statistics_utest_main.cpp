@@ -0,0 +1,6 @@
+/* file statistics_utest_main.cpp */
+
+#define CATCH_CONFIG_MAIN
+#include "catch2/catch.hpp"
+
+/* end statistics_utest_main.cpp */
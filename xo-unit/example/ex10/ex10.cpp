@@ -0,0 +1,126 @@
+/** @file ex10.cpp
+ *
+ *  benchmark: xquantity cross-unit arithmetic,
+ *    conversion factor computed from scratch (walk bpus of both units)
+ *  vs.
+ *    conversion factor from detail::conversion_cache
+ *
+ *  use:
+ *    $ xo_unit_ex10 [n]
+ **/
+
+#include "xo/unit/xquantity.hpp"
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <limits>
+#include <vector>
+
+namespace {
+    using xo::qty::xquantity;
+
+    /* keep compiler from hoisting/eliding benchmark loop body */
+    void
+    clobber(void const * p)
+    {
+        asm volatile("" : : "r"(p) : "memory");
+    }
+
+    template <typename Fn>
+    double
+    time_sec(Fn && fn, int n_rep)
+    {
+        auto t0 = std::chrono::steady_clock::now();
+        for (int i = 0; i < n_rep; ++i)
+            fn();
+        auto t1 = std::chrono::steady_clock::now();
+
+        return std::chrono::duration<double>(t1 - t0).count() / n_rep;
+    }
+
+    void
+    report(char const * label, std::size_t n, double dt_sec, double check)
+    {
+        std::cout << label << ": " << (n / dt_sec) * 1e-6 << " M ops/sec"
+                  << "  (check=" << check << ")" << std::endl;
+    }
+
+    /* x + y,  computing conversion factor without cache
+     * (same as xquantity::add before conversion_cache)
+     */
+    xquantity<double>
+    add_uncached(const xquantity<double> & x, const xquantity<double> & y)
+    {
+        using namespace xo::qty;
+
+        auto cf = detail::nu_conversion_factor_uncached<double,
+                                                        std::int64_t,
+                                                        detail::width2x_t<std::int64_t>>(y.unit(), x.unit());
+
+        if (cf.convertible_)
+            return xquantity<double>(x.scale() + cf.factor_ * y.scale(), x.unit());
+        else
+            return xquantity<double>(std::numeric_limits<double>::quiet_NaN(), x.unit());
+    }
+
+    /* z[i] = x[i] + y[i] */
+    template <typename Add>
+    void
+    bench(char const * label,
+          std::vector<xquantity<double>> const & x_v,
+          std::vector<xquantity<double>> const & y_v,
+          int n_rep,
+          Add && add)
+    {
+        std::size_t n = x_v.size();
+        std::vector<xquantity<double>> z(n);
+
+        double dt = time_sec([&]() {
+            for (std::size_t i = 0; i < n; ++i)
+                z[i] = add(x_v[i], y_v[i]);
+            clobber(z.data());
+        }, n_rep);
+
+        report(label, n, dt, z[n-1].scale());
+    }
+}
+
+int
+main (int argc, char ** argv) {
+    using namespace xo::qty;
+    namespace u = xo::qty::u;
+
+    std::size_t n = 100000;
+    int n_rep = 20;
+
+    if (argc > 1)
+        n = std::strtoull(argv[1], nullptr, 10);
+
+    /* basis units:  km + m (compile-time table) */
+    std::vector<xquantity<double>> km_v;
+    std::vector<xquantity<double>> m_v;
+    /* compound units:  km/hr + m/s (per-thread cache) */
+    std::vector<xquantity<double>> kph_v;
+    std::vector<xquantity<double>> mps_v;
+
+    for (std::size_t i = 0; i < n; ++i) {
+        double x = 1.0 + (i % 1000);
+
+        km_v.push_back(xquantity(x, u::kilometer));
+        m_v.push_back(xquantity(0.5 * x, u::meter));
+        kph_v.push_back(xquantity(x, u::kilometer / u::hour));
+        mps_v.push_back(xquantity(0.5 * x, u::meter / u::second));
+    }
+
+    auto add_cached = [](const xquantity<double> & x, const xquantity<double> & y) { return x + y; };
+
+    bench("uncached  km + m     ", km_v, m_v, n_rep, add_uncached);
+    bench("cached    km + m     ", km_v, m_v, n_rep, add_cached);
+    bench("uncached  km/hr + m/s", kph_v, mps_v, n_rep, add_uncached);
+    bench("cached    km/hr + m/s", kph_v, mps_v, n_rep, add_cached);
+    bench("same unit m + m      ", m_v, m_v, n_rep, add_cached);
+
+    return 0;
+}
+
+/** end ex10.cpp **/
@@ -0,0 +1,130 @@
+/** @file ex9.cpp
+ *
+ *  benchmark: bulk unit conversion + element-wise arithmetic,
+ *    std::vector<quantity<..>> (one element at a time)
+ *  vs.
+ *    quantity_array<..>        (one scalefactor,  vectorized loop)
+ *
+ *  use:
+ *    $ xo_unit_ex9 [n]
+ **/
+
+#include "xo/unit/quantity_array.hpp"
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <vector>
+
+namespace {
+    /* keep compiler from hoisting/eliding benchmark loop body */
+    void
+    clobber(void const * p)
+    {
+        asm volatile("" : : "r"(p) : "memory");
+    }
+
+    template <typename Fn>
+    double
+    time_sec(Fn && fn, int n_rep)
+    {
+        auto t0 = std::chrono::steady_clock::now();
+        for (int i = 0; i < n_rep; ++i)
+            fn();
+        auto t1 = std::chrono::steady_clock::now();
+
+        return std::chrono::duration<double>(t1 - t0).count() / n_rep;
+    }
+
+    void
+    report(char const * label, std::size_t n, double dt_sec, double check)
+    {
+        std::cout << label << ": " << (n / dt_sec) * 1e-6 << " M elements/sec"
+                  << "  (check=" << check << ")" << std::endl;
+    }
+}
+
+int
+main (int argc, char ** argv) {
+    using namespace xo::qty;
+    namespace u = xo::qty::u;
+
+    std::size_t n = 1000000;
+    int n_rep = 50;
+
+    if (argc > 1)
+        n = std::strtoull(argv[1], nullptr, 10);
+
+    /* durations in milliseconds,  distances in millimeters */
+    std::vector<quantity<u::millisecond>> t_v(n);
+    std::vector<quantity<u::millimeter>> d_v(n);
+    quantity_array<u::millisecond> t_a(n);
+    quantity_array<u::millimeter> d_a(n);
+
+    for (std::size_t i = 0; i < n; ++i) {
+        double t = 1.0 + (i % 1000);
+        double d = 0.5 * (i % 777);
+
+        t_v[i] = qty::milliseconds(t);
+        d_v[i] = qty::millimeters(d);
+        t_a.scales()[i] = t;
+        d_a.scales()[i] = d;
+    }
+
+    /* ms -> s */
+    /* both versions allocate their result */
+    {
+        std::vector<quantity<u::second>> z;
+
+        double dt = time_sec([&]() {
+            z = std::vector<quantity<u::second>>(n);
+            for (std::size_t i = 0; i < n; ++i)
+                z[i] = t_v[i].rescale_ext<u::second>();
+            clobber(z.data());
+        }, n_rep);
+
+        report("vector<quantity>  ms->s ", n, dt, z[n-1].scale());
+    }
+
+    {
+        quantity_array<u::second> z;
+
+        double dt = time_sec([&]() {
+            z = t_a.rescale_ext<u::second>();
+            clobber(z.data());
+        }, n_rep);
+
+        report("quantity_array    ms->s ", n, dt, z.scales()[n-1]);
+    }
+
+    /* mm/ms -> m/s */
+    {
+        using speed_type = quantity<(u::meter / u::second)>;
+
+        std::vector<speed_type> z;
+
+        double dt = time_sec([&]() {
+            z = std::vector<speed_type>(n);
+            for (std::size_t i = 0; i < n; ++i)
+                z[i] = (d_v[i].rescale_ext<u::meter>() / t_v[i].rescale_ext<u::second>());
+            clobber(z.data());
+        }, n_rep);
+
+        report("vector<quantity>  m/s   ", n, dt, z[n-1].scale());
+    }
+
+    {
+        quantity_array<(u::meter / u::second)> z;
+
+        double dt = time_sec([&]() {
+            /* mm/ms computed directly,  then one conversion pass */
+            z = (d_a / t_a).rescale_ext<(u::meter / u::second)>();
+            clobber(z.data());
+        }, n_rep);
+
+        report("quantity_array    m/s   ", n, dt, z.scales()[n-1]);
+    }
+
+    return 0;
+}
+
+/** end ex9.cpp **/
@@ -0,0 +1,357 @@
+/** @file conversion_cache.hpp
+ *
+ *  Author: Roland Conybeare
+ **/
+
+#pragma once
+
+#include "scaled_unit.hpp"
+#include <array>
+#include <cmath>
+#include <cstdint>
+#include <type_traits>
+#include <utility>
+
+namespace xo {
+    namespace qty {
+        namespace detail {
+            /** @defgroup conversion-cache-hash natural unit hashing **/
+            ///@{
+
+            /** splitmix64 finalizer **/
+            constexpr std::uint64_t
+            hash_mix(std::uint64_t x) {
+                x ^= (x >> 30);
+                x *= 0xbf58476d1ce4e5b9ull;
+                x ^= (x >> 27);
+                x *= 0x94d049bb133111ebull;
+                x ^= (x >> 31);
+                return x;
+            }
+
+            /** hash for basis-power-unit @p x.
+             *
+             *  Uses scalefactor and power ratios as stored (does not normalize).
+             *  Consequently equal-but-unnormalized bpus may hash differently;
+             *  @ref conversion_cache tolerates this (costs a cache miss).
+             **/
+            template <typename Int>
+            constexpr std::uint64_t
+            bpu_hash(const bpu<Int> & x) {
+                std::uint64_t h = hash_mix(static_cast<std::uint64_t>(x.native_dim()) + 1);
+                h = hash_mix(h ^ static_cast<std::uint64_t>(x.scalefactor().num()));
+                h = hash_mix(h ^ static_cast<std::uint64_t>(x.scalefactor().den()));
+                h = hash_mix(h ^ static_cast<std::uint64_t>(x.power().num()));
+                h = hash_mix(h ^ static_cast<std::uint64_t>(x.power().den()));
+                return h;
+            }
+
+            /** hash for natural unit @p x.
+             *  Independent of bpu order,  consistent with natural_unit equality
+             **/
+            template <typename Int>
+            constexpr std::uint64_t
+            nu_hash(const natural_unit<Int> & x) {
+                std::uint64_t h = 0;
+                for (std::size_t i = 0, n = x.n_bpu(); i < n; ++i)
+                    h += bpu_hash(x[i]);
+                return h;
+            }
+
+            /** hash for ordered pair (@p from, @p to) of natural units **/
+            template <typename Int>
+            constexpr std::uint64_t
+            nu_pair_hash(const natural_unit<Int> & from,
+                         const natural_unit<Int> & to) {
+                return hash_mix(nu_hash(from) + hash_mix(nu_hash(to) ^ 0x9e3779b97f4a7c15ull));
+            }
+
+            ///@}
+
+            /** @class conversion_factor
+             *  @brief dimensionless multiplier converting amounts in one natural unit to another
+             **/
+            template <typename Factor>
+            struct conversion_factor {
+                /** true iff source and destination units have the same dimension **/
+                bool convertible_ = false;
+                /** amount in source unit * factor = amount in destination unit.
+                 *  Meaningful only when @ref convertible_ is true
+                 **/
+                Factor factor_ = Factor{};
+            };
+
+            /** multiplier type produced when converting a @p Repr-valued amount;
+             *  matches @c (::sqrt(outer_scale_sq) * outer_scale_factor.convert_to<Repr>())
+             **/
+            template <typename Repr>
+            using conversion_factor_t = decltype(std::declval<double>() * std::declval<Repr>());
+
+            /** compute factor converting amounts in natural unit @p from to natural unit @p to,
+             *  by walking bpus of both units (see @ref su_ratio).
+             *
+             *  Constexpr (with c++23) when conversion does not involve fractional powers.
+             **/
+            template <typename Repr, typename Int, typename Int2x>
+            constexpr conversion_factor<conversion_factor_t<Repr>>
+            nu_conversion_factor_uncached(const natural_unit<Int> & from,
+                                          const natural_unit<Int> & to)
+            {
+                auto rr = detail::su_ratio<Int, Int2x>(from, to);
+
+                if (rr.natural_unit_.is_dimensionless()) {
+                    /* NOTE: test for unit .outer_scale_sq to get constexpr result with c++23 */
+                    return conversion_factor<conversion_factor_t<Repr>>
+                        { true,
+                          (((rr.outer_scale_sq_ == 1.0) ? 1.0 : ::sqrt(rr.outer_scale_sq_))
+                           * rr.outer_scale_factor_.template convert_to<Repr>()) };
+                } else {
+                    return conversion_factor<conversion_factor_t<Repr>>{};
+                }
+            }
+
+            /** @defgroup conversion-cache-seed conversion_cache compile-time table **/
+            ///@{
+
+            /** basis units with entries in compile-time conversion table.
+             *
+             *  Omits extreme units (e.g. picogram,  lightsecond) since some of their
+             *  pairwise scalefactor ratios don't fit in @c scalefactor_ratio_type
+             **/
+            template <typename Int>
+            inline constexpr std::array<natural_unit<Int>, 28> conversion_seed_unit_v = {
+                nu::microgram.template to_repr<Int>(),
+                nu::milligram.template to_repr<Int>(),
+                nu::gram.template to_repr<Int>(),
+                nu::kilogram.template to_repr<Int>(),
+                nu::tonne.template to_repr<Int>(),
+
+                nu::micrometer.template to_repr<Int>(),
+                nu::millimeter.template to_repr<Int>(),
+                nu::meter.template to_repr<Int>(),
+                nu::kilometer.template to_repr<Int>(),
+                nu::inch.template to_repr<Int>(),
+                nu::foot.template to_repr<Int>(),
+                nu::yard.template to_repr<Int>(),
+                nu::mile.template to_repr<Int>(),
+
+                nu::nanosecond.template to_repr<Int>(),
+                nu::microsecond.template to_repr<Int>(),
+                nu::millisecond.template to_repr<Int>(),
+                nu::second.template to_repr<Int>(),
+                nu::minute.template to_repr<Int>(),
+                nu::hour.template to_repr<Int>(),
+                nu::day.template to_repr<Int>(),
+                nu::week.template to_repr<Int>(),
+                nu::month.template to_repr<Int>(),
+                nu::year.template to_repr<Int>(),
+                nu::year250.template to_repr<Int>(),
+                nu::year360.template to_repr<Int>(),
+                nu::year365.template to_repr<Int>(),
+
+                nu::currency.template to_repr<Int>(),
+                nu::price.template to_repr<Int>(),
+            };
+
+            /** sentinel unit index for empty seed slot **/
+            inline constexpr std::uint16_t c_conversion_no_unit = 0xffff;
+
+            /** #of slots in compile-time table;  power of 2,  load factor <= 1/2 **/
+            inline constexpr std::size_t c_conversion_seed_slots = 1024;
+
+            /** compile-time table entry;
+             *  refers to units by index into @ref conversion_seed_unit_v
+             **/
+            template <typename Factor>
+            struct conversion_seed_entry {
+                std::uint64_t hash_ = 0;
+                std::uint16_t from_ix_ = c_conversion_no_unit;
+                std::uint16_t to_ix_ = c_conversion_no_unit;
+                Factor factor_ = Factor{};
+            };
+
+            /** build open-addressed table (linear probing) with conversion factors for
+             *  every ordered pair of distinct same-dimension units in @ref conversion_seed_unit_v
+             **/
+            template <typename Repr, typename Int, typename Int2x>
+            constexpr auto
+            make_conversion_seed_table()
+            {
+                using entry_type = conversion_seed_entry<conversion_factor_t<Repr>>;
+
+                constexpr std::size_t mask = c_conversion_seed_slots - 1;
+                const auto & unit_v = conversion_seed_unit_v<Int>;
+
+                std::array<entry_type, c_conversion_seed_slots> retval{};
+                std::size_t n_entry = 0;
+
+                for (std::size_t i = 0; i < unit_v.size(); ++i) {
+                    for (std::size_t j = 0; j < unit_v.size(); ++j) {
+                        if ((i == j) || (unit_v[i][0].native_dim() != unit_v[j][0].native_dim()))
+                            continue;
+
+                        auto conv = nu_conversion_factor_uncached<Repr, Int, Int2x>(unit_v[i], unit_v[j]);
+
+                        std::uint64_t h = nu_pair_hash(unit_v[i], unit_v[j]);
+                        std::size_t slot = h & mask;
+
+                        while (retval[slot].from_ix_ != c_conversion_no_unit)
+                            slot = (slot + 1) & mask;
+
+                        retval[slot] = entry_type{h,
+                                                  static_cast<std::uint16_t>(i),
+                                                  static_cast<std::uint16_t>(j),
+                                                  conv.factor_};
+                        ++n_entry;
+                    }
+                }
+
+                /* keep probe sequences short.  not a constant expression if violated */
+                if (2 * n_entry > c_conversion_seed_slots)
+                    throw "make_conversion_seed_table: table overfull";
+
+                return retval;
+            }
+
+            /** compile-time conversion table,  indexed by (hash & (c_conversion_seed_slots - 1)) **/
+            template <typename Repr, typename Int, typename Int2x>
+            inline constexpr auto conversion_seed_table = make_conversion_seed_table<Repr, Int, Int2x>();
+
+            /** find entry for (@p from, @p to) with pair hash @p h in compile-time table.
+             *  nullptr if not present
+             **/
+            template <typename Repr, typename Int, typename Int2x>
+            constexpr const conversion_seed_entry<conversion_factor_t<Repr>> *
+            conversion_seed_find(const natural_unit<Int> & from,
+                                 const natural_unit<Int> & to,
+                                 std::uint64_t h)
+            {
+                constexpr std::size_t mask = c_conversion_seed_slots - 1;
+                const auto & table = conversion_seed_table<Repr, Int, Int2x>;
+                const auto & unit_v = conversion_seed_unit_v<Int>;
+
+                for (std::size_t slot = h & mask; ; slot = (slot + 1) & mask) {
+                    const auto & e = table[slot];
+
+                    if (e.from_ix_ == c_conversion_no_unit)
+                        return nullptr;
+
+                    if ((e.hash_ == h)
+                        && (unit_v[e.from_ix_] == from)
+                        && (unit_v[e.to_ix_] == to))
+                    {
+                        return &e;
+                    }
+                }
+            }
+
+            ///@}
+
+            /** @class conversion_cache
+             *  @brief memoize conversion factors between natural units
+             *
+             *  Conversion factor between two natural units (e.g. km -> m) is
+             *  a pure function of the pair of units,  but computing it with
+             *  @ref su_ratio walks both units' bpu arrays and does double-width
+             *  rational arithmetic.  @ref xquantity must do this at runtime
+             *  on every cross-unit add/subtract/rescale.
+             *
+             *  Lookup proceeds in two steps:
+             *  1. compile-time table (@ref conversion_seed_table):
+             *     open-addressed,  keyed on hash of (from, to),
+             *     with an entry for every same-dimension pair of common basis units
+             *     (e.g. every pair of time units from nanosecond to year).
+             *     Read-only,  so shared across threads without synchronization.
+             *  2. per-thread direct-mapped cache for everything else
+             *     (compound units,  fractional powers).
+             *     A miss computes with @ref nu_conversion_factor_uncached
+             *     and overwrites the slot.
+             *
+             *  Cached results are identical to uncached ones.
+             **/
+            template <typename Repr, typename Int, typename Int2x>
+            class conversion_cache {
+            public:
+                /** @defgroup conversion-cache-types conversion_cache type traits **/
+                ///@{
+                using factor_type = conversion_factor_t<Repr>;
+                using result_type = conversion_factor<factor_type>;
+                using unit_type = natural_unit<Int>;
+                ///@}
+
+            public:
+                /** @defgroup conversion-cache-methods conversion_cache methods **/
+                ///@{
+                /** factor converting amounts in unit @p from to unit @p to **/
+                static result_type lookup(const unit_type & from,
+                                          const unit_type & to)
+                {
+                    if (from == to)
+                        return result_type{true, 1.0 * static_cast<Repr>(1)};
+
+                    std::uint64_t h = nu_pair_hash(from, to);
+
+                    /* 1. compile-time entries for common units */
+                    if (auto * seed = conversion_seed_find<Repr, Int, Int2x>(from, to, h))
+                        return result_type{true, seed->factor_};
+
+                    /* 2. per-thread cache */
+                    cache_entry & e = slot_v()[h & (c_cache_slots - 1)];
+
+                    if (!e.valid_ || (e.hash_ != h) || (e.from_ != from) || (e.to_ != to)) {
+                        e.hash_ = h;
+                        e.valid_ = true;
+                        e.from_ = from;
+                        e.to_ = to;
+                        e.conv_ = nu_conversion_factor_uncached<Repr, Int, Int2x>(from, to);
+                    }
+
+                    return e.conv_;
+                }
+
+                /** true iff (@p from, @p to) has an entry in compile-time table **/
+                static constexpr bool is_seeded(const unit_type & from,
+                                                const unit_type & to)
+                {
+                    return (conversion_seed_find<Repr, Int, Int2x>(from, to, nu_pair_hash(from, to))
+                            != nullptr);
+                }
+                ///@}
+
+            private:
+                /** per-thread cache entry **/
+                struct cache_entry {
+                    std::uint64_t hash_ = 0;
+                    bool valid_ = false;
+                    unit_type from_;
+                    unit_type to_;
+                    result_type conv_;
+                };
+
+                /** #of slots in per-thread cache;  power of 2 **/
+                static constexpr std::size_t c_cache_slots = 32;
+
+                static std::array<cache_entry, c_cache_slots> & slot_v() {
+                    static thread_local std::array<cache_entry, c_cache_slots> s_slot_v;
+                    return s_slot_v;
+                }
+            };
+
+            /** factor converting amounts in natural unit @p from to natural unit @p to.
+             *  Uses @ref conversion_cache,  except in constant-evaluated context.
+             **/
+            template <typename Repr, typename Int, typename Int2x>
+            constexpr conversion_factor<conversion_factor_t<Repr>>
+            nu_conversion_factor(const natural_unit<Int> & from,
+                                 const natural_unit<Int> & to)
+            {
+                if (std::is_constant_evaluated())
+                    return nu_conversion_factor_uncached<Repr, Int, Int2x>(from, to);
+                else
+                    return conversion_cache<Repr, Int, Int2x>::lookup(from, to);
+            }
+        } /*namespace detail*/
+    } /*namespace qty*/
+} /*namespace xo*/
+
+/** end conversion_cache.hpp **/
@@ -0,0 +1,498 @@
+/** @file quantity_array.hpp
+ *
+ *  Author: Roland Conybeare
+ **/
+
+#pragma once
+
+#include "quantity.hpp"
+#include <cstddef>
+#include <initializer_list>
+#include <span>
+#include <stdexcept>
+#include <utility>
+#include <vector>
+
+namespace xo {
+    namespace qty {
+        namespace detail {
+            /** true iff quantities with units @p Unit1 and @p Unit2 have the same dimension,
+             *  i.e. are inter-convertible.  Evaluated at compile time.
+             **/
+            template <auto Unit1, auto Unit2>
+            constexpr bool
+            su_same_dimension() {
+                using r_int_type = std::common_type_t<typename decltype(Unit1)::ratio_int_type,
+                                                      typename decltype(Unit2)::ratio_int_type>;
+                using r_int2x_type = detail::width2x_t<r_int_type>;
+
+                return detail::su_ratio<r_int_type, r_int2x_type>(Unit1.natural_unit_,
+                                                                  Unit2.natural_unit_)
+                    .natural_unit_.is_dimensionless();
+            }
+
+            /** multiplier converting a multiple of @p Unit1 to a multiple of @p Unit2.
+             *  Computed once per bulk operation,  not once per element.
+             *  Not usable in a constant expression when the conversion needs @c sqrt()
+             *  (fractional dimension),  at least until c++26.
+             **/
+            template <auto Unit1, auto Unit2, typename Repr>
+            requires (su_same_dimension<Unit1, Unit2>())
+            constexpr Repr
+            su_conversion_factor() {
+                return quantity<Unit1, Repr>(1).template rescale_ext<Unit2>().scale();
+            }
+        } /*namespace detail*/
+
+        /** @class quantity_array
+         *
+         *  @brief represent a contiguous array of quantities sharing a single unit.
+         *
+         *  @tparam ScaledUnit unit for every element;  as for @ref quantity
+         *  @tparam Repr type used to represent a multiple of @p ScaledUnit
+         *
+         *  Stores raw @p Repr values contiguously (no per-element unit information):
+         *  @code
+         *  quantity_array<u::meter> a(n);  // n doubles, in meters
+         *  @endcode
+         *
+         *  Dimension checks happen at compile time,  exactly as for @ref quantity.
+         *  Unit conversion computes one scale factor per operation,  then applies
+         *  it with a single multiply loop over the stored values
+         *  (auto-vectorized by the compiler).  Compare with
+         *  @c std::vector<quantity<..>>,  where each element is converted separately.
+         **/
+        template <
+            auto ScaledUnit,
+            typename Repr = double>
+        requires (ScaledUnit.is_natural() && ScaledUnit.is_scaled_unit_type())
+        class quantity_array {
+        public:
+            /** @defgroup quantity-array-type-traits quantity_array type traits **/
+            ///@{
+            /** @brief runtime representation for each element **/
+            using repr_type = Repr;
+            /** @brief scalar quantity type for each element **/
+            using value_type = quantity<ScaledUnit, Repr>;
+            /** @brief type used to represent unit information */
+            using unit_type = decltype(ScaledUnit);
+            /** @brief type used for numerator and denominator in basis-unit scalefactor ratios */
+            using ratio_int_type = unit_type::ratio_int_type;
+            ///@}
+
+        public:
+            /** @defgroup quantity-array-ctors quantity_array constructors **/
+            ///@{
+            /** @brief create empty array **/
+            quantity_array() = default;
+            /** @brief create array of @p n zero amounts **/
+            explicit quantity_array(std::size_t n) : scale_v_(n) {}
+            /** @brief create array with element @c i representing @p scales[i] @c ScaledUnits **/
+            explicit quantity_array(std::span<Repr const> scales)
+                : scale_v_(scales.begin(), scales.end()) {}
+            /** @brief create array adopting @p scales;
+             *  element @c i represents @p scales[i] @c ScaledUnits
+             **/
+            explicit quantity_array(std::vector<Repr> && scales)
+                : scale_v_(std::move(scales)) {}
+            /** @brief create array from quantities;
+             *  elements with compatible units convert implicitly
+             **/
+            quantity_array(std::initializer_list<value_type> xs) {
+                this->scale_v_.reserve(xs.size());
+                for (const auto & x : xs)
+                    this->scale_v_.push_back(x.scale());
+            }
+            ///@}
+
+            /** @defgroup quantity-array-access-methods quantity_array access methods **/
+            ///@{
+            std::size_t size() const { return scale_v_.size(); }
+            bool empty() const { return scale_v_.empty(); }
+
+            /** @brief unit shared by all elements **/
+            constexpr const unit_type & unit() const { return s_scaled_unit; }
+
+            /** @brief element values,  as multiples of @c ScaledUnit **/
+            std::span<Repr const> scales() const { return scale_v_; }
+            /** @brief element values,  as multiples of @c ScaledUnit (writable) **/
+            std::span<Repr> scales() { return scale_v_; }
+
+            Repr const * data() const { return scale_v_.data(); }
+            Repr * data() { return scale_v_.data(); }
+
+            /** @brief element @p i,  as a scalar quantity **/
+            value_type operator[](std::size_t i) const { return value_type(scale_v_[i]); }
+
+            /** @brief sum of all elements **/
+            value_type sum() const {
+                Repr s{0};
+                for (Repr x : scale_v_)
+                    s += x;
+                return value_type(s);
+            }
+            ///@}
+
+            /** @defgroup quantity-array-modifiers quantity_array modifiers **/
+            ///@{
+            void reserve(std::size_t n) { scale_v_.reserve(n); }
+            void resize(std::size_t n) { scale_v_.resize(n); }
+            void clear() { scale_v_.clear(); }
+
+            /** @brief replace element @p i with @p x,  converting units if necessary **/
+            template <typename Q2>
+            requires (quantity_concept<Q2> && Q2::always_constexpr_unit)
+            void set(std::size_t i, const Q2 & x) {
+                scale_v_[i] = x.template rescale_ext<s_scaled_unit>().scale();
+            }
+
+            /** @brief append @p x,  converting units if necessary **/
+            template <typename Q2>
+            requires (quantity_concept<Q2> && Q2::always_constexpr_unit)
+            void push_back(const Q2 & x) {
+                scale_v_.push_back(x.template rescale_ext<s_scaled_unit>().scale());
+            }
+            ///@}
+
+            /** @defgroup quantity-array-unit-conversion **/
+            ///@{
+
+            /** create equivalent array using scale representation @p Repr2 instead of @c Repr **/
+            template <typename Repr2>
+            auto with_repr() const {
+                quantity_array<s_scaled_unit, Repr2> retval(this->size());
+
+                Repr const * x = this->data();
+                Repr2 * z = retval.data();
+
+                for (std::size_t i = 0, n = this->size(); i < n; ++i)
+                    z[i] = static_cast<Repr2>(x[i]);
+
+                return retval;
+            }
+
+            /** create equivalent array expressed as multiples of @p ScaledUnit2.
+             *  Dimension mismatch is a compile-time error.
+             **/
+            template <auto ScaledUnit2>
+            requires (detail::su_same_dimension<ScaledUnit, ScaledUnit2>())
+            auto rescale_ext() const & {
+                auto const k = detail::su_conversion_factor<ScaledUnit, ScaledUnit2, Repr>();
+
+                quantity_array<ScaledUnit2, Repr> retval(this->size());
+
+                Repr const * x = this->data();
+                Repr * z = retval.data();
+
+                for (std::size_t i = 0, n = this->size(); i < n; ++i)
+                    z[i] = k * x[i];
+
+                return retval;
+            }
+
+            /** as above,  but converts in place and moves storage to the result;
+             *  avoids allocating when converting a temporary,  e.g.
+             *  @code
+             *  (dist / time).rescale_ext<u::meter / u::second>()
+             *  @endcode
+             **/
+            template <auto ScaledUnit2>
+            requires (detail::su_same_dimension<ScaledUnit, ScaledUnit2>())
+            auto rescale_ext() && {
+                auto const k = detail::su_conversion_factor<ScaledUnit, ScaledUnit2, Repr>();
+
+                for (Repr & x : scale_v_)
+                    x *= k;
+
+                return quantity_array<ScaledUnit2, Repr>(std::move(scale_v_));
+            }
+            ///@}
+
+            /** @defgroup quantity-array-operators **/
+            ///@{
+
+            /** add @p y element-wise,  in place, converting units if necessary **/
+            template <auto ScaledUnit2, typename Repr2>
+            requires (detail::su_same_dimension<ScaledUnit, ScaledUnit2>())
+            quantity_array & operator+=(const quantity_array<ScaledUnit2, Repr2> & y) {
+                auto const k = detail::su_conversion_factor<ScaledUnit2, ScaledUnit, Repr>();
+
+                check_same_size(*this, y);
+
+                Repr * x = this->data();
+                Repr2 const * yp = y.data();
+
+                for (std::size_t i = 0, n = this->size(); i < n; ++i)
+                    x[i] += k * yp[i];
+
+                return *this;
+            }
+
+            /** subtract @p y element-wise,  in place, converting units if necessary **/
+            template <auto ScaledUnit2, typename Repr2>
+            requires (detail::su_same_dimension<ScaledUnit, ScaledUnit2>())
+            quantity_array & operator-=(const quantity_array<ScaledUnit2, Repr2> & y) {
+                auto const k = detail::su_conversion_factor<ScaledUnit2, ScaledUnit, Repr>();
+
+                check_same_size(*this, y);
+
+                Repr * x = this->data();
+                Repr2 const * yp = y.data();
+
+                for (std::size_t i = 0, n = this->size(); i < n; ++i)
+                    x[i] -= k * yp[i];
+
+                return *this;
+            }
+
+            /** multiply every element by dimensionless @p y **/
+            template <typename Dimensionless>
+            requires std::is_arithmetic_v<Dimensionless>
+            quantity_array & operator*=(Dimensionless y) {
+                for (Repr & x : scale_v_)
+                    x *= y;
+                return *this;
+            }
+
+            /** divide every element by dimensionless @p y **/
+            template <typename Dimensionless>
+            requires std::is_arithmetic_v<Dimensionless>
+            quantity_array & operator/=(Dimensionless y) {
+                for (Repr & x : scale_v_)
+                    x /= y;
+                return *this;
+            }
+            ///@}
+
+            /** throw unless @p x and @p y have the same number of elements **/
+            template <typename A1, typename A2>
+            static void check_same_size(const A1 & x, const A2 & y) {
+                if (x.size() != y.size())
+                    throw std::runtime_error("quantity_array: expected operands with equal size");
+            }
+
+        public:
+            /** @brief unit for every element of this array. Determined at compile-time **/
+            static constexpr scaled_unit<ratio_int_type> s_scaled_unit = ScaledUnit;
+
+        private:
+            /** element i represents @c scale_v_[i] multiples of @ref s_scaled_unit **/
+            std::vector<Repr> scale_v_;
+        };
+
+        namespace detail {
+            struct quantity_array_util {
+                /* unit (+ outer scalefactor) for product (DivideFlag=false)
+                 * or ratio (DivideFlag=true) of two natural units
+                 */
+                template <bool DivideFlag, typename Int, typename Int2x, typename NaturalUnit>
+                static constexpr auto su_combine(const NaturalUnit & lhs, const NaturalUnit & rhs) {
+                    if constexpr (DivideFlag)
+                        return detail::su_ratio<Int, Int2x>(lhs, rhs);
+                    else
+                        return detail::su_product<Int, Int2x>(lhs, rhs);
+                }
+
+                /* element-wise z[i] = k * x[i] * y[i]  (Op=multiply)
+                 *            or  k * x[i] / y[i]  (Op=divide),
+                 * with unit of z and constant k computed at compile time
+                 * (same scheme as quantity_util::multiply(), quantity_util::divide())
+                 */
+                template <bool DivideFlag, auto U1, typename R1, auto U2, typename R2>
+                static auto product(const quantity_array<U1, R1> & x,
+                                    const quantity_array<U2, R2> & y)
+                {
+                    using r_repr_type = std::common_type_t<R1, R2>;
+                    using r_int_type = std::common_type_t<typename decltype(U1)::ratio_int_type,
+                                                          typename decltype(U2)::ratio_int_type>;
+                    using r_int2x_type = detail::width2x_t<r_int_type>;
+
+                    constexpr auto rr = su_combine<DivideFlag, r_int_type, r_int2x_type>(U1.natural_unit_,
+                                                                                         U2.natural_unit_);
+
+                    r_repr_type k = (((rr.outer_scale_sq_ == 1.0)
+                                      ? 1.0
+                                      : ::sqrt(rr.outer_scale_sq_))
+                                     * rr.outer_scale_factor_.template convert_to<r_repr_type>());
+
+                    quantity_array<detail::su_promote<r_int_type>(rr.natural_unit_),
+                                   r_repr_type> retval(x.size());
+
+                    x.check_same_size(x, y);
+
+                    R1 const * xp = x.data();
+                    R2 const * yp = y.data();
+                    r_repr_type * z = retval.data();
+
+                    for (std::size_t i = 0, n = x.size(); i < n; ++i) {
+                        if constexpr (DivideFlag)
+                            z[i] = k * static_cast<r_repr_type>(xp[i]) / static_cast<r_repr_type>(yp[i]);
+                        else
+                            z[i] = k * static_cast<r_repr_type>(xp[i]) * static_cast<r_repr_type>(yp[i]);
+                    }
+
+                    return retval;
+                }
+
+                /* element-wise z[i] = x[i] + sgn * k * y[i],
+                 * with k converting y to units of x
+                 */
+                template <int Sign, auto U1, typename R1, auto U2, typename R2>
+                requires (su_same_dimension<U1, U2>())
+                static auto sum(const quantity_array<U1, R1> & x,
+                                const quantity_array<U2, R2> & y)
+                {
+                    using r_repr_type = std::common_type_t<R1, R2>;
+
+                    r_repr_type const k = Sign * detail::su_conversion_factor<U2, U1, r_repr_type>();
+
+                    quantity_array<U1, r_repr_type> retval(x.size());
+
+                    x.check_same_size(x, y);
+
+                    R1 const * xp = x.data();
+                    R2 const * yp = y.data();
+                    r_repr_type * z = retval.data();
+
+                    for (std::size_t i = 0, n = x.size(); i < n; ++i)
+                        z[i] = static_cast<r_repr_type>(xp[i]) + k * static_cast<r_repr_type>(yp[i]);
+
+                    return retval;
+                }
+
+                /* element-wise z[i] = k * x[i],
+                 * with k a scalar quantity (possibly with dimension)
+                 */
+                template <auto U1, typename R1, typename Q2>
+                requires (quantity_concept<Q2> && Q2::always_constexpr_unit)
+                static auto scale(const quantity_array<U1, R1> & x, const Q2 & k)
+                {
+                    /* unit + scalefactor for (1 U1) * k */
+                    auto k1 = quantity<U1, R1>(1) * k;
+
+                    using k1_type = decltype(k1);
+                    using r_repr_type = typename k1_type::repr_type;
+
+                    quantity_array<k1_type::s_scaled_unit, r_repr_type> retval(x.size());
+
+                    r_repr_type kv = k1.scale();
+                    R1 const * xp = x.data();
+                    r_repr_type * z = retval.data();
+
+                    for (std::size_t i = 0, n = x.size(); i < n; ++i)
+                        z[i] = kv * static_cast<r_repr_type>(xp[i]);
+
+                    return retval;
+                }
+            };
+        } /*namespace detail*/
+
+        /** @addtogroup quantity-array-operators **/
+        ///@{
+
+        /** element-wise sum.  Result has units of @p x.
+         *  Dimension mismatch is a compile-time error.
+         **/
+        template <auto U1, typename R1, auto U2, typename R2>
+        requires (detail::su_same_dimension<U1, U2>())
+        auto
+        operator+ (const quantity_array<U1, R1> & x, const quantity_array<U2, R2> & y)
+        {
+            return detail::quantity_array_util::sum<+1>(x, y);
+        }
+
+        /** element-wise difference.  Result has units of @p x.
+         *  Dimension mismatch is a compile-time error.
+         **/
+        template <auto U1, typename R1, auto U2, typename R2>
+        requires (detail::su_same_dimension<U1, U2>())
+        auto
+        operator- (const quantity_array<U1, R1> & x, const quantity_array<U2, R2> & y)
+        {
+            return detail::quantity_array_util::sum<-1>(x, y);
+        }
+
+        /** element-wise product.  Result unit computed at compile time **/
+        template <auto U1, typename R1, auto U2, typename R2>
+        auto
+        operator* (const quantity_array<U1, R1> & x, const quantity_array<U2, R2> & y)
+        {
+            return detail::quantity_array_util::product<false>(x, y);
+        }
+
+        /** element-wise ratio.  Result unit computed at compile time **/
+        template <auto U1, typename R1, auto U2, typename R2>
+        auto
+        operator/ (const quantity_array<U1, R1> & x, const quantity_array<U2, R2> & y)
+        {
+            return detail::quantity_array_util::product<true>(x, y);
+        }
+
+        /** multiply each element of @p x by scalar quantity @p y **/
+        template <auto U1, typename R1, typename Q2>
+        requires (quantity_concept<Q2> && Q2::always_constexpr_unit)
+        auto
+        operator* (const quantity_array<U1, R1> & x, const Q2 & y)
+        {
+            return detail::quantity_array_util::scale(x, y);
+        }
+
+        /** multiply each element of @p y by scalar quantity @p x **/
+        template <typename Q1, auto U2, typename R2>
+        requires (quantity_concept<Q1> && Q1::always_constexpr_unit)
+        auto
+        operator* (const Q1 & x, const quantity_array<U2, R2> & y)
+        {
+            return detail::quantity_array_util::scale(y, x);
+        }
+
+        /** multiply each element of @p x by dimensionless @p y **/
+        template <auto U1, typename R1, typename Dimensionless>
+        requires std::is_arithmetic_v<Dimensionless>
+        auto
+        operator* (const quantity_array<U1, R1> & x, Dimensionless y)
+        {
+            quantity_array<U1, std::common_type_t<R1, Dimensionless>> retval
+                = x.template with_repr<std::common_type_t<R1, Dimensionless>>();
+
+            retval *= y;
+
+            return retval;
+        }
+
+        /** multiply each element of @p y by dimensionless @p x **/
+        template <typename Dimensionless, auto U2, typename R2>
+        requires std::is_arithmetic_v<Dimensionless>
+        auto
+        operator* (Dimensionless x, const quantity_array<U2, R2> & y)
+        {
+            return y * x;
+        }
+
+        /** divide each element of @p x by dimensionless @p y **/
+        template <auto U1, typename R1, typename Dimensionless>
+        requires std::is_arithmetic_v<Dimensionless>
+        auto
+        operator/ (const quantity_array<U1, R1> & x, Dimensionless y)
+        {
+            quantity_array<U1, std::common_type_t<R1, Dimensionless>> retval
+                = x.template with_repr<std::common_type_t<R1, Dimensionless>>();
+
+            retval /= y;
+
+            return retval;
+        }
+
+        ///@}
+
+        /** create equivalent array expressed as multiples of @p Unit **/
+        template <auto Unit, auto U1, typename R1>
+        auto
+        with_units(const quantity_array<U1, R1> & x)
+        {
+            return x.template rescale_ext<Unit>();
+        }
+    } /*namespace qty*/
+} /*namespace xo*/
+
+/** end quantity_array.hpp **/
@@ -6,6 +6,7 @@
 #pragma once
 
 #include "natural_unit.hpp"
+#include "conversion_cache.hpp"
 #include "quantity_ops.hpp"
 #include "scaled_unit.hpp"
 
@@ -204,12 +205,13 @@ namespace xo {
                                                         typename Quantity2::ratio_int2x_type>;
 
                 /* conversion to get y in same units as x:  multiply by y/x */
-                auto rr = detail::su_ratio<r_int_type, r_int2x_type>(y.unit(), x.unit());
+                auto cf = detail::nu_conversion_factor<r_repr_type,
+                                                       r_int_type,
+                                                       r_int2x_type>(y.unit(), x.unit());
 
-                if (rr.natural_unit_.is_dimensionless()) {
+                if (cf.convertible_) {
                     r_repr_type r_scale = (static_cast<r_repr_type>(x.scale())
-                                           + (::sqrt(rr.outer_scale_sq_)
-                                              * rr.outer_scale_factor_.template convert_to<r_repr_type>()
+                                           + (cf.factor_
                                               * static_cast<r_repr_type>(y.scale())));
 
                     return xquantity<r_repr_type, r_int_type>(r_scale, x.unit_.template to_repr<r_int_type>());
@@ -232,12 +234,13 @@ namespace xo {
                                                         typename Quantity2::ratio_int2x_type>;
 
                 /* conversion to get y in same units as x:  multiply by y/x */
-                auto rr = detail::su_ratio<r_int_type, r_int2x_type>(y.unit(), x.unit());
+                auto cf = detail::nu_conversion_factor<r_repr_type,
+                                                       r_int_type,
+                                                       r_int2x_type>(y.unit(), x.unit());
 
-                if (rr.natural_unit_.is_dimensionless()) {
+                if (cf.convertible_) {
                     r_repr_type r_scale = (static_cast<r_repr_type>(x.scale())
-                                           - (::sqrt(rr.outer_scale_sq_)
-                                              * rr.outer_scale_factor_.template convert_to<r_repr_type>()
+                                           - (cf.factor_
                                               * static_cast<r_repr_type>(y.scale())));
 
                     return xquantity<r_repr_type, r_int_type>(r_scale, x.unit_.template to_repr<r_int_type>());
@@ -257,13 +260,12 @@ namespace xo {
             constexpr
             auto rescale(const natural_unit<Int> & unit2) const {
                 /* conversion factor from .unit -> unit2*/
-                auto rr = detail::su_ratio<ratio_int_type,
-                                           ratio_int2x_type>(this->unit_, unit2);
+                auto cf = detail::nu_conversion_factor<repr_type,
+                                                       ratio_int_type,
+                                                       ratio_int2x_type>(this->unit_, unit2);
 
-                if (rr.natural_unit_.is_dimensionless()) {
-                    repr_type r_scale = (::sqrt(rr.outer_scale_sq_)
-                                         * rr.outer_scale_factor_.template convert_to<repr_type>()
-                                         * this->scale_);
+                if (cf.convertible_) {
+                    repr_type r_scale = (cf.factor_ * this->scale_);
                     return xquantity(r_scale, unit2);
                 } else {
                     return xquantity(std::numeric_limits<repr_type>::quiet_NaN(), unit2);
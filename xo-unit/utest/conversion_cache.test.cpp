@@ -0,0 +1,119 @@
+/* @file conversion_cache.test.cpp */
+
+#include "xo/unit/conversion_cache.hpp"
+#include "xo/unit/xquantity.hpp"
+#include <catch2/catch.hpp>
+#include <cmath>
+#include <vector>
+
+namespace xo {
+    namespace qty {
+        namespace {
+            using int2x_type = detail::width2x_t<std::int64_t>;
+            using cache_type = detail::conversion_cache<double, std::int64_t, int2x_type>;
+
+            /* reference: walk both units' bpus (no cache) */
+            detail::conversion_factor<double>
+            uncached(const natural_unit<std::int64_t> & from,
+                     const natural_unit<std::int64_t> & to)
+            {
+                return detail::nu_conversion_factor_uncached<double, std::int64_t, int2x_type>(from, to);
+            }
+        }
+
+        TEST_CASE("conversion_cache.seeded", "[conversion_cache]") {
+            /* compile-time table populated for common units */
+            static_assert(cache_type::is_seeded(nu::kilometer, nu::meter));
+            static_assert(cache_type::is_seeded(nu::millisecond, nu::hour));
+            static_assert(!cache_type::is_seeded(nu::kilometer, nu::second));
+            static_assert(!cache_type::is_seeded(nu::meter, nu::meter));
+
+            const auto & unit_v = detail::conversion_seed_unit_v<std::int64_t>;
+
+            for (const auto & from : unit_v) {
+                for (const auto & to : unit_v) {
+                    INFO("from=" << from.abbrev() << ", to=" << to.abbrev());
+
+                    auto cf0 = uncached(from, to);
+                    auto cf = cache_type::lookup(from, to);
+
+                    REQUIRE(cf.convertible_ == cf0.convertible_);
+                    if (cf0.convertible_) {
+                        /* identical,  not just close */
+                        REQUIRE(cf.factor_ == cf0.factor_);
+                    }
+                }
+            }
+
+            REQUIRE(cache_type::lookup(nu::kilometer, nu::meter).factor_ == 1000.0);
+            REQUIRE(cache_type::lookup(nu::minute, nu::second).factor_ == 60.0);
+        } /*TEST_CASE(conversion_cache.seeded)*/
+
+        TEST_CASE("conversion_cache.runtime", "[conversion_cache]") {
+            /* compound units,  fractional powers:  per-thread cache */
+            std::vector<natural_unit<std::int64_t>> unit_v
+                = { (u::meter / u::second).natural_unit_,
+                    (u::kilometer / u::hour).natural_unit_,
+                    (u::millimeter / u::millisecond).natural_unit_,
+                    (u::meter * u::meter).natural_unit_,
+                    (u::foot * u::foot).natural_unit_,
+                    (u::kilogram * u::meter / (u::second * u::second)).natural_unit_,
+                    (u::gram * u::millimeter / (u::minute * u::minute)).natural_unit_,
+                    nu::volatility_30d,
+                    nu::volatility_250d,
+                    nu::volatility_360d,
+                    nu::picosecond,
+                    nu::second,
+                };
+
+            static_assert(!cache_type::is_seeded((u::meter / u::second).natural_unit_,
+                                                 (u::kilometer / u::hour).natural_unit_));
+
+            /* twice:  1st pass misses,  2nd pass (mostly) hits */
+            for (int pass = 0; pass < 2; ++pass) {
+                for (const auto & from : unit_v) {
+                    for (const auto & to : unit_v) {
+                        INFO("pass=" << pass << ", from=" << from.abbrev() << ", to=" << to.abbrev());
+
+                        auto cf0 = uncached(from, to);
+                        auto cf = cache_type::lookup(from, to);
+
+                        REQUIRE(cf.convertible_ == cf0.convertible_);
+                        if (cf0.convertible_)
+                            REQUIRE(cf.factor_ == cf0.factor_);
+                    }
+                }
+            }
+
+            REQUIRE(cache_type::lookup(unit_v[0], unit_v[1]).factor_ == Approx(3.6).epsilon(1e-15));
+            REQUIRE(cache_type::lookup(unit_v[0], unit_v[2]).factor_ == 1.0);
+            REQUIRE(!cache_type::lookup(unit_v[0], unit_v[3]).convertible_);
+        } /*TEST_CASE(conversion_cache.runtime)*/
+
+        TEST_CASE("conversion_cache.xquantity", "[conversion_cache]") {
+            /* xquantity arithmetic goes through cache */
+            xquantity x(1.5, u::kilometer);
+            xquantity y(250.0, u::meter);
+            xquantity t(1.0, u::second);
+
+            REQUIRE((x + y).scale() == 1.75);
+            REQUIRE((y + x).scale() == 1750.0);
+            REQUIRE((x - y).scale() == 1.25);
+            REQUIRE(y.rescale(nu::kilometer).scale() == 0.25);
+            REQUIRE(x > y);
+
+            xquantity v1(36.0, u::kilometer / u::hour);
+            xquantity v2(10.0, u::meter / u::second);
+
+            REQUIRE((v2 + v1).scale() == Approx(20.0).epsilon(1e-15));
+            REQUIRE(v1.rescale(v2.unit()).scale() == Approx(10.0).epsilon(1e-15));
+
+            /* dimension mismatch */
+            REQUIRE(std::isnan((x + t).scale()));
+            REQUIRE(std::isnan((x - t).scale()));
+            REQUIRE(std::isnan(x.rescale(nu::second).scale()));
+        } /*TEST_CASE(conversion_cache.xquantity)*/
+    } /*namespace qty*/
+} /*namespace xo*/
+
+/* end conversion_cache.test.cpp */
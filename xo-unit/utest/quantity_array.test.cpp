@@ -0,0 +1,120 @@
+/* @file quantity_array.test.cpp */
+
+#include "xo/unit/quantity_array.hpp"
+#include <catch2/catch.hpp>
+#include <vector>
+
+namespace xo {
+    namespace qty {
+        namespace {
+            /* true iff x + y is well-formed */
+            template <typename A1, typename A2>
+            concept addable = requires(A1 x, A2 y) { x + y; };
+
+            /* true iff x.rescale_ext<Unit>() is well-formed */
+            template <typename A1, auto Unit>
+            concept rescalable = requires(A1 x) { x.template rescale_ext<Unit>(); };
+        }
+
+        TEST_CASE("quantity_array.ctor", "[quantity_array]") {
+            quantity_array<u::millisecond> a{qty::milliseconds(1.0),
+                                             qty::seconds(2.0),
+                                             qty::microseconds(500.0)};
+
+            REQUIRE(a.size() == 3);
+            REQUIRE(a.scales()[0] == 1.0);
+            REQUIRE(a.scales()[1] == 2000.0);
+            REQUIRE(a.scales()[2] == 0.5);
+
+            /* element access gives a scalar quantity */
+            auto q = a[1];
+            static_assert(std::same_as<decltype(q), quantity<u::millisecond, double>>);
+            REQUIRE(q.scale() == 2000.0);
+
+            a.set(0, qty::seconds(0.25));
+            REQUIRE(a.scales()[0] == 250.0);
+
+            REQUIRE(a.sum().scale() == 2250.5);
+
+            static_assert(sizeof(quantity_array<u::meter>) == sizeof(std::vector<double>));
+        } /*TEST_CASE(quantity_array.ctor)*/
+
+        TEST_CASE("quantity_array.rescale", "[quantity_array]") {
+            std::vector<double> v = {1.0, 2.5, -3.0, 1e6};
+
+            quantity_array<u::millisecond> ms{std::span<double const>(v)};
+
+            auto s = ms.rescale_ext<u::second>();
+            static_assert(std::same_as<decltype(s), quantity_array<u::second, double>>);
+
+            for (std::size_t i = 0; i < v.size(); ++i) {
+                /* same answer as scalar conversion */
+                REQUIRE(s.scales()[i] == qty::milliseconds(v[i]).rescale_ext<u::second>().scale());
+            }
+
+            auto ms2 = with_units<u::millisecond>(s);
+            for (std::size_t i = 0; i < v.size(); ++i)
+                REQUIRE(ms2.scales()[i] == Approx(v[i]).epsilon(1e-15));
+
+            /* dimension mismatch rejected at compile time */
+            static_assert(rescalable<quantity_array<u::millisecond>, u::minute>);
+            static_assert(!rescalable<quantity_array<u::millisecond>, u::meter>);
+        } /*TEST_CASE(quantity_array.rescale)*/
+
+        TEST_CASE("quantity_array.arith", "[quantity_array]") {
+            quantity_array<u::meter> d{qty::meters(1.0), qty::meters(2.0), qty::meters(3.0)};
+            quantity_array<u::millimeter> dmm{qty::millimeters(10.0), qty::millimeters(20.0), qty::millimeters(30.0)};
+            quantity_array<u::second> t{qty::seconds(2.0), qty::seconds(4.0), qty::seconds(8.0)};
+
+            /* sum:  units of lhs */
+            auto d2 = d + dmm;
+            static_assert(std::same_as<decltype(d2), quantity_array<u::meter, double>>);
+            REQUIRE(d2.scales()[0] == Approx(1.01));
+            REQUIRE(d2.scales()[2] == Approx(3.03));
+
+            auto d3 = dmm - d;
+            static_assert(std::same_as<decltype(d3), quantity_array<u::millimeter, double>>);
+            REQUIRE(d3.scales()[1] == Approx(-1980.0));
+
+            d2 -= dmm;
+            REQUIRE(d2.scales()[1] == Approx(2.0));
+
+            static_assert(addable<quantity_array<u::meter>, quantity_array<u::millimeter>>);
+            static_assert(!addable<quantity_array<u::meter>, quantity_array<u::second>>);
+
+            /* product/ratio:  unit computed at compile time */
+            auto v = d / t;
+            REQUIRE(v[0] == qty::meters(1.0) / qty::seconds(2.0));
+            REQUIRE(v.scales()[2] == 0.375);
+
+            auto a = d * d;
+            REQUIRE(a[1] == qty::meters(2.0) * qty::meters(2.0));
+
+            /* mixed scale:  mm/s -> scalefactor folded into one multiply */
+            auto vmm = dmm / t;
+            REQUIRE(vmm[0] == qty::millimeters(10.0) / qty::seconds(2.0));
+
+            /* scalar quantity broadcast */
+            auto dt = t * qty::meters(3.0);
+            REQUIRE(dt[2] == qty::seconds(8.0) * qty::meters(3.0));
+
+            auto td = qty::meters(3.0) * t;
+            REQUIRE(td[2] == qty::meters(3.0) * qty::seconds(8.0));
+
+            /* dimensionless scalar */
+            auto d4 = 2 * d;
+            REQUIRE(d4.scales()[2] == 6.0);
+            auto d5 = d / 4.0;
+            REQUIRE(d5.scales()[1] == 0.5);
+
+            d4 *= 0.5;
+            REQUIRE(d4.scales()[1] == 2.0);
+
+            /* size mismatch:  runtime error */
+            quantity_array<u::meter> short_d(2);
+            REQUIRE_THROWS_AS(d + short_d, std::runtime_error);
+        } /*TEST_CASE(quantity_array.arith)*/
+    } /*namespace qty*/
+} /*namespace xo*/
+
+/* end quantity_array.test.cpp */
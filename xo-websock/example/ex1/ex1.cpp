@@ -0,0 +1,216 @@
+/* @file ex1.cpp
+ *
+ * benchmark: WebsocketSink event serialization throughput (events/sec, one session)
+ *
+ *   legacy:  std::stringstream + PrintJson,  ss.str() twice,
+ *            Webserver::send_text() copies into session output buffer
+ *   vs.
+ *   current: WebsocketSink::notify_ev_tp(),  PrintJson writes directly into
+ *            reusable WsMessageBuffer (with LWS_PRE headroom);
+ *            Webserver::send_message() swaps storage with session output buffer
+ *
+ * Network i/o is excluded:  uses a stand-in Webserver that stores each message
+ * the way WebserverImpl's session output buffer does,  and never calls lws_write().
+ *
+ * use:
+ *   $ websock_ex1 [n]
+ */
+
+#include "xo/websock/Webserver.hpp"
+#include "xo/websock/WebsocketSink.hpp"
+#include "xo/websock/WsMessageBuffer.hpp"
+#include <xo/printjson/PrintJson.hpp>
+#include <xo/printjson/init_printjson.hpp>
+#include <xo/reflect/Reflect.hpp>
+#include <xo/reflect/StructReflector.hpp>
+#include <xo/ppsink/quoted_ostream.hpp>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <sstream>
+
+namespace {
+    using xo::rp;
+    using xo::web::Webserver;
+    using xo::web::WebsocketSink;
+    using xo::web::WsMessageBuffer;
+    using xo::web::Runstate;
+    using xo::web::HttpEndpointDescr;
+    using xo::web::StreamEndpointDescr;
+    using xo::json::PrintJson;
+    using xo::reflect::Reflect;
+    using xo::reflect::StructReflector;
+    using xo::reflect::TaggedPtr;
+    using xo::pp::quot;
+
+    /* sample event,  similar in shape to a market-data update */
+    struct BenchEvent {
+        std::int64_t tm_;
+        std::uint32_t seq_;
+        double bid_px_;
+        double ask_px_;
+        std::int32_t bid_sz_;
+        std::int32_t ask_sz_;
+        std::string symbol_;
+    };
+
+    void
+    reflect_bench_event()
+    {
+        StructReflector<BenchEvent> sr;
+
+        if (sr.is_incomplete()) {
+            REFLECT_MEMBER(sr, tm);
+            REFLECT_MEMBER(sr, seq);
+            REFLECT_MEMBER(sr, bid_px);
+            REFLECT_MEMBER(sr, ask_px);
+            REFLECT_MEMBER(sr, bid_sz);
+            REFLECT_MEMBER(sr, ask_sz);
+            REFLECT_MEMBER(sr, symbol);
+        }
+
+        sr.require_complete();
+    } /*reflect_bench_event*/
+
+    /* stand-in for WebserverImpl with one always-idle session:
+     * keeps last message,  as WebserverImpl's per-session output buffer would
+     */
+    class BenchWebserver : public Webserver {
+    public:
+        static rp<BenchWebserver> make() { return new BenchWebserver(); }
+
+        std::size_t n_msg() const { return n_msg_; }
+        std::size_t n_byte() const { return n_byte_; }
+        WsMessageBuffer const & last_msg() const { return session_msg_; }
+
+        virtual Runstate state() const override { return Runstate::stopped; }
+        virtual void register_http_endpoint(HttpEndpointDescr const &) override {}
+        virtual void register_stream_endpoint(StreamEndpointDescr const &) override {}
+        virtual void start_webserver() override {}
+        virtual void interrupt_stop_webserver() override {}
+        virtual void stop_webserver() override {}
+        virtual void join_webserver() override {}
+        virtual std::vector<xo::web::WsSessionStats> session_stats() const override { return {}; }
+
+        /* legacy path:  copy into session output buffer */
+        virtual void send_text(uint32_t /*session_id*/, std::string text) override {
+            this->session_msg_.clear();
+            this->session_msg_.append(text);
+
+            ++(this->n_msg_);
+            this->n_byte_ += this->session_msg_.text_z();
+        }
+
+        /* current path:  swap storage with session output buffer */
+        virtual void send_message(uint32_t /*session_id*/, WsMessageBuffer * p_msg) override {
+            this->session_msg_.swap(*p_msg);
+            p_msg->clear();
+
+            ++(this->n_msg_);
+            this->n_byte_ += this->session_msg_.text_z();
+        }
+
+    private:
+        std::size_t n_msg_ = 0;
+        std::size_t n_byte_ = 0;
+        WsMessageBuffer session_msg_;
+    }; /*BenchWebserver*/
+
+    /* WebsocketSinkImpl::notify_ev_tp() before WsMessageBuffer */
+    void
+    legacy_notify_ev_tp(Webserver * websrv,
+                        PrintJson const & pjson,
+                        std::string const & stream_name,
+                        TaggedPtr const & ev_tp,
+                        std::size_t * p_log_z)
+    {
+        std::stringstream ss;
+
+        ss << "{" << quot("stream") << ": " << quot(stream_name)
+           << ", " << quot("event") << ": ";
+
+        pjson.print_tp(ev_tp, &ss);
+
+        ss << "}";
+
+        /* was log && log("sending", xtag("msg", ss.str())), with log always enabled */
+        *p_log_z += ss.str().size();
+
+        websrv->send_text(0, ss.str());
+    } /*legacy_notify_ev_tp*/
+
+    template <typename Fn>
+    double
+    time_sec(Fn && fn)
+    {
+        auto t0 = std::chrono::steady_clock::now();
+        fn();
+        auto t1 = std::chrono::steady_clock::now();
+
+        return std::chrono::duration<double>(t1 - t0).count();
+    }
+
+    void
+    report(char const * label, BenchWebserver const & websrv, double dt_sec)
+    {
+        std::cout << label << ": " << (websrv.n_msg() / dt_sec) * 1e-6 << " M events/sec"
+                  << "  " << (websrv.n_byte() / dt_sec) * 1e-6 << " MB/sec"
+                  << std::endl;
+    }
+}
+
+int
+main(int argc, char ** argv)
+{
+    using namespace xo;
+
+    std::size_t n = 1000000;
+
+    if (argc > 1)
+        n = std::strtoull(argv[1], nullptr, 10);
+
+    InitSubsys<S_printjson_tag>::require();
+    Subsystem::initialize_all();
+
+    reflect_bench_event();
+
+    rp<PrintJson> pjson = json::PrintJsonSingleton::instance();
+    std::string stream_name = "/bench/quotes";
+
+    BenchEvent ev{1700000000000000, 0, 100.25, 100.50, 300, 200, "XYZ"};
+    TaggedPtr ev_tp = Reflect::make_tp(&ev);
+
+    {
+        rp<BenchWebserver> websrv = BenchWebserver::make();
+        std::size_t log_z = 0;
+
+        double dt = time_sec([&]() {
+            for (std::size_t i = 0; i < n; ++i) {
+                ev.seq_ = i;
+                legacy_notify_ev_tp(websrv.get(), *(pjson.get()), stream_name, ev_tp, &log_z);
+            }
+        });
+
+        report("legacy  stringstream + send_text      ", *(websrv.get()), dt);
+    }
+
+    {
+        rp<BenchWebserver> websrv = BenchWebserver::make();
+        rp<WebsocketSink> sink = WebsocketSink::make(websrv, pjson, 0 /*session_id*/, stream_name);
+
+        double dt = time_sec([&]() {
+            for (std::size_t i = 0; i < n; ++i) {
+                ev.seq_ = i;
+                sink->notify_ev_tp(ev_tp);
+            }
+        });
+
+        report("current WsMessageBuffer + send_message", *(websrv.get()), dt);
+
+        std::cout << "last message: " << websrv->last_msg().text_view() << std::endl;
+    }
+
+    return 0;
+}
+
+/* end ex1.cpp */
@@ -0,0 +1,130 @@
+/* @file ex2.cpp
+ *
+ * demo: per-session outbound queues (WsSendQueue) isolate a slow client
+ *
+ * One producer thread (stand-in for a reactor thread driving WebsocketSinks)
+ * publishes each message to two sessions,  in bursts of 32 messages
+ * every 50us:
+ *   fast: consumer thread drains its queue continuously
+ *   slow: consumer thread stalls for 1ms after every 64 messages
+ *         (stand-in for a client on a congested link)
+ *
+ * Network i/o is excluded;  consumers just pop,  the way a libwebsockets
+ * service thread does before calling ::lws_write().
+ *
+ * For each overflow policy,  reports producer throughput and per-session
+ * queue metrics (see WsSessionStats).  Producer never blocks;
+ * slow session loses messages according to policy,  fast session loses none.
+ *
+ * use:
+ *   $ websock_ex2 [n]
+ */
+
+#include "xo/websock/WsSendQueue.hpp"
+#include <atomic>
+#include <chrono>
+#include <cstdlib>
+#include <iostream>
+#include <string>
+#include <thread>
+
+namespace {
+    using xo::web::WsSendQueue;
+    using xo::web::WsOverflowPolicy;
+    using xo::web::WsSessionStats;
+    using xo::web::WsMessageBuffer;
+
+    /* drain *p_q until *p_done and queue empty;
+     * if stall_flag,  sleep 1ms after every 64 messages
+     */
+    void
+    consume(WsSendQueue * p_q, std::atomic<bool> * p_done, bool stall_flag)
+    {
+        WsMessageBuffer msg;
+        std::size_t n = 0;
+
+        for (;;) {
+            if (p_q->pop(&msg)) {
+                ++n;
+
+                if (stall_flag && (n % 64 == 0))
+                    std::this_thread::sleep_for(std::chrono::milliseconds(1));
+            } else if (p_done->load(std::memory_order_acquire)) {
+                if (!p_q->pop(&msg))
+                    break;
+            } else {
+                std::this_thread::yield();
+            }
+        }
+    } /*consume*/
+
+    void
+    report(char const * label, WsSessionStats const & stats)
+    {
+        std::cout << "  " << label
+                  << ": enqueued " << stats.n_enqueued_
+                  << ", sent " << stats.n_sent_
+                  << ", dropped " << stats.n_dropped_
+                  << ", max depth " << stats.max_queue_depth_
+                  << std::endl;
+    } /*report*/
+
+    void
+    run(WsOverflowPolicy policy, std::size_t n)
+    {
+        WsSendQueue fast_q(256, policy);
+        WsSendQueue slow_q(256, policy);
+
+        std::atomic<bool> done = false;
+
+        std::thread fast_thread(consume, &fast_q, &done, false);
+        std::thread slow_thread(consume, &slow_q, &done, true);
+
+        WsMessageBuffer msg;
+        std::string text(120, 'x');
+
+        auto t0 = std::chrono::steady_clock::now();
+
+        for (std::size_t i = 0; i < n; ++i) {
+            msg.append(text);
+            fast_q.push(&msg);
+
+            msg.append(text);
+            slow_q.push(&msg);
+
+            if (i % 32 == 31)
+                std::this_thread::sleep_for(std::chrono::microseconds(50));
+        }
+
+        auto t1 = std::chrono::steady_clock::now();
+
+        done.store(true, std::memory_order_release);
+
+        fast_thread.join();
+        slow_thread.join();
+
+        double dt = std::chrono::duration<double>(t1 - t0).count();
+
+        std::cout << policy << ": producer " << (2 * n / dt) * 1e-3 << " K msgs/sec" << std::endl;
+
+        report("fast", fast_q.stats());
+        report("slow", slow_q.stats());
+    } /*run*/
+}
+
+int
+main(int argc, char ** argv)
+{
+    std::size_t n = 200000;
+
+    if (argc > 1)
+        n = std::strtoull(argv[1], nullptr, 10);
+
+    run(WsOverflowPolicy::drop_newest, n);
+    run(WsOverflowPolicy::drop_oldest, n);
+    run(WsOverflowPolicy::coalesce, n);
+
+    return 0;
+}
+
+/* end ex2.cpp */
@@ -9,7 +9,10 @@
 #include <xo/webutil/Alist.hpp>
 #include <xo/webutil/HttpEndpointDescr.hpp>
 #include <xo/webutil/StreamEndpointDescr.hpp>
-#include <regex>
+#include <cstdint>
+#include <memory>
+#include <string>
+#include <vector>
 
 namespace xo {
     namespace web {
@@ -23,10 +26,12 @@ namespace xo {
 
         public:
             static std::unique_ptr<DynamicEndpoint> make_http(std::string uri_pattern,
-                                                              HttpEndpointFn http_cb) {
+                                                              HttpEndpointFn http_cb,
+                                                              std::string mime_type) {
                 return (std::unique_ptr<DynamicEndpoint>
                         (new DynamicEndpoint(std::move(uri_pattern),
                                              std::move(http_cb),
+                                             std::move(mime_type),
                                              nullptr,
                                              nullptr)));
             } /*make_http*/
@@ -37,6 +42,7 @@ namespace xo {
                 return (std::unique_ptr<DynamicEndpoint>
                         (new DynamicEndpoint(std::move(uri_pattern),
                                              nullptr,
+                                             std::string(),
                                              std::move(sub_fn),
                                              std::move(unsub_fn))));
             } /*make_stream*/
@@ -45,6 +51,13 @@ namespace xo {
                 return EndpointUtil::stem(this->uri_pattern_);
             } /*stem*/
 
+            std::string const & uri_pattern() const { return uri_pattern_; }
+            std::vector<std::string> const & var_v() const { return var_v_; }
+            std::vector<std::uint32_t> const & seg_var_ix_v() const { return seg_var_ix_v_; }
+
+            /* mime type for .http_response() output */
+            std::string const & mime_type() const { return mime_type_; }
+
 #ifdef NOT_USING
             /* true iff incoming_uri matches .uri_pattern */
             bool is_match(std::string const & incoming_uri) const {
@@ -56,11 +69,14 @@ namespace xo {
 #endif
 
             /* get html from this endpoint,  on behalf of uri=incoming_uri;
-             * write html on *p_os
+             * write html on *p_os.
+             * alist holds values for .var_v,  captured from incoming_uri
+             * while routing (see EndpointRouter.lookup())
              *
              * require: non-null http_fn
              */
             void http_response(std::string const & incoming_uri,
+                               Alist const & alist,
                                std::ostream * p_os) const;
 
             /* subscribe stream from this endpoint,  on behalf of uri=incoming_uri.
@@ -78,6 +94,7 @@ namespace xo {
         private:
             explicit DynamicEndpoint(std::string uri_pattern,
                                      HttpEndpointFn http_fn,
+                                     std::string mime_type,
                                      StreamSubscribeFn subscribe_fn,
                                      StreamUnsubscribeFn unsubscribe_fn);
 
@@ -91,29 +108,39 @@ namespace xo {
              *     /fixed/stem/apple/more/fixed/stuff/bananas
              *    --> invoke callback with Alist
              *        ("a" -> "apple", "b" -> "bananas")
-             *    endpoint will be stored in WebserverImpl.stem_map
-             *    under fixed prefix,  in this case
-             *     /fixed/stem/
+             *    endpoint will be stored in an EndpointRouter,
+             *    at the trie node for path segments
+             *     ["", "fixed", "stem", ${}, "more", "fixed", "stuff", ${}]
              *
              * 2. will not match uris like:
              *     /fixed/stem/app/le/more/fixed/stuff/bononos
+             *
+             * a variable must occupy an entire path segment
              */
             std::string uri_pattern_;
-            /* regex for matching input that satisfies .uri_pattern:
-             * each occurrence of
-             *    ${...} replaced by [[:alnum:]]+
-             */
-            std::regex uri_regex_;
             /* variables found in .uri_pattern,
-             * in the order in which they appear
+             * in the order in which they first appear.
              * if .uri_pattern is
              *   /fixed/stem/${a}/more/fixed/stuff/${b}
              * then .var_v will be:
              *   ["a", "b"]
+             * a variable that appears more than once is recorded once,
+             * so for
+             *   /fixed/stem/${a}/more/fixed/stuff/${b}/${a}
+             * .var_v is also ["a", "b"]
              */
             std::vector<std::string> var_v_;
+            /* one entry per variable segment of .uri_pattern:
+             * index of that segment's variable in .var_v.
+             * for
+             *   /fixed/stem/${a}/more/fixed/stuff/${b}/${a}
+             * .seg_var_ix_v is [0, 1, 0]
+             */
+            std::vector<std::uint32_t> seg_var_ix_v_;
             /* run this function to produce an http response */
             HttpEndpointFn http_fn_;
+            /* mime type for output from .http_fn */
+            std::string mime_type_;
             /* run this function to subscribe event stream */
             StreamSubscribeFn subscribe_fn_;
             /* run this function to unsubscribe event stream */
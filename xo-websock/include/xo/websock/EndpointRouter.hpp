@@ -0,0 +1,111 @@
+/* file EndpointRouter.hpp
+ *
+ * author: Roland Conybeare, Oct 2026
+ */
+
+#pragma once
+
+#include "DynamicEndpoint.hpp"
+#include <xo/webutil/Alist.hpp>
+#include <map>
+#include <memory>
+#include <string>
+#include <string_view>
+#include <vector>
+
+namespace xo {
+    namespace web {
+        /* routing table for dynamic endpoints (http or stream).
+         *
+         * Trie over '/'-delimited path segments of registered uri patterns.
+         * Each trie edge is either a literal segment,  or a variable segment ${..};
+         * endpoint lives at the node reached by its complete pattern.
+         *
+         * e.g. with patterns
+         *   /uls/snap
+         *   /uls/colsnap/n/${n}
+         *   /uls/colsnap/dt/${ms}
+         * have trie:
+         *
+         *   "" -> "uls" +-> "snap"                           [/uls/snap]
+         *               \-> "colsnap" +-> "n" -> ${}         [/uls/colsnap/n/${n}]
+         *                             \-> "dt" -> ${}        [/uls/colsnap/dt/${ms}]
+         *
+         * Literal edges are preferred over variable edges;
+         * backtracks to variable edge only if literal edge fails to match
+         * the rest of the uri.  A uri segment at depth d is only ever compared
+         * with edges out of depth-d nodes,  so routing visits each trie node
+         * at most once.
+         *
+         * Cost:
+         * - without backtracking (e.g. no node has both a literal and a variable
+         *   edge on the path taken),  one node per path segment,  so depends
+         *   on uri length,  not #of registered endpoints.
+         * - worst case,  bounded by #of trie nodes at depth <= #of uri segments;
+         *   e.g. patterns /a/b/c and /${x}/${y}/d with uri /a/b/d visit
+         *   the literal path a,b before backtracking to ${x},${y}.
+         *
+         * Not thread-safe;  see WebserverImpl.endpoint_mutex
+         */
+        class EndpointRouter {
+        public:
+            EndpointRouter();
+            ~EndpointRouter();
+
+            /* #of registered endpoints */
+            std::size_t size() const { return n_endpoint_; }
+
+            /* add endpoint,  replacing any existing endpoint with
+             * the same pattern (ignoring variable names).
+             * router gives up its reference to a replaced endpoint;
+             * endpoint is destroyed once holders of pointers from .lookup()
+             * (e.g. active subscriptions) release theirs.
+             * throws if pattern has a variable that doesn't occupy
+             * an entire path segment,  e.g. /foo/bar${x}
+             */
+            void insert(std::unique_ptr<DynamicEndpoint> endpoint);
+
+            /* find endpoint whose pattern matches incoming_uri;
+             * nullptr if none.
+             * on match,  if p_alist is non-null,  append values for endpoint's
+             * pattern variables to *p_alist (see DynamicEndpoint.var_v).
+             * returned pointer stays valid after endpoint is replaced,
+             * so caller may use it after releasing any lock on the router
+             */
+            std::shared_ptr<DynamicEndpoint> lookup(std::string_view incoming_uri,
+                                                    Alist * p_alist) const;
+
+        private:
+            /* trie node */
+            struct Node {
+                /* edges for literal path segments */
+                std::map<std::string, std::unique_ptr<Node>, std::less<>> literal_map_;
+                /* edge for a variable path segment ${..} */
+                std::unique_ptr<Node> var_child_;
+                /* endpoint whose pattern ends at this node,  if any */
+                std::shared_ptr<DynamicEndpoint> endpoint_;
+            }; /*Node*/
+
+            /* match remainder of incoming_uri,  starting at position pos,
+             * against subtrie at node.  pos=npos when uri exhausted.
+             * returns node holding matched endpoint,  or nullptr.
+             * on success,  *p_capture_v holds values for variable segments,
+             * in uri order
+             */
+            static Node const * match(Node const * node,
+                                           std::string_view incoming_uri,
+                                           std::size_t pos,
+                                           std::vector<std::string_view> * p_capture_v);
+
+        private:
+            /* trie root;  edges from root match the 1st path segment
+             * (empty for uris that begin with '/')
+             */
+            std::unique_ptr<Node> root_;
+            /* #of endpoints stored in trie */
+            std::size_t n_endpoint_ = 0;
+        }; /*EndpointRouter*/
+    } /*namespace web*/
+} /*namespace xo*/
+
+/* end EndpointRouter.hpp */
@@ -6,6 +6,7 @@
 #pragma once
 
 #include <string>
+#include <string_view>
 
 namespace xo {
     namespace web {
@@ -18,6 +19,39 @@ namespace xo {
              * e.g. stem("/dyn/uls/${ulticker}/snap") => "/dyn/uls/"
              */
             static std::string stem(std::string const & pattern);
+
+            /* path segment of path starting at *p_pos;
+             * advance *p_pos past the following '/',  or to npos at end of path.
+             * segments are delimited by '/',  so "/a/b" has segments ["", "a", "b"].
+             *
+             * require: *p_pos != npos
+             */
+            static std::string_view next_segment(std::string_view path,
+                                                 std::size_t * p_pos) {
+                std::size_t p = *p_pos;
+                std::size_t q = path.find('/', p);
+
+                if (q == std::string_view::npos) {
+                    *p_pos = q;
+                    return path.substr(p);
+                } else {
+                    *p_pos = q + 1;
+                    return path.substr(p, q - p);
+                }
+            } /*next_segment*/
+
+            /* true iff path segment seg is a pattern variable,  i.e. exactly ${name};
+             * if so,  report name in *p_name
+             *
+             * e.g. var_segment("${ulticker}", &name) => true, name="ulticker"
+             *      var_segment("snap", &name) => false
+             */
+            static bool var_segment(std::string_view seg, std::string_view * p_name);
+
+            /* true iff path segment seg contains "${",
+             * whether or not it's a well-formed variable segment
+             */
+            static bool has_var(std::string_view seg);
         }; /*EndpointUtil*/
 
     } /*namespace web*/
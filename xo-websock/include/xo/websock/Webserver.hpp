@@ -2,6 +2,8 @@
 
 #pragma once
 
+#include "WsMessageBuffer.hpp"
+#include "WsSendQueue.hpp"
 #include <xo/printjson/PrintJson.hpp>
 #include <xo/webutil/HttpEndpointDescr.hpp>
 #include <xo/webutil/StreamEndpointDescr.hpp>
@@ -26,21 +28,34 @@ namespace xo {
         } /*operator<<*/
 
         class WebserverConfig {
+        public:
+            /* default per-session outbound queue capacity (#of messages) */
+            static constexpr std::uint32_t c_default_send_queue_capacity = 1024;
+
         public:
             WebserverConfig() = default;
             WebserverConfig(std::int32_t port,
                             bool tls_flag,
                             bool host_check_flag,
-                            bool use_retry_flag)
+                            bool use_retry_flag,
+                            std::uint32_t n_service_thread = 1,
+                            std::uint32_t send_queue_capacity = c_default_send_queue_capacity,
+                            WsOverflowPolicy overflow_policy = WsOverflowPolicy::drop_oldest)
                 : port_{port},
                   tls_flag_{tls_flag},
                   host_check_flag_{host_check_flag},
-                  use_retry_flag_{use_retry_flag} {}
+                  use_retry_flag_{use_retry_flag},
+                  n_service_thread_{n_service_thread},
+                  send_queue_capacity_{send_queue_capacity},
+                  overflow_policy_{overflow_policy} {}
 
             std::int32_t port() const { return port_; }
             bool tls_flag() const { return tls_flag_; }
             bool host_check_flag() const { return host_check_flag_; }
             bool use_retry_flag() const { return use_retry_flag_; }
+            std::uint32_t n_service_thread() const { return n_service_thread_; }
+            std::uint32_t send_queue_capacity() const { return send_queue_capacity_; }
+            WsOverflowPolicy overflow_policy() const { return overflow_policy_; }
 
         private:
             /* accept incoming http requests on this port# */
@@ -51,11 +66,21 @@ namespace xo {
             bool host_check_flag_ = false;
             /* see lws_context_creation_info.retry_and_idle_policy */
             bool use_retry_flag_ = false;
+            /* #of libwebsockets service threads,  each with its own lws context,
+             * all listening on .port (kernel spreads incoming connections).
+             * a websocket session stays on the thread that accepted it
+             */
+            std::uint32_t n_service_thread_ = 1;
+            /* capacity of each websocket session's outbound queue */
+            std::uint32_t send_queue_capacity_ = c_default_send_queue_capacity;
+            /* what to do when a session's outbound queue is full */
+            WsOverflowPolicy overflow_policy_ = WsOverflowPolicy::drop_oldest;
         }; /*WebserverConfig*/
 
         /* libwebsocket:
          * 1. doesn't support multiple threads
-         *    (actually, looks like it does on further examination)
+         *    (actually, looks like it does on further examination;
+         *     see WebserverConfig.n_service_thread)
          * 2. doesn't expose listening ports etc (at least afaik);
          *    in other words it expects to take over application's main thread
          *
@@ -94,7 +119,7 @@ namespace xo {
             /* start thread for this webserver; idempotent */
             virtual void start_webserver() = 0;
             /* stop thread for this webserver;  suitable for calling
-             * from interrupt handler
+             * from interrupt handler (lock-free, async-signal-safe)
              */
             virtual void interrupt_stop_webserver() = 0;
             /* stop thread for this webserver; idempotent */
@@ -102,9 +127,19 @@ namespace xo {
             /* wait until webserver thread stopped */
             virtual void join_webserver() = 0;
 
+            /* outbound-traffic metrics,  one entry per open websocket session */
+            virtual std::vector<WsSessionStats> session_stats() const = 0;
+
             /* send text to a websocket session identified by session_id */
             virtual void send_text(uint32_t session_id,
                                    std::string text) = 0;
+            /* send message *p_msg to websocket session identified by session_id.
+             * Takes message contents without copying;
+             * on return *p_msg is empty,  holding recycled storage
+             * for caller to build its next message in.
+             */
+            virtual void send_message(uint32_t session_id,
+                                      WsMessageBuffer * p_msg) = 0;
 
             // ----- Inherited from Displayable -----
 
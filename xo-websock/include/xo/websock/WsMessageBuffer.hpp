@@ -0,0 +1,157 @@
+/* file WsMessageBuffer.hpp
+ *
+ * author: Roland Conybeare, Oct 2026
+ */
+
+#pragma once
+
+#include <libwebsockets.h>
+#include <algorithm>
+#include <cstring>
+#include <streambuf>
+#include <string_view>
+#include <utility>
+#include <vector>
+
+namespace xo {
+    namespace web {
+        /* reusable buffer for one outbound websocket message,
+         * laid out the way ::lws_write() wants it:
+         *
+         *    +---...---+---...--------+---...---+
+         *    | LWS_PRE | text payload | (spare) |
+         *    +---...---+---...--------+---...---+
+         *    ^         ^              ^         ^
+         *    .buf_v    .text()        pptr()    epptr()
+         *
+         * First LWS_PRE bytes are headroom owned by libwebsockets;
+         * application never touches them.
+         *
+         * Also a std::streambuf:  an ostream attached to a WsMessageBuffer
+         * formats directly into the payload area,  so a message can be built
+         * (e.g. by PrintJson) and handed to Webserver::send_message()
+         * without intermediate std::string copies.
+         *
+         * Storage is retained across .clear(),  so after warmup,
+         * building a message doesn't allocate.
+         * Webserver::send_message() swaps storage with the session's
+         * (already-sent) output buffer,  so handoff doesn't copy either.
+         */
+        class WsMessageBuffer : public std::streambuf {
+        public:
+            /* bytes reserved ahead of payload for libwebsockets */
+            static constexpr std::size_t c_headroom = LWS_PRE;
+
+        public:
+            WsMessageBuffer() = default;
+            explicit WsMessageBuffer(std::string_view text) { this->append(text); }
+            WsMessageBuffer(WsMessageBuffer && x) noexcept { this->swap(x); }
+            WsMessageBuffer(WsMessageBuffer const & x) = delete;
+
+            WsMessageBuffer & operator=(WsMessageBuffer && x) noexcept {
+                this->swap(x);
+                x.clear();
+                return *this;
+            }
+            WsMessageBuffer & operator=(WsMessageBuffer const & x) = delete;
+
+            /* non-const access required.
+             * lws_write() will prepend headers in .buf_v[0..LWS_PRE-1]
+             */
+            unsigned char * text() { return reinterpret_cast<unsigned char *>(this->pbase()); }
+            unsigned char const * text() const { return reinterpret_cast<unsigned char const *>(this->pbase()); }
+            std::size_t text_z() const { return this->pptr() - this->pbase(); }
+            /* payload size that can be stored without reallocating */
+            std::size_t text_capacity() const { return this->epptr() - this->pbase(); }
+
+            std::string_view text_view() const {
+                return std::string_view(this->pbase(), this->text_z());
+            }
+
+            /* discard payload;  keeps storage */
+            void clear() { this->reset_put_area(0); }
+
+            /* ensure payload capacity at least z;  preserves current payload */
+            void reserve_text(std::size_t z) {
+                if (z > this->text_capacity())
+                    this->expand_to(z);
+            }
+
+            void append(char const * s, std::size_t n) { this->xsputn(s, n); }
+            void append(std::string_view s) { this->xsputn(s.data(), s.size()); }
+
+            void swap(WsMessageBuffer & x) noexcept {
+                std::size_t z = this->text_z();
+                std::size_t x_z = x.text_z();
+
+                this->buf_v_.swap(x.buf_v_);
+
+                this->reset_put_area(x_z);
+                x.reset_put_area(z);
+            } /*swap*/
+
+        protected:
+            virtual std::streamsize xsputn(char const * s, std::streamsize n) override {
+                if (n <= 0)
+                    return 0;
+
+                std::size_t z = this->text_z();
+
+                this->reserve_text(z + n);
+
+                ::memcpy(this->pptr(), s, n);
+                this->pbump(n);
+
+                return n;
+            } /*xsputn*/
+
+            virtual int_type overflow(int_type ch) override {
+                if (traits_type::eq_int_type(ch, traits_type::eof()))
+                    return traits_type::not_eof(ch);
+
+                this->reserve_text(this->text_z() + 1);
+
+                *(this->pptr()) = traits_type::to_char_type(ch);
+                this->pbump(1);
+
+                return ch;
+            } /*overflow*/
+
+        private:
+            /* grow storage (at least 2x),  preserve payload */
+            void expand_to(std::size_t z) {
+                std::size_t text_z = this->text_z();
+                std::size_t new_z = std::max(z, 2 * this->text_capacity());
+
+                /* aim for at least a typical event without reallocating */
+                new_z = std::max(new_z, std::size_t(256));
+
+                this->buf_v_.resize(c_headroom + new_z);
+                this->reset_put_area(text_z);
+            } /*expand_to*/
+
+            /* establish put area over payload region of .buf_v,
+             * with first z payload bytes occupied
+             */
+            void reset_put_area(std::size_t z) {
+                if (this->buf_v_.empty()) {
+                    this->setp(nullptr, nullptr);
+                } else {
+                    char * lo = reinterpret_cast<char *>(&(this->buf_v_[c_headroom]));
+                    char * hi = reinterpret_cast<char *>(this->buf_v_.data() + this->buf_v_.size());
+
+                    this->setp(lo, hi);
+                    this->pbump(static_cast<int>(z));
+                }
+            } /*reset_put_area*/
+
+        private:
+            /* storage: LWS_PRE bytes headroom, then payload.
+             * payload occupies [.pbase, .pptr);  [.pptr, .epptr) is spare
+             */
+            std::vector<unsigned char> buf_v_;
+        }; /*WsMessageBuffer*/
+    } /*namespace web*/
+} /*namespace xo*/
+
+/* end WsMessageBuffer.hpp */
@@ -10,16 +10,20 @@
 
 namespace xo {
     namespace web {
-        class WebserverImplWsThread;
+        class WsServiceThread;
         class WebsocketSessionRecd;
 
-        /* only websocket thread can obtain this token */
+        /* only websocket thread can obtain this token.
+         * with several service threads,  each has its own token;
+         * possession is evidence of running on the thread that services
+         * the lws context in question
+         */
         class WsSafetyToken : public SafetyToken<class WsSafetyToken_tag> {
         private:
-            friend class WebserverImplWsThread;
+            friend class WsServiceThread;
 
         private:
-            /* only WebserverImpl should construct this */
+            /* only WsServiceThread should construct this */
             WsSafetyToken() = default;
         }; /*WsSafetyToken*/
 
@@ -0,0 +1,266 @@
+/* file WsSendQueue.hpp
+ *
+ * author: Roland Conybeare, Oct 2026
+ */
+
+#pragma once
+
+#include "WsMessageBuffer.hpp"
+#include <algorithm>
+#include <atomic>
+#include <bit>
+#include <cstdint>
+#include <memory>
+#include <ostream>
+
+namespace xo {
+    namespace web {
+        /* what a session's outbound queue does with a new message when it's full */
+        enum class WsOverflowPolicy {
+            /* discard the incoming message */
+            drop_newest,
+            /* discard oldest queued message to make room */
+            drop_oldest,
+            /* discard entire backlog;  queue collapses to the incoming message.
+             * suits streams where each message supersedes its predecessors
+             * (e.g. snapshots):  a client that falls a full queue behind
+             * skips straight to current state
+             */
+            coalesce,
+        };
+
+        class WsOverflowPolicyUtil {
+        public:
+            static char const * policy_descr(WsOverflowPolicy x);
+        }; /*WsOverflowPolicyUtil*/
+
+        inline std::ostream & operator<<(std::ostream & os, WsOverflowPolicy x) {
+            os << WsOverflowPolicyUtil::policy_descr(x);
+            return os;
+        } /*operator<<*/
+
+        /* outbound-traffic metrics for one websocket session */
+        struct WsSessionStats {
+            /* websocket session id# */
+            std::uint32_t session_id_ = 0;
+            /* #of messages currently queued (approximate while traffic in flight) */
+            std::uint32_t queue_depth_ = 0;
+            /* high-water mark for .queue_depth */
+            std::uint32_t max_queue_depth_ = 0;
+            /* #of messages accepted into queue */
+            std::uint64_t n_enqueued_ = 0;
+            /* #of messages handed to libwebsockets */
+            std::uint64_t n_sent_ = 0;
+            /* #of messages discarded by overflow policy */
+            std::uint64_t n_dropped_ = 0;
+        }; /*WsSessionStats*/
+
+        /* bounded lock-free outbound queue for one websocket session.
+         *
+         * Application threads (e.g. WebsocketSink on a reactor thread) push;
+         * the session's libwebsockets service thread pops.
+         * Neither side blocks the other:  a slow client fills its own queue,
+         * and then loses messages according to WsOverflowPolicy,
+         * instead of stalling delivery to other sessions.
+         *
+         * Slot-sequence ring (after Vyukov's bounded mpmc queue),
+         * so that multiple producers are safe,  and so that a producer
+         * may also pop (to implement drop_oldest / coalesce).
+         *
+         * Messages move in and out by swapping WsMessageBuffer storage:
+         * .push() returns the slot's previous (already-sent) storage to the
+         * producer,  .pop() hands the consumer's previous storage back to the slot.
+         * So steady-state traffic doesn't allocate.
+         */
+        class WsSendQueue {
+        public:
+            /* create queue with room for at least capacity messages
+             * (rounded up to a power of 2)
+             */
+            WsSendQueue(std::uint32_t capacity, WsOverflowPolicy policy)
+                : policy_{policy}
+                {
+                    std::uint32_t n = std::bit_ceil(std::max(capacity, 2u));
+
+                    this->mask_ = n - 1;
+                    this->slot_v_.reset(new Slot[n]);
+
+                    for (std::uint32_t i = 0; i < n; ++i)
+                        this->slot_v_[i].seq_.store(i, std::memory_order_relaxed);
+                }
+
+            std::uint32_t capacity() const { return mask_ + 1; }
+            WsOverflowPolicy policy() const { return policy_; }
+
+            /* true once .close() has been called */
+            bool is_closed() const { return closed_flag_.load(std::memory_order_acquire); }
+
+            /* stop accepting messages:  subsequent .push() calls discard.
+             * messages already queued remain poppable
+             */
+            void close() { this->closed_flag_.store(true, std::memory_order_release); }
+
+            /* approximate #of queued messages */
+            std::uint32_t depth() const {
+                std::uint64_t tail = this->tail_.load(std::memory_order_relaxed);
+                std::uint64_t head = this->head_.load(std::memory_order_relaxed);
+
+                return (tail > head) ? tail - head : 0;
+            }
+
+            /* add message *p_msg to queue,  applying .policy if full.
+             * on return *p_msg is empty,  holding recycled storage.
+             *
+             * returns false iff *p_msg itself was discarded
+             * (drop_newest,  or queue closed)
+             */
+            bool push(WsMessageBuffer * p_msg) {
+                if (this->is_closed()) {
+                    p_msg->clear();
+                    return false;
+                }
+
+                while (!this->try_push(p_msg)) {
+                    if (this->policy_ == WsOverflowPolicy::drop_newest) {
+                        p_msg->clear();
+                        this->n_dropped_.fetch_add(1, std::memory_order_relaxed);
+
+                        return false;
+                    }
+
+                    /* make room:  evict one (drop_oldest) or all (coalesce) queued messages.
+                     * a concurrent pop may beat us to it,  that's fine too
+                     */
+                    WsMessageBuffer victim;
+                    std::uint32_t n_evict = ((this->policy_ == WsOverflowPolicy::coalesce)
+                                             ? this->capacity() : 1);
+
+                    for (std::uint32_t i = 0; (i < n_evict) && this->try_pop(&victim); ++i)
+                        this->n_dropped_.fetch_add(1, std::memory_order_relaxed);
+                }
+
+                this->n_enqueued_.fetch_add(1, std::memory_order_relaxed);
+
+                /* record high-water mark */
+                std::uint32_t d = this->depth();
+                std::uint32_t hwm = this->max_depth_.load(std::memory_order_relaxed);
+
+                while ((d > hwm)
+                       && !this->max_depth_.compare_exchange_weak(hwm, d, std::memory_order_relaxed))
+                    ;
+
+                return true;
+            } /*push*/
+
+            /* remove oldest message,  swapping it into *p_msg.
+             * previous contents of *p_msg are discarded;  its storage is kept by queue.
+             *
+             * returns false if queue is empty
+             */
+            bool pop(WsMessageBuffer * p_msg) {
+                if (this->try_pop(p_msg)) {
+                    this->n_sent_.fetch_add(1, std::memory_order_relaxed);
+                    return true;
+                }
+
+                return false;
+            } /*pop*/
+
+            /* report metrics;  .session_id left as 0 */
+            WsSessionStats stats() const {
+                WsSessionStats retval;
+
+                retval.queue_depth_ = this->depth();
+                retval.max_queue_depth_ = this->max_depth_.load(std::memory_order_relaxed);
+                retval.n_enqueued_ = this->n_enqueued_.load(std::memory_order_relaxed);
+                retval.n_sent_ = this->n_sent_.load(std::memory_order_relaxed);
+                retval.n_dropped_ = this->n_dropped_.load(std::memory_order_relaxed);
+
+                return retval;
+            } /*stats*/
+
+        private:
+            /* slot holding message for enqueue position p when .seq = p+1,
+             * or available for enqueue position p when .seq = p.
+             */
+            struct Slot {
+                std::atomic<std::uint64_t> seq_;
+                WsMessageBuffer msg_;
+            };
+
+            bool try_push(WsMessageBuffer * p_msg) {
+                std::uint64_t pos = this->tail_.load(std::memory_order_relaxed);
+
+                for (;;) {
+                    Slot & slot = this->slot_v_[pos & this->mask_];
+                    std::uint64_t seq = slot.seq_.load(std::memory_order_acquire);
+                    std::int64_t dif = static_cast<std::int64_t>(seq - pos);
+
+                    if (dif == 0) {
+                        if (this->tail_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                            slot.msg_.swap(*p_msg);
+                            p_msg->clear();
+
+                            slot.seq_.store(pos + 1, std::memory_order_release);
+
+                            return true;
+                        }
+                    } else if (dif < 0) {
+                        /* full */
+                        return false;
+                    } else {
+                        pos = this->tail_.load(std::memory_order_relaxed);
+                    }
+                }
+            } /*try_push*/
+
+            bool try_pop(WsMessageBuffer * p_msg) {
+                std::uint64_t pos = this->head_.load(std::memory_order_relaxed);
+
+                for (;;) {
+                    Slot & slot = this->slot_v_[pos & this->mask_];
+                    std::uint64_t seq = slot.seq_.load(std::memory_order_acquire);
+                    std::int64_t dif = static_cast<std::int64_t>(seq - (pos + 1));
+
+                    if (dif == 0) {
+                        if (this->head_.compare_exchange_weak(pos, pos + 1, std::memory_order_relaxed)) {
+                            p_msg->clear();
+                            slot.msg_.swap(*p_msg);
+
+                            slot.seq_.store(pos + this->mask_ + 1, std::memory_order_release);
+
+                            return true;
+                        }
+                    } else if (dif < 0) {
+                        /* empty */
+                        return false;
+                    } else {
+                        pos = this->head_.load(std::memory_order_relaxed);
+                    }
+                }
+            } /*try_pop*/
+
+        private:
+            /* behavior when queue is full */
+            WsOverflowPolicy policy_;
+            /* set by .close();  .push() discards once set */
+            std::atomic<bool> closed_flag_ = false;
+            /* .slot_v has .mask+1 slots */
+            std::uint32_t mask_ = 0;
+            std::unique_ptr<Slot[]> slot_v_;
+
+            /* next position to pop */
+            alignas(64) std::atomic<std::uint64_t> head_ = 0;
+            /* next position to push */
+            alignas(64) std::atomic<std::uint64_t> tail_ = 0;
+
+            /* metrics */
+            alignas(64) std::atomic<std::uint32_t> max_depth_ = 0;
+            std::atomic<std::uint64_t> n_enqueued_ = 0;
+            std::atomic<std::uint64_t> n_sent_ = 0;
+            std::atomic<std::uint64_t> n_dropped_ = 0;
+        }; /*WsSendQueue*/
+    } /*namespace web*/
+} /*namespace xo*/
+
+/* end WsSendQueue.hpp */
@@ -4,6 +4,7 @@
  */
 
 #include "DynamicEndpoint.hpp"
+#include <algorithm>
 
 namespace xo {
     using xo::web::Alist;
@@ -12,118 +13,45 @@ namespace xo {
     namespace web {
         DynamicEndpoint::DynamicEndpoint(std::string uri_pattern,
                                          HttpEndpointFn http_fn,
+                                         std::string mime_type,
                                          StreamSubscribeFn subscribe_fn,
                                          StreamUnsubscribeFn unsubscribe_fn)
             : uri_pattern_{std::move(uri_pattern)},
               http_fn_{std::move(http_fn)},
+              mime_type_{std::move(mime_type)},
               subscribe_fn_{std::move(subscribe_fn)},
               unsubscribe_fn_{std::move(unsubscribe_fn)}
         {
-            std::string r_pat;
-
-            /* 1st pass -- construct pattern regex .uri_regex
-             * to identify urls that belong to this endpoint
-             *
-             * using regex like:
-             *   \$\{[[:alnum:]]+\}
+            /* e.g. if .uri_pattern:
+             *   /fixed/stem/${a}/more/fixed/stuff/${b}/${a}
+             * then .var_v:
+             *   ["a", "b"]
+             * and .seg_var_ix_v:
+             *   [0, 1, 0]
+             * i.e. avoid extracting the same variable name twice
              */
-            {
-                std::regex var_rgx("\\$\\{[[:alnum:]]+\\}");
-
-                /* e.g. if .uri_pattern:
-                 *    /fixed/stem/${a}/more/fixed/stuff/${b}
-                 * then want r_pat:
-                 *    /fixed/stem/[[:alnum:]]+/more/fixed/stuff/[[:alnum:]]+
-                 * to find values pattern variables like ${a}, ${b}
-                 */
-                std::regex_replace(std::back_inserter(r_pat),
-                                   this->uri_pattern_.begin(),
-                                   this->uri_pattern_.end(),
-                                   var_rgx,
-                                   std::string("([[:alnum:]]+)"));
-
-                this->uri_regex_ = std::regex(r_pat);
-            }
+            std::string_view pat = this->uri_pattern_;
 
-            /* 2nd pass -- identify pattern variables */
-            {
-                /* regex for:
-                 *   \$\{([[:alnum:]]+)\}
-                 * use to match input like
-                 *   ${apple}
-                 * and also extract the variable name
-                 *   apple
-                 */
-                std::regex var_rgx("\\$\\{([[:alnum:]]+)\\}");
-                std::smatch match;
+            for (std::size_t p = 0; p != std::string_view::npos; ) {
+                std::string_view seg = EndpointUtil::next_segment(pat, &p);
+                std::string_view name;
 
-                std::string subject = this->uri_pattern_;
+                if (EndpointUtil::var_segment(seg, &name)) {
+                    auto ix = std::find(this->var_v_.begin(), this->var_v_.end(), name);
 
-                /* if subject like
-                 *   /fixed/stem/${a}/more/fixed/stuff/${b}
-                 * extract
-                 *   ["a", "b"]
-                 *
-                 * for
-                 *   /fixed/stem/${a}/more/fixed/stuff/${b}/${a}
-                 * also extract
-                 *   ["a", "b"]
-                 * i.e. avoid extracting the same variable name twice
-                 */
-                while (std::regex_search(subject, match, var_rgx)) {
-                    std::string v = match[1];
+                    if (ix == this->var_v_.end())
+                        ix = this->var_v_.insert(ix, std::string(name));
 
-                    bool present_flag = false;
-
-                    for (auto const & x : this->var_v_) {
-                        if (x == v) {
-                            present_flag = true;
-                            break;
-                        }
-                    }
-
-                    if (!present_flag)
-                        this->var_v_.push_back(match[1]);
-
-                    subject = match.suffix().str();
+                    this->seg_var_ix_v_.push_back(ix - this->var_v_.begin());
                 }
             }
         } /*ctor*/
 
         void
         DynamicEndpoint::http_response(std::string const & incoming_uri,
+                                       Alist const & alist,
                                        std::ostream * p_os) const
         {
-            /* send this uri argument list  callback.
-             * contains variables extracted from .uri_pattern
-             * (variables surrounded by ${...})
-             */
-            Alist alist;
-
-            /* extract pattern variables in uri
-             * c.f. 2nd pass in DynamicEndpoint.ctor
-             */
-            std::smatch match;
-            std::string subject = incoming_uri;
-
-            /* if subject like
-             *   /fixed/stem/apple/more/fixed/stuff/beagle
-             * with .uri_pattern
-             *   /fixed/stem/${a}/more/fixed/stuff/${b}
-             * then we have .uri_regex
-             *   /fixed/stem/([[:alnum:]]+)/more/fixed/stuff/([[:alnum:]]+)
-             * use this to extract values for keys in .var_v,
-             * in the same order
-             */
-            if (std::regex_match(subject, match, this->uri_regex_)) {
-                for (size_t i = 0, n = this->var_v_.size(); i<n; ++i) {
-                    std::string i_name = this->var_v_[i];
-                    std::string i_value = match[1+i];
-
-                    alist.push_back(i_name, i_value);
-                }
-            }
-
             this->http_fn_(incoming_uri, alist, p_os);
         } /*http_response*/
 
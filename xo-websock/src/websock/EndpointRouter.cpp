@@ -0,0 +1,144 @@
+/* file EndpointRouter.cpp
+ *
+ * author: Roland Conybeare, Oct 2026
+ */
+
+#include "EndpointRouter.hpp"
+#include "EndpointUtil.hpp"
+#include <xo/indentlog2/print/tostr.hpp>
+#include <algorithm>
+#include <stdexcept>
+
+namespace xo {
+    namespace web {
+        EndpointRouter::EndpointRouter() : root_{new Node()} {}
+
+        EndpointRouter::~EndpointRouter() = default;
+
+        void
+        EndpointRouter::insert(std::unique_ptr<DynamicEndpoint> endpoint)
+        {
+            using xo::pp::tostr;
+            using xo::pp::xtag;
+
+            std::string_view pat = endpoint->uri_pattern();
+
+            Node * node = this->root_.get();
+
+            for (std::size_t p = 0; p != std::string_view::npos; ) {
+                std::string_view seg = EndpointUtil::next_segment(pat, &p);
+                std::string_view name;
+
+                if (EndpointUtil::var_segment(seg, &name)) {
+                    if (!node->var_child_)
+                        node->var_child_.reset(new Node());
+
+                    node = node->var_child_.get();
+                } else if (EndpointUtil::has_var(seg)) {
+                    throw std::runtime_error(tostr("EndpointRouter::insert"
+                                                   ": pattern variable must occupy entire path segment",
+                                                   xtag("pattern", pat),
+                                                   xtag("segment", seg)));
+                } else {
+                    auto ix = node->literal_map_.find(seg);
+
+                    if (ix == node->literal_map_.end())
+                        ix = node->literal_map_.emplace(std::string(seg), new Node()).first;
+
+                    node = ix->second.get();
+                }
+            }
+
+            if (!node->endpoint_)
+                ++(this->n_endpoint_);
+
+            node->endpoint_ = std::move(endpoint);
+        } /*insert*/
+
+        EndpointRouter::Node const *
+        EndpointRouter::match(Node const * node,
+                              std::string_view incoming_uri,
+                              std::size_t pos,
+                              std::vector<std::string_view> * p_capture_v)
+        {
+            if (pos == std::string_view::npos)
+                return node->endpoint_ ? node : nullptr;
+
+            std::size_t next_pos = pos;
+            std::string_view seg = EndpointUtil::next_segment(incoming_uri, &next_pos);
+
+            /* 1. literal edge */
+            {
+                auto ix = node->literal_map_.find(seg);
+
+                if (ix != node->literal_map_.end()) {
+                    Node const * retval = match(ix->second.get(),
+                                                incoming_uri,
+                                                next_pos,
+                                                p_capture_v);
+                    if (retval)
+                        return retval;
+                }
+            }
+
+            /* 2. variable edge;  variables don't match empty segments */
+            if (node->var_child_ && !seg.empty()) {
+                p_capture_v->push_back(seg);
+
+                Node const * retval = match(node->var_child_.get(),
+                                            incoming_uri,
+                                            next_pos,
+                                            p_capture_v);
+                if (retval)
+                    return retval;
+
+                p_capture_v->pop_back();
+            }
+
+            return nullptr;
+        } /*match*/
+
+        std::shared_ptr<DynamicEndpoint>
+        EndpointRouter::lookup(std::string_view incoming_uri,
+                               Alist * p_alist) const
+        {
+            if (incoming_uri.empty())
+                return nullptr;
+
+            std::vector<std::string_view> capture_v;
+
+            Node const * node = match(this->root_.get(),
+                                      incoming_uri,
+                                      0 /*pos*/,
+                                      &capture_v);
+
+            if (!node)
+                return nullptr;
+
+            std::shared_ptr<DynamicEndpoint> const & endpoint = node->endpoint_;
+
+            if (p_alist) {
+                std::vector<std::string> const & var_v = endpoint->var_v();
+                std::vector<std::uint32_t> const & seg_var_ix_v = endpoint->seg_var_ix_v();
+
+                /* one capture per variable segment;  a variable that appears
+                 * more than once takes its value from its 1st appearance.
+                 * .var_v is in order of 1st appearance,  so a segment introduces
+                 * a new variable iff its index is the next one expected
+                 */
+                std::size_t n_var = 0;
+
+                for (std::size_t i = 0, n = std::min(seg_var_ix_v.size(), capture_v.size()); i < n; ++i) {
+                    if (seg_var_ix_v[i] == n_var) {
+                        p_alist->push_back(var_v[n_var], std::string(capture_v[i]));
+                        ++n_var;
+                    }
+                }
+            }
+
+            return endpoint;
+        } /*lookup*/
+    } /*namespace web*/
+} /*namespace xo*/
+
+/* end EndpointRouter.cpp */
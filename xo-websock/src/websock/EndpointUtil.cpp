@@ -4,6 +4,7 @@
  */
 
 #include "EndpointUtil.hpp"
+#include <cctype>
 
 namespace xo {
     namespace web {
@@ -32,6 +33,29 @@ namespace xo {
                 return pattern.substr(0, p);
             }
         } /*stem*/
+
+        bool
+        EndpointUtil::var_segment(std::string_view seg, std::string_view * p_name)
+        {
+            if ((seg.size() < 4) || !seg.starts_with("${") || !seg.ends_with('}'))
+                return false;
+
+            std::string_view name = seg.substr(2, seg.size() - 3);
+
+            for (char ch : name) {
+                if (!std::isalnum(static_cast<unsigned char>(ch)) && (ch != '_'))
+                    return false;
+            }
+
+            *p_name = name;
+            return true;
+        } /*var_segment*/
+
+        bool
+        EndpointUtil::has_var(std::string_view seg)
+        {
+            return (seg.find("${") != std::string_view::npos);
+        } /*has_var*/
     } /*namespace web*/
 } /*namespace xo*/
 
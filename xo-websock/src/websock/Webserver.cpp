@@ -18,9 +18,11 @@
 
 #include "Webserver.hpp"
 #include "DynamicEndpoint.hpp"
+#include "EndpointRouter.hpp"
 #include "WebsockUtil.hpp"
 #include "WebsocketSink.hpp"
 #include "WsSafetyToken.hpp"
+#include "WsSendQueue.hpp"
 #include <xo/printjson/PrintJson.hpp>
 #include <xo/indentlog2/print/tostr.hpp>
 #include <xo/ppsink/scope.hpp>
@@ -28,10 +30,10 @@
 #include <xo/ppsink/pretty_struct.hpp>
 #include <xo/ppsink/tag_ostream.hpp>   /* os << xtag(..) */
 #include <json/json.h> // for Json::Reader,  to parse json input
+#include <algorithm>
+#include <atomic>
 #include <condition_variable>
-#include <deque>
-#include <regex>
-#include <unordered_map>
+#include <shared_mutex>
 #include <vector>
 
 namespace xo {
@@ -65,21 +67,19 @@ namespace xo {
             return "???";
         } /*runstate_descr*/
 
-        /* both websocket and appl thread can obtain this token.
-         * see WebsocketSessionRecd.  Posession of this token is evidence
-         * caller holds WebsocketSessionRecd.mutex
-         */
-        class WsSessionSafetyToken : public SafetyToken<class WsSessionSafetyToken_tag> {
-        private:
-            friend class WebsocketSessionRecd;
-
-        private:
-            /* only WebsocketSessionRecd should construct this
-             * mutex argument present just to alert reader
-             */
-            WsSessionSafetyToken(std::unique_lock<std::mutex> const &) {}
-        }; /*WsSessionSafetyToken*/
+        char const *
+        WsOverflowPolicyUtil::policy_descr(WsOverflowPolicy x)
+        {
+#    define CASE(x) case WsOverflowPolicy::x: return #x
+            switch(x) {
+                CASE(drop_newest);
+                CASE(drop_oldest);
+                CASE(coalesce);
+            }
+#    undef CASE
 
+            return "???";
+        } /*policy_descr*/
 
         namespace {
             /* one of these is created for each client connecting to us */
@@ -87,7 +87,7 @@ namespace xo {
             struct OutputBuffer;
 
             /* editor bait:
-             *   WebserverImpl::send_text()
+             *   WebserverImpl::send_message()
              *   ws_pss
              *
              * NOTE:
@@ -126,67 +126,65 @@ namespace xo {
              */
             struct OutputBuffer {
             public:
-                OutputBuffer(uint32_t session_id) : session_id_{session_id} {}
+                OutputBuffer() = default;
                 ~OutputBuffer() = default;
 
                 uint32_t session_id() const { return session_id_; }
                 struct lws * wsi() const { return wsi_; }
+                WebsocketSessionRecd * session_recd() const { return session_recd_; }
 
                 /* non-const access required.
-                 * lws_write() will prepend headers in .buf_v[0..LWS_PRE-1]
+                 * lws_write() will prepend headers in LWS_PRE bytes before .text()
                  */
-                unsigned char * text() { return &(buf_v_[LWS_PRE]); }
-                unsigned char const * text() const { return &(buf_v_[LWS_PRE]); }
-                size_t text_z() const { return text_z_; }
+                unsigned char * text() { return msg_.text(); }
+                unsigned char const * text() const { return msg_.text(); }
+                size_t text_z() const { return msg_.text_z(); }
 
-                std::string_view text_view() const {
-                    return std::string_view((char const *)(this->text()),
-                                            this->text_z());
-                }
+                std::string_view text_view() const { return msg_.text_view(); }
 
                 bool is_busy() const { return this->sent_seq_ < this->stored_seq_; }
                 bool is_idle() const { return this->sent_seq_ == this->stored_seq_; }
 
                 void establish_wsi(struct lws * wsi) { this->wsi_ = wsi; }
 
+                /* called once,  when websocket session opens */
+                void establish_session(uint32_t session_id,
+                                       WebsocketSessionRecd * session_recd,
+                                       WsSafetyToken const &) {
+                    this->session_id_ = session_id;
+                    this->session_recd_ = session_recd;
+                }
+
                 bool is_writeable(WsSafetyToken const &) const { return is_writeable_; }
                 void set_is_writeable(bool x, WsSafetyToken const &) { is_writeable_ = x; }
 
-                /* caller must hold WebsocketSessionRecd.mutex;
-                 * evidenced by wsession_token
+                /* load next message (if any) from *p_send_q,  in preparation for
+                 * sending it.  takes message by swapping storage;
+                 * queue keeps storage for already-sent message.
+                 *
+                 * returns false if nothing queued.
+                 *
+                 * require: .is_idle()
                  */
-                void store_message(uint32_t msg_seq,
-                                   std::string const & text,
-                                   WsSessionSafetyToken const & wsession_token) {
+                bool load_message(WsSendQueue * p_send_q,
+                                  WsSafetyToken const & ws_safety_token) {
                     scope log(XO_ENTER0_(info));
 
-                    wsession_token.verify();
-
-                    if (sent_seq_ != stored_seq_) {
-                        log && log("store_message: attempt storing new msg_seq but sent_seq!=stored_seq",
-                                   xtag("sent_seq", sent_seq_),
-                                   xtag("stored_seq", stored_seq_),
-                                   xtag("msg_seq", msg_seq));
-                        assert(false);
-                    }
-
-                    size_t req_z = LWS_PRE + text.size();
+                    ws_safety_token.verify();
 
-                    if (this->buf_v_.size() < req_z)
-                        this->buf_v_.resize(req_z);
+                    assert(this->is_idle());
 
-                    this->text_z_ = text.size();
+                    if (!p_send_q->pop(&(this->msg_)))
+                        return false;
 
-                    ::memcpy(&(this->buf_v_[LWS_PRE]), text.c_str(), this->text_z_);
+                    log && log(xtag("buf", (void*)this->msg_.text()),
+                               xtag("text", this->msg_.text_view()),
+                               xtag("text_z", this->msg_.text_z()));
 
-                    log && log(xtag("buf", (void*)&(this->buf_v_[0])),
-                               xtag("msg_seq", msg_seq),
-                               xtag("text", text),
-                               xtag("text.size", text.size()),
-                               xtag("req_z", req_z));
+                    ++(this->stored_seq_);
 
-                    this->stored_seq_ = msg_seq;
-                } /*store_message*/
+                    return true;
+                } /*load_message*/
 
                 int lws_write_aux(WsSafetyToken const & ws_safety_token)
                     {
@@ -253,9 +251,14 @@ namespace xo {
 
             private:
                 /* identifies websocket session associated with this buffer
-                 * established permanently in ctor
+                 * established permanently from LWS_CALLBACK_ESTABLISHED
                  */
-                uint32_t session_id_;
+                uint32_t session_id_ = 0;
+
+                /* bookkeeping for this session;  owned by WebserverImpl.
+                 * established alongside .session_id
+                 */
+                WebsocketSessionRecd * session_recd_ = nullptr;
 
                 /* opaque pointer;  owned by libwebsocket + identifies this session.
                  * established once (per websocket session) from LWS_CALLBACK_ESTABLISHED
@@ -273,17 +276,16 @@ namespace xo {
                  */
                 bool is_writeable_ = false;
 
-                /* seq# of last message sent using this buffer;  .sent_seq chases .stored_seq */
+                /* #of messages sent using this buffer;  .sent_seq chases .stored_seq */
                 uint32_t sent_seq_ = 0;
-                /* seq# of last message stored using this buffer */
+                /* #of messages loaded into this buffer */
                 uint32_t stored_seq_ = 0;
 
                 /* buffer for outbound text.
-                 * using the first LWS_PRE + .text_z bytes.
-                 * 1st LWS_PRE bytes owned by lws library, must not touch these
+                 * LWS_PRE bytes of headroom (owned by lws library, must not touch these),
+                 * followed by .text_z bytes of payload
                  */
-                std::vector<unsigned char> buf_v_;
-                size_t text_z_ = 0;
+                WsMessageBuffer msg_;
             }; /*OutputBuffer*/
 
             /*
@@ -323,8 +325,6 @@ namespace xo {
 
                 struct per_session_data__minimal * pss_list; /* linked-list of live pss*/
 
-                uint32_t next_session_id_;
-
                 //struct msg amsg; /* the one pending message... */
                 //int current; /* the current message number we are caching */
             }; /*per_vhost_data__minimal*/
@@ -334,10 +334,10 @@ namespace xo {
         class WebsocketSubscriptionRecd {
         public:
             WebsocketSubscriptionRecd(std::string const & incoming_uri,
-                                      DynamicEndpoint * endpoint,
+                                      std::shared_ptr<DynamicEndpoint> endpoint,
                                       rp<AbstractSink> const & ws_sink)
                 : incoming_uri_{incoming_uri},
-                  endpoint_{endpoint},
+                  endpoint_{std::move(endpoint)},
                   ws_sink_{ws_sink}
                 {}
 
@@ -354,9 +354,11 @@ namespace xo {
             /* original subscription url */
             std::string incoming_uri_;
             /* endpoint that matched .subscribe_cmd
-             * (see WebserverImpl.stream_map)
+             * (see WebserverImpl.stream_router).
+             * shared with router;  keeps endpoint alive for .unsubscribe()
+             * if endpoint is replaced in the meantime
              */
-            DynamicEndpoint * endpoint_ = nullptr;
+            std::shared_ptr<DynamicEndpoint> endpoint_;
             /* id created when subscription established
              * (see CallbackSetImpl.add_callback())
              */
@@ -370,21 +372,47 @@ namespace xo {
         /* bookkeeping record for a websocket session.
          * WebserverImpl (below) keeps exactly one of these
          * for each active websocket session
+         *
+         * Outbound traffic:
+         * - application threads call .send_message():
+         *   push to .send_q (lock-free),  and wake the session's service thread
+         *   (at most one ::lws_cancel_service() per batch of messages;  see .wake_pending)
+         * - on wakeup,  session's service thread calls .lws_request_writeable():
+         *   asks lws for LWS_CALLBACK_SERVER_WRITEABLE,  writes nothing
+         * - from LWS_CALLBACK_SERVER_WRITEABLE,  service thread calls .lws_write_pending():
+         *   writes at most one message,  and asks for another callback while
+         *   .send_q is non-empty.
+         * So lws only ever holds one message per session;  backlog stays in .send_q,
+         * where WsOverflowPolicy applies.
          */
         class WebsocketSessionRecd {
         public:
-            WebsocketSessionRecd(OutputBuffer * output_buf) : output_buf_{output_buf} {
-                assert(this->output_buf_);
-            }
+            WebsocketSessionRecd(uint32_t session_id,
+                                 OutputBuffer * output_buf,
+                                 lws_context * lws_cx,
+                                 uint32_t send_queue_capacity,
+                                 WsOverflowPolicy overflow_policy)
+                : session_id_{session_id},
+                  output_buf_{output_buf},
+                  lws_cx_{lws_cx},
+                  send_q_{send_queue_capacity, overflow_policy}
+                {
+                    assert(this->output_buf_);
+                }
 
-            bool is_output_busy() const {
-                return (this->output_buf_
-                        && this->output_buf_->is_busy());
-            }
-            bool outbound_q_empty() const { return this->outbound_q_.empty(); }
+            uint32_t session_id() const { return session_id_; }
+            bool is_closed() const { return send_q_.is_closed(); }
+
+            WsSessionStats stats() const {
+                WsSessionStats retval = this->send_q_.stats();
+
+                retval.session_id_ = this->session_id_;
+
+                return retval;
+            } /*stats*/
 
             void subscribe_endpoint(std::string const & incoming_cmd,
-                                    DynamicEndpoint * endpoint,
+                                    std::shared_ptr<DynamicEndpoint> endpoint,
                                     rp<AbstractSink> const & ws_sink) {
 
                 scope log(XO_ENTER0_(info),
@@ -392,7 +420,7 @@ namespace xo {
 
                 std::unique_ptr<WebsocketSubscriptionRecd> sub_recd_uptr
                     (new WebsocketSubscriptionRecd(incoming_cmd,
-                                                   endpoint,
+                                                   std::move(endpoint),
                                                    ws_sink));
                 WebsocketSubscriptionRecd * sub_recd_addr = sub_recd_uptr.get();
 
@@ -409,125 +437,122 @@ namespace xo {
                     sub_recd_addr->subscribe();
             } /*subscribe_endpoint*/
 
-            void send_text(std::string text) {
+            /* send message *p_msg;  on return *p_msg is empty,
+             * holding recycled storage.  see Webserver::send_message()
+             *
+             * threadsafe, lock-free.
+             */
+            void send_message(WsMessageBuffer * p_msg) {
                 scope log(XO_ENTER0_(info));
 
-                std::unique_lock<std::mutex> lock(this->mutex_);
+                /* if queue is full,  applies overflow policy;
+                 * if session closed,  discards
+                 */
+                if (!this->send_q_.push(p_msg) && this->is_closed()) {
+                    log && log("session closed -> discard");
+                    return;
+                }
 
-                if (!(this->output_buf_)) {
-                    log && log("ws_pss.output_buf not present -> exit");
-                } else if (this->is_output_busy()) {
-                    log && log("ws_pss.output_msg busy, enqueue");
+                /* interrupt libwebsocket event loop,  unless wakeup already pending.
+                 * will send 'wait cancelled' event to the listening wsi
+                 * of this session's lws context;  service thread responds
+                 * via WebserverImpl::lws_request_writeable()
+                 */
+                if (!this->wake_pending_.exchange(true, std::memory_order_acq_rel))
+                    ::lws_cancel_service(this->lws_cx_);
+            } /*send_message*/
 
-                    /* previous message already in progress, enq or drop */
-                    this->enqueue_text(std::move(text),
-                                       WsSessionSafetyToken(lock));
+            /* ask lws to call back (LWS_CALLBACK_SERVER_WRITEABLE) when this
+             * session can accept data.  Called on wakeup from .send_message();
+             * doesn't write anything itself:  writing outside SERVER_WRITEABLE
+             * makes lws buffer without bound.
+             *
+             * Require:
+             * - MUST be invoked from the lws event loop that owns this session,
+             *   for threadsafety;  ws_safety_token provides evidence of this
+             */
+            void lws_request_writeable(WsSafetyToken const & ws_safety_token) {
+                ws_safety_token.verify();
 
-                    /* this message will eventually get sent via
-                     *   .lws_write_pending_traffic()
+                if (!(this->output_buf_)) {
+                    /* output message buffer not established,
+                     * or session closed
                      */
-                } else {
-                    /* send message now! */
-                    log && log("output_msg idle, send now");
-
-                    this->prepare_outbound_message(std::move(text),
-                                                   WsSessionSafetyToken(lock));
-
-                    /* can release lock,  won't be using for remainder of this function */
-                    lock.unlock();
-
-                    lws_context * lws_cx = ::lws_get_context(this->output_buf_->wsi());
+                    return;
+                }
 
-                    /* interrupt libwebsocket event loop.
-                     * will send 'wait cancelled' event to all sockets.
-                     *
-                     * Actually,  after testing -- looks like this sends to one wsi per protocol:
-                     * basically to the "listening" wsi,  not to websocket "session" wsi
-                     */
-                    ::lws_cancel_service(lws_cx);
+                /* clear before arming:  a message pushed after this point
+                 * triggers another wakeup
+                 */
+                this->wake_pending_.store(false, std::memory_order_seq_cst);
 
-                    /* NOTE: web documentation seems to suggest using lws_callback_on_writable():
-                     *
-                     *   trigger call from websocket thread to send data.
-                     *   will cause reentry via websocket thread into
-                     *     WebserverImpl::notify_minimal()
-                     *   with reason=LWS_CALLBACK_SERVER_WRITEABLE
-                     *
-                     * ^^^ Hmm,  doesn't seem to work this way.
-                     *     Suspect this would only work if socket currently
-                     *     in non-writeable state.
-                     */
-                    //lws_callback_on_writable(ws_pss->wsi);
-                }
-            } /*send_text*/
+                if (this->send_q_.depth() > 0)
+                    ::lws_callback_on_writable(this->output_buf_->wsi());
+            } /*lws_request_writeable*/
 
-            /* write some pending traffic from lws event loop
+            /* write (at most) one pending message,  from LWS_CALLBACK_SERVER_WRITEABLE.
+             * re-arms writeable callback while more messages are queued.
+             * returns false if ::lws_write() failed
              *
              * Require:
-             * - MUST be invoked from lws event loop,  for threadsafety;
-             *   ws_safety_token provides evidence of this
+             * - MUST be invoked from the lws event loop that owns this session,
+             *   for threadsafety;  ws_safety_token provides evidence of this
              */
-            void lws_write_pending(WsSafetyToken const & ws_safety_token) {
+            bool lws_write_pending(WsSafetyToken const & ws_safety_token) {
                 scope log(XO_ENTER0_(info));
 
                 log && log(xtag("output_buf", (void*)this->output_buf_));
 
-#ifdef OBSOLETE
-                per_session_data__minimal * ws_pss = this->ws_pss_;
-
-                if (!ws_pss) {
-                    lscope.log("null ws_pss, exit");
-                    return;
-                }
-#endif
-
                 if (!(this->output_buf_)) {
                     /* output message buffer not established,
-                     * implies nothing sent yet
+                     * or session closed
                      */
                     log && log("output_msg either not established or destroyed, exit");
-                    return;
+                    return true;
                 }
 
-                /* loop until no queued messages for this session */
-                for (;;) {
-                    if (!(this->output_buf_->is_writeable(ws_safety_token))) {
-                        /* call to lws_write() already in progress */
-                        log && log("output_buf not writeable (bc lws_write in progress)");
-                        return;
-                    }
+                if (!(this->output_buf_->is_writeable(ws_safety_token))) {
+                    /* call to lws_write() already in progress;
+                     * lws calls LWS_CALLBACK_SERVER_WRITEABLE again when it completes
+                     */
+                    log && log("output_buf not writeable (bc lws_write in progress)");
+                    return true;
+                }
 
-                    if (this->output_buf_->is_idle()) {
-                        /* already up-to-date for this session */
-                        log && log("output idle (up-to-date)");
-                        return;
-                    }
+                if (::lws_send_pipe_choked(this->output_buf_->wsi())) {
+                    /* socket not draining;  leave backlog in .send_q */
+                    log && log("send pipe choked");
 
-                    this->output_buf_->lws_write_aux(ws_safety_token);
+                    ::lws_callback_on_writable(this->output_buf_->wsi());
+                    return true;
+                }
 
-                    /* if there are any appl messages queued,  prepare to send another one */
-                    if (this->outbound_q_.empty()) {
-                        /* all caught up,  nothing left to send */
-                        log && log("up-to-date after write");
-                    } else {
-                        std::unique_lock<std::mutex> lock(this->mutex_);
+                if (this->output_buf_->is_idle()
+                    && !(this->output_buf_->load_message(&(this->send_q_), ws_safety_token)))
+                {
+                    /* all caught up,  nothing left to send */
+                    log && log("output idle (up-to-date)");
+                    return true;
+                }
 
-                        std::string text(this->dequeue_text(WsSessionSafetyToken(lock)));
+                if (this->output_buf_->lws_write_aux(ws_safety_token) < 0)
+                    return false;
 
-                        this->prepare_outbound_message(std::move(text),
-                                                       WsSessionSafetyToken(lock));
-                    }
-                }
+                /* one message per callback;  come back for the rest */
+                if (this->send_q_.depth() > 0)
+                    ::lws_callback_on_writable(this->output_buf_->wsi());
+
+                return true;
             } /*lws_write_pending*/
 
-            /* threadsafe */
+            /* called from lws event loop when session closes */
             void unsubscribe_all() {
                 std::lock_guard<std::mutex> lock(this->mutex_);
 
+                this->send_q_.close();
+
                 /* also drop .output_buf,
                  * to short-circuit any subsequent attempts to use .lws_write_pending()
-                 * (which will happen in response to LWS_CALLBACK_EVENT_WAIT_CANCELLED
-                 *  on any session)
                  */
                 for (auto & sub_ptr : this->active_subscription_v_)
                     sub_ptr->unsubscribe();
@@ -537,79 +562,98 @@ namespace xo {
             } /*unsubscribe_all*/
 
         private:
-            uint32_t generate_msg_seq() { return ++(this->last_msg_seq_); }
-
-            /* enqueue application-level message.
-             * use this when .ws_pss.outbound_buf is busy
+            /* websocket session id# for this session */
+            uint32_t session_id_ = 0;
+            /* output destined for this session.
+             * libws (via per_session_data__minimal) also points to
+             * .output_buf.   only touched from session's service thread
+             */
+            OutputBuffer * output_buf_ = nullptr;
+            /* lws context for service thread that owns this session */
+            lws_context * lws_cx_ = nullptr;
+            /* true when service thread has been (or is about to be) woken
+             * to drain .send_q
              */
-            void enqueue_text(std::string text,
-                              WsSessionSafetyToken const & /*wss_token*/) {
-                this->outbound_q_.push_back(std::move(text));
-            } /*enqueue_text*/
-
-            /* remove a deferred message from .outbound_q,
-             * and return it.  This can happen if output becomes
-             * available after being write-blocked
+            std::atomic<bool> wake_pending_ = false;
+            /* protects .active_subscription_v */
+            std::mutex mutex_;
+            /* active subscriptions established by this session */
+            std::vector<std::unique_ptr<WebsocketSubscriptionRecd>> active_subscription_v_;
+            /* outgoing messages,  waiting for service thread.
+             * bounded;  see WebserverConfig.overflow_policy.
+             * closed when session closes;  subsequent messages discarded
              */
-            std::string dequeue_text(WsSessionSafetyToken const & /*wss_token*/) {
-                assert(!this->outbound_q_.empty());
+            WsSendQueue send_q_;
+        }; /*WebsocketSessionRecd*/
 
-                std::string retval = std::move(this->outbound_q_.front());
+        /* defined in this translation unit, after WebserverImpl */
+        class WebserverImplWsThread;
+        class WebserverImpl;
 
-                this->outbound_q_.pop_front();
+        /* one libwebsockets service thread,  with its own lws context.
+         *
+         * WebserverImpl runs WebserverConfig.n_service_thread of these,
+         * all listening on the same port;  kernel distributes incoming
+         * connections (SO_REUSEPORT,  see LWS_SERVER_OPTION_ALLOW_LISTEN_SHARE).
+         * A websocket session is serviced by whichever thread accepted it,
+         * for its entire lifetime.
+         *
+         * lws_context_user() for the context gives back this WsServiceThread.
+         */
+        class WsServiceThread {
+        public:
+            WsServiceThread(WebserverImpl * websrv, uint32_t service_ix)
+                : websrv_{websrv}, service_ix_{service_ix}
+                {
+                    ::memset(&(this->cx_config_), 0, sizeof(this->cx_config_));
+                }
 
-                return retval;
-            } /*dequeue_text*/
+            WebserverImpl * websrv() const { return websrv_; }
+            uint32_t service_ix() const { return service_ix_; }
+            lws_context_creation_info * cx_config() { return &cx_config_; }
+            lws_context * lws_cx() const { return lws_cx_.load(std::memory_order_acquire); }
 
-            /* prepare outbound message for sending in contiguous memory;
-             * in particular prepends header.
-             *
-             * this can be called from either websocket or appl thread,
-             * so needs to be threadsafe.
+            /* a function taking .ws_safety_token as an argument,
+             * announces that it is being called from this service thread,
+             * i.e. reentrantly from ::lws_service(.lws_cx)
              */
-            void prepare_outbound_message(std::string text,
-                                          WsSessionSafetyToken const & wss_token) {
-                scope log(XO_ENTER0_(info));
+            WsSafetyToken const & ws_safety_token() const { return ws_safety_token_; }
 
-                /* sequence# for this outbound message */
-                uint32_t msg_seq = this->generate_msg_seq();
+            /* sessions serviced by this thread */
+            std::vector<WebsocketSessionRecd *> & session_v(WsSafetyToken const &) { return session_v_; }
 
-                this->output_buf_->store_message(msg_seq,
-                                                 std::move(text),
-                                                 wss_token);
+            void set_lws_cx(lws_context * x) { this->lws_cx_.store(x, std::memory_order_release); }
+            void set_thread(std::unique_ptr<std::thread> x) { this->thread_ptr_ = std::move(x); }
 
-                /* now ws_pss->output_msg_->is_busy() */
-                log && log("staged next write",
-                           xtag("wsi", (void*)this->output_buf_->wsi()),
-                           xtag("text_z", this->output_buf_->text_z()));
-            } /*prepare_outbound_message*/
+            void join() {
+                if (this->thread_ptr_) {
+                    this->thread_ptr_->join();
+                    this->thread_ptr_ = nullptr;
+                }
+            } /*join*/
 
         private:
-            /* output destined for this session
-             * libws (via per_session_data__minimal) also points to
-             * .output_buf
+            /* webserver that owns this thread */
+            WebserverImpl * websrv_ = nullptr;
+            /* index of this thread in WebserverImpl.service_v */
+            uint32_t service_ix_ = 0;
+            /* configuration record for .lws_cx;
+             * AFAIK require lifetime >= lws_context
              */
-            OutputBuffer * output_buf_ = nullptr;
-            /* protects .active_subscription_v, .last_msg_seq, .outbound_q */
-            std::mutex mutex_;
-            /* active subscriptions established by this session */
-            std::vector<std::unique_ptr<WebsocketSubscriptionRecd>> active_subscription_v_;
-            /* generate seq#'s for outgoing messages */
-            uint32_t last_msg_seq_ = 0;
-            /* when new outgoing message appears:
-             * 1. if .pss->output_msg empty,  allocate it and store message there;
-             *    invoke lws_callback_on_writeable(.pss->wsi) to get message sent asap
-             * 2. otherwise sending a previous message is in-progress;
-             *    put outgoing message to the back of .outbound_q
+            lws_context_creation_info cx_config_;
+            /* runtime state owned by LWS library.
+             * written by service thread;  read by .interrupt_stop_webserver()
              */
-            std::deque<std::string> outbound_q_;
-        }; /*WebsocketSessionRecd*/
-
-        using EndpointMap = std::unordered_map<std::string,
-                                               std::unique_ptr<DynamicEndpoint>>;
-
-        /* defined in this translation unit, after WebserverImpl */
-        class WebserverImplWsThread;
+            std::atomic<lws_context *> lws_cx_ = nullptr;
+            /* thread running WebserverImpl::run(this) */
+            std::unique_ptr<std::thread> thread_ptr_;
+            /* open websocket sessions serviced by this thread.
+             * only touched from this thread
+             */
+            std::vector<WebsocketSessionRecd *> session_v_;
+            /* evidence of running on this thread */
+            WsSafetyToken ws_safety_token_;
+        }; /*WsServiceThread*/
 
         class WebserverImpl : public Webserver {
         public:
@@ -617,7 +661,6 @@ namespace xo {
                           rp<PrintJson> const & pjson)
                 : ws_config_{ws_config},
                   pjson_{pjson},
-                  readjson_{Json::CharReaderBuilder().newCharReader()},
                   interrupt_flag_{false},
                   state_{Runstate::stopped}
                 {
@@ -632,17 +675,21 @@ namespace xo {
                 this->join_webserver();
             } /*dtor*/
 
-            virtual void run() = 0;
+            /* run service loop for svc.   borrows calling thread,  doesn't return
+             * until webserver stopped.
+             */
+            virtual void run(WsServiceThread * svc) = 0;
 
             // ----- Inherited from Webserver -----
 
-            virtual Runstate state() const override { return state_; }
+            virtual Runstate state() const override { return state_.load(std::memory_order_acquire); }
             virtual void register_http_endpoint(HttpEndpointDescr const & endpoint) override;
             virtual void register_stream_endpoint(StreamEndpointDescr const & endpoint) override;
             virtual void start_webserver() override;
             virtual void interrupt_stop_webserver() override;
             virtual void stop_webserver() override;
             virtual void join_webserver() override;
+            virtual std::vector<WsSessionStats> session_stats() const override;
 
         protected:
             void set_lws_log_level() {
@@ -745,14 +792,18 @@ namespace xo {
                 p_retry->secs_since_valid_hangup = 10;
             } /*init_retry*/
 
-            /* requires:
+            /* initialize lws context configuration for service thread svc
+             *
+             * requires:
              * - .pvo           initialized,  see .init_pvo()
              * - .protocol_v[]  initialized,  see .init_protocols()
              * - .mount_dynamic initialized,  see .init_mount_dynamic()
              * - .mount_static  initialized,  see .init_mount_static()
              * - .retry         initialized,  see .init_retry()
              */
-            void init_cx_config(lws_context_creation_info * p_cx_config) {
+            void init_cx_config(WsServiceThread * svc, uint32_t n_service) {
+                lws_context_creation_info * p_cx_config = svc->cx_config();
+
                 ::memset(p_cx_config, 0, sizeof(*p_cx_config));
                 p_cx_config->port       = this->ws_config_.port();
                 p_cx_config->vhost_name = "localhost";
@@ -764,7 +815,16 @@ namespace xo {
                 p_cx_config->protocols  = this->protocol_v_.data();
                 p_cx_config->mounts     = &(this->mount_static_);
                 /* userdata -- accessible from context with lws_context_user() */
-                p_cx_config->user       = (void*)this;
+                p_cx_config->user       = (void*)svc;
+
+#if defined(LWS_SERVER_OPTION_ALLOW_LISTEN_SHARE)
+                if (n_service > 1) {
+                    /* each service thread listens on .port */
+                    p_cx_config->options |= LWS_SERVER_OPTION_ALLOW_LISTEN_SHARE;
+                }
+#else
+                assert(n_service == 1);
+#endif
 
 #if defined(LWS_WITH_TLS)
                 if (this->ws_config_.tls_flag()) {
@@ -784,20 +844,15 @@ namespace xo {
                 }
             } /*init_cx_config*/
 
-            /* check for a DynamicEndpoint stored under stem;
-             * if found,  invoke it on incoming_uri to respond
-             *
-             * return.  true iff stem matched a dynamic endpoint;
-             */
-            DynamicEndpoint * lookup_dynamic_http_stem(std::string const & stem);
-
-            /* write dynamic http response for incoming_uri, on *p_os
+            /* write dynamic http response for incoming_uri, on *p_os;
+             * report its mime type in *p_mime_type.
              * incoming_uri will be suffix of original uri from browser,
              * following dynamic mount point [/dyn].
              * see .init_mount_dynamic()
              */
             void dynamic_http_response(std::string const & incoming_uri,
-                                       std::ostream * p_os);
+                                       std::ostream * p_os,
+                                       std::string * p_mime_type);
 
             /* act on incoming websocket command
              * expecting json like
@@ -812,23 +867,32 @@ namespace xo {
              */
             void notify_vhd(per_vhost_data__minimal * vhd);
 #endif
-            /* called from libwebsocket thread when creating a new websocket session */
+            /* #of service threads to run;  WebserverConfig.n_service_thread,
+             * unless lws can't share a listening port
+             */
+            uint32_t n_service_thread() const;
+
+            /* called from service thread svc when creating a new websocket session */
             void notify_ws_session_open(OutputBuffer * output_buf,
-                                        per_vhost_data__minimal * vhd,
+                                        WsServiceThread * svc,
                                         WsSafetyToken const & ws_safety_token);
-            /* called from libwebsocket thread whenever a websocket session is closed */
+            /* called from service thread svc whenever a websocket session is closed */
             void notify_ws_session_close(OutputBuffer * output_buf,
-                                         per_vhost_data__minimal * vhd,
+                                         WsServiceThread * svc,
                                          WsSafetyToken const & ws_safety_token);
 
             /* send text to the websocket session identified by session_id */
             void send_text(uint32_t session_id,
                            std::string text) override;
+            /* send message to the websocket session identified by session_id */
+            void send_message(uint32_t session_id,
+                              WsMessageBuffer * p_msg) override;
 
-            /* from lws event loop,  write any pending outbound traffic
-             * see .pending_session_q
+            /* from lws event loop for svc,  request writeable callbacks
+             * for sessions serviced by svc that have pending outbound traffic
              */
-            void lws_write_pending_traffic(WsSafetyToken const & ws_safety_token);
+            void lws_request_writeable(WsServiceThread * svc,
+                                       WsSafetyToken const & ws_safety_token);
 
         protected:
             /* callback for http protocol */
@@ -849,9 +913,6 @@ namespace xo {
             /* json printer (w/ plugins for reflected types) */
             rp<PrintJson> pjson_;
 
-            /* json reader */
-            std::unique_ptr<Json::CharReader> readjson_;
-
             /* --- 1. LWS configuration stuff (set once) ---*/
 
 #if defined(LWS_WITH_PLUGINS)
@@ -880,57 +941,52 @@ namespace xo {
              */
             lws_retry_bo_t retry_;
 
-            /* configuration record for lws context
-             * AFAIK require lifetime >= lws_context
-             */
-            lws_context_creation_info cx_config_;
-
-            /* runtime state owned by LWS library
-             * can get application-determined user data from a lws_context by
-             *   lws_context_user(.lws_cx)
-             */
-            lws_context * lws_cx_ = nullptr;
-
             /* --- 2. startup/shutdown control --- */
 
             /* set this to true to prevent further service loop iteration */
             std::atomic<bool> interrupt_flag_;
 
-            /* protects .state */
+            /* protects .service_v, .n_running_service;
+             * serializes transitions of .state,  except running -> stop_requested
+             * (see .interrupt_stop_webserver())
+             */
             std::mutex mutex_;
             std::condition_variable cond_;
 
             /* valid states
              *
-             *   .state           .thread_ptr
-             *   -----------------------------------------------
-             *   running          thread in WebserverImpl::run()
-             *   stop_requested   thread in WebserverImpl::run()
-             *   stopped          nullptr
+             *   .state           .service_v
+             *   -----------------------------------------------------
+             *   running          threads in WebserverImpl::run()
+             *   stop_requested   threads in WebserverImpl::run()
+             *   stopped          empty
+             *
+             * atomic,  so that .interrupt_stop_webserver() can update it
+             * without .mutex (e.g. from a signal handler)
              */
-            Runstate state_;
-            std::unique_ptr<std::thread> thread_ptr_;
+            std::atomic<Runstate> state_;
+            /* service threads;  see WebserverConfig.n_service_thread */
+            std::vector<std::unique_ptr<WsServiceThread>> service_v_;
+            /* #of service threads that haven't yet exited WebserverImpl::run() */
+            uint32_t n_running_service_ = 0;
 
             /* --- 3. plugin state (writable while server runs) --- */
 
-            /* map :: stem->http_fn,
-             * where
-             *  stem = "longest non-variable URI prefix"
-             *
-             * use .register_http_endpoint() to insert a new URI into this map
-             *
-             * this map used for http endpoints
+            /* protects .http_router, .stream_router.
+             * service threads take shared locks
              */
-            EndpointMap stem_map_;
-            /* map :: stem->subscribe_fn
-             * where
-             *  stem = "longest non-variable URI prefix"
+            mutable std::shared_mutex endpoint_mutex_;
+
+            /* routing table :: uri pattern -> http_fn
              *
-             * use .register_stream_endpoint() to insert a new URI into this map
+             * use .register_http_endpoint() to insert a new URI pattern
+             */
+            EndpointRouter http_router_;
+            /* routing table :: uri pattern -> subscribe_fn
              *
-             * this map used for stream endpoints
+             * use .register_stream_endpoint() to insert a new URI pattern
              */
-            EndpointMap stream_map_;
+            EndpointRouter stream_router_;
 
             /* --- 4. libwebsocket session manager --- */
 
@@ -948,7 +1004,13 @@ namespace xo {
              */
             per_vhost_data__minimal * ws_vhd_ = nullptr;
 
-            /* indexed by session id# (see per_session_data__minimal.session_id)
+            /* protects .session_v, .free_session_id_v.
+             * application threads (.send_message()) take shared locks;
+             * service threads take exclusive locks to open/close sessions
+             */
+            mutable std::shared_mutex session_mutex_;
+
+            /* indexed by session id# (see OutputBuffer.session_id)
              * .session_v.size() = {max #of simultaneously-open websocket sessions}.
              * may contain empty slots.   if .session_v[i] is empty,
              * then i appears in .free_session_id_v[], i..e .free_session_id_v[j]=i for some j
@@ -968,9 +1030,12 @@ namespace xo {
         WebserverImpl::register_http_endpoint(HttpEndpointDescr const & endpoint_descr)
         {
             auto endpoint = DynamicEndpoint::make_http(endpoint_descr.uri_pattern(),
-                                                       endpoint_descr.endpoint_fn());
+                                                       endpoint_descr.endpoint_fn(),
+                                                       endpoint_descr.mime_type());
+
+            std::unique_lock<std::shared_mutex> lock(this->endpoint_mutex_);
 
-            this->stem_map_[endpoint->stem()] = std::move(endpoint);
+            this->http_router_.insert(std::move(endpoint));
         } /*register_http_endpoint*/
 
         void
@@ -980,7 +1045,9 @@ namespace xo {
                                                          endpoint_descr.subscribe_fn(),
                                                          endpoint_descr.unsubscribe_fn());
 
-            this->stream_map_[endpoint->stem()] = std::move(endpoint);
+            std::unique_lock<std::shared_mutex> lock(this->endpoint_mutex_);
+
+            this->stream_router_.insert(std::move(endpoint));
         } /*register_stream_endpoint*/
 
 #ifdef DEFINED_BUT_NOT_USED
@@ -991,44 +1058,67 @@ namespace xo {
         } /*notify_vhd*/
 #endif
 
+        uint32_t
+        WebserverImpl::n_service_thread() const
+        {
+#if defined(LWS_SERVER_OPTION_ALLOW_LISTEN_SHARE)
+            return std::max(this->ws_config_.n_service_thread(), 1u);
+#else
+            /* this libwebsockets can't share a listening port between contexts */
+            return 1;
+#endif
+        } /*n_service_thread*/
+
         void
         WebserverImpl::notify_ws_session_open(OutputBuffer * output_buf,
-                                              per_vhost_data__minimal * vhd,
+                                              WsServiceThread * svc,
                                               WsSafetyToken const & ws_safety_token)
         {
             ws_safety_token.verify();
 
-            uint32_t new_id = output_buf->session_id();
+            WebsocketSessionRecd * ws_session_recd = nullptr;
 
-            if (this->session_v_.size() <= new_id)
-                this->session_v_.resize(new_id + 1);
+            {
+                std::unique_lock<std::shared_mutex> lock(this->session_mutex_);
 
-            this->session_v_[new_id].reset(new WebsocketSessionRecd(output_buf));
+                /* recycle a previously-used session id if possible,
+                 * to keep .session_v from growing without bound
+                 */
+                uint32_t new_id = 0;
 
-            /* control comes here when a new websocket session is created,
-             * after LWS_CALLBACK_HTTP_BIND_PROTOCOL
-             */
-            output_buf->set_is_writeable(true, ws_safety_token);
+                if (this->free_session_id_v_.empty()) {
+                    new_id = this->session_v_.size();
+                    this->session_v_.resize(new_id + 1);
+                } else {
+                    new_id = this->free_session_id_v_.back();
+                    this->free_session_id_v_.pop_back();
+                }
 
-            /* compute next available session id + store in vhost struct */
+                this->session_v_[new_id].reset
+                    (new WebsocketSessionRecd(new_id,
+                                              output_buf,
+                                              svc->lws_cx(),
+                                              this->ws_config_.send_queue_capacity(),
+                                              this->ws_config_.overflow_policy()));
 
-            if (this->free_session_id_v_.empty()) {
-                /* generate a new session id */
-                uint32_t id = this->session_v_.size();
+                ws_session_recd = this->session_v_[new_id].get();
+            }
 
-                vhd->next_session_id_ = id;
-            } else {
-                /* recycle a previously-used session id */
-                uint32_t id = this->free_session_id_v_[this->free_session_id_v_.size() - 1];
-                this->free_session_id_v_.pop_back();
+            output_buf->establish_session(ws_session_recd->session_id(),
+                                          ws_session_recd,
+                                          ws_safety_token);
 
-                vhd->next_session_id_ = id;
-            }
+            svc->session_v(ws_safety_token).push_back(ws_session_recd);
+
+            /* control comes here when a new websocket session is created,
+             * after LWS_CALLBACK_HTTP_BIND_PROTOCOL
+             */
+            output_buf->set_is_writeable(true, ws_safety_token);
         } /*notify_ws_session_open*/
 
         void
         WebserverImpl::notify_ws_session_close(OutputBuffer * output_buf,
-                                               per_vhost_data__minimal * /*vhd*/,
+                                               WsServiceThread * svc,
                                                WsSafetyToken const & ws_safety_token)
         {
             scope log(XO_ENTER0_(info));
@@ -1037,18 +1127,31 @@ namespace xo {
                        xtag("this", (void*)this),
                        xtag("output_buf", (void*)output_buf));
 
-            assert(output_buf->session_id() < this->session_v_.size());
-
             ws_safety_token.verify();
 
-            WebsocketSessionRecd * ws_session_recd
-                = this->session_v_[output_buf->session_id()].get();
+            WebsocketSessionRecd * ws_session_recd = output_buf->session_recd();
+
+            if (!ws_session_recd) {
+                /* session never established */
+                return;
+            }
+
+            ws_session_recd->unsubscribe_all();
+
+            {
+                auto & svc_session_v = svc->session_v(ws_safety_token);
 
-            if (ws_session_recd) {
-                ws_session_recd->unsubscribe_all();
+                std::erase(svc_session_v, ws_session_recd);
             }
 
-            this->free_session_id_v_.push_back(output_buf->session_id());
+            {
+                std::unique_lock<std::shared_mutex> lock(this->session_mutex_);
+
+                /* session record stays in .session_v until its id is recycled;
+                 * application threads may still hold its id
+                 */
+                this->free_session_id_v_.push_back(output_buf->session_id());
+            }
         } /*notify_ws_session_close*/
 
         /* note: to access lws_protocols.user,
@@ -1063,7 +1166,8 @@ namespace xo {
         {
             lws_context * lws_cx = lws_get_context(wsi);
             void * cx_user_data = lws_context_user(lws_cx);
-            WebserverImpl * websrv = reinterpret_cast<WebserverImpl *>(cx_user_data);
+            WsServiceThread * svc = reinterpret_cast<WsServiceThread *>(cx_user_data);
+            WebserverImpl * websrv = svc ? svc->websrv() : nullptr;
 
             struct per_session_data__http * http_pss
                 = reinterpret_cast<struct per_session_data__http *>(user_data);
@@ -1108,26 +1212,27 @@ namespace xo {
                           http_pss->output_str, http_pss);
 
                 std::stringstream response_ss;
+                /* mime type chosen by endpoint */
+                std::string mime_type;
 
                 assert(websrv);
 
                 websrv->dynamic_http_response(incoming_uri,
-                                              &response_ss);
+                                              &response_ss,
+                                              &mime_type);
 
                 *(http_pss->output_str) = response_ss.str();
 
-                lwsl_user("LWS_CALLBACK_HTTP: got response [%s]",
-                          http_pss->output_str->c_str());
-
-                /* choose mime type */
-                constexpr char const * c_mime_type = "application/json";
+                lwsl_user("LWS_CALLBACK_HTTP: got response [%zu bytes, %s]",
+                          http_pss->output_str->size(),
+                          mime_type.c_str());
 
                 /* prepare and write http headers
                  * (do these precede &p ??)
                  */
                 if (lws_add_http_common_headers(wsi,
                                                 HTTP_STATUS_OK,
-                                                c_mime_type,
+                                                mime_type.c_str(),
                                                 http_pss->output_str->length(),
                                                 &p, end))
                     return 1;
@@ -1231,13 +1336,30 @@ namespace xo {
         void
         WebserverImpl::start_webserver()
         {
-            switch(state_) {
+            std::unique_lock<std::mutex> lock(this->mutex_);
+
+            switch(this->state_.load()) {
             case Runstate::stopped:
             {
-                std::unique_lock<std::mutex> lock(this->mutex_);
+                uint32_t n_service = this->n_service_thread();
+
+                this->interrupt_flag_ = false;
+                this->service_v_.clear();
+
+                for (uint32_t i = 0; i < n_service; ++i) {
+                    this->service_v_.push_back(std::make_unique<WsServiceThread>(this, i));
+                    this->init_cx_config(this->service_v_.back().get(), n_service);
+                }
+
+                this->n_running_service_ = n_service;
 
-                this->thread_ptr_.reset(new std::thread(&WebserverImpl::run, this));
-                this->state_ = Runstate::running;
+                for (auto & svc : this->service_v_) {
+                    svc->set_thread(std::make_unique<std::thread>(&WebserverImpl::run,
+                                                                  this,
+                                                                  svc.get()));
+                }
+
+                this->state_.store(Runstate::running);
             }
             break;
             case Runstate::stop_requested:
@@ -1250,102 +1372,31 @@ namespace xo {
             }
         } /*start_webserver*/
 
-        namespace {
-            DynamicEndpoint *
-            lookup_stem(std::string const & stem,
-                        EndpointMap const & ep_map)
-            {
-                scope log(XO_DEBUG_(true /*debug_flag*/),
-                          xtag("stem", stem));
-
-                auto ix = ep_map.find(stem);
-
-                if (ix != ep_map.end())
-                    return ix->second.get();
-                else
-                    return nullptr;
-            } /*lookup_stem*/
-
-            DynamicEndpoint *
-            lookup_pattern(std::string const & incoming_uri,
-                           EndpointMap const & ep_map)
-            {
-                if (incoming_uri.empty())
-                    return nullptr;
-
-                /* find longest prefix of incoming_uri that appears in .stem_map.
-                 *
-                 * 1. try the whole uri
-                 * 2. try successively shorter prefixes of uri that end in '/'
-                 * 3. try successively shorter prefixes of uri that do not end in '/'
-                 */
-
-                /* 1. try the whole uri */
-                DynamicEndpoint * endpoint = nullptr;
-
-                endpoint = lookup_stem(incoming_uri, ep_map);
-
-                if (!endpoint) {
-                    /* 2. try successively shorter prefixes of uri that end in '/'.
-                     *    we already checked for the whole uri,  so look for a match
-                     *    at or before the 2nd-last character
-                     */
-                    if (incoming_uri.size() >= 2) {
-                        std::string::size_type p = incoming_uri.size() - 1;
-
-                        while (!endpoint) {
-                            p = incoming_uri.find_last_of('/', p-1);
-
-                            if (p == std::string::npos)
-                                break;
-
-                            endpoint
-                                = lookup_stem(incoming_uri.substr(0, p+1), ep_map);
-
-                            if (p == 0)
-                                break;
-                        }
-                    }
-                }
-
-                if (!endpoint) {
-                    /* 3. try successively shorter prefixes of uri that don't end in '/'.
-                     */
-                    if (incoming_uri.size() >= 2) {
-                        std::string::size_type p = incoming_uri.size() - 2;
-
-                        while (!endpoint) {
-                            if (incoming_uri[p] == '/') {
-                                /* all stems ending in '/' have already been excluded */
-                                ;
-                            } else {
-                                endpoint
-                                    = lookup_stem(incoming_uri.substr(0, p+1), ep_map);
-                            }
-
-                            if (p == 0)
-                                break;
-
-                            --p;
-                        }
-                    }
-                }
-
-                return endpoint;
-            } /*lookup_pattern*/
-        } /*namespace*/
-
         void
         WebserverImpl::dynamic_http_response(std::string const & incoming_uri,
-                                             std::ostream * p_os)
+                                             std::ostream * p_os,
+                                             std::string * p_mime_type)
         {
-            DynamicEndpoint * endpoint = lookup_pattern(incoming_uri,
-                                                        this->stem_map_);
+            /* values for pattern variables,  e.g. ${n} in /uls/colsnap/n/${n} */
+            Alist alist;
+
+            /* release lock before invoking endpoint:
+             * its callback may (un)register endpoints
+             */
+            std::shared_ptr<DynamicEndpoint> endpoint;
+            {
+                std::shared_lock<std::shared_mutex> lock(this->endpoint_mutex_);
+
+                endpoint = this->http_router_.lookup(incoming_uri, &alist);
+            }
 
             if (endpoint) {
-                endpoint->http_response(incoming_uri, p_os);
+                *p_mime_type = endpoint->mime_type();
+                endpoint->http_response(incoming_uri, alist, p_os);
                 return;
             } else {
+                *p_mime_type = "text/html";
+
                 /* if control here,  no match */
 
                 /* or replace pss->str, pss->len with whatever dynamic content you like */
@@ -1377,11 +1428,16 @@ namespace xo {
 
             Json::Value root;
 
+            /* reader per call:  Json::CharReader keeps parse state,
+             * and several service threads may get here concurrently
+             */
+            std::unique_ptr<Json::CharReader> readjson(Json::CharReaderBuilder().newCharReader());
+
             JSONCPP_STRING err;
-            bool ok = this->readjson_->parse(incoming_cmd.data(),
-                                             incoming_cmd.data() + incoming_cmd.size(),
-                                             &root,
-                                             &err);
+            bool ok = readjson->parse(incoming_cmd.data(),
+                                      incoming_cmd.data() + incoming_cmd.size(),
+                                      &root,
+                                      &err);
 
             if (!ok) {
                 log && log("error: parsing failed",
@@ -1400,8 +1456,17 @@ namespace xo {
 
                 log && log("subscribe stream", xtag("stream", stream_name));
 
-                DynamicEndpoint * endpoint = lookup_pattern(stream_name,
-                                                            this->stream_map_);
+                /* shared_ptr keeps endpoint alive even if a concurrent
+                 * .register_stream_endpoint() replaces it.
+                 * release lock before subscribing:  endpoint's subscribe callback
+                 * may (un)register endpoints
+                 */
+                std::shared_ptr<DynamicEndpoint> endpoint;
+                {
+                    std::shared_lock<std::shared_mutex> endpoint_lock(this->endpoint_mutex_);
+
+                    endpoint = this->stream_router_.lookup(stream_name, nullptr /*p_alist*/);
+                }
 
                 if (endpoint) {
                     log && log("endpoint found");
@@ -1420,12 +1485,18 @@ namespace xo {
                     assert(ws_sink->allow_polymorphic_source());
                     assert(ws_sink->allow_volatile_source());
 
-                    WebsocketSessionRecd * ws_recd = this->session_v_[session_id].get();
+                    WebsocketSessionRecd * ws_recd = nullptr;
+
+                    {
+                        std::shared_lock<std::shared_mutex> lock(this->session_mutex_);
+
+                        ws_recd = this->session_v_[session_id].get();
+                    }
 
                     assert(ws_recd);
 
                     ws_recd->subscribe_endpoint(std::string(incoming_cmd),
-                                                endpoint,
+                                                std::move(endpoint),
                                                 ws_sink);
                 } else {
                     log && log("endpoint not found");
@@ -1436,20 +1507,29 @@ namespace xo {
         void
         WebserverImpl::interrupt_stop_webserver()
         {
-            /* NOTE: this is threadsafe - ::lws_cancel_service()
-             *       writes to a pipe to interrupt polling loop
+            /* NOTE: threadsafe + async-signal-safe:
+             *       - takes no locks (.stop_webserver() calls this with .mutex held)
+             *       - .interrupt_flag and .state are lock-free atomics
+             *       - ::lws_cancel_service() writes to a pipe to interrupt polling loop
              */
-            {
-                this->interrupt_flag_ = true;
+            static_assert(std::atomic<Runstate>::is_always_lock_free);
 
-                if (this->lws_cx_) {
-                    ::lws_cancel_service(this->lws_cx_);
+            this->interrupt_flag_ = true;
+
+            for (auto & svc : this->service_v_) {
+                lws_context * lws_cx = svc->lws_cx();
+
+                if (lws_cx) {
+                    ::lws_cancel_service(lws_cx);
                 }
             }
 
-            std::unique_lock<std::mutex> lock(this->mutex_);
+            /* service threads may have already exited (state stopped);
+             * in that case leave state alone
+             */
+            Runstate expected = Runstate::running;
 
-            this->state_ = Runstate::stop_requested;
+            this->state_.compare_exchange_strong(expected, Runstate::stop_requested);
         } /*interrupt_stop_webserver*/
 
         void
@@ -1457,7 +1537,7 @@ namespace xo {
         {
             std::unique_lock<std::mutex> lock(this->mutex_);
 
-            if(this->state_ == Runstate::running) {
+            if(this->state_.load() == Runstate::running) {
                 this->interrupt_stop_webserver();
             }
         } /*stop_webserver*/
@@ -1467,23 +1547,51 @@ namespace xo {
             while(true) {
                 std::unique_lock<std::mutex> lock(this->mutex_);
 
-                if (this->state_ == Runstate::stopped)
+                if (this->state_.load() == Runstate::stopped)
                     break;
 
                 this->cond_.wait(lock);
             }
 
-            if (this->thread_ptr_) {
-                this->thread_ptr_->join();
-                this->thread_ptr_ = nullptr;
-            }
+            for (auto & svc : this->service_v_)
+                svc->join();
+
+            this->service_v_.clear();
         } /*join_webserver*/
 
+        std::vector<WsSessionStats>
+        WebserverImpl::session_stats() const
+        {
+            std::vector<WsSessionStats> retval;
+
+            std::shared_lock<std::shared_mutex> lock(this->session_mutex_);
+
+            for (auto const & session_ptr : this->session_v_) {
+                if (session_ptr && !session_ptr->is_closed())
+                    retval.push_back(session_ptr->stats());
+            }
+
+            return retval;
+        } /*session_stats*/
+
         void
         WebserverImpl::send_text(uint32_t session_id,
                                  std::string text)
+        {
+            WsMessageBuffer msg(text);
+
+            this->send_message(session_id, &msg);
+        } /*send_text*/
+
+        void
+        WebserverImpl::send_message(uint32_t session_id,
+                                    WsMessageBuffer * p_msg)
         {
             scope log(XO_ENTER0_(info));
+
+            /* shared lock:  only excludes session open/close */
+            std::shared_lock<std::shared_mutex> lock(this->session_mutex_);
+
             log && log(xtag("session_id", session_id),
                        xtag(".session_v.size", this->session_v_.size()));
 
@@ -1491,34 +1599,35 @@ namespace xo {
                 WebsocketSessionRecd * p_session_recd = this->session_v_[session_id].get();
 
                 if (p_session_recd)
-                    p_session_recd->send_text(text);
-
-                //per_session_data__minimal * ws_pss = p_session_recd->ws_pss();
-
-                //lscope.log(xtag("ws_pss", ws_pss),
-                //           xtag("ws_pss.wsi", ws_pss->wsi));
-
+                    p_session_recd->send_message(p_msg);
+                else
+                    p_msg->clear();
             } else {
                 assert(false);
+
+                p_msg->clear();
             }
-        } /*send_text*/
+        } /*send_message*/
 
         void
-        WebserverImpl::lws_write_pending_traffic(WsSafetyToken const & ws_safety_token)
+        WebserverImpl::lws_request_writeable(WsServiceThread * svc,
+                                             WsSafetyToken const & ws_safety_token)
         {
             scope log(XO_ENTER0_(info));
 
             ws_safety_token.verify();
 
-            for (auto & session_ptr : this->session_v_) {
-                if (session_ptr)
-                    session_ptr->lws_write_pending(ws_safety_token);
-            }
-        } /*lws_write_pending_traffic*/
-
-        /* sequester .ws_safety_token:
-         * it may only be used by dedicated websocket library thread
-         * (the unique thread that calls ::lws_service())
+            /* only sessions belonging to svc;  other service threads
+             * take care of their own
+             */
+            for (WebsocketSessionRecd * session_recd : svc->session_v(ws_safety_token))
+                session_recd->lws_request_writeable(ws_safety_token);
+        } /*lws_request_writeable*/
+
+        /* libwebsockets callbacks + service loop.
+         * WsSafetyToken for each service thread is sequestered in WsServiceThread:
+         * it may only be used by that thread
+         * (the unique thread that calls ::lws_service() for its context)
          */
         class WebserverImplWsThread : public WebserverImpl {
         public:
@@ -1537,7 +1646,7 @@ namespace xo {
                     this->init_mount_dynamic(&(this->mount_dynamic_));
                     this->init_mount_static(&(this->mount_dynamic_),
                                             &(this->mount_static_));
-                    this->init_cx_config(&(this->cx_config_));
+                    /* per-thread lws context config: see .start_webserver() */
                 } /*ctor*/
 
             /* create instance */
@@ -1549,10 +1658,10 @@ namespace xo {
             /* init helper */
             virtual void init_protocols(std::vector<lws_protocols> * p_v) override;
 
-            /* run webserver.   borrows calling thread,  doesn't return
+            /* run service loop for svc.   borrows calling thread,  doesn't return
              * until webserver stopped.
              */
-            virtual void run() override;
+            virtual void run(WsServiceThread * svc) override;
 
         private:
             /* callback for lws-minimal protocol (websocket) */
@@ -1561,15 +1670,6 @@ namespace xo {
                                       void * user_data,
                                       void * incoming_uri,
                                       size_t len);
-
-            WsSafetyToken const & ws_safety_token() const { return ws_safety_token_; }
-
-        private:
-            /* a function taking .ws_safety_token as an argument,
-             * announces that it is being called from the libws thread,
-             * i.e. reentrantly from ::lws_service()
-             */
-            WsSafetyToken ws_safety_token_;
         }; /*WebserverImplWsThread*/
 
         /* 1. anything after the host:port prefix will get handled by callback_dynamic_http
@@ -1641,10 +1741,13 @@ namespace xo {
             assert(lws_cx);
             void * cx_user_data = lws_context_user(lws_cx);
 
-            WebserverImplWsThread * websrv = reinterpret_cast<WebserverImplWsThread *>(cx_user_data);
+            WsServiceThread * svc = reinterpret_cast<WsServiceThread *>(cx_user_data);
+            assert(svc);
+
+            WebserverImplWsThread * websrv = static_cast<WebserverImplWsThread *>(svc->websrv());
             assert(websrv);
 
-            WsSafetyToken const & ws_token = websrv->ws_safety_token();
+            WsSafetyToken const & ws_token = svc->ws_safety_token();
 
             struct per_session_data__minimal * ws_pss
                 = ((struct per_session_data__minimal *)user_data);
@@ -1662,8 +1765,6 @@ namespace xo {
                 = ((struct per_vhost_data__minimal *)
                    lws_protocol_vh_priv_get(lws_get_vhost(wsi),
                                             lws_get_protocol(wsi)));
-            int m;
-
             switch (reason) {
             case LWS_CALLBACK_PROTOCOL_INIT:
             {
@@ -1675,7 +1776,6 @@ namespace xo {
                 vhd->vhost = lws_get_vhost(wsi);
                 vhd->protocol = lws_get_protocol(wsi);
                 vhd->pss_list = nullptr;
-                vhd->next_session_id_ = 1;
                 //vhd->current = 0;
 
                 lwsl_user("WebserverImpl::notify_minimal: vhost=%p, protocols=%p protocol.name=%s\n",
@@ -1699,7 +1799,8 @@ namespace xo {
 
                 assert(vhd);
 
-                ws_pss->output_buf_ = new OutputBuffer(vhd->next_session_id_++);
+                /* session id assigned from LWS_CALLBACK_ESTABLISHED */
+                ws_pss->output_buf_ = new OutputBuffer();
 
                 lwsl_user("establish pss->output_buf [%p] in ws_pss [%p]",
                           ws_pss->output_buf_,
@@ -1735,7 +1836,7 @@ namespace xo {
 
                 output_buf->establish_wsi(wsi);
 
-                websrv->notify_ws_session_open(output_buf, vhd, ws_token);
+                websrv->notify_ws_session_open(output_buf, svc, ws_token);
             }
             break;
 
@@ -1747,7 +1848,7 @@ namespace xo {
                 assert(ws_pss->output_buf_);
                 assert(vhd);
 
-                websrv->notify_ws_session_close(ws_pss->output_buf_, vhd, ws_token);
+                websrv->notify_ws_session_close(ws_pss->output_buf_, svc, ws_token);
 
                 if (ws_pss->output_buf_) {
                     delete ws_pss->output_buf_;
@@ -1760,8 +1861,11 @@ namespace xo {
 
             case LWS_CALLBACK_EVENT_WAIT_CANCELLED:
             {
+                /* arm SERVER_WRITEABLE for sessions with queued messages;
+                 * writing happens there
+                 */
                 if (websrv)
-                    websrv->lws_write_pending_traffic(ws_token);
+                    websrv->lws_request_writeable(svc, ws_token);
             }
             break;
 
@@ -1802,55 +1906,24 @@ namespace xo {
                 lwsl_user("notify_minimal: unblock writing, output_msg=[%p]",
                           ws_pss->output_buf_);
 
-                if (ws_pss->output_buf_->is_writeable(ws_token)) {
-                    //assert(false);
-                } else {
+                if (!(ws_pss->output_buf_->is_writeable(ws_token))) {
                     /* a previous call to lws_write() reported a partial write;
                      * that write has now completed
                      */
                     ws_pss->output_buf_->lws_write_completion(ws_token);
-                    break;
                 }
 
-                if (ws_pss->output_buf_->is_idle()) {
-                    lwsl_user("client entry: output_msg buffer up-to-date, return");
-                    /* already up-to-date,  nothing new to send */
-                    break;
-                }
+                WebsocketSessionRecd * session_recd = ws_pss->output_buf_->session_recd();
 
-#ifdef NOT_USING
-                if (ws_pss->last == vhd->current) {
-                    /* already up-to-date */
+                if (!session_recd) {
+                    lwsl_user("client entry: session not yet established, return");
                     break;
                 }
 
-                if (!pss->output_msg_.payload) {
-                    pss->output_msg_.payload = ::malloc(LWS_PRE + output_z);
-                    pss->output_msg_.len = output_z;
-                }
-
-                ::memcpy((char *)pss->output_msg_.payload + LWS_PRE, output_cstr, output_z);
-
-                lwsl_user("allocate pss->output_msg [%p] in pss [%p]",
-                          pss->output_msg_.payload, pss);
-                m = lws_write(wsi,
-                              ((unsigned char *)pss->output_msg_.payload) + LWS_PRE,
-                              pss->output_msg_.len,
-                              LWS_WRITE_TEXT);
-#endif
-
-                //XO_SCOPE_(lscope);
-
-                /* pss->output_msg_ was populated from WebserverImpl.send_text(), q.v. */
-
-                m = ws_pss->output_buf_->lws_write_aux(ws_token);
-
-#ifdef NOT_USING
-                m = lws_write(wsi, ((unsigned char *)vhd->amsg.payload) +
-                              LWS_PRE, vhd->amsg.len, LWS_WRITE_TEXT);
-                if (m < (int)vhd->amsg.len) { .. }
-#endif
-                if (m == -1) {
+                /* send next queued message (if any) for this session.
+                 * messages were queued from WebserverImpl.send_message(), q.v.
+                 */
+                if (!session_recd->lws_write_pending(ws_token)) {
                     lwsl_err("WebserverImplWsThread::notify_minimal: return -1 from callback");
                     return -1;
                 }
@@ -1915,12 +1988,14 @@ namespace xo {
         } /*notify_minimal*/
 
         void
-        WebserverImplWsThread::run()
+        WebserverImplWsThread::run(WsServiceThread * svc)
         {
             scope log(XO_DEBUG_(false /*debug_flag*/));
 
             lwsl_user("LWS minimal http server dynamic"
-                      " | visit http://localhost:%d\n", this->ws_config_.port());
+                      " | visit http://localhost:%d (service thread %u)\n",
+                      this->ws_config_.port(),
+                      svc->service_ix());
 #if defined(LWS_WITH_PLUGINS)
             lwsl_user("LWS_WITH_PLUGINS present");
 #endif
@@ -1928,33 +2003,41 @@ namespace xo {
             lwsl_user("LWS_WITH_TLS present");
 #endif
 
-            /* exit when .state is stop_requested,  setting state to .stopped */
+            /* exit when .state is stop_requested;
+             * last service thread to exit sets state to .stopped
+             */
 
-            this->lws_cx_ = lws_create_context(&(this->cx_config_));
+            lws_context * lws_cx = lws_create_context(svc->cx_config());
 
-            if (!(this->lws_cx_)) {
-                lwsl_err("lws init failed\n");
-                return;
-            }
+            if (lws_cx) {
+                svc->set_lws_cx(lws_cx);
 
-            std::int32_t n_event = 0;
-            while ((n_event >= 0) && !(this->interrupt_flag_)) {
-                n_event = ::lws_service(this->lws_cx_,
-                                        0 /*ignored (used to be timeout)*/);
-            }
+                std::int32_t n_event = 0;
+                while ((n_event >= 0) && !(this->interrupt_flag_)) {
+                    n_event = ::lws_service(lws_cx,
+                                            0 /*ignored (used to be timeout)*/);
+                }
 
-            log && log("webserver runner returned - service loop exited",
-                       xtag("n_event", n_event),
-                       xtag("interrupted", this->interrupt_flag_.load()));
+                log && log("webserver runner returned - service loop exited",
+                           xtag("service_ix", svc->service_ix()),
+                           xtag("n_event", n_event),
+                           xtag("interrupted", this->interrupt_flag_.load()));
 
-            lws_context_destroy(this->lws_cx_);
-            this->lws_cx_ = nullptr;
+                lws_context_destroy(lws_cx);
+                svc->set_lws_cx(nullptr);
+            } else {
+                lwsl_err("lws init failed\n");
+            }
 
             {
                 std::unique_lock<std::mutex> lock(this->mutex_);
 
-                this->state_ = Runstate::stopped;
-                this->cond_.notify_all();
+                assert(this->n_running_service_ > 0);
+
+                if (--(this->n_running_service_) == 0) {
+                    this->state_.store(Runstate::stopped);
+                    this->cond_.notify_all();
+                }
             }
 
             log && log("exit");
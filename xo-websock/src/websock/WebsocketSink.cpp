@@ -5,6 +5,7 @@
 
 #include "WebsocketSink.hpp"
 #include "Webserver.hpp"
+#include "WsMessageBuffer.hpp"
 #include <xo/printjson/PrintJson.hpp>
 #include <xo/reflect/Reflect.hpp>
 #include <xo/reflect/TaggedPtr.hpp>
@@ -12,6 +13,8 @@
 #include <xo/ppsink/scope.hpp>
 #include <xo/ppsink/scope_macros.hpp>
 #include <xo/ppsink/tag_ostream.hpp>      /* ss << xtag(..) */
+#include <ostream>
+#include <sstream>
 
 namespace xo {
     using xo::reactor::AbstractSource;
@@ -54,8 +57,15 @@ namespace xo {
                 : websrv_{std::move(websrv)},
                   pjson_{std::move(pjson)},
                   session_id_{session_id},
-                  stream_name_{std::move(stream_name)}
-                {}
+                  stream_name_{std::move(stream_name)},
+                  msg_os_{&msg_}
+                {
+                    /* message envelope prefix is the same for every event */
+                    std::stringstream ss;
+                    ss << "{" << quot("stream") << ": " << quot(this->stream_name_)
+                       << ", " << quot("event") << ": ";
+                    this->msg_prefix_ = ss.str();
+                }
 
             virtual std::string const & name() const override { return name_; }
             virtual void set_name(std::string const & x) override { this->name_ = x; }
@@ -94,6 +104,18 @@ namespace xo {
             std::string stream_name_;
             /* count #of events received */
             uint32_t n_in_ev_ = 0;
+            /* envelope text preceding each event:
+             *   {"stream": "/this/stream/name", "event":
+             */
+            std::string msg_prefix_;
+            /* outgoing message built here,  with headroom for lws_write().
+             * storage recycled by Webserver::send_message(),
+             * so steady-state serialization doesn't allocate.
+             * Consequently .notify_ev_tp() is not reentrant
+             */
+            WsMessageBuffer msg_;
+            /* formats into .msg */
+            std::ostream msg_os_;
         }; /*WebsocketSinkImpl*/
 
         TypeDescr
@@ -110,25 +132,29 @@ namespace xo {
         void
         WebsocketSinkImpl::notify_ev_tp(TaggedPtr const & ev_tp)
         {
-            scope log(XO_DEBUG_(true /*debug_flag*/));
+            scope log(XO_DEBUG_(false /*debug_flag*/));
 
-            std::stringstream ss;
+            /* .msg normally empty here (holds storage recycled from a previous message),
+             * but not if a previous call threw part way through (e.g. from .print_tp());
+             * discard any such partial message,  and any error state on .msg_os
+             */
+            this->msg_.clear();
+            this->msg_os_.clear();
 
             /* format message envelope */
-            ss << "{" << quot("stream") << ": " << quot(this->stream_name_)
-               << ", " << quot("event") << ": ";
+            this->msg_.append(this->msg_prefix_);
 
-            /* format event as json */
-            this->pjson_->print_tp(ev_tp, &ss);
+            /* format event as json,  directly into .msg */
+            this->pjson_->print_tp(ev_tp, &(this->msg_os_));
 
-            ss << "}";
+            this->msg_.append("}");
 
-            log && log("sending", xtag("msg", ss.str()));
+            log && log("sending", xtag("msg", this->msg_.text_view()));
 
             ++(this->n_in_ev_);
 
-            /* send event via associated websocket */
-            this->websrv_->send_text(this->session_id_, ss.str());
+            /* send event via associated websocket;  hands off .msg storage without copying */
+            this->websrv_->send_message(this->session_id_, &(this->msg_));
 
         } /*notify_ev_tp*/
 
@@ -0,0 +1,212 @@
+/* @file EndpointRouter.test.cpp */
+
+#include "xo/websock/EndpointRouter.hpp"
+#include <catch2/catch.hpp>
+#include <memory>
+#include <string>
+#include <vector>
+
+namespace xo {
+    using xo::web::EndpointRouter;
+    using xo::web::DynamicEndpoint;
+    using xo::web::Alist;
+
+    namespace ut {
+        namespace {
+            /* http endpoint for pattern;  callback never invoked here */
+            std::unique_ptr<DynamicEndpoint>
+            make_endpoint(std::string pattern)
+            {
+                return DynamicEndpoint::make_http(std::move(pattern),
+                                                  [](std::string const &, Alist const &, std::ostream *) {},
+                                                  "text/plain");
+            } /*make_endpoint*/
+
+            /* pattern of endpoint matching uri,  or "" if none */
+            std::string
+            route(EndpointRouter const & router, std::string const & uri, Alist * p_alist = nullptr)
+            {
+                std::shared_ptr<DynamicEndpoint> endpoint = router.lookup(uri, p_alist);
+
+                return endpoint ? endpoint->uri_pattern() : std::string();
+            } /*route*/
+        } /*namespace*/
+
+        TEST_CASE("endpoint-router-literal", "[websock][router]") {
+            EndpointRouter router;
+
+            router.insert(make_endpoint("/uls/snap"));
+            router.insert(make_endpoint("/uls/colsnap"));
+
+            REQUIRE(router.size() == 2);
+
+            REQUIRE(route(router, "/uls/snap") == "/uls/snap");
+            REQUIRE(route(router, "/uls/colsnap") == "/uls/colsnap");
+
+            /* match is exact:  no prefix match,  no trailing '/' */
+            REQUIRE(route(router, "/uls") == "");
+            REQUIRE(route(router, "/uls/snap/") == "");
+            REQUIRE(route(router, "/uls/snap/x") == "");
+            REQUIRE(route(router, "uls/snap") == "");
+            REQUIRE(route(router, "") == "");
+
+            /* replacing endpoint with same pattern doesn't change size */
+            router.insert(make_endpoint("/uls/snap"));
+
+            REQUIRE(router.size() == 2);
+            REQUIRE(route(router, "/uls/snap") == "/uls/snap");
+        } /*TEST_CASE(endpoint-router-literal)*/
+
+        TEST_CASE("endpoint-router-replace", "[websock][router]") {
+            EndpointRouter router;
+
+            router.insert(make_endpoint("/uls/${ticker}"));
+
+            std::shared_ptr<DynamicEndpoint> held = router.lookup("/uls/spx", nullptr);
+            std::weak_ptr<DynamicEndpoint> held_w = held;
+
+            REQUIRE(held);
+
+            /* same pattern,  different variable name -> replaces */
+            router.insert(make_endpoint("/uls/${sym}"));
+
+            REQUIRE(router.size() == 1);
+            REQUIRE(route(router, "/uls/spx") == "/uls/${sym}");
+
+            /* replaced endpoint survives while still referenced.. */
+            REQUIRE(held->uri_pattern() == "/uls/${ticker}");
+
+            /* ..and is released once no longer referenced */
+            held.reset();
+
+            REQUIRE(held_w.expired());
+        } /*TEST_CASE(endpoint-router-replace)*/
+
+        TEST_CASE("endpoint-router-priority", "[websock][router]") {
+            EndpointRouter router;
+
+            /* insert variable pattern first,  to show priority doesn't depend on order */
+            router.insert(make_endpoint("/uls/${ticker}/snap"));
+            router.insert(make_endpoint("/uls/spx/snap"));
+
+            /* literal segment beats variable segment */
+            {
+                Alist alist;
+
+                REQUIRE(route(router, "/uls/spx/snap", &alist) == "/uls/spx/snap");
+                REQUIRE(alist.lookup("ticker") == "");
+            }
+
+            /* variable segment used when no literal edge */
+            {
+                Alist alist;
+
+                REQUIRE(route(router, "/uls/ndx/snap", &alist) == "/uls/${ticker}/snap");
+                REQUIRE(alist.lookup("ticker") == "ndx");
+            }
+        } /*TEST_CASE(endpoint-router-priority)*/
+
+        TEST_CASE("endpoint-router-backtrack", "[websock][router]") {
+            EndpointRouter router;
+
+            router.insert(make_endpoint("/uls/spx/snap"));
+            router.insert(make_endpoint("/uls/${ticker}/hist"));
+            router.insert(make_endpoint("/${a}/${b}/depth"));
+
+            /* literal 'spx' edge taken first,  fails at 'hist';
+             * backtracks to ${ticker}
+             */
+            {
+                Alist alist;
+
+                REQUIRE(route(router, "/uls/spx/hist", &alist) == "/uls/${ticker}/hist");
+                REQUIRE(alist.lookup("ticker") == "spx");
+            }
+
+            /* backtracks two levels,  past both literal 'uls' and ${ticker} */
+            {
+                Alist alist;
+
+                REQUIRE(route(router, "/uls/spx/depth", &alist) == "/${a}/${b}/depth");
+                REQUIRE(alist.lookup("a") == "uls");
+                REQUIRE(alist.lookup("b") == "spx");
+            }
+
+            /* captures from abandoned branch don't leak into result */
+            {
+                Alist alist;
+
+                REQUIRE(route(router, "/uls/ndx/depth", &alist) == "/${a}/${b}/depth");
+                REQUIRE(alist.lookup("ticker") == "");
+                REQUIRE(alist.lookup("a") == "uls");
+                REQUIRE(alist.lookup("b") == "ndx");
+            }
+
+            REQUIRE(route(router, "/uls/spx/other") == "");
+        } /*TEST_CASE(endpoint-router-backtrack)*/
+
+        TEST_CASE("endpoint-router-empty-segment", "[websock][router]") {
+            EndpointRouter router;
+
+            router.insert(make_endpoint("/uls/${ticker}/snap"));
+            router.insert(make_endpoint("/file/${name}"));
+
+            /* variable doesn't match an empty segment */
+            REQUIRE(route(router, "/uls//snap") == "");
+            REQUIRE(route(router, "/file/") == "");
+
+            REQUIRE(route(router, "/file/x") == "/file/${name}");
+
+            /* empty literal segment only matches a pattern that has one */
+            router.insert(make_endpoint("/uls//snap"));
+
+            REQUIRE(route(router, "/uls//snap") == "/uls//snap");
+        } /*TEST_CASE(endpoint-router-empty-segment)*/
+
+        TEST_CASE("endpoint-router-partial-var", "[websock][router]") {
+            EndpointRouter router;
+
+            /* variable must occupy an entire segment */
+            REQUIRE_THROWS_AS(router.insert(make_endpoint("/foo/x${a}")), std::runtime_error);
+            REQUIRE_THROWS_AS(router.insert(make_endpoint("/foo/${a}x")), std::runtime_error);
+            REQUIRE_THROWS_AS(router.insert(make_endpoint("/foo/${a")), std::runtime_error);
+            REQUIRE_THROWS_AS(router.insert(make_endpoint("/foo/${a-b}")), std::runtime_error);
+
+            REQUIRE(router.size() == 0);
+            REQUIRE(route(router, "/foo/x1") == "");
+        } /*TEST_CASE(endpoint-router-partial-var)*/
+
+        TEST_CASE("endpoint-router-duplicate-var", "[websock][router]") {
+            std::unique_ptr<DynamicEndpoint> endpoint = make_endpoint("/x/${a}/${b}/${a}");
+
+            /* each variable name recorded once */
+            REQUIRE(endpoint->var_v() == std::vector<std::string>{"a", "b"});
+            REQUIRE(endpoint->seg_var_ix_v() == std::vector<std::uint32_t>{0, 1, 0});
+
+            EndpointRouter router;
+
+            router.insert(std::move(endpoint));
+            router.insert(make_endpoint("/y/${a}/${a}/${b}"));
+
+            /* repeated variable takes value from its 1st appearance */
+            {
+                Alist alist;
+
+                REQUIRE(route(router, "/x/1/2/3", &alist) == "/x/${a}/${b}/${a}");
+                REQUIRE(alist.lookup("a") == "1");
+                REQUIRE(alist.lookup("b") == "2");
+            }
+
+            /* later variables still paired with the right segment */
+            {
+                Alist alist;
+
+                REQUIRE(route(router, "/y/1/2/3", &alist) == "/y/${a}/${a}/${b}");
+                REQUIRE(alist.lookup("a") == "1");
+                REQUIRE(alist.lookup("b") == "3");
+            }
+        } /*TEST_CASE(endpoint-router-duplicate-var)*/
+    } /*namespace ut*/
+} /*namespace xo*/
+
+/* end EndpointRouter.test.cpp */
@@ -0,0 +1,237 @@
+/* @file WsSendQueue.test.cpp */
+
+#include "xo/websock/WsSendQueue.hpp"
+#include <catch2/catch.hpp>
+#include <atomic>
+#include <charconv>
+#include <string>
+#include <thread>
+#include <vector>
+
+namespace xo {
+    using xo::web::WsSendQueue;
+    using xo::web::WsOverflowPolicy;
+    using xo::web::WsMessageBuffer;
+    using xo::web::WsSessionStats;
+
+    namespace ut {
+        namespace {
+            /* push messages "0", "1", .., "n-1";  returns #of pushes that returned true */
+            std::uint32_t
+            push_sequence(WsSendQueue * p_q, std::uint32_t n)
+            {
+                std::uint32_t n_accepted = 0;
+                WsMessageBuffer msg;
+
+                for (std::uint32_t i = 0; i < n; ++i) {
+                    msg.append(std::to_string(i));
+
+                    if (p_q->push(&msg))
+                        ++n_accepted;
+
+                    /* push always leaves caller's buffer empty */
+                    REQUIRE(msg.text_z() == 0);
+                }
+
+                return n_accepted;
+            } /*push_sequence*/
+
+            std::vector<std::string>
+            drain(WsSendQueue * p_q)
+            {
+                std::vector<std::string> retval;
+                WsMessageBuffer msg;
+
+                while (p_q->pop(&msg))
+                    retval.push_back(std::string(msg.text_view()));
+
+                return retval;
+            } /*drain*/
+
+            struct PolicyCase {
+                WsOverflowPolicy policy_;
+                /* expected return count from push_sequence() */
+                std::uint32_t n_accepted_;
+                /* expected survivors,  in pop order */
+                std::vector<std::string> survivor_v_;
+                /* expected .n_dropped */
+                std::uint64_t n_dropped_;
+            };
+        } /*namespace*/
+
+        TEST_CASE("ws-send-queue-overflow", "[websock][sendqueue]") {
+            /* capacity 4,  10 messages */
+            std::vector<PolicyCase> case_v = {
+                {WsOverflowPolicy::drop_newest, 4, {"0", "1", "2", "3"}, 6},
+                {WsOverflowPolicy::drop_oldest, 10, {"6", "7", "8", "9"}, 6},
+                /* full at "4" -> backlog discarded,  queue = [4 5 6 7];
+                 * full at "8" -> discarded again,    queue = [8 9]
+                 */
+                {WsOverflowPolicy::coalesce, 10, {"8", "9"}, 8},
+            };
+
+            for (PolicyCase const & tc : case_v) {
+                INFO("policy=" << tc.policy_);
+
+                WsSendQueue q(4, tc.policy_);
+
+                REQUIRE(q.capacity() == 4);
+                REQUIRE(q.policy() == tc.policy_);
+
+                REQUIRE(push_sequence(&q, 10) == tc.n_accepted_);
+                REQUIRE(q.depth() == tc.survivor_v_.size());
+
+                WsSessionStats stats = q.stats();
+
+                REQUIRE(stats.n_dropped_ == tc.n_dropped_);
+                REQUIRE(stats.n_enqueued_ == tc.n_accepted_);
+                REQUIRE(stats.max_queue_depth_ == 4);
+                REQUIRE(stats.n_sent_ == 0);
+
+                REQUIRE(drain(&q) == tc.survivor_v_);
+
+                stats = q.stats();
+
+                REQUIRE(stats.queue_depth_ == 0);
+                REQUIRE(stats.n_sent_ == tc.survivor_v_.size());
+                /* every message accounted for */
+                REQUIRE(stats.n_sent_ + stats.n_dropped_ == 10);
+
+                /* queue usable again after draining */
+                REQUIRE(push_sequence(&q, 2) == 2);
+                REQUIRE(drain(&q) == std::vector<std::string>{"0", "1"});
+            }
+        } /*TEST_CASE(ws-send-queue-overflow)*/
+
+        TEST_CASE("ws-send-queue-capacity", "[websock][sendqueue]") {
+            /* rounded up to power of 2,  at least 2 */
+            REQUIRE(WsSendQueue(0, WsOverflowPolicy::drop_newest).capacity() == 2);
+            REQUIRE(WsSendQueue(3, WsOverflowPolicy::drop_newest).capacity() == 4);
+            REQUIRE(WsSendQueue(64, WsOverflowPolicy::drop_newest).capacity() == 64);
+            REQUIRE(WsSendQueue(65, WsOverflowPolicy::drop_newest).capacity() == 128);
+        } /*TEST_CASE(ws-send-queue-capacity)*/
+
+        TEST_CASE("ws-send-queue-close", "[websock][sendqueue]") {
+            WsSendQueue q(8, WsOverflowPolicy::drop_oldest);
+
+            REQUIRE(!q.is_closed());
+            REQUIRE(push_sequence(&q, 3) == 3);
+
+            q.close();
+
+            REQUIRE(q.is_closed());
+
+            /* closed queue discards new messages,  without counting them as overflow */
+            REQUIRE(push_sequence(&q, 5) == 0);
+            REQUIRE(q.stats().n_enqueued_ == 3);
+            REQUIRE(q.stats().n_dropped_ == 0);
+
+            /* already-queued messages still available */
+            REQUIRE(drain(&q) == std::vector<std::string>{"0", "1", "2"});
+        } /*TEST_CASE(ws-send-queue-close)*/
+
+        /* several producers + one consumer,  for each policy:
+         * - every message is either delivered once,  dropped,  or still queued
+         * - each producer's delivered messages arrive in the order sent
+         */
+        TEST_CASE("ws-send-queue-stress", "[websock][sendqueue]") {
+            constexpr std::uint32_t c_n_producer = 4;
+            constexpr std::uint32_t c_n_msg = 20000;
+
+            for (WsOverflowPolicy policy : {WsOverflowPolicy::drop_newest,
+                                            WsOverflowPolicy::drop_oldest,
+                                            WsOverflowPolicy::coalesce})
+            {
+                INFO("policy=" << policy);
+
+                WsSendQueue q(64, policy);
+
+                std::atomic<std::uint32_t> n_producer_done = 0;
+                std::vector<std::thread> producer_v;
+
+                for (std::uint32_t p = 0; p < c_n_producer; ++p) {
+                    producer_v.emplace_back([&q, &n_producer_done, p]
+                        {
+                            WsMessageBuffer msg;
+
+                            for (std::uint32_t i = 0; i < c_n_msg; ++i) {
+                                msg.append(std::to_string(p) + ":" + std::to_string(i));
+                                q.push(&msg);
+                            }
+
+                            ++n_producer_done;
+                        });
+                }
+
+                /* .last_seen_v[p]:  1 + seq# of last message received from producer p */
+                std::vector<std::uint32_t> last_seen_v(c_n_producer, 0);
+                std::uint64_t n_received = 0;
+                bool in_order = true;
+                bool well_formed = true;
+
+                auto consume = [&](WsMessageBuffer const & msg)
+                    {
+                        std::string_view text = msg.text_view();
+                        std::size_t colon = text.find(':');
+
+                        std::uint32_t p = 0;
+                        std::uint32_t i = 0;
+
+                        if ((colon == std::string_view::npos)
+                            || (std::from_chars(text.data(), text.data() + colon, p).ec != std::errc())
+                            || (std::from_chars(text.data() + colon + 1, text.data() + text.size(), i).ec != std::errc())
+                            || (p >= c_n_producer))
+                        {
+                            well_formed = false;
+                            return;
+                        }
+
+                        if (i + 1 <= last_seen_v[p])
+                            in_order = false;
+
+                        last_seen_v[p] = i + 1;
+                        ++n_received;
+                    };
+
+                {
+                    WsMessageBuffer msg;
+
+                    while (n_producer_done.load() < c_n_producer) {
+                        if (q.pop(&msg))
+                            consume(msg);
+                        else
+                            std::this_thread::yield();
+                    }
+
+                    for (std::thread & t : producer_v)
+                        t.join();
+
+                    /* remaining backlog */
+                    while (q.pop(&msg))
+                        consume(msg);
+                }
+
+                REQUIRE(well_formed);
+                REQUIRE(in_order);
+
+                WsSessionStats stats = q.stats();
+
+                REQUIRE(stats.queue_depth_ == 0);
+                REQUIRE(stats.n_sent_ == n_received);
+                REQUIRE(stats.max_queue_depth_ <= q.capacity());
+
+                if (policy == WsOverflowPolicy::drop_newest) {
+                    /* rejected at the door,  or delivered */
+                    REQUIRE(stats.n_enqueued_ + stats.n_dropped_ == c_n_producer * c_n_msg);
+                    REQUIRE(stats.n_enqueued_ == stats.n_sent_);
+                } else {
+                    /* always accepted;  then evicted,  or delivered */
+                    REQUIRE(stats.n_enqueued_ == c_n_producer * c_n_msg);
+                    REQUIRE(stats.n_sent_ + stats.n_dropped_ == c_n_producer * c_n_msg);
+                }
+            }
+        } /*TEST_CASE(ws-send-queue-stress)*/
+    } /*namespace ut*/
+} /*namespace xo*/
+
+/* end WsSendQueue.test.cpp */
@@ -0,0 +1,6 @@
+/* file websock_unit_utest_main.cpp */
+
+#define CATCH_CONFIG_MAIN
+#include "catch2/catch.hpp"
+
+/* end websock_unit_utest_main.cpp */
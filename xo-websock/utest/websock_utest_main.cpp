@@ -27,12 +27,18 @@
 #include "websock/Webserver.hpp"
 #include <xo/timeutil/timeutil.hpp>
 #include <signal.h>
+#include <unistd.h>
 
 /* webserver instance */
 static xo::ref::rp<xo::web::Webserver> g_ws;
 
+/* async-signal-safe:  no iostreams,  no locks.
+ * Webserver::interrupt_stop_webserver() only touches atomics + lws_cancel_service()
+ */
 void sigint_handler(int /*sig*/) {
-    std::cerr << "main thread interrupt_handler\n";
+    static char const c_msg[] = "main thread interrupt_handler\n";
+
+    (void)::write(STDERR_FILENO, c_msg, sizeof(c_msg) - 1);
 
     if (g_ws)
         g_ws->interrupt_stop_webserver();
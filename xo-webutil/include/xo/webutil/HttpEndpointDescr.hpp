@@ -28,17 +28,25 @@ namespace xo {
          * this comprises:
          * - a uri pattern.
          * - a function that can deliver http content on demand
+         * - mime type for that content
          */
         class HttpEndpointDescr {
         public:
             using PpSink = xo::pp::PpSink;
 
+            /* default mime type:  endpoints mostly deliver json */
+            static constexpr char const * c_mime_json = "application/json";
+            /* mime type for binary content,  e.g. reactor::ColumnarSnapshot */
+            static constexpr char const * c_mime_binary = "application/octet-stream";
+
         public:
             HttpEndpointDescr(std::string uri_pattern,
-                              HttpEndpointFn endpoint_fn);
+                              HttpEndpointFn endpoint_fn,
+                              std::string mime_type = c_mime_json);
 
             std::string const & uri_pattern() const { return uri_pattern_; }
             HttpEndpointFn const & endpoint_fn() const { return endpoint_fn_; }
+            std::string const & mime_type() const { return mime_type_; }
 
             /** structured pretty-printing: render this descriptor into @p sink.
              *
@@ -74,6 +82,8 @@ namespace xo {
              * appears in .uri_pattern (surrounded by ${..})
              */
             HttpEndpointFn endpoint_fn_;
+            /* mime type for content written by .endpoint_fn */
+            std::string mime_type_;
         }; /*HttpEndpointDescr*/
 
     } /*namespace web*/
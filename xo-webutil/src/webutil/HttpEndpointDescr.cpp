@@ -8,9 +8,11 @@
 namespace xo {
     namespace web {
         HttpEndpointDescr::HttpEndpointDescr(std::string uri_pattern,
-                                             HttpEndpointFn endpoint_fn)
+                                             HttpEndpointFn endpoint_fn,
+                                             std::string mime_type)
             : uri_pattern_{std::move(uri_pattern)},
-              endpoint_fn_{std::move(endpoint_fn)}
+              endpoint_fn_{std::move(endpoint_fn)},
+              mime_type_{std::move(mime_type)}
         {}
 
         void